@@ -29,6 +29,7 @@
 #include <miral/cursor_theme.h>
 #include <miral/keymap.h>
 #include <miral/toolkit_event.h>
+#include <miral/realtime_scheduling.h>
 #include <miral/x11_support.h>
 #include <miral/wayland_extensions.h>
 
@@ -113,6 +114,7 @@ int main(int argc, char const* argv[])
             CursorTheme{"default:DMZ-White"},
             WaylandExtensions{},
             X11Support{},
+            RealtimeScheduling{},
             window_managers,
             display_configuration_options,
             external_client_launcher,
@@ -20,9 +20,11 @@
 #include "mir/dispatch/dispatchable.h"
 #include "mir/posix_rw_mutex.h"
 
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <list>
+#include <memory>
 #include <mutex>
 
 #include <pthread.h>
@@ -44,6 +46,21 @@ enum class DispatchReentrancy
                      */
 };
 
+/**
+ * \brief When a watched fd is reported as ready for dispatch
+ */
+enum class DispatchTrigger
+{
+    level,          /**< Whenever the fd has relevant events pending, however
+                     *   much each dispatch consumes.
+                     */
+    edge            /**< Only when new relevant events arrive. The dispatch function
+                     *   must consume everything pending on the (non-blocking) fd, and
+                     *   must tolerate being called when there is nothing to consume.
+                     *   This saves re-arming the fd after each sequential dispatch.
+                     */
+};
+
 /**
  * \brief An adaptor that combines multiple Dispatchables into a single Dispatchable
  * \note Instances are fully thread-safe.
@@ -72,6 +89,14 @@ public:
      * \brief Add a dispatchable to the adaptor, specifying the reentrancy of dispatch()
      */
     void add_watch(std::shared_ptr<Dispatchable> const& dispatchee, DispatchReentrancy reentrancy);
+    /**
+     * \brief Add a dispatchable to the adaptor, specifying the reentrancy of dispatch()
+     *        and when it is triggered
+     */
+    void add_watch(
+        std::shared_ptr<Dispatchable> const& dispatchee,
+        DispatchReentrancy reentrancy,
+        DispatchTrigger trigger);
 
     /**
      * \brief Add a simple callback to the adaptor
@@ -92,9 +117,18 @@ public:
      * \param [in] fd   File descriptor of watch to remove.
      */
     void remove_watch(Fd const& fd);
+
+    /**
+     * \brief The number of times the watch on a file-descriptor has been dispatched
+     * \param [in] fd   File descriptor of the watch
+     * \return          The count, or 0 if \p fd is not watched
+     */
+    auto dispatch_count(Fd const& fd) const -> uint64_t;
 private:
-    PosixRWMutex lifetime_mutex;
-    std::list<std::pair<std::shared_ptr<Dispatchable>, bool>> dispatchee_holder;
+    struct Watch;
+
+    mutable PosixRWMutex lifetime_mutex;
+    std::list<std::shared_ptr<Watch>> dispatchee_holder;
 
     Fd epoll_fd;
 };
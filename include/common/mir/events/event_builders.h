@@ -198,6 +198,8 @@ EventUPtr make_touch_event(
     std::vector<TouchContact> const& contacts);
 
 EventUPtr clone_event(MirEvent const& event);
+/// Shares ownership of event, taking the control block from the same pool as input events rather than the heap
+std::shared_ptr<MirEvent> share_event(EventUPtr&& event);
 void transform_positions(MirEvent& event, mir::geometry::Displacement const& movement);
 void scale_positions(MirEvent& event, float scale);
 void set_window_id(MirEvent& event, int window_id);
@@ -0,0 +1,84 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GEOMETRY_REGION_H_
+#define MIR_GEOMETRY_REGION_H_
+
+#include "mir/geometry/point.h"
+#include "mir/geometry/rectangle.h"
+#include "mir/geometry/displacement.h"
+
+#include <initializer_list>
+#include <iosfwd>
+#include <vector>
+
+namespace mir
+{
+namespace geometry
+{
+
+/**
+ * An area made up of rectangles, without overlaps.
+ *
+ * The rectangles are kept in y-x banded order: the area is split into horizontal bands, each holding
+ * non-touching rectangles sorted left to right, and vertically adjacent bands that span the same columns
+ * are merged. As a result any two equal areas have exactly the same rectangles, and adding, subtracting
+ * or intersecting regions is linear in the number of rectangles.
+ */
+class Region
+{
+public:
+    Region();
+    Region(Rectangle const& rect);
+    Region(std::initializer_list<Rectangle> const& rects);
+    explicit Region(std::vector<Rectangle> const& rects);
+    /* We want to keep implicit copy and move methods */
+
+    /// Adds the area of other to this region
+    void add(Region const& other);
+    /// Removes the area of other from this region
+    void subtract(Region const& other);
+    /// Restricts this region to the area it shares with other
+    void intersect(Region const& other);
+    void translate(Displacement const& displacement);
+    void clear();
+
+    bool empty() const;
+    bool contains(Point const& point) const;
+    /// True if every point of rect is in this region (including when rect is empty)
+    bool contains(Rectangle const& rect) const;
+    Rectangle bounding_rectangle() const;
+
+    typedef std::vector<Rectangle>::const_iterator const_iterator;
+    typedef std::vector<Rectangle>::size_type size_type;
+    const_iterator begin() const;
+    const_iterator end() const;
+    /// The number of rectangles in the region
+    size_type size() const;
+
+    bool operator==(Region const& other) const;
+    bool operator!=(Region const& other) const;
+
+private:
+    std::vector<Rectangle> rectangles;
+};
+
+std::ostream& operator<<(std::ostream& out, Region const& value);
+
+}
+}
+
+#endif /* MIR_GEOMETRY_REGION_H_ */
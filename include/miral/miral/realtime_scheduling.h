@@ -0,0 +1,49 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRAL_REALTIME_SCHEDULING_H
+#define MIRAL_REALTIME_SCHEDULING_H
+
+#include <memory>
+
+namespace mir { class Server; }
+
+namespace miral
+{
+/// Add user configuration options for running the input thread, and optionally the compositor threads, with
+/// real-time (SCHED_FIFO or SCHED_RR) priority, a CPU affinity and locked memory.
+/// Real-time priority needs CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO; if it is not allowed a warning is logged
+/// and the threads keep normal scheduling.
+/// \remark Since MirAL 3.7
+class RealtimeScheduling
+{
+public:
+
+    void operator()(mir::Server& server) const;
+
+    RealtimeScheduling();
+    ~RealtimeScheduling();
+    RealtimeScheduling(RealtimeScheduling const&);
+    auto operator=(RealtimeScheduling const&) -> RealtimeScheduling&;
+
+private:
+    struct Self;
+    std::shared_ptr<Self> self;
+};
+
+}
+
+#endif //MIRAL_REALTIME_SCHEDULING_H
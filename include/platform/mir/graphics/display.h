@@ -75,6 +75,26 @@ public:
      */
     virtual std::chrono::milliseconds recommended_sleep() const = 0;
 
+    /**
+     * Returns the Frame the most recently completed post() reached the
+     * screen on. If post() returned before the content was scanned out, or
+     * the platform does not learn when that happens, this is the time of
+     * the post() with an MSC of zero.
+     */
+    virtual Frame last_frame() const
+    {
+        return Frame{0, Frame::Timestamp::now(CLOCK_MONOTONIC)};
+    }
+
+    /**
+     * Waits for the content of the most recent post() to be scanned out,
+     * if post() returned before it was, and then returns last_frame().
+     */
+    virtual Frame wait_for_last_frame()
+    {
+        return last_frame();
+    }
+
     virtual ~DisplaySyncGroup() = default;
 protected:
     DisplaySyncGroup() = default;
@@ -258,6 +258,8 @@ struct EGLExtensions
         PFNEGLCREATEIMAGEKHRPROC const eglCreateImageKHR;
         PFNEGLDESTROYIMAGEKHRPROC const eglDestroyImageKHR;
         PFNGLEGLIMAGETARGETTEXTURE2DOESPROC const glEGLImageTargetTexture2DOES;
+        /// Part of the same GL extension as glEGLImageTargetTexture2DOES, but not relied upon (may be null)
+        PFNGLEGLIMAGETARGETRENDERBUFFERSTORAGEOESPROC const glEGLImageTargetRenderbufferStorageOES;
     };
     LazyDisplayExtensions<BaseExtensions> const base;
 
@@ -47,6 +47,12 @@ public:
      */
     virtual std::shared_ptr<Buffer> buffer() const = 0;
 
+    /**
+     * The part of buffer() to draw, in buffer pixels. It is scaled to fill
+     * screen_position(); usually this is the whole buffer.
+     */
+    virtual geometry::RectangleD src_bounds() const = 0;
+
     virtual geometry::Rectangle screen_position() const = 0;
     virtual std::optional<geometry::Rectangle> clip_area() const = 0;
 
@@ -69,6 +75,13 @@ public:
     virtual glm::mat4 transformation() const = 0;
 
     virtual bool shaped() const = 0;  // meaning the pixel format has alpha
+
+    /**
+     * The parts of a shaped() renderable its client guarantees are fully
+     * opaque, in the same coordinates as screen_position(). Blending and
+     * occlusion may treat these as if the renderable were not shaped.
+     */
+    virtual std::vector<geometry::Rectangle> opaque_region() const = 0;
 protected:
     Renderable() = default;
     Renderable(Renderable const&) = delete;
@@ -0,0 +1,64 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_SOLID_COLOUR_BUFFER_H_
+#define MIR_GRAPHICS_SOLID_COLOUR_BUFFER_H_
+
+#include "mir/graphics/buffer_basic.h"
+#include "mir/renderer/sw/pixel_source.h"
+
+#include <array>
+
+namespace mir
+{
+namespace graphics
+{
+/**
+ * A buffer whose every pixel is the same colour.
+ *
+ * It has no pixel storage: renderers that recognise it fill the renderable's
+ * screen_position() with colour() instead of sampling a texture. Where pixels
+ * are needed (such as for a cursor) they can be read as ARGB 8888.
+ */
+class SolidColourBuffer :
+    public BufferBasic,
+    public NativeBufferBase,
+    public renderer::software::ReadTransferableBuffer
+{
+public:
+    /// Premultiplied red, green, blue and alpha, each in [0, 1]
+    using Colour = std::array<float, 4>;
+
+    explicit SolidColourBuffer(Colour const& colour, geometry::Size size = geometry::Size{1, 1});
+
+    auto colour() const -> Colour const& { return colour_; }
+
+    geometry::Size size() const override;
+    MirPixelFormat pixel_format() const override;
+    NativeBufferBase* native_buffer_base() override;
+
+    MirPixelFormat format() const override;
+    geometry::Stride stride() const override;
+    void transfer_from_buffer(unsigned char* destination) const override;
+
+private:
+    Colour const colour_;
+    geometry::Size const size_;
+};
+}
+}
+
+#endif // MIR_GRAPHICS_SOLID_COLOUR_BUFFER_H_
@@ -0,0 +1,48 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_INPUT_DEVICE_STATISTICS_H_
+#define MIR_INPUT_INPUT_DEVICE_STATISTICS_H_
+
+#include <chrono>
+#include <cstdint>
+
+namespace mir
+{
+namespace input
+{
+/// How much input a device has sent, and how long the input thread has spent handling it, since it was added
+struct InputDeviceStatistics
+{
+    /// Events received from the device (including any dropped)
+    uint64_t events{0};
+    /// Motion events dropped (and merged into later events) by the motion rate limit
+    uint64_t dropped_events{0};
+    /// The rate events were received at over the last complete measurement period (zero once the device is quiet)
+    uint64_t events_per_second{0};
+
+    /// Time spent handling the device's events, from receiving them to the end of dispatch. The handling times
+    /// are only measured while the input report wants the statistics (see InputReport::wants_device_statistics()).
+    std::chrono::nanoseconds handle_input_time{0};
+    /// Time spent in the event filters, which is part of handle_input_time
+    std::chrono::nanoseconds event_filter_time{0};
+    /// Time spent in the seat, excluding event_filter_time
+    std::chrono::nanoseconds seat_time{0};
+};
+}
+}
+
+#endif /* MIR_INPUT_INPUT_DEVICE_STATISTICS_H_ */
@@ -18,6 +18,8 @@
 #ifndef MIR_INPUT_INPUT_REPORT_H_
 #define MIR_INPUT_INPUT_REPORT_H_
 
+#include "mir/input/input_device_statistics.h"
+
 #include <stdint.h>
 
 namespace mir
@@ -39,6 +41,11 @@ public:
     virtual void opened_input_device(char const* device_name, char const* input_platform) = 0;
     virtual void failed_to_open_input_device(char const* device_name, char const* input_platform) = 0;
 
+    /// Called about once a second for each device sending input, and once more when it goes quiet
+    virtual void device_statistics(char const* device_name, InputDeviceStatistics const& statistics) = 0;
+    /// Whether device_statistics() is used. If not, the time spent handling input isn't measured.
+    virtual auto wants_device_statistics() const -> bool { return true; }
+
 protected:
     InputReport() = default;
     InputReport(InputReport const&) = delete;
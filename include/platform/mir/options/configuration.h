@@ -46,6 +46,21 @@ extern char const* const wayland_extensions_opt;
 extern char const* const add_wayland_extensions_opt;
 extern char const* const drop_wayland_extensions_opt;
 extern char const* const idle_timeout_opt;
+extern char const* const hidden_surface_frame_rate_opt;
+extern char const* const coalesce_pointer_motion_opt;
+extern char const* const resample_touch_opt;
+extern char const* const input_record_opt;
+extern char const* const input_motion_rate_limit_opt;
+
+/// Real-time scheduling options. These are only available if the shell adds them (e.g. with miral::RealtimeScheduling)
+///@{
+extern char const* const realtime_policy_opt;
+extern char const* const input_thread_priority_opt;
+extern char const* const input_thread_cpus_opt;
+extern char const* const compositor_thread_priority_opt;
+extern char const* const compositor_thread_cpus_opt;
+extern char const* const lock_memory_opt;
+///@}
 
 extern char const* const enable_key_repeat_opt;
 
@@ -20,10 +20,17 @@
 #include "buffer_render_target.h"
 
 #include <optional>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
 #include <GLES2/gl2.h>
 
 namespace mir
 {
+namespace graphics
+{
+struct EGLExtensions;
+}
 namespace renderer
 {
 namespace gl
@@ -35,8 +42,13 @@ class BasicBufferRenderTarget: public BufferRenderTarget
 {
 public:
     BasicBufferRenderTarget(std::shared_ptr<Context> const& ctx);
+    ~BasicBufferRenderTarget();
 
     void set_buffer(std::shared_ptr<software::WriteMappableBuffer> const& buffer) override;
+    void set_buffer_region(
+        std::shared_ptr<software::WriteMappableBuffer> const& buffer,
+        geometry::Rectangle const& region) override;
+    void set_gpu_buffer(std::shared_ptr<graphics::Buffer> const& buffer) override;
 
     auto size() const -> geometry::Size override;
     void make_current() override;
@@ -50,7 +62,8 @@ private:
     public:
         Framebuffer(geometry::Size const& size);
         ~Framebuffer();
-        void copy_to(software::WriteMappableBuffer& buffer);
+        /// Copies the bottom-left region.size of the framebuffer into region of the buffer
+        void copy_to(software::WriteMappableBuffer& buffer, geometry::Rectangle const& region);
         void bind();
 
         geometry::Size const size;
@@ -61,12 +74,25 @@ private:
 
         GLuint colour_buffer;
         GLuint fbo;
+        std::vector<unsigned char> staging;
     };
 
+    /// A dmabuf imported as an EGLImage, with a framebuffer that renders straight into it
+    class ImportedFramebuffer;
+
     std::shared_ptr<Context> const ctx;
 
     std::shared_ptr<software::WriteMappableBuffer> buffer{nullptr};
+    /// The part of buffer being rendered to, the framebuffer is sized for the whole buffer so it can be reused
+    geometry::Rectangle region;
     std::optional<Framebuffer> framebuffer;
+
+    std::shared_ptr<graphics::Buffer> gpu_buffer{nullptr};
+    /// Only needed (and only created) once a GPU buffer is rendered to
+    std::shared_ptr<graphics::EGLExtensions> egl_extensions;
+    /// Clients cycle through a few buffers, so each is only imported once. Keyed by the dmabuf's inode, which can't
+    /// be reused while the import holds a reference. Most recently used last.
+    std::vector<std::pair<ino_t, std::unique_ptr<ImportedFramebuffer>>> imported_framebuffers;
 };
 
 }
@@ -18,12 +18,16 @@
 #define MIR_RENDERER_GL_BUFFER_RENDER_TARGET_H_
 
 #include "render_target.h"
-#include "mir/geometry/size.h"
+#include "mir/geometry/rectangle.h"
 
 #include <memory>
 
 namespace mir
 {
+namespace graphics
+{
+class Buffer;
+}
 namespace renderer
 {
 namespace software
@@ -37,7 +41,14 @@ namespace gl
 class BufferRenderTarget: public RenderTarget
 {
 public:
+    /// Switching to another buffer of the same size keeps the last frame, so swap_buffers() can copy it out again
     virtual void set_buffer(std::shared_ptr<software::WriteMappableBuffer> const& buffer) = 0;
+    /// Frames are only rendered into region (top-left origin) of the buffer, the rest of its content is left alone
+    virtual void set_buffer_region(
+        std::shared_ptr<software::WriteMappableBuffer> const& buffer,
+        geometry::Rectangle const& region) = 0;
+    /// Frames are rendered straight into a GPU buffer (such as a client's dmabuf), with no copy through the CPU
+    virtual void set_gpu_buffer(std::shared_ptr<graphics::Buffer> const& buffer) = 0;
 };
 
 }
@@ -75,11 +75,14 @@ public:
     MotionParameters();
     MotionParameters& from_device(int device_id);
     MotionParameters& with_movement(int rel_x, int rel_y);
+    MotionParameters& with_scroll(float h_scroll, float v_scroll);
     MotionParameters& with_event_time(std::chrono::nanoseconds time);
 
     int device_id;
     int rel_x;
     int rel_y;
+    float h_scroll;
+    float v_scroll;
     std::optional<std::chrono::nanoseconds> event_time;
 };
 MotionParameters a_pointer_event();
@@ -19,6 +19,8 @@
 #include "mir/posix_rw_mutex.h"
 
 #include <boost/throw_exception.hpp>
+#include <array>
+#include <atomic>
 #include <shared_mutex>
 
 #include <sys/epoll.h>
@@ -63,8 +65,30 @@ private:
     std::function<void()> const handler;
 };
 
+// Enough for everything a busy input thread has ready to be taken by a single epoll_wait()
+size_t const max_batch{16};
 }
 
+struct md::MultiplexingDispatchable::Watch : std::enable_shared_from_this<Watch>
+{
+    Watch(std::shared_ptr<Dispatchable> const& dispatchable, DispatchReentrancy reentrancy, DispatchTrigger trigger)
+        : dispatchable{dispatchable},
+          sequential{reentrancy == DispatchReentrancy::sequential},
+          edge_triggered{trigger == DispatchTrigger::edge}
+    {
+    }
+
+    std::shared_ptr<Dispatchable> const dispatchable;
+    bool const sequential;
+    bool const edge_triggered;
+
+    // Events for the watch may already have been taken from epoll when it is removed
+    std::atomic<bool> removed{false};
+    // Edges reported while a sequential, edge-triggered watch is being dispatched
+    std::atomic<int> edges_pending{0};
+    std::atomic<uint64_t> dispatches{0};
+};
+
 md::MultiplexingDispatchable::MultiplexingDispatchable()
     : lifetime_mutex{PosixRWMutex::Type::PreferWriterNonRecursive},
       epoll_fd{mir::Fd{::epoll_create1(EPOLL_CLOEXEC)}}
@@ -102,14 +126,14 @@ bool md::MultiplexingDispatchable::dispatch(md::FdEvents events)
         return false;
     }
 
-    std::shared_ptr<md::Dispatchable> source;
-    bool rearm_source{false};
-    epoll_event event;
+    std::array<epoll_event, max_batch> ready_events;
+    std::array<std::shared_ptr<Watch>, max_batch> ready_watches;
+    size_t ready_count;
 
     {
         std::shared_lock<decltype(lifetime_mutex)> lock{lifetime_mutex};
 
-        auto result = epoll_wait(epoll_fd, &event, 1, 0);
+        auto result = epoll_wait(epoll_fd, ready_events.data(), ready_events.size(), 0);
 
         if (result < 0)
         {
@@ -125,20 +149,56 @@ bool md::MultiplexingDispatchable::dispatch(md::FdEvents events)
             return true;
         }
 
-        auto event_source = reinterpret_cast<decltype(dispatchee_holder)::pointer>(event.data.ptr);
-
-        source = event_source->first;
-        rearm_source = event_source->second;
+        ready_count = result;
+        for (size_t i = 0; i != ready_count; ++i)
+        {
+            ready_watches[i] = static_cast<Watch*>(ready_events[i].data.ptr)->shared_from_this();
+        }
     }
 
-    if (!source->dispatch(epoll_to_fd_event(event)))
-    {
-        remove_watch(source);
-    }
-    else if (rearm_source)
+    for (size_t i = 0; i != ready_count; ++i)
     {
-        event.events = fd_event_to_epoll(source->relevant_events()) | EPOLLONESHOT;
-        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, source->watch_fd(), &event);
+        auto& watch = *ready_watches[i];
+
+        if (watch.removed)
+        {
+            // Removed by dispatching an earlier event of the batch, or by another thread
+            continue;
+        }
+
+        bool const gate_edges = watch.sequential && watch.edge_triggered;
+        if (gate_edges && watch.edges_pending.fetch_add(1) != 0)
+        {
+            // Another thread is dispatching the watch, and will go round again for this edge
+            continue;
+        }
+
+        bool keep_watching;
+        for (;;)
+        {
+            ++watch.dispatches;
+            keep_watching = watch.dispatchable->dispatch(epoll_to_fd_event(ready_events[i]));
+
+            if (!keep_watching || !gate_edges)
+                break;
+
+            int only_our_edge{1};
+            if (watch.edges_pending.compare_exchange_strong(only_our_edge, 0))
+                break;
+
+            // Any number of edges reported meanwhile are covered by one more dispatch
+            watch.edges_pending = 1;
+        }
+
+        if (!keep_watching)
+        {
+            remove_watch(watch.dispatchable);
+        }
+        else if (watch.sequential && !watch.edge_triggered)
+        {
+            ready_events[i].events = fd_event_to_epoll(watch.dispatchable->relevant_events()) | EPOLLONESHOT;
+            epoll_ctl(epoll_fd, EPOLL_CTL_MOD, watch.dispatchable->watch_fd(), &ready_events[i]);
+        }
     }
 
     return true;
@@ -156,24 +216,34 @@ void md::MultiplexingDispatchable::add_watch(std::shared_ptr<md::Dispatchable> c
 
 void md::MultiplexingDispatchable::add_watch(std::shared_ptr<md::Dispatchable> const& dispatchee,
                                              DispatchReentrancy reentrancy)
+{
+    add_watch(dispatchee, reentrancy, DispatchTrigger::level);
+}
+
+void md::MultiplexingDispatchable::add_watch(std::shared_ptr<md::Dispatchable> const& dispatchee,
+                                             DispatchReentrancy reentrancy,
+                                             DispatchTrigger trigger)
 {
     decltype(dispatchee_holder)::iterator new_holder;
     {
         std::unique_lock lock{lifetime_mutex};
         new_holder = dispatchee_holder.emplace(dispatchee_holder.begin(),
-                                               dispatchee,
-                                               reentrancy == DispatchReentrancy::sequential);
+                                               std::make_shared<Watch>(dispatchee, reentrancy, trigger));
     }
 
     epoll_event e;
     ::memset(&e, 0, sizeof(e));
 
     e.events = fd_event_to_epoll(dispatchee->relevant_events());
-    if (reentrancy == DispatchReentrancy::sequential)
+    if (trigger == DispatchTrigger::edge)
+    {
+        e.events |= EPOLLET;
+    }
+    else if (reentrancy == DispatchReentrancy::sequential)
     {
         e.events |= EPOLLONESHOT;
     }
-    e.data.ptr = static_cast<void*>(&(*new_holder));
+    e.data.ptr = static_cast<void*>(new_holder->get());
     if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, dispatchee->watch_fd(), &e) < 0)
     {
         std::unique_lock lock{lifetime_mutex};
@@ -217,8 +287,26 @@ void md::MultiplexingDispatchable::remove_watch(Fd const& fd)
     }
 
     std::unique_lock lock{lifetime_mutex};
-    dispatchee_holder.remove_if([&fd](std::pair<std::shared_ptr<Dispatchable>,bool> const& candidate)
+    dispatchee_holder.remove_if([&fd](std::shared_ptr<Watch> const& candidate)
     {
-        return candidate.first->watch_fd() == fd;
+        if (candidate->dispatchable->watch_fd() != fd)
+        {
+            return false;
+        }
+        candidate->removed = true;
+        return true;
     });
 }
+
+auto md::MultiplexingDispatchable::dispatch_count(Fd const& fd) const -> uint64_t
+{
+    std::shared_lock lock{lifetime_mutex};
+    for (auto const& watch : dispatchee_holder)
+    {
+        if (watch->dispatchable->watch_fd() == fd)
+        {
+            return watch->dispatches;
+        }
+    }
+    return 0;
+}
@@ -17,6 +17,7 @@
 #include "mir/events/event_builders.h"
 
 #include "mir/events/event_private.h"
+#include "mir/events/event_pool.h"
 #include "mir/events/window_placement_event.h"
 #include "mir/input/xkb_mapper.h"
 
@@ -386,6 +387,15 @@ mir::EventUPtr mev::clone_event(MirEvent const& event)
     return make_uptr_event(event.clone());
 }
 
+std::shared_ptr<MirEvent> mev::share_event(EventUPtr&& event)
+{
+    if (!event)
+        return {};
+
+    auto const deleter = event.get_deleter();
+    return {event.release(), deleter, PoolAllocator<MirEvent>{}};
+}
+
 void mev::transform_positions(MirEvent& event, mir::geometry::Displacement const& movement)
 {
     if (event.type() == mir_event_type_input)
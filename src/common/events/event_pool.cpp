@@ -0,0 +1,100 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/events/event_pool.h"
+#include "mir/events/keyboard_event.h"
+#include "mir/events/pointer_event.h"
+#include "mir/events/touch_event.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+namespace mev = mir::events;
+
+namespace
+{
+class BlockPool
+{
+public:
+    /// Big enough for any input event (and so for any control block sharing one)
+    static std::size_t constexpr block_size{
+        std::max({sizeof(MirKeyboardEvent), sizeof(MirPointerEvent), sizeof(MirTouchEvent)})};
+    /// Enough for a burst of events queued for slow clients, without holding on to memory indefinitely
+    static std::size_t constexpr max_free_blocks{1024};
+
+    auto allocate(std::size_t size) -> void*
+    {
+        if (size > block_size)
+            return ::operator new(size);
+
+        {
+            std::lock_guard lock{mutex};
+            if (auto const block = free_list)
+            {
+                free_list = block->next;
+                --free_count;
+                return block;
+            }
+        }
+
+        return ::operator new(block_size);
+    }
+
+    void deallocate(void* block, std::size_t size) noexcept
+    {
+        if (size <= block_size)
+        {
+            std::lock_guard lock{mutex};
+            if (free_count < max_free_blocks)
+            {
+                free_list = new (block) FreeBlock{free_list};
+                ++free_count;
+                return;
+            }
+        }
+
+        ::operator delete(block);
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    std::mutex mutex;
+    FreeBlock* free_list{nullptr};
+    std::size_t free_count{0};
+};
+
+auto the_pool() -> BlockPool&
+{
+    // Deliberately never destroyed: events can be released during static destruction
+    static auto* const pool = new BlockPool;
+    return *pool;
+}
+}
+
+auto mev::pool_allocate(std::size_t size) -> void*
+{
+    return the_pool().allocate(size);
+}
+
+void mev::pool_deallocate(void* block, std::size_t size) noexcept
+{
+    the_pool().deallocate(block, size);
+}
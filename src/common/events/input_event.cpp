@@ -19,6 +19,7 @@
 #include "mir/events/keyboard_event.h"
 #include "mir/events/pointer_event.h"
 #include "mir/events/touch_event.h"
+#include "mir/events/event_pool.h"
 
 MirInputEvent::MirInputEvent(MirInputEventType input_type,
                              MirInputDeviceId dev,
@@ -124,3 +125,13 @@ MirInputEvent::MirInputEvent(MirInputEventType input_type) :
     input_type_{input_type}
 {
 }
+
+void* MirInputEvent::operator new(std::size_t size)
+{
+    return mir::events::pool_allocate(size);
+}
+
+void MirInputEvent::operator delete(void* event, std::size_t size) noexcept
+{
+    mir::events::pool_deallocate(event, size);
+}
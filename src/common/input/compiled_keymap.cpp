@@ -0,0 +1,175 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/input/compiled_keymap.h"
+#include "mir/input/keymap.h"
+#include "mir/anonymous_shm_file.h"
+#include "mir/fatal.h"
+
+#include <boost/throw_exception.hpp>
+#include <xkbcommon/xkbcommon.h>
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <system_error>
+#include <vector>
+
+namespace mi = mir::input;
+
+namespace
+{
+/// libxkbcommon reference counts (of the context and keymaps) are not atomic, so everything that changes them goes
+/// through this
+std::mutex xkb_refcount_mutex;
+
+void unref_state(xkb_state* state)
+{
+    std::lock_guard lock{xkb_refcount_mutex};
+    xkb_state_unref(state);
+}
+
+auto shared_context() -> xkb_context*
+{
+    // Deliberately never released: compiled keymaps may outlive any static destruction order we could pick
+    static xkb_context* const context = []
+        {
+            auto const context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+            if (!context)
+            {
+                mir::fatal_error("Failed to create XKB context");
+            }
+            return context;
+        }();
+    return context;
+}
+
+/// Returns an invalid Fd if sealing is not supported
+auto sealed_memfd(char const* data, size_t size) -> mir::Fd
+{
+    mir::Fd fd{memfd_create("mir-keymap", MFD_CLOEXEC | MFD_ALLOW_SEALING)};
+    if (fd < 0)
+    {
+        return {};
+    }
+
+    for (size_t written = 0; written < size;)
+    {
+        auto const result = write(fd, data + written, size - written);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to write keymap"}));
+        }
+        written += result;
+    }
+
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+    {
+        return {};
+    }
+    return fd;
+}
+
+struct CacheEntry
+{
+    std::shared_ptr<mi::Keymap> keymap;
+    std::weak_ptr<mi::CompiledKeymap const> compiled;
+};
+
+std::mutex cache_mutex;
+std::vector<CacheEntry> cache;
+}
+
+mi::CompiledKeymap::CompiledKeymap(::xkb_keymap* keymap)
+    : keymap{keymap}
+{
+}
+
+mi::CompiledKeymap::~CompiledKeymap()
+{
+    std::lock_guard lock{xkb_refcount_mutex};
+    xkb_keymap_unref(keymap);
+}
+
+auto mi::CompiledKeymap::make_state() const -> StatePtr
+{
+    std::lock_guard lock{xkb_refcount_mutex};
+    return {xkb_state_new(keymap), &unref_state};
+}
+
+void mi::CompiledKeymap::serialise() const
+{
+    std::unique_ptr<char, void(*)(void*)> const buffer{
+        xkb_keymap_get_as_string(keymap, XKB_KEYMAP_FORMAT_TEXT_V1),
+        free};
+    // so the null terminator is included
+    size = strlen(buffer.get()) + 1;
+
+    fd = sealed_memfd(buffer.get(), size);
+    if (fd < 0)
+    {
+        text.assign(buffer.get(), size);
+    }
+}
+
+auto mi::CompiledKeymap::text_fd() const -> Fd
+{
+    std::call_once(serialised, [this] { serialise(); });
+
+    if (fd >= 0)
+    {
+        return fd;
+    }
+
+    AnonymousShmFile copy{size};
+    memcpy(copy.base_ptr(), text.data(), size);
+    return Fd{dup(copy.fd())};
+}
+
+auto mi::CompiledKeymap::text_size() const -> size_t
+{
+    std::call_once(serialised, [this] { serialise(); });
+    return size;
+}
+
+auto mi::compiled_keymap_for(std::shared_ptr<Keymap> const& keymap) -> std::shared_ptr<CompiledKeymap const>
+{
+    std::lock_guard lock{cache_mutex};
+
+    std::erase_if(cache, [](CacheEntry const& entry) { return entry.compiled.expired(); });
+
+    for (auto const& entry : cache)
+    {
+        if (entry.keymap->matches(*keymap))
+        {
+            if (auto const compiled = entry.compiled.lock())
+                return compiled;
+        }
+    }
+
+    ::xkb_keymap* raw_keymap;
+    {
+        std::lock_guard refcount_lock{xkb_refcount_mutex};
+        raw_keymap = keymap->make_unique_xkb_keymap(shared_context()).release();
+    }
+    auto const compiled = std::make_shared<CompiledKeymap const>(raw_keymap);
+    cache.push_back({keymap, compiled});
+    return compiled;
+}
@@ -0,0 +1,395 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/input/input_recording.h"
+#include "mir/events/event.h"
+#include "mir/events/input_event.h"
+#include "mir/events/keyboard_event.h"
+#include "mir/events/pointer_event.h"
+#include "mir/events/touch_event.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace mi = mir::input;
+
+namespace
+{
+char const magic[8] = {'M', 'I', 'R', 'I', 'N', 'R', 'E', 'C'};
+uint32_t const version{1};
+
+/// Records are written out once this much has been buffered...
+size_t const flush_size{64 * 1024};
+/// ...or by the flusher thread this long after the last write, whichever comes first
+std::chrono::nanoseconds const flush_interval{std::chrono::seconds{1}};
+
+template<typename T>
+void put(std::string& out, T value)
+{
+    out.append(reinterpret_cast<char const*>(&value), sizeof value);
+}
+
+void put(std::string& out, std::string const& value)
+{
+    put<uint16_t>(out, value.size());
+    out.append(value.data(), value.size());
+}
+
+class Reader
+{
+public:
+    Reader(std::string const& path)
+        : path{path},
+          in{path, std::ios::binary}
+    {
+        if (!in)
+            BOOST_THROW_EXCEPTION(std::runtime_error{"Failed to open input recording " + path});
+    }
+
+    template<typename T>
+    auto get() -> T
+    {
+        T value;
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof value))
+            truncated();
+        return value;
+    }
+
+    auto get_string() -> std::string
+    {
+        std::string value(get<uint16_t>(), '\0');
+        if (!in.read(value.data(), value.size()))
+            truncated();
+        return value;
+    }
+
+    auto at_end() -> bool
+    {
+        return in.peek() == std::char_traits<char>::eof();
+    }
+
+    [[noreturn]] void malformed(std::string const& what)
+    {
+        BOOST_THROW_EXCEPTION(std::runtime_error{"Malformed input recording " + path + ": " + what});
+    }
+
+private:
+    [[noreturn]] void truncated()
+    {
+        malformed("truncated");
+    }
+
+    std::string const path;
+    std::ifstream in;
+};
+
+auto now() -> std::chrono::nanoseconds
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+}
+}
+
+mi::InputRecordingWriter::InputRecordingWriter(std::string const& path)
+    : file{::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600)},
+      last_flush{now()}
+{
+    if (file == Fd::invalid)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{
+            errno,
+            std::system_category(),
+            "Failed to create input recording " + path}));
+    }
+
+    buffer.reserve(flush_size);
+    buffer.append(magic, sizeof magic);
+    put(buffer, version);
+    {
+        std::unique_lock lock{mutex};
+        flush(lock);
+    }
+
+    // Writes out what is buffered at least once a flush_interval, whether or not more input arrives
+    flusher = std::thread{[this]
+        {
+            std::unique_lock lock{mutex};
+            while (!stopping)
+            {
+                // With nothing buffered there is nothing due, so just look again in a flush_interval
+                auto const due = buffer.empty() ?
+                    std::chrono::steady_clock::now() + flush_interval :
+                    std::chrono::steady_clock::time_point{last_flush + flush_interval};
+                if (stopped.wait_until(lock, due, [this] { return stopping; }))
+                    break;
+
+                if (!buffer.empty() && now() - last_flush >= flush_interval)
+                {
+                    flush(lock);
+                    lock.lock();
+                }
+            }
+        }};
+}
+
+mi::InputRecordingWriter::~InputRecordingWriter()
+{
+    {
+        std::lock_guard lock{mutex};
+        stopping = true;
+    }
+    stopped.notify_all();
+    flusher.join();
+
+    std::unique_lock lock{mutex};
+    flush(lock);
+}
+
+void mi::InputRecordingWriter::device_added(
+    MirInputDeviceId id,
+    std::string const& name,
+    std::string const& unique_id,
+    uint32_t capabilities)
+{
+    RecordedInput record{RecordedInput::Kind::device_added, id, now()};
+    record.name = name;
+    record.unique_id = unique_id;
+    record.capabilities = capabilities;
+    write(record);
+}
+
+void mi::InputRecordingWriter::device_removed(MirInputDeviceId id)
+{
+    write(RecordedInput{RecordedInput::Kind::device_removed, id, now()});
+}
+
+void mi::InputRecordingWriter::record(MirEvent const& event)
+{
+    if (event.type() != mir_event_type_input)
+        return;
+
+    auto const& input = *event.to_input();
+    RecordedInput record{RecordedInput::Kind::key, input.device_id(), input.event_time()};
+
+    switch (input.input_type())
+    {
+    case mir_input_event_type_key:
+    {
+        auto const& key = *input.to_keyboard();
+        record.key_action = key.action();
+        record.scan_code = key.scan_code();
+        break;
+    }
+    case mir_input_event_type_pointer:
+    {
+        auto const& pointer = *input.to_pointer();
+        record.kind = RecordedInput::Kind::pointer;
+        record.pointer_action = pointer.action();
+        record.buttons = pointer.buttons();
+        record.dx = pointer.motion().dx.as_value();
+        record.dy = pointer.motion().dy.as_value();
+        record.h_scroll = pointer.h_scroll().precise.as_value();
+        record.v_scroll = pointer.v_scroll().precise.as_value();
+        break;
+    }
+    case mir_input_event_type_touch:
+    {
+        auto const& touch = *input.to_touch();
+        record.kind = RecordedInput::Kind::touch;
+        for (size_t i = 0; i != touch.pointer_count(); ++i)
+        {
+            auto const position = touch.position(i);
+            record.contacts.push_back({
+                touch.id(i),
+                touch.action(i),
+                touch.tool_type(i),
+                position.x.as_value(),
+                position.y.as_value(),
+                touch.pressure(i),
+                touch.touch_major(i),
+                touch.touch_minor(i),
+                touch.orientation(i)});
+        }
+        break;
+    }
+    default:
+        return;
+    }
+
+    write(record);
+}
+
+void mi::InputRecordingWriter::write(RecordedInput const& record)
+{
+    std::unique_lock lock{mutex};
+
+    put(buffer, record.kind);
+    put<int64_t>(buffer, record.device_id);
+    put<int64_t>(buffer, record.time.count());
+
+    switch (record.kind)
+    {
+    case RecordedInput::Kind::device_added:
+        put(buffer, record.capabilities);
+        put(buffer, record.name);
+        put(buffer, record.unique_id);
+        break;
+
+    case RecordedInput::Kind::device_removed:
+        break;
+
+    case RecordedInput::Kind::key:
+        put<uint8_t>(buffer, record.key_action);
+        put(buffer, record.scan_code);
+        break;
+
+    case RecordedInput::Kind::pointer:
+        put<uint8_t>(buffer, record.pointer_action);
+        put<uint32_t>(buffer, record.buttons);
+        put(buffer, record.dx);
+        put(buffer, record.dy);
+        put(buffer, record.h_scroll);
+        put(buffer, record.v_scroll);
+        break;
+
+    case RecordedInput::Kind::touch:
+        put<uint8_t>(buffer, record.contacts.size());
+        for (auto const& contact : record.contacts)
+        {
+            put<int32_t>(buffer, contact.id);
+            put<uint8_t>(buffer, contact.action);
+            put<uint8_t>(buffer, contact.tool_type);
+            put(buffer, contact.x);
+            put(buffer, contact.y);
+            put(buffer, contact.pressure);
+            put(buffer, contact.touch_major);
+            put(buffer, contact.touch_minor);
+            put(buffer, contact.orientation);
+        }
+        break;
+    }
+
+    // Batched to keep a syscall per event off the input thread, while losing at most a second or so of input if
+    // the server is killed (the flusher thread writes out anything left for longer)
+    if (buffer.size() >= flush_size)
+        flush(lock);
+}
+
+void mi::InputRecordingWriter::flush(std::unique_lock<std::mutex>& lock)
+{
+    std::string batch;
+    batch.reserve(flush_size);
+    batch.swap(buffer);
+    last_flush = now();
+
+    // Taken before releasing mutex, so that a batch buffered meanwhile can't be written out ahead of this one
+    std::lock_guard writing{file_mutex};
+    lock.unlock();
+
+    char const* data = batch.data();
+    size_t remaining = batch.size();
+    while (remaining)
+    {
+        auto const written = ::write(file, data, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            // Don't take the input thread down with a full disk; the rest of this batch is lost
+            break;
+        }
+        data += written;
+        remaining -= written;
+    }
+}
+
+auto mi::read_input_recording(std::string const& path) -> std::vector<RecordedInput>
+{
+    Reader reader{path};
+
+    char file_magic[sizeof magic];
+    for (auto& c : file_magic)
+        c = reader.get<char>();
+    if (memcmp(file_magic, magic, sizeof magic) != 0)
+        reader.malformed("not an input recording");
+    if (reader.get<uint32_t>() != version)
+        reader.malformed("unsupported version");
+
+    std::vector<RecordedInput> records;
+    while (!reader.at_end())
+    {
+        RecordedInput record{
+            static_cast<RecordedInput::Kind>(reader.get<uint8_t>()),
+            reader.get<int64_t>(),
+            std::chrono::nanoseconds{reader.get<int64_t>()}};
+
+        switch (record.kind)
+        {
+        case RecordedInput::Kind::device_added:
+            record.capabilities = reader.get<uint32_t>();
+            record.name = reader.get_string();
+            record.unique_id = reader.get_string();
+            break;
+
+        case RecordedInput::Kind::device_removed:
+            break;
+
+        case RecordedInput::Kind::key:
+            record.key_action = static_cast<MirKeyboardAction>(reader.get<uint8_t>());
+            record.scan_code = reader.get<int32_t>();
+            break;
+
+        case RecordedInput::Kind::pointer:
+            record.pointer_action = static_cast<MirPointerAction>(reader.get<uint8_t>());
+            record.buttons = reader.get<uint32_t>();
+            record.dx = reader.get<float>();
+            record.dy = reader.get<float>();
+            record.h_scroll = reader.get<float>();
+            record.v_scroll = reader.get<float>();
+            break;
+
+        case RecordedInput::Kind::touch:
+            record.contacts.resize(reader.get<uint8_t>());
+            for (auto& contact : record.contacts)
+            {
+                contact.id = reader.get<int32_t>();
+                contact.action = static_cast<MirTouchAction>(reader.get<uint8_t>());
+                contact.tool_type = static_cast<MirTouchTooltype>(reader.get<uint8_t>());
+                contact.x = reader.get<float>();
+                contact.y = reader.get<float>();
+                contact.pressure = reader.get<float>();
+                contact.touch_major = reader.get<float>();
+                contact.touch_minor = reader.get<float>();
+                contact.orientation = reader.get<float>();
+            }
+            break;
+
+        default:
+            reader.malformed("unknown record kind");
+        }
+
+        records.push_back(std::move(record));
+    }
+
+    return records;
+}
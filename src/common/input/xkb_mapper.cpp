@@ -108,10 +108,6 @@ mi::XKBComposeTablePtr make_unique_compose_table_from_locale(mi::XKBContextPtr c
            &xkb_compose_table_unref};
 }
 
-mi::XKBStatePtr make_unique_state(xkb_keymap* keymap)
-{
-    return {xkb_state_new(keymap), xkb_state_unref};
-}
 }
 
 mi::XKBContextPtr mi::make_unique_context()
@@ -231,7 +227,7 @@ void mircv::XKBMapper::set_keymap(std::shared_ptr<Keymap> new_keymap)
 {
     std::lock_guard lg(guard);
     default_keymap = std::move(new_keymap);
-    default_compiled_keymap = default_keymap->make_unique_xkb_keymap(context.get());
+    default_compiled_keymap = compiled_keymap_for(default_keymap);
     device_mapping.clear();
 }
 
@@ -244,7 +240,7 @@ void mircv::XKBMapper::set_keymap(MirInputDeviceId id, std::shared_ptr<Keymap> n
 {
     std::lock_guard lg(guard);
 
-    auto compiled_keymap = new_keymap->make_unique_xkb_keymap(context.get());
+    auto compiled_keymap = compiled_keymap_for(new_keymap);
     auto mapping_state = std::make_unique<XkbMappingState>(std::move(new_keymap), std::move(compiled_keymap));
 
     device_mapping.erase(id);
@@ -295,10 +291,10 @@ auto mircv::XKBMapper::xkb_modifiers() const -> MirXkbModifiers
 
 mircv::XKBMapper::XkbMappingState::XkbMappingState(
     std::shared_ptr<Keymap> keymap,
-    std::shared_ptr<xkb_keymap> compiled_keymap)
+    std::shared_ptr<CompiledKeymap const> compiled_keymap)
     : keymap{std::move(keymap)},
       compiled_keymap{std::move(compiled_keymap)},
-      state{make_unique_state(this->compiled_keymap.get())}
+      state{this->compiled_keymap->make_state()}
 {
 }
 
@@ -0,0 +1,215 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define MIR_LOG_COMPONENT "thread-scheduling"
+
+#include "mir/thread_scheduling.h"
+#include "mir/log.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+auto parse_cpu(std::string const& text, std::string const& list) -> int
+{
+    size_t parsed{0};
+    int cpu{-1};
+    try
+    {
+        cpu = std::stoi(text, &parsed);
+    }
+    catch (std::exception const&)
+    {
+    }
+
+    if (parsed == 0 || parsed != text.size() || cpu < 0 || cpu >= CPU_SETSIZE)
+    {
+        BOOST_THROW_EXCEPTION(std::invalid_argument{"Invalid CPU list \"" + list + "\""});
+    }
+    return cpu;
+}
+
+auto policy_name(mir::ThreadScheduling::Policy policy) -> char const*
+{
+    switch (policy)
+    {
+    case mir::ThreadScheduling::Policy::fifo:
+        return "SCHED_FIFO";
+    case mir::ThreadScheduling::Policy::round_robin:
+        return "SCHED_RR";
+    }
+    return "unknown";
+}
+}
+
+auto mir::parse_scheduling_policy(std::string const& name) -> ThreadScheduling::Policy
+{
+    if (name == "fifo")
+        return ThreadScheduling::Policy::fifo;
+    if (name == "rr")
+        return ThreadScheduling::Policy::round_robin;
+
+    BOOST_THROW_EXCEPTION(std::invalid_argument{"Invalid scheduling policy \"" + name + "\" (expected fifo or rr)"});
+}
+
+auto mir::parse_cpu_list(std::string const& list) -> std::vector<int>
+{
+    std::vector<int> cpus;
+    if (list.empty())
+        return cpus;
+
+    size_t start{0};
+    while (start <= list.size())
+    {
+        auto end = list.find(',', start);
+        if (end == std::string::npos)
+            end = list.size();
+
+        auto const item = list.substr(start, end - start);
+        auto const dash = item.find('-');
+        if (dash == std::string::npos)
+        {
+            cpus.push_back(parse_cpu(item, list));
+        }
+        else
+        {
+            auto const first = parse_cpu(item.substr(0, dash), list);
+            auto const last = parse_cpu(item.substr(dash + 1), list);
+            if (last < first)
+            {
+                BOOST_THROW_EXCEPTION(std::invalid_argument{"Invalid CPU list \"" + list + "\""});
+            }
+            for (auto cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+
+        start = end + 1;
+    }
+
+    return cpus;
+}
+
+void mir::apply_thread_scheduling(ThreadScheduling const& scheduling, std::string const& thread_description)
+{
+    if (!scheduling.cpus.empty())
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (auto const cpu : scheduling.cpus)
+            CPU_SET(cpu, &cpu_set);
+
+        if (auto const error = pthread_setaffinity_np(pthread_self(), sizeof cpu_set, &cpu_set))
+        {
+            log_warning(
+                "Failed to set the CPU affinity of the %s thread: %s",
+                thread_description.c_str(),
+                strerror(error));
+        }
+    }
+
+    if (scheduling.priority > 0)
+    {
+        sched_param param{};
+        param.sched_priority = scheduling.priority;
+        auto const policy = scheduling.policy == ThreadScheduling::Policy::fifo ? SCHED_FIFO : SCHED_RR;
+
+        if (auto const error = pthread_setschedparam(pthread_self(), policy, &param))
+        {
+            log_warning(
+                "Failed to give the %s thread %s priority %d: %s",
+                thread_description.c_str(),
+                policy_name(scheduling.policy),
+                scheduling.priority,
+                strerror(error));
+        }
+        else
+        {
+            log_info(
+                "Running the %s thread with %s priority %d",
+                thread_description.c_str(),
+                policy_name(scheduling.policy),
+                scheduling.priority);
+        }
+    }
+}
+
+struct mir::ScopedThreadScheduling::Saved
+{
+    std::optional<cpu_set_t> cpus;
+    std::optional<std::pair<int, sched_param>> policy;
+};
+
+mir::ScopedThreadScheduling::ScopedThreadScheduling(
+    ThreadScheduling const& scheduling,
+    std::string const& thread_description)
+    : saved{std::make_unique<Saved>()}
+{
+    // Only what is about to change is saved, and so restored
+    cpu_set_t cpus;
+    if (!scheduling.cpus.empty() && pthread_getaffinity_np(pthread_self(), sizeof cpus, &cpus) == 0)
+    {
+        saved->cpus = cpus;
+    }
+
+    int policy;
+    sched_param param;
+    if (scheduling.priority > 0 && pthread_getschedparam(pthread_self(), &policy, &param) == 0)
+    {
+        saved->policy = std::make_pair(policy, param);
+    }
+
+    apply_thread_scheduling(scheduling, thread_description);
+}
+
+mir::ScopedThreadScheduling::~ScopedThreadScheduling()
+{
+    if (saved->policy)
+    {
+        pthread_setschedparam(pthread_self(), saved->policy->first, &saved->policy->second);
+    }
+
+    if (saved->cpus)
+    {
+        pthread_setaffinity_np(pthread_self(), sizeof *saved->cpus, &*saved->cpus);
+    }
+}
+
+void mir::lock_process_memory()
+{
+    // Locking future mappings under a finite RLIMIT_MEMLOCK would make allocations fail once the limit is reached
+    rlimit limit{};
+    bool const unlimited = getrlimit(RLIMIT_MEMLOCK, &limit) == 0 && limit.rlim_cur == RLIM_INFINITY;
+    if (!unlimited)
+    {
+        log_warning("RLIMIT_MEMLOCK is limited: only memory already mapped will be locked");
+    }
+
+    if (mlockall(unlimited ? MCL_CURRENT | MCL_FUTURE : MCL_CURRENT) != 0)
+    {
+        log_warning("Failed to lock process memory: %s", strerror(errno));
+    }
+}
@@ -0,0 +1,375 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/geometry/region.h"
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+
+namespace geom = mir::geometry;
+
+namespace
+{
+using RectIterator = std::vector<geom::Rectangle>::const_iterator;
+
+auto left_of(geom::Rectangle const& rect) -> int { return rect.left().as_int(); }
+auto right_of(geom::Rectangle const& rect) -> int { return rect.right().as_int(); }
+auto top_of(geom::Rectangle const& rect) -> int { return rect.top().as_int(); }
+auto bottom_of(geom::Rectangle const& rect) -> int { return rect.bottom().as_int(); }
+
+/// A horizontal run of a band, [left, right)
+struct Span
+{
+    int left;
+    int right;
+};
+
+/// Walks the bands of a region from top to bottom
+class BandCursor
+{
+public:
+    explicit BandCursor(std::vector<geom::Rectangle> const& rects)
+        : band{rects.begin()},
+          end{rects.end()},
+          band_end{end_of_band(band)}
+    {
+    }
+
+    auto done() const -> bool { return band == end; }
+    auto top() const -> int { return top_of(*band); }
+    auto bottom() const -> int { return bottom_of(*band); }
+    auto first() const -> RectIterator { return band; }
+    auto last() const -> RectIterator { return band_end; }
+
+    void next()
+    {
+        band = band_end;
+        band_end = end_of_band(band);
+    }
+
+private:
+    auto end_of_band(RectIterator start) const -> RectIterator
+    {
+        if (start == end)
+            return end;
+
+        auto const top = top_of(*start);
+        return std::find_if(start, end, [top](auto const& rect) { return top_of(rect) != top; });
+    }
+
+    RectIterator band;
+    RectIterator const end;
+    RectIterator band_end;
+};
+
+/// Sweeps the edges of two bands left to right, keeping the parts where op(in_a, in_b) holds
+template<typename Op>
+void combine_spans(
+    RectIterator a, RectIterator a_end,
+    RectIterator b, RectIterator b_end,
+    Op op,
+    std::vector<Span>& spans)
+{
+    // Edge 2n is the left of rectangle n and edge 2n+1 its right, so after passing an odd number of edges we are inside
+    auto const edge = [](RectIterator first, long index)
+        {
+            auto const& rect = first[index / 2];
+            return index % 2 ? right_of(rect) : left_of(rect);
+        };
+    auto const a_edges = 2 * (a_end - a);
+    auto const b_edges = 2 * (b_end - b);
+    long a_index{0};
+    long b_index{0};
+
+    bool inside{false};
+    int span_left{0};
+    while (a_index < a_edges || b_index < b_edges)
+    {
+        auto const x = std::min(
+            a_index < a_edges ? edge(a, a_index) : std::numeric_limits<int>::max(),
+            b_index < b_edges ? edge(b, b_index) : std::numeric_limits<int>::max());
+
+        if (a_index < a_edges && edge(a, a_index) == x)
+            ++a_index;
+        if (b_index < b_edges && edge(b, b_index) == x)
+            ++b_index;
+
+        bool const now_inside = op(a_index % 2 == 1, b_index % 2 == 1);
+        if (now_inside && !inside)
+        {
+            span_left = x;
+        }
+        else if (!now_inside && inside)
+        {
+            spans.push_back({span_left, x});
+        }
+        inside = now_inside;
+    }
+}
+
+/// Appends a band, merging it into the previous band when they touch and cover the same columns
+void append_band(
+    std::vector<geom::Rectangle>& rects,
+    size_t& last_band,
+    int top,
+    int bottom,
+    std::vector<Span> const& spans)
+{
+    if (spans.empty())
+        return;
+
+    auto const same_columns = [](Span const& span, geom::Rectangle const& rect)
+        {
+            return span.left == left_of(rect) && span.right == right_of(rect);
+        };
+
+    if (last_band < rects.size() &&
+        bottom_of(rects[last_band]) == top &&
+        rects.size() - last_band == spans.size() &&
+        std::equal(spans.begin(), spans.end(), rects.begin() + last_band, same_columns))
+    {
+        for (auto rect = rects.begin() + last_band; rect != rects.end(); ++rect)
+        {
+            rect->size.height = geom::Height{bottom - top_of(*rect)};
+        }
+        return;
+    }
+
+    last_band = rects.size();
+    for (auto const& span : spans)
+    {
+        rects.push_back({{span.left, top}, {span.right - span.left, bottom - top}});
+    }
+}
+
+/// Combines two banded regions, keeping the parts where op(in_a, in_b) holds
+template<typename Op>
+auto combine(std::vector<geom::Rectangle> const& a, std::vector<geom::Rectangle> const& b, Op op)
+    -> std::vector<geom::Rectangle>
+{
+    std::vector<geom::Rectangle> result;
+    result.reserve(a.size() + b.size());
+    std::vector<Span> spans;
+    size_t last_band{0};
+
+    BandCursor a_band{a};
+    BandCursor b_band{b};
+    auto y = std::numeric_limits<int>::min();
+    while (!a_band.done() || !b_band.done())
+    {
+        if (!a_band.done() && a_band.bottom() <= y)
+        {
+            a_band.next();
+            continue;
+        }
+        if (!b_band.done() && b_band.bottom() <= y)
+        {
+            b_band.next();
+            continue;
+        }
+
+        bool const in_a = !a_band.done() && a_band.top() <= y;
+        bool const in_b = !b_band.done() && b_band.top() <= y;
+
+        // Both bands are unchanged from y until the next time either of them starts or stops
+        auto next_y = std::numeric_limits<int>::max();
+        if (!a_band.done())
+            next_y = std::min(next_y, in_a ? a_band.bottom() : a_band.top());
+        if (!b_band.done())
+            next_y = std::min(next_y, in_b ? b_band.bottom() : b_band.top());
+
+        if (in_a || in_b)
+        {
+            spans.clear();
+            combine_spans(
+                a_band.first(), in_a ? a_band.last() : a_band.first(),
+                b_band.first(), in_b ? b_band.last() : b_band.first(),
+                op,
+                spans);
+            append_band(result, last_band, y, next_y, spans);
+        }
+
+        y = next_y;
+    }
+
+    return result;
+}
+
+auto is_empty(geom::Rectangle const& rect) -> bool
+{
+    return rect.size.width <= geom::Width{0} || rect.size.height <= geom::Height{0};
+}
+}
+
+geom::Region::Region()
+{
+}
+
+geom::Region::Region(Rectangle const& rect)
+{
+    if (!is_empty(rect))
+        rectangles.push_back(rect);
+}
+
+geom::Region::Region(std::initializer_list<Rectangle> const& rects)
+    : Region(std::vector<Rectangle>{rects})
+{
+}
+
+geom::Region::Region(std::vector<Rectangle> const& rects)
+{
+    // Merging in pairs keeps building from n rectangles at O(n log n) rather than O(n²)
+    std::vector<Region> parts(rects.begin(), rects.end());
+    while (parts.size() > 1)
+    {
+        std::vector<Region> merged;
+        merged.reserve((parts.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < parts.size(); i += 2)
+        {
+            merged.push_back(std::move(parts[i]));
+            merged.back().add(parts[i + 1]);
+        }
+        if (parts.size() % 2)
+        {
+            merged.push_back(std::move(parts.back()));
+        }
+        parts = std::move(merged);
+    }
+
+    if (!parts.empty())
+        rectangles = std::move(parts.front().rectangles);
+}
+
+void geom::Region::add(Region const& other)
+{
+    if (other.rectangles.empty())
+        return;
+
+    rectangles = combine(rectangles, other.rectangles, [](bool in_a, bool in_b) { return in_a || in_b; });
+}
+
+void geom::Region::subtract(Region const& other)
+{
+    if (rectangles.empty() || other.rectangles.empty())
+        return;
+
+    rectangles = combine(rectangles, other.rectangles, [](bool in_a, bool in_b) { return in_a && !in_b; });
+}
+
+void geom::Region::intersect(Region const& other)
+{
+    rectangles = combine(rectangles, other.rectangles, [](bool in_a, bool in_b) { return in_a && in_b; });
+}
+
+void geom::Region::translate(Displacement const& displacement)
+{
+    for (auto& rect : rectangles)
+        rect.top_left += displacement;
+}
+
+void geom::Region::clear()
+{
+    rectangles.clear();
+}
+
+bool geom::Region::empty() const
+{
+    return rectangles.empty();
+}
+
+bool geom::Region::contains(Point const& point) const
+{
+    auto const x = point.x.as_int();
+    auto const y = point.y.as_int();
+
+    // Both the tops and bottoms of the rectangles increase monotonically, so the band can be found by bisection
+    auto const band = std::partition_point(
+        rectangles.begin(), rectangles.end(),
+        [y](auto const& rect) { return bottom_of(rect) <= y; });
+    if (band == rectangles.end() || top_of(*band) > y)
+        return false;
+
+    auto const band_end = std::partition_point(
+        band, rectangles.end(),
+        [top = top_of(*band)](auto const& rect) { return top_of(rect) == top; });
+    auto const span = std::partition_point(
+        band, band_end,
+        [x](auto const& rect) { return right_of(rect) <= x; });
+
+    return span != band_end && left_of(*span) <= x;
+}
+
+bool geom::Region::contains(Rectangle const& rect) const
+{
+    Region uncovered{rect};
+    uncovered.subtract(*this);
+    return uncovered.empty();
+}
+
+geom::Rectangle geom::Region::bounding_rectangle() const
+{
+    if (rectangles.empty())
+        return Rectangle{};
+
+    auto left = left_of(rectangles.front());
+    auto right = right_of(rectangles.front());
+    for (auto const& rect : rectangles)
+    {
+        left = std::min(left, left_of(rect));
+        right = std::max(right, right_of(rect));
+    }
+
+    auto const top = top_of(rectangles.front());
+    auto const bottom = bottom_of(rectangles.back());
+    return {{left, top}, {right - left, bottom - top}};
+}
+
+geom::Region::const_iterator geom::Region::begin() const
+{
+    return rectangles.begin();
+}
+
+geom::Region::const_iterator geom::Region::end() const
+{
+    return rectangles.end();
+}
+
+geom::Region::size_type geom::Region::size() const
+{
+    return rectangles.size();
+}
+
+bool geom::Region::operator==(Region const& other) const
+{
+    // The banded representation is canonical, so equal areas have equal rectangles
+    return rectangles == other.rectangles;
+}
+
+bool geom::Region::operator!=(Region const& other) const
+{
+    return !(*this == other);
+}
+
+std::ostream& geom::operator<<(std::ostream& out, Region const& value)
+{
+    out << '[';
+    for (auto const& rect : value)
+        out << rect << ", ";
+    out << ']';
+
+    return out;
+}
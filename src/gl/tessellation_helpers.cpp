@@ -17,9 +17,37 @@
 #include "mir/graphics/renderable.h"
 #include "mir/graphics/buffer.h"
 
+#include <algorithm>
+
 namespace mg = mir::graphics;
 namespace mgl = mir::gl;
 namespace geom = mir::geometry;
+
+namespace
+{
+struct TexBounds
+{
+    GLfloat left, top, right, bottom;
+};
+
+/// The texture coordinates of the renderable's src_bounds()
+auto tex_bounds_of(mg::Renderable const& renderable) -> TexBounds
+{
+    auto const buffer_size = renderable.buffer()->size();
+    if (buffer_size.width == geom::Width{} || buffer_size.height == geom::Height{})
+        return {0.0f, 0.0f, 1.0f, 1.0f};
+
+    auto const src = renderable.src_bounds();
+    double const width = buffer_size.width.as_int();
+    double const height = buffer_size.height.as_int();
+    return {
+        static_cast<GLfloat>(src.left().as_value() / width),
+        static_cast<GLfloat>(src.top().as_value() / height),
+        static_cast<GLfloat>(src.right().as_value() / width),
+        static_cast<GLfloat>(src.bottom().as_value() / height)};
+}
+}
+
 mgl::Primitive mgl::tessellate_renderable_into_rectangle(
     mg::Renderable const& renderable, geom::Displacement const& offset)
 {
@@ -33,13 +61,99 @@ mgl::Primitive mgl::tessellate_renderable_into_rectangle(
     mgl::Primitive rectangle;
     rectangle.type = GL_TRIANGLE_STRIP;
 
-    GLfloat const tex_right = 1.0f;
-    GLfloat const tex_bottom = 1.0f;
+    auto const tex = tex_bounds_of(renderable);
 
     auto& vertices = rectangle.vertices;
-    vertices[0] = {{left,  top,    0.0f}, {0.0f,      0.0f}};
-    vertices[1] = {{left,  bottom, 0.0f}, {0.0f,      tex_bottom}};
-    vertices[2] = {{right, top,    0.0f}, {tex_right, 0.0f}};
-    vertices[3] = {{right, bottom, 0.0f}, {tex_right, tex_bottom}};
+    vertices[0] = {{left,  top,    0.0f}, {tex.left,  tex.top}};
+    vertices[1] = {{left,  bottom, 0.0f}, {tex.left,  tex.bottom}};
+    vertices[2] = {{right, top,    0.0f}, {tex.right, tex.top}};
+    vertices[3] = {{right, bottom, 0.0f}, {tex.right, tex.bottom}};
     return rectangle;
 }
+
+void mgl::tessellate_renderable_by_opacity(
+    std::vector<mgl::Primitive>& primitives,
+    mg::Renderable const& renderable,
+    geom::Displacement const& offset,
+    std::vector<geom::Rectangle> const& opaque_region)
+{
+    auto const rect = renderable.screen_position();
+    if (opaque_region.empty() || rect.size.width == geom::Width{} || rect.size.height == geom::Height{})
+    {
+        primitives.push_back(tessellate_renderable_into_rectangle(renderable, offset));
+        return;
+    }
+
+    auto const left = rect.left().as_int();
+    auto const right = rect.right().as_int();
+    auto const top = rect.top().as_int();
+    auto const bottom = rect.bottom().as_int();
+
+    std::vector<int> xs{left, right};
+    std::vector<int> ys{top, bottom};
+    for (auto const& opaque : opaque_region)
+    {
+        xs.push_back(std::clamp(opaque.left().as_int(), left, right));
+        xs.push_back(std::clamp(opaque.right().as_int(), left, right));
+        ys.push_back(std::clamp(opaque.top().as_int(), top, bottom));
+        ys.push_back(std::clamp(opaque.bottom().as_int(), top, bottom));
+    }
+    for (auto* edges : {&xs, &ys})
+    {
+        std::sort(edges->begin(), edges->end());
+        edges->erase(std::unique(edges->begin(), edges->end()), edges->end());
+    }
+
+    auto const cell_is_opaque = [&](int x0, int y0, int x1, int y1)
+        {
+            return std::any_of(opaque_region.begin(), opaque_region.end(), [&](geom::Rectangle const& opaque)
+                {
+                    return opaque.left().as_int() <= x0 && x1 <= opaque.right().as_int() &&
+                           opaque.top().as_int() <= y0 && y1 <= opaque.bottom().as_int();
+                });
+        };
+
+    auto const tex = tex_bounds_of(renderable);
+    GLfloat const tex_per_x = (tex.right - tex.left) / (right - left);
+    GLfloat const tex_per_y = (tex.bottom - tex.top) / (bottom - top);
+    auto const add_rectangle = [&](int x0, int y0, int x1, int y1, bool opaque)
+        {
+            GLfloat const tex_left = tex.left + (x0 - left) * tex_per_x;
+            GLfloat const tex_right = tex.left + (x1 - left) * tex_per_x;
+            GLfloat const tex_top = tex.top + (y0 - top) * tex_per_y;
+            GLfloat const tex_bottom = tex.top + (y1 - top) * tex_per_y;
+
+            GLfloat const l = x0 - offset.dx.as_int();
+            GLfloat const r = x1 - offset.dx.as_int();
+            GLfloat const t = y0 - offset.dy.as_int();
+            GLfloat const b = y1 - offset.dy.as_int();
+
+            mgl::Primitive rectangle;
+            rectangle.type = GL_TRIANGLE_STRIP;
+            rectangle.opaque = opaque;
+
+            auto& vertices = rectangle.vertices;
+            vertices[0] = {{l, t, 0.0f}, {tex_left,  tex_top}};
+            vertices[1] = {{l, b, 0.0f}, {tex_left,  tex_bottom}};
+            vertices[2] = {{r, t, 0.0f}, {tex_right, tex_top}};
+            vertices[3] = {{r, b, 0.0f}, {tex_right, tex_bottom}};
+            primitives.push_back(rectangle);
+        };
+
+    for (auto y = ys.begin(); std::next(y) != ys.end(); ++y)
+    {
+        auto run_start = xs.front();
+        auto run_opaque = cell_is_opaque(xs[0], *y, xs[1], *std::next(y));
+        for (auto x = std::next(xs.begin()); std::next(x) != xs.end(); ++x)
+        {
+            auto const opaque = cell_is_opaque(*x, *y, *std::next(x), *std::next(y));
+            if (opaque != run_opaque)
+            {
+                add_rectangle(run_start, *y, *x, *std::next(y), run_opaque);
+                run_start = *x;
+                run_opaque = opaque;
+            }
+        }
+        add_rectangle(run_start, *y, xs.back(), *std::next(y), run_opaque);
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_COMMON_EVENT_POOL_H_
+#define MIR_COMMON_EVENT_POOL_H_
+
+#include <cstddef>
+
+namespace mir
+{
+namespace events
+{
+/**
+ * Storage for input events and the control blocks that share them.
+ *
+ * Every movement of every input device creates an event, and the dispatcher clones another for each recipient,
+ * so blocks are recycled through a free list rather than returned to the heap. Safe to use from any thread.
+ */
+auto pool_allocate(std::size_t size) -> void*;
+void pool_deallocate(void* block, std::size_t size) noexcept;
+
+/// A standard allocator drawing from the event pool
+template<typename T>
+struct PoolAllocator
+{
+    using value_type = T;
+
+    PoolAllocator() = default;
+    template<typename U>
+    PoolAllocator(PoolAllocator<U> const&) {}
+
+    auto allocate(std::size_t n) -> T* { return static_cast<T*>(pool_allocate(n * sizeof(T))); }
+    void deallocate(T* block, std::size_t n) noexcept { pool_deallocate(block, n * sizeof(T)); }
+
+    template<typename U>
+    auto operator==(PoolAllocator<U> const&) const -> bool { return true; }
+};
+}
+}
+
+#endif /* MIR_COMMON_EVENT_POOL_H_ */
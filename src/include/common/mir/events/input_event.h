@@ -47,6 +47,12 @@ struct MirInputEvent : MirEvent
     MirTouchEvent* to_touch();
     MirTouchEvent const* to_touch() const;
 
+    /// Input events are recycled through mir::events::pool_allocate() rather than the heap
+    /// @{
+    static void* operator new(std::size_t size);
+    static void operator delete(void* event, std::size_t size) noexcept;
+    /// @}
+
 protected:
     MirInputEvent(MirInputEventType input_type,
                   MirInputDeviceId dev,
@@ -0,0 +1,81 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_COMPILED_KEYMAP_H_
+#define MIR_INPUT_COMPILED_KEYMAP_H_
+
+#include "mir/fd.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+struct xkb_keymap;
+struct xkb_state;
+
+namespace mir
+{
+namespace input
+{
+class Keymap;
+
+/**
+ * An XKB keymap compiled once and shared by everything using a matching Keymap.
+ *
+ * libxkbcommon reference counts are not atomic, so states must be created through make_state() (which serialises
+ * the keymap's reference count) rather than by calling xkb_state_new() on xkb_keymap() directly.
+ */
+class CompiledKeymap
+{
+public:
+    using StatePtr = std::unique_ptr<xkb_state, void(*)(xkb_state*)>;
+
+    explicit CompiledKeymap(xkb_keymap* keymap);
+    ~CompiledKeymap();
+
+    /// Only to be used for read-only queries
+    auto xkb_keymap() const -> ::xkb_keymap* { return keymap; }
+
+    auto make_state() const -> StatePtr;
+
+    /// The keymap in XKB_KEYMAP_FORMAT_TEXT_V1, as sent by wl_keyboard.keymap
+    /// @{
+    /// A sealed, read-only memfd, created on first use and shared by all clients (which must map it MAP_PRIVATE)
+    auto text_fd() const -> Fd;
+    /// Including the null terminator
+    auto text_size() const -> size_t;
+    /// @}
+
+    CompiledKeymap(CompiledKeymap const&) = delete;
+    CompiledKeymap& operator=(CompiledKeymap const&) = delete;
+
+private:
+    void serialise() const;
+
+    ::xkb_keymap* const keymap;
+    std::once_flag mutable serialised;
+    Fd mutable fd;
+    size_t mutable size{0};
+    /// Only kept if sealed memfds are unavailable, in which case each client gets its own copy
+    std::string mutable text;
+};
+
+/// The compiled form of keymap. This is only compiled if no matching keymap is already in use in the process.
+auto compiled_keymap_for(std::shared_ptr<Keymap> const& keymap) -> std::shared_ptr<CompiledKeymap const>;
+}
+}
+
+#endif // MIR_INPUT_COMPILED_KEYMAP_H_
@@ -0,0 +1,142 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_INPUT_RECORDING_H_
+#define MIR_INPUT_INPUT_RECORDING_H_
+
+#include "mir_toolkit/event.h"
+#include "mir/fd.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mir
+{
+namespace input
+{
+/**
+ * A device being added or removed, or an input event from it, as recorded by InputRecordingWriter.
+ *
+ * Only the members relevant to the kind of record are meaningful.
+ */
+struct RecordedInput
+{
+    enum class Kind : uint8_t
+    {
+        device_added,
+        device_removed,
+        key,
+        pointer,
+        touch
+    };
+
+    struct Contact
+    {
+        MirTouchId id;
+        MirTouchAction action;
+        MirTouchTooltype tool_type;
+        float x;
+        float y;
+        float pressure;
+        float touch_major;
+        float touch_minor;
+        float orientation;
+    };
+
+    Kind kind;
+    MirInputDeviceId device_id;
+    /// The event time, or when the device was added or removed (on CLOCK_MONOTONIC)
+    std::chrono::nanoseconds time;
+
+    // device_added
+    std::string name{};
+    std::string unique_id{};
+    uint32_t capabilities{0};
+
+    // key
+    MirKeyboardAction key_action{mir_keyboard_action_up};
+    int32_t scan_code{0};
+
+    // pointer
+    MirPointerAction pointer_action{mir_pointer_action_motion};
+    MirPointerButtons buttons{0};
+    float dx{0};
+    float dy{0};
+    float h_scroll{0};
+    float v_scroll{0};
+
+    // touch
+    std::vector<Contact> contacts{};
+};
+
+/**
+ * Writes devices and their input events to a compact binary file, for replay by benchmarks.
+ *
+ * The file is an 8 byte "MIRINREC" magic and a 32 bit version, followed by the records. Each record is a byte for its
+ * kind, the 64 bit device id and time, then the fields for that kind. Everything is in host byte order, as the
+ * recordings are only meant to be replayed on the machine (or at least the architecture) that made them.
+ *
+ * The file is only readable by its owner, as it holds everything typed while recording. Records are buffered, and
+ * written out in batches (by a thread of the writer's own at least once a second) and on destruction.
+ *
+ * \note Instances are thread-safe.
+ */
+class InputRecordingWriter
+{
+public:
+    /// \throws std::system_error if the file cannot be created
+    explicit InputRecordingWriter(std::string const& path);
+    ~InputRecordingWriter();
+
+    void device_added(
+        MirInputDeviceId id,
+        std::string const& name,
+        std::string const& unique_id,
+        uint32_t capabilities);
+    void device_removed(MirInputDeviceId id);
+    /// Events other than key, pointer and touch input are ignored
+    void record(MirEvent const& event);
+
+    InputRecordingWriter(InputRecordingWriter const&) = delete;
+    InputRecordingWriter& operator=(InputRecordingWriter const&) = delete;
+
+private:
+    void write(RecordedInput const& record);
+    /// Writes out the buffer, releasing the lock on mutex first so records can be buffered meanwhile
+    void flush(std::unique_lock<std::mutex>& lock);
+
+    std::mutex mutex;
+    Fd const file;
+    std::string buffer;
+    std::chrono::nanoseconds last_flush;
+    bool stopping{false};
+    std::condition_variable stopped;
+    /// Held while writing a batch out, so batches are written in order
+    std::mutex file_mutex;
+    std::thread flusher;
+};
+
+/// \throws std::runtime_error if the file cannot be read or is not an input recording
+auto read_input_recording(std::string const& path) -> std::vector<RecordedInput>;
+}
+}
+
+#endif /* MIR_INPUT_INPUT_RECORDING_H_ */
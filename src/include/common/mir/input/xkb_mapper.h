@@ -19,6 +19,7 @@
 
 #include "mir/input/key_mapper.h"
 #include "mir/input/keymap.h"
+#include "mir/input/compiled_keymap.h"
 #include "mir/optional_value.h"
 #include "mir/events/xkb_modifiers.h"
 
@@ -81,7 +82,7 @@ private:
 
     struct XkbMappingState
     {
-        explicit XkbMappingState(std::shared_ptr<Keymap> keymap, std::shared_ptr<xkb_keymap> compiled_keymap);
+        explicit XkbMappingState(std::shared_ptr<Keymap> keymap, std::shared_ptr<CompiledKeymap const> compiled_keymap);
         void set_key_state(std::vector<uint32_t> const& key_state);
 
         bool update_and_map(MirEvent& event, ComposeState* compose_state);
@@ -98,7 +99,7 @@ private:
         void release_modifier(MirInputEventModifiers mod);
 
         std::shared_ptr<Keymap> const keymap;
-        std::shared_ptr<xkb_keymap> const compiled_keymap;
+        std::shared_ptr<CompiledKeymap const> const compiled_keymap;
         XKBStatePtr state;
         MirInputEventModifiers modifier_state{0};
     };
@@ -108,7 +109,7 @@ private:
 
     XKBContextPtr context;
     std::shared_ptr<Keymap> default_keymap;
-    std::shared_ptr<xkb_keymap> default_compiled_keymap;
+    std::shared_ptr<CompiledKeymap const> default_compiled_keymap;
     XKBComposeTablePtr compose_table;
     MirXkbModifiers xkb_modifiers_;
     MirInputDeviceId last_device_id;
@@ -0,0 +1,74 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_THREAD_SCHEDULING_H_
+#define MIR_THREAD_SCHEDULING_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mir
+{
+/// How a latency sensitive thread (such as input reading or compositing) is scheduled
+struct ThreadScheduling
+{
+    enum class Policy
+    {
+        fifo,           ///< SCHED_FIFO
+        round_robin     ///< SCHED_RR
+    };
+
+    /// Real-time priority from 1 (lowest) to 99, or 0 to leave the thread with normal scheduling
+    int priority{0};
+    Policy policy{Policy::fifo};
+    /// The CPUs the thread may run on, or empty for any
+    std::vector<int> cpus;
+};
+
+/// Parses "fifo" or "rr", throwing std::invalid_argument for anything else
+auto parse_scheduling_policy(std::string const& name) -> ThreadScheduling::Policy;
+
+/// Parses a list of CPUs such as "3" or "0-1,4", throwing std::invalid_argument if it is malformed.
+/// An empty list means any CPU.
+auto parse_cpu_list(std::string const& list) -> std::vector<int>;
+
+/// Applies scheduling to the calling thread. Whatever the system does not allow (typically real-time priority
+/// without CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO) is logged and otherwise ignored.
+void apply_thread_scheduling(ThreadScheduling const& scheduling, std::string const& thread_description);
+
+/// Applies scheduling to the calling thread for its lifetime, then restores what the thread had before. This allows
+/// scheduling threads that are borrowed from a pool. Must be destroyed on the thread that created it.
+class ScopedThreadScheduling
+{
+public:
+    ScopedThreadScheduling(ThreadScheduling const& scheduling, std::string const& thread_description);
+    ~ScopedThreadScheduling();
+
+    ScopedThreadScheduling(ScopedThreadScheduling const&) = delete;
+    ScopedThreadScheduling& operator=(ScopedThreadScheduling const&) = delete;
+
+private:
+    struct Saved;
+    std::unique_ptr<Saved> const saved;
+};
+
+/// Locks the memory of the process, so that it is never paged out. Memory mapped later is also locked if
+/// RLIMIT_MEMLOCK is unlimited. Failure is logged and otherwise ignored.
+void lock_process_memory();
+}
+
+#endif /* MIR_THREAD_SCHEDULING_H_ */
@@ -34,7 +34,7 @@ struct Primitive
     enum {max_vertices = 4};
 
     Primitive()
-        : type(GL_TRIANGLE_FAN), nvertices(4)
+        : type(GL_TRIANGLE_FAN), nvertices(4), opaque(false)
     {
         // Default is a quad. Just need to assign vertices[] and tex_id.
     }
@@ -42,6 +42,7 @@ struct Primitive
     GLenum type; // GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_TRIANGLES etc
     int nvertices;
     Vertex vertices[max_vertices];
+    bool opaque; // Every texel covered is known to be opaque, so blending may be skipped
 };
 }
 }
@@ -18,6 +18,9 @@
 #define MIR_GL_TESSELLATION_HELPERS_H_
 #include "mir/gl/primitive.h"
 #include "mir/geometry/displacement.h"
+#include "mir/geometry/rectangle.h"
+
+#include <vector>
 
 namespace mir
 {
@@ -28,6 +31,18 @@ namespace gl
 Primitive tessellate_renderable_into_rectangle(
     graphics::Renderable const& renderable, geometry::Displacement const& offset);
 
+/**
+ * Appends rectangles covering the renderable to primitives, split along the
+ * edges of opaque_region (given in the same coordinates as screen_position())
+ * so that each one is either entirely opaque or not. Runs of cells in the
+ * same row with the same opacity are merged.
+ */
+void tessellate_renderable_by_opacity(
+    std::vector<Primitive>& primitives,
+    graphics::Renderable const& renderable,
+    geometry::Displacement const& offset,
+    std::vector<geometry::Rectangle> const& opaque_region);
+
 }
 }
 #endif /* MIR_GL_TESSELLATION_HELPERS_H_ */
@@ -46,6 +46,13 @@ public:
     virtual void drop_old_buffers() = 0;
     virtual auto has_submitted_buffer() const -> bool = 0;
     virtual auto framedropping() const -> bool = 0;
+
+    /// The buffer has been presented on the output covering output_area
+    virtual void frame_presented(
+        graphics::BufferID buffer,
+        geometry::Rectangle const& output_area,
+        graphics::Frame const& frame,
+        bool zero_copy) = 0;
 };
 
 }
@@ -18,6 +18,9 @@
 #define MIR_COMPOSITOR_COMPOSITOR_REPORT_H_
 
 #include "mir/graphics/renderable.h"
+#include "mir/geometry/rectangle.h"
+
+#include <chrono>
 
 namespace mir
 {
@@ -36,6 +39,8 @@ public:
     virtual void started() = 0;
     virtual void stopped() = 0;
     virtual void scheduled() = 0;
+    /// A screen capture of area was delivered, taking cost; rendered is false if an earlier render was reused
+    virtual void captured_area(geometry::Rectangle const& area, std::chrono::nanoseconds cost, bool rendered) = 0;
 protected:
     CompositorReport() = default;
     virtual ~CompositorReport() = default;
@@ -21,6 +21,10 @@
 
 namespace mir
 {
+namespace graphics
+{
+struct Frame;
+}
 namespace compositor
 {
 
@@ -31,6 +35,12 @@ public:
 
     virtual void composite(SceneElementSequence&& scene_sequence) = 0;
 
+    /// The last composited frame has been posted and reached the screen on frame.
+    virtual void frame_presented(graphics::Frame const& frame) = 0;
+
+    /// Whether anything is waiting on frame_presented() for when the last frame reached the screen.
+    virtual auto awaits_presentation() const -> bool { return false; }
+
 protected:
     DisplayBufferCompositor() = default;
     DisplayBufferCompositor& operator=(DisplayBufferCompositor const&) = delete;
@@ -17,6 +17,9 @@
 #ifndef MIR_COMPOSITOR_SCENE_ELEMENT_H_
 #define MIR_COMPOSITOR_SCENE_ELEMENT_H_
 
+#include "mir/geometry/forward.h"
+
+#include <functional>
 #include <memory>
 
 namespace mir
@@ -24,6 +27,7 @@ namespace mir
 namespace graphics
 {
 class Renderable;
+struct Frame;
 }
 namespace compositor
 {
@@ -37,6 +41,16 @@ public:
     virtual void rendered() = 0;
     virtual void occluded() = 0;
 
+    /// Notified when the frame the element was rendered into reaches the output covering
+    /// output_area. zero_copy is set when the element's buffer was scanned out directly.
+    using PresentationCallback = std::function<void(
+        geometry::Rectangle const& output_area,
+        graphics::Frame const& frame,
+        bool zero_copy)>;
+
+    /// The callback outlives the element, so must not hold its buffer. May be empty.
+    virtual auto presentation_callback() const -> PresentationCallback = 0;
+
 protected:
     SceneElement() = default;
     SceneElement(SceneElement const&) = delete;
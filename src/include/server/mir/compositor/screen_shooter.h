@@ -26,6 +26,10 @@
 
 namespace mir
 {
+namespace graphics
+{
+class Buffer;
+}
 namespace renderer
 {
 namespace software
@@ -49,6 +53,20 @@ public:
         mir::geometry::Rectangle const& area,
         std::function<void(std::optional<time::Timestamp>)>&& callback) = 0;
 
+    /// As capture(), for a buffer that already holds a capture of area which is only out of date within stale_area
+    /// (given in the same coordinates as area). Implementations may re-render and copy just that part of the buffer.
+    virtual void capture_update(
+        std::shared_ptr<renderer::software::WriteMappableBuffer> const& buffer,
+        mir::geometry::Rectangle const& area,
+        mir::geometry::Rectangle const& stale_area,
+        std::function<void(std::optional<time::Timestamp>)>&& callback) = 0;
+
+    /// As capture(), but renders straight into a GPU buffer (such as a client's dmabuf) rather than through the CPU
+    virtual void capture_gpu_buffer(
+        std::shared_ptr<graphics::Buffer> const& buffer,
+        mir::geometry::Rectangle const& area,
+        std::function<void(std::optional<time::Timestamp>)>&& callback) = 0;
+
 private:
     ScreenShooter(ScreenShooter const&) = delete;
     ScreenShooter& operator=(ScreenShooter const&) = delete;
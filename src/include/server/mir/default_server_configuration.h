@@ -110,6 +110,7 @@ class GLConfig;
 namespace input
 {
 class InputReport;
+class InputLatencyReport;
 class SeatObserver;
 class Scene;
 class InputManager;
@@ -305,6 +306,7 @@ public:
     /** @name input configuration
      *  @{ */
     virtual std::shared_ptr<input::InputReport> the_input_report();
+    virtual std::shared_ptr<input::InputLatencyReport> the_input_latency_report();
     virtual std::shared_ptr<ObserverRegistrar<input::SeatObserver>> the_seat_observer_registrar();
     virtual std::shared_ptr<input::CompositeEventFilter> the_composite_event_filter();
 
@@ -365,6 +367,7 @@ protected:
     CachedPtr<frontend::Connector>   xwayland_connector;
 
     CachedPtr<input::InputReport> input_report;
+    CachedPtr<input::InputLatencyReport> input_latency_report;
     CachedPtr<input::EventFilterChainDispatcher> event_filter_chain_dispatcher;
     CachedPtr<input::CompositeEventFilter> composite_event_filter;
     CachedPtr<input::InputManager>    input_manager;
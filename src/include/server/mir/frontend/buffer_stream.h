@@ -20,6 +20,7 @@
 #include <mir_toolkit/common.h>
 #include "mir/graphics/buffer_id.h"
 #include "mir/geometry/size.h"
+#include "mir/geometry/rectangle.h"
 #include <functional>
 #include <memory>
 
@@ -29,6 +30,7 @@ namespace graphics
 {
 class Buffer;
 struct BufferProperties;
+struct Frame;
 }
 
 namespace frontend
@@ -44,6 +46,15 @@ public:
     virtual void set_frame_posted_callback(
         std::function<void(geometry::Size const&)> const& callback) = 0;
 
+    /// Called with the id of the presented buffer, the area of the output it was presented on,
+    /// the frame it was presented in and whether it was scanned out without being composited
+    virtual void set_frame_presented_callback(
+        std::function<void(
+            graphics::BufferID,
+            geometry::Rectangle const&,
+            graphics::Frame const&,
+            bool)> const& callback) = 0;
+
     virtual void with_most_recent_buffer_do(
         std::function<void(graphics::Buffer&)> const& exec) = 0;
 
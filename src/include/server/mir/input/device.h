@@ -18,6 +18,7 @@
 #define MIR_INPUT_DEVICE_H_
 
 #include "mir/input/device_capability.h"
+#include "mir/input/input_device_statistics.h"
 #include "mir_toolkit/event.h"
 #include "mir/optional_value.h"
 
@@ -54,6 +55,8 @@ public:
 
     virtual optional_value<MirTouchscreenConfig> touchscreen_configuration() const = 0;
     virtual void apply_touchscreen_configuration(MirTouchscreenConfig const&) = 0;
+
+    virtual InputDeviceStatistics statistics() const = 0;
 private:
     Device(Device const&) = delete;
     Device& operator=(Device const&) = delete;
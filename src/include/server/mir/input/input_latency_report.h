@@ -0,0 +1,58 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_INPUT_LATENCY_REPORT_H_
+#define MIR_INPUT_INPUT_LATENCY_REPORT_H_
+
+#include <chrono>
+
+namespace mir
+{
+namespace input
+{
+/**
+ * Follows input events from the kernel to the screen.
+ *
+ * Each stage identifies the event by the time the input platform stamped it with (on CLOCK_MONOTONIC), so the
+ * latency of a stage is the time it was reached less the event time.
+ */
+class InputLatencyReport
+{
+public:
+    virtual ~InputLatencyReport() = default;
+
+    /// The seat received the event from its input device
+    virtual void received_event(std::chrono::nanoseconds event_time) = 0;
+    /// The seat handed the event to the input dispatcher
+    virtual void dispatched_event(std::chrono::nanoseconds event_time) = 0;
+    /// The event was sent to a Wayland client
+    virtual void sent_event(std::chrono::nanoseconds event_time) = 0;
+    /// The client committed a buffer, the latest event sent to it being from event_time
+    virtual void committed_after_event(std::chrono::nanoseconds event_time) = 0;
+    /// A buffer committed in response to the event reached the screen at presentation_time (on CLOCK_MONOTONIC)
+    virtual void presented_after_event(
+        std::chrono::nanoseconds event_time,
+        std::chrono::nanoseconds presentation_time) = 0;
+
+protected:
+    InputLatencyReport() = default;
+    InputLatencyReport(InputLatencyReport const&) = delete;
+    InputLatencyReport& operator=(InputLatencyReport const&) = delete;
+};
+}
+}
+
+#endif /* MIR_INPUT_INPUT_LATENCY_REPORT_H_ */
@@ -18,6 +18,7 @@
 #define MIR_SCENE_SURFACE_H_
 
 #include "mir/graphics/renderable.h"
+#include "mir/graphics/buffer_id.h"
 #include "mir/input/surface.h"
 #include "mir/frontend/surface.h"
 #include "mir/compositor/compositor_id.h"
@@ -31,7 +32,7 @@
 namespace mir
 {
 namespace shell { class InputTargeter; }
-namespace graphics { class CursorImage; }
+namespace graphics { class CursorImage; struct Frame; }
 namespace compositor { class BufferStream; }
 namespace scene
 {
@@ -40,6 +41,10 @@ struct StreamInfo
     std::shared_ptr<compositor::BufferStream> stream;
     geometry::Displacement displacement;
     optional_value<geometry::Size> size;
+    /// Fully opaque parts of the stream, relative to its top left
+    std::vector<geometry::Rectangle> opaque_region{};
+    /// The part of the buffer to show, in buffer pixels. The whole buffer if unset.
+    optional_value<geometry::RectangleD> src_bounds{};
 };
 
 class SurfaceObserver;
@@ -65,6 +70,13 @@ public:
     virtual geometry::Size window_size() const = 0;
 
     virtual graphics::RenderableList generate_renderables(compositor::CompositorID id) const = 0; 
+    /// Notify the stream rendered with the given id that buffer reached the output covering output_area on frame
+    virtual void buffer_presented(
+        graphics::Renderable::ID stream,
+        graphics::BufferID buffer,
+        geometry::Rectangle const& output_area,
+        graphics::Frame const& frame,
+        bool zero_copy) = 0;
     virtual int buffers_ready_for_compositor(void const* compositor_id) const = 0;
 
     virtual MirWindowType type() const = 0;
@@ -88,6 +100,8 @@ public:
      * set_input_region({Rectangle{}}).
      */
     virtual void set_input_region(std::vector<geometry::Rectangle> const& region) = 0;
+    /// The input region last set, empty if there is none
+    virtual auto input_region() const -> std::vector<geometry::Rectangle> = 0;
     /// Given value is the frame size of the window
     virtual void resize(geometry::Size const& window_size) = 0;
     virtual void set_transformation(glm::mat4 const& t) = 0;
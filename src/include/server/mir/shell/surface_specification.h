@@ -49,6 +49,10 @@ struct StreamSpecification
     std::weak_ptr<frontend::BufferStream> stream;
     geometry::Displacement displacement;
     optional_value<geometry::Size> size;
+    /// Fully opaque parts of the stream, relative to its top left
+    std::vector<geometry::Rectangle> opaque_region{};
+    /// The part of the buffer to show, in buffer pixels. The whole buffer if unset.
+    optional_value<geometry::RectangleD> src_bounds{};
 };
 auto operator==(StreamSpecification const& lhs, StreamSpecification const& rhs) -> bool;
 
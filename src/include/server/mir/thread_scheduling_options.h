@@ -0,0 +1,35 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_THREAD_SCHEDULING_OPTIONS_H_
+#define MIR_THREAD_SCHEDULING_OPTIONS_H_
+
+#include "mir/thread_scheduling.h"
+
+namespace mir
+{
+namespace options
+{
+class Option;
+}
+
+/// The scheduling asked for by the given priority and CPU options, together with options::realtime_policy_opt.
+/// Options the shell has not added leave the thread with normal scheduling.
+auto thread_scheduling_from(options::Option const& options, char const* priority_opt, char const* cpus_opt)
+    -> ThreadScheduling;
+}
+
+#endif /* MIR_THREAD_SCHEDULING_OPTIONS_H_ */
@@ -0,0 +1,61 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "miral/realtime_scheduling.h"
+
+#include <mir/server.h>
+#include <mir/options/configuration.h>
+
+namespace mo = mir::options;
+
+struct miral::RealtimeScheduling::Self
+{
+};
+
+miral::RealtimeScheduling::RealtimeScheduling() : self{std::make_shared<Self>()}
+{
+}
+
+void miral::RealtimeScheduling::operator()(mir::Server& server) const
+{
+    server.add_configuration_option(
+        mo::realtime_policy_opt,
+        "Real-time scheduling policy for threads given a priority: [fifo, rr]", "fifo");
+
+    server.add_configuration_option(
+        mo::input_thread_priority_opt,
+        "Real-time priority (1-99) of the input thread, or 0 for normal scheduling", 0);
+
+    server.add_configuration_option(
+        mo::input_thread_cpus_opt,
+        "CPUs the input thread may run on (e.g. \"3\" or \"2-3\"), defaults to any", mir::OptionType::string);
+
+    server.add_configuration_option(
+        mo::compositor_thread_priority_opt,
+        "Real-time priority (1-99) of the compositor threads, or 0 for normal scheduling", 0);
+
+    server.add_configuration_option(
+        mo::compositor_thread_cpus_opt,
+        "CPUs the compositor threads may run on (e.g. \"0,1\"), defaults to any", mir::OptionType::string);
+
+    server.add_configuration_option(
+        mo::lock_memory_opt,
+        "Lock the server's memory so it is never paged out", mir::OptionType::null);
+}
+
+miral::RealtimeScheduling::~RealtimeScheduling() = default;
+miral::RealtimeScheduling::RealtimeScheduling(RealtimeScheduling const&) = default;
+auto miral::RealtimeScheduling::operator=(RealtimeScheduling const&) -> RealtimeScheduling& = default;
@@ -44,6 +44,8 @@ public:
   void hidden_set_to(mir::scene::Surface const *surf, bool hide) override;
   void input_consumed(mir::scene::Surface const *surf,
                       std::shared_ptr<MirEvent const> const& event) override;
+  void input_region_set_to(mir::scene::Surface const *surf,
+                           std::vector<mir::geometry::Rectangle> const &region) override;
   void moved_to(mir::scene::Surface const *surf,
                 mir::geometry::Point const &top_left) override;
   void orientation_set_to(mir::scene::Surface const *surf,
@@ -130,6 +132,11 @@ void miroil::SurfaceObserverImpl::input_consumed(mir::scene::Surface const* surf
     listener->input_consumed(surf, event.get());
 }
 
+void miroil::SurfaceObserverImpl::input_region_set_to(mir::scene::Surface const*, std::vector<mir::geometry::Rectangle> const&)
+{
+    // Not part of the miroil::SurfaceObserver interface
+}
+
 void miroil::SurfaceObserverImpl::moved_to(mir::scene::Surface const* surf, mir::geometry::Point const& top_left)
 {
     listener->moved_to(surf, top_left);
@@ -0,0 +1,72 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/solid_colour_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace mg = mir::graphics;
+namespace geom = mir::geometry;
+
+mg::SolidColourBuffer::SolidColourBuffer(Colour const& colour, geom::Size size)
+    : colour_{colour},
+      size_{size}
+{
+}
+
+geom::Size mg::SolidColourBuffer::size() const
+{
+    return size_;
+}
+
+MirPixelFormat mg::SolidColourBuffer::pixel_format() const
+{
+    // An opaque colour is reported without alpha so the surface can be treated as opaque throughout
+    return colour_[3] < 1.0f ? mir_pixel_format_argb_8888 : mir_pixel_format_xrgb_8888;
+}
+
+mg::NativeBufferBase* mg::SolidColourBuffer::native_buffer_base()
+{
+    return this;
+}
+
+MirPixelFormat mg::SolidColourBuffer::format() const
+{
+    return pixel_format();
+}
+
+geom::Stride mg::SolidColourBuffer::stride() const
+{
+    return geom::Stride{size_.width.as_uint32_t() * MIR_BYTES_PER_PIXEL(mir_pixel_format_argb_8888)};
+}
+
+void mg::SolidColourBuffer::transfer_from_buffer(unsigned char* destination) const
+{
+    auto const channel = [this](size_t i) -> uint32_t
+        {
+            return static_cast<uint32_t>(std::lround(std::clamp(colour_[i], 0.0f, 1.0f) * 255));
+        };
+    uint32_t const pixel = channel(3) << 24 | channel(0) << 16 | channel(1) << 8 | channel(2);
+
+    auto const pixels = size_.width.as_uint32_t() * size_.height.as_uint32_t();
+    for (auto i = 0u; i != pixels; ++i)
+    {
+        std::memcpy(destination + i * sizeof pixel, &pixel, sizeof pixel);
+    }
+}
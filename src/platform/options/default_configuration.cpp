@@ -44,6 +44,17 @@ char const* const mo::wayland_extensions_opt      = "wayland-extensions";
 char const* const mo::add_wayland_extensions_opt  = "add-wayland-extensions";
 char const* const mo::drop_wayland_extensions_opt = "drop-wayland-extensions";
 char const* const mo::idle_timeout_opt            = "idle-timeout";
+char const* const mo::hidden_surface_frame_rate_opt = "hidden-surface-frame-rate";
+char const* const mo::coalesce_pointer_motion_opt = "coalesce-pointer-motion";
+char const* const mo::resample_touch_opt          = "resample-touch";
+char const* const mo::input_record_opt            = "input-record";
+char const* const mo::input_motion_rate_limit_opt = "input-motion-rate-limit";
+char const* const mo::realtime_policy_opt         = "realtime-policy";
+char const* const mo::input_thread_priority_opt   = "input-thread-priority";
+char const* const mo::input_thread_cpus_opt       = "input-thread-cpus";
+char const* const mo::compositor_thread_priority_opt = "compositor-thread-priority";
+char const* const mo::compositor_thread_cpus_opt  = "compositor-thread-cpus";
+char const* const mo::lock_memory_opt             = "lock-memory";
 
 char const* const mo::off_opt_value = "off";
 char const* const mo::log_opt_value = "log";
@@ -179,6 +190,20 @@ mo::DefaultConfiguration::DefaultConfiguration(
         (idle_timeout_opt, po::value<int>()->default_value(0),
             "Time (in seconds) Mir will remain idle before turning off the display, "
             "or 0 to keep display on forever.")
+        (hidden_surface_frame_rate_opt, po::value<int>()->default_value(1),
+            "Maximum rate (in Hz) of frame callbacks to clients whose surfaces are occluded, offscreen or minimised. "
+            "0 holds them until the surface is visible again, a negative value disables throttling.")
+        (coalesce_pointer_motion_opt, po::value<bool>()->default_value(false),
+            "Send clients at most one pointer motion per output refresh, just before it is due. "
+            "Relative pointer motion is still sent at the full input rate.")
+        (resample_touch_opt, po::value<bool>()->default_value(false),
+            "Send clients touch motion resampled to one update per output refresh, just before it is due, rather "
+            "than at the touchscreen's rate. Touches going down or up are still sent as they happen.")
+        (input_record_opt, po::value<std::string>(),
+            "File to record input devices and events to, for replaying in benchmarks.")
+        (input_motion_rate_limit_opt, po::value<int>()->default_value(0),
+            "Maximum rate (in Hz) of pointer and touch motion events taken from each input device, or 0 for no limit. "
+            "Pointer motion above the limit is merged into the device's next pointer event.")
         (fatal_except_opt, "On \"fatal error\" conditions [e.g. drivers behaving "
             "in unexpected ways] throw an exception (instead of a core dump)")
         (debug_opt, "Enable extra development debugging. "
@@ -368,7 +368,11 @@ void mie::Platform::start()
             }
         });
 
-    platform_dispatchable->add_watch(udev_dispatchable);
+    // The udev monitor socket is non-blocking, and is drained by each dispatch
+    platform_dispatchable->add_watch(
+        udev_dispatchable,
+        md::DispatchReentrancy::sequential,
+        md::DispatchTrigger::edge);
     platform_dispatchable->add_watch(libinput_dispatchable);
     platform_dispatchable->add_watch(action_queue);
     process_input_events();
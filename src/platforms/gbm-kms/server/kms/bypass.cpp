@@ -17,6 +17,7 @@
 #include "bypass.h"
 
 #include "mir/graphics/renderable.h"
+#include "mir/graphics/buffer.h"
 
 using namespace mir;
 namespace mgg = mir::graphics::gbm;
@@ -41,6 +42,9 @@ bool mgg::BypassMatch::operator()(std::shared_ptr<graphics::Renderable> const& r
     auto const is_opaque = !((renderable->alpha() != 1.0f) || renderable->shaped());
     auto const fits = (renderable->screen_position() == view_area);
     auto const is_orthogonal = (renderable->transformation() == identity);
-    bypass_is_feasible = (is_opaque && fits && is_orthogonal);
+    // Scanning out the buffer would show all of it
+    auto const is_uncropped =
+        (renderable->src_bounds() == geometry::RectangleD{{0, 0}, geometry::SizeD{renderable->buffer()->size()}});
+    bypass_is_feasible = (is_opaque && fits && is_orthogonal && is_uncropped);
     return bypass_is_feasible;
 }
@@ -26,7 +26,11 @@
 
 #include <boost/exception/errinfo_errno.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace mg = mir::graphics;
@@ -86,6 +90,63 @@ int get_drm_cursor_width(int fd)
     return int(width);
 }
 
+uint32_t const filler = 0; // 0x3f3f3f3f; is useful to make buffer visible for debugging
+size_t const max_cached_images = 8;
+
+// Copies the top-left \a width x \a height pixels of \a src into \a dest, rotated by \a orientation.
+// The loops work on whole pixels with the destination written sequentially, so the
+// compiler can vectorise them (the normal and inverted cases are straight or reversed row copies).
+void rotate_image(
+    uint32_t const* __restrict__ src, uint32_t width, uint32_t height, uint32_t src_stride,
+    uint32_t* __restrict__ dest, uint32_t dest_stride,
+    MirOrientation orientation)
+{
+    if (width == 0 || height == 0)
+        return;
+
+    switch (orientation)
+    {
+    case mir_orientation_normal:
+        for (uint32_t row = 0; row != height; ++row)
+        {
+            std::copy_n(src + row*src_stride, width, dest + row*dest_stride);
+        }
+        break;
+
+    case mir_orientation_inverted:
+        for (uint32_t row = 0; row != height; ++row)
+        {
+            auto const src_row = src + ((height-1)-row)*src_stride;
+            std::reverse_copy(src_row, src_row + width, dest + row*dest_stride);
+        }
+        break;
+
+    case mir_orientation_left:
+        for (uint32_t row = 0; row != width; ++row)
+        {
+            auto const src_col = src + ((width-1)-row);
+            auto const dest_row = dest + row*dest_stride;
+            for (uint32_t col = 0; col != height; ++col)
+            {
+                dest_row[col] = src_col[col*src_stride];
+            }
+        }
+        break;
+
+    case mir_orientation_right:
+        for (uint32_t row = 0; row != width; ++row)
+        {
+            auto const src_col = src + row + (height-1)*src_stride;
+            auto const dest_row = dest + row*dest_stride;
+            for (uint32_t col = 0; col != height; ++col)
+            {
+                dest_row[col] = src_col[-static_cast<ptrdiff_t>(col*src_stride)];
+            }
+        }
+        break;
+    }
+}
+
 gbm_device* gbm_create_device_checked(int fd)
 {
     auto device = gbm_create_device(fd);
@@ -95,20 +156,29 @@ gbm_device* gbm_create_device_checked(int fd)
     }
     return device;
 }
+
+gbm_bo* gbm_create_cursor_bo_checked(gbm_device* device, int fd)
+{
+    auto buffer = gbm_bo_create(
+        device,
+        get_drm_cursor_width(fd),
+        get_drm_cursor_height(fd),
+        GBM_FORMAT_ARGB8888,
+        GBM_BO_USE_CURSOR | GBM_BO_USE_WRITE);
+    if (!buffer)
+    {
+        BOOST_THROW_EXCEPTION(std::runtime_error("failed to create gbm-kms buffer"));
+    }
+    return buffer;
+}
 }
 
 mgg::Cursor::GBMBOWrapper::GBMBOWrapper(int fd, MirOrientation orientation) :
+    fd{fd},
     device{gbm_create_device_checked(fd)},
-    buffer{
-        gbm_bo_create(
-            device,
-            get_drm_cursor_width(fd),
-            get_drm_cursor_height(fd),
-            GBM_FORMAT_ARGB8888,
-            GBM_BO_USE_CURSOR | GBM_BO_USE_WRITE)},
+    buffer{gbm_create_cursor_bo_checked(device, fd)},
     current_orientation{orientation}
 {
-    if (!buffer) BOOST_THROW_EXCEPTION(std::runtime_error("failed to create gbm-kms buffer"));
 }
 
 inline mgg::Cursor::GBMBOWrapper::operator gbm_bo*()
@@ -118,21 +188,60 @@ inline mgg::Cursor::GBMBOWrapper::operator gbm_bo*()
 
 inline mgg::Cursor::GBMBOWrapper::~GBMBOWrapper()
 {
-    if (device)
-        gbm_device_destroy(device);
+    if (back_buffer)
+        gbm_bo_destroy(back_buffer);
     if (buffer)
         gbm_bo_destroy(buffer);
+    if (device)
+        gbm_device_destroy(device);
 }
 
 mgg::Cursor::GBMBOWrapper::GBMBOWrapper(GBMBOWrapper&& from)
-    : device{from.device},
+    : fd{from.fd},
+      device{from.device},
       buffer{from.buffer},
-      current_orientation{from.current_orientation}
+      back_buffer{from.back_buffer},
+      current_orientation{from.current_orientation},
+      image{std::move(from.image)},
+      back_image{std::move(from.back_image)}
 {
     from.buffer = nullptr;
+    from.back_buffer = nullptr;
     from.device = nullptr;
 }
 
+auto mgg::Cursor::GBMBOWrapper::present(
+    std::shared_ptr<PaddedImage const> const& new_image,
+    std::function<void(gbm_bo*, PaddedImage const&)> const& write) -> bool
+{
+    // The padded image cache hands out the same image for the same content, so identity is enough
+    if (image == new_image)
+        return false;
+
+    // Nothing has been displayed from the front buffer yet, so it's safe to write to
+    if (!image)
+    {
+        write(buffer, *new_image);
+        image = new_image;
+        return true;
+    }
+
+    if (back_image != new_image)
+    {
+        if (!back_buffer)
+            back_buffer = gbm_create_cursor_bo_checked(device, fd);
+
+        // Forget the old contents first, in case the write fails part way through
+        back_image.reset();
+        write(back_buffer, *new_image);
+        back_image = new_image;
+    }
+
+    std::swap(buffer, back_buffer);
+    std::swap(image, back_image);
+    return true;
+}
+
 auto mir::graphics::gbm::Cursor::GBMBOWrapper::change_orientation(MirOrientation new_orientation) -> bool
 {
     if (current_orientation == new_orientation)
@@ -188,11 +297,30 @@ void mgg::Cursor::write_buffer_data_locked(
     }
 }
 
-void mgg::Cursor::pad_and_write_image_data_locked(
-    std::lock_guard<std::mutex> const& lg,
-    GBMBOWrapper& buffer)
+auto mgg::Cursor::padded_image_locked(
+    std::lock_guard<std::mutex> const&,
+    MirOrientation orientation,
+    uint32_t buffer_stride,
+    uint32_t buffer_height) -> std::shared_ptr<PaddedImage const>
 {
-    auto const orientation = buffer.orientation();
+    auto const matches = [&](std::shared_ptr<PaddedImage const> const& image)
+        {
+            // The hash only picks out candidates, the pixels are compared to rule out a collision
+            return image->argb8888_hash == argb8888_hash &&
+                image->orientation == orientation &&
+                image->buffer_stride == buffer_stride &&
+                image->buffer_height == buffer_height &&
+                image->size == size &&
+                memcmp(image->argb8888.data(), argb8888.data(), argb8888.size() * sizeof(uint32_t)) == 0;
+        };
+
+    auto const cached = std::find_if(begin(padded_images), end(padded_images), matches);
+    if (cached != end(padded_images))
+    {
+        std::rotate(begin(padded_images), cached, cached + 1);
+        return padded_images.front();
+    }
+
     bool const sideways = orientation == mir_orientation_left || orientation == mir_orientation_right;
 
     auto const min_width  = sideways ? min_buffer_width : min_buffer_height;
@@ -200,101 +328,87 @@ void mgg::Cursor::pad_and_write_image_data_locked(
 
     auto const image_width = std::min(min_width, size.width.as_uint32_t());
     auto const image_height = std::min(min_height, size.height.as_uint32_t());
-    auto const image_stride = size.width.as_uint32_t() * 4;
-
-    auto const buffer_stride = std::max(min_width*4, gbm_bo_get_stride(buffer));  // in bytes
-    auto const buffer_height = std::max(min_height, gbm_bo_get_height(buffer));
-    size_t const padded_size = buffer_stride * buffer_height;
-
-    auto padded = std::unique_ptr<uint8_t[]>(new uint8_t[padded_size]);
-    size_t rhs_padding = buffer_stride - 4*image_width;
-
-    auto const filler = 0; // 0x3f; is useful to make buffer visible for debugging
-    uint8_t const* src = argb8888.data();
-    uint8_t* dest = &padded[0];
-
-    switch (orientation)
-    {
-    case mir_orientation_normal:
-        for (unsigned int y = 0; y < image_height; y++)
-        {
-            memcpy(dest, src, 4*image_width);
-            memset(dest + 4*image_width, filler, rhs_padding);
-            dest += buffer_stride;
-            src += image_stride;
-        }
-
-        memset(dest, 0, buffer_stride * (buffer_height - image_height));
-        break;
-
-    case mir_orientation_inverted:
-        for (unsigned int row = 0; row != image_height; ++row)
-        {
-            memset(dest+row*buffer_stride+4*image_width, filler, rhs_padding);
 
-            for (unsigned int col = 0; col != image_width; ++col)
-            {
-                memcpy(dest+row*buffer_stride+4*col, src + ((image_height-1)-row)*image_stride + 4*((image_width-1)-col), 4);
-            }
-        }
-
-        memset(dest+image_height*buffer_stride, filler, buffer_stride * (buffer_height - image_height));
-        break;
+    auto const image = std::make_shared<PaddedImage>(PaddedImage{
+        size,
+        argb8888,
+        argb8888_hash,
+        orientation,
+        buffer_stride,
+        buffer_height,
+        std::vector<uint32_t>(buffer_stride/4 * buffer_height, filler)});
+
+    rotate_image(
+        argb8888.data(), image_width, image_height, size.width.as_uint32_t(),
+        image->pixels.data(), buffer_stride/4,
+        orientation);
+
+    if (padded_images.size() == max_cached_images)
+        padded_images.pop_back();
+    padded_images.insert(begin(padded_images), image);
+
+    return image;
+}
 
-    case mir_orientation_left:
-        for (unsigned int row = 0; row != image_width; ++row)
-        {
-            memset(dest+row*buffer_stride+4*image_height, filler, rhs_padding);
+auto mgg::Cursor::pad_and_write_image_data_locked(
+    std::lock_guard<std::mutex> const& lg,
+    GBMBOWrapper& buffer) -> bool
+{
+    auto const orientation = buffer.orientation();
+    bool const sideways = orientation == mir_orientation_left || orientation == mir_orientation_right;
 
-            for (unsigned int col = 0; col != image_height; ++col)
-            {
-                memcpy(dest+row*buffer_stride+4*col, src + ((image_width-1)-row)*4 + image_stride*col, 4);
-            }
-        }
+    auto const min_width  = sideways ? min_buffer_width : min_buffer_height;
+    auto const min_height = sideways ? min_buffer_height : min_buffer_width;
 
-        memset(dest+image_width*buffer_stride, filler, buffer_stride * (buffer_height - image_width));
-        break;
+    auto const buffer_stride = std::max(min_width*4, gbm_bo_get_stride(buffer));  // in bytes
+    auto const buffer_height = std::max(min_height, gbm_bo_get_height(buffer));
 
-    case mir_orientation_right:
-        for (unsigned int row = 0; row != image_width; ++row)
+    return buffer.present(
+        padded_image_locked(lg, orientation, buffer_stride, buffer_height),
+        [&](gbm_bo* bo, PaddedImage const& image)
         {
-            memset(dest+row*buffer_stride+4*image_height, filler, rhs_padding);
-
-            for (unsigned int col = 0; col != image_height; ++col)
-            {
-                memcpy(dest+row*buffer_stride+4*col, src + row*4 + image_stride*((image_height-1)-col), 4);
-            }
-        }
-
-        memset(dest+image_width*buffer_stride, filler, buffer_stride * (buffer_height - image_width));
-        break;
-    }
-
-    write_buffer_data_locked(lg, buffer, &padded[0], padded_size);
+            write_buffer_data_locked(lg, bo, image.pixels.data(), image.pixels.size() * sizeof(uint32_t));
+        });
 }
 
 void mgg::Cursor::show(CursorImage const& cursor_image)
 {
     std::lock_guard lg(guard);
 
-    size = cursor_image.size();
+    auto const new_size = cursor_image.size();
+    auto const pixels = static_cast<char const*>(cursor_image.as_argb_8888());
+    auto const bytes = new_size.width.as_uint32_t() * new_size.height.as_uint32_t() * sizeof(uint32_t);
 
-    argb8888.resize(size.width.as_uint32_t() * size.height.as_uint32_t() * 4);
-    memcpy(argb8888.data(), cursor_image.as_argb_8888(), argb8888.size());
+    // Animated cursors are often re-sent unchanged, so only take a copy of the image (which we
+    // need to lay it out again on rotation or hotplug) when it differs from the current one.
+    // A matching hash is confirmed against the copy, so a collision can't leave a stale image.
+    auto const new_hash = std::hash<std::string_view>{}({pixels, bytes});
+    if (new_hash != argb8888_hash || new_size != size || memcmp(pixels, argb8888.data(), bytes) != 0)
+    {
+        size = new_size;
+        argb8888.resize(bytes / sizeof(uint32_t));
+        memcpy(argb8888.data(), pixels, bytes);
+        argb8888_hash = new_hash;
+    }
 
     hotspot = cursor_image.hotspot();
+    bool buffers_changed = false;
     {
         auto locked_buffers = buffers.lock();
         for (auto& tuple : *locked_buffers)
         {
-            pad_and_write_image_data_locked(lg, std::get<2>(tuple));
+            if (pad_and_write_image_data_locked(lg, std::get<2>(tuple)))
+                buffers_changed = true;
         }
     }
 
     // Writing the data could throw an exception so let's
     // hold off on setting visible until after we have succeeded.
-    visible = true;
-    place_cursor_at_locked(lg, current_position, ForceState);
+    auto const was_visible = std::exchange(visible, true);
+
+    // If the displayed buffers are unchanged only the hotspot (and so the position) can need updating
+    auto const force_state = buffers_changed || !was_visible || last_set_failed ? ForceState : UpdateState;
+    place_cursor_at_locked(lg, current_position, force_state);
 }
 
 void mgg::Cursor::move_to(geometry::Point position)
@@ -407,10 +521,11 @@ void mgg::Cursor::place_cursor_at_locked(
 
             auto const changed_orientation = buffer.change_orientation(orientation);
 
-            if (changed_orientation)
-                pad_and_write_image_data_locked(lg, buffer);
+            // A buffer needs (re-)laying out when rotated, or when new (the output was hotplugged)
+            auto const changed_buffer =
+                (changed_orientation || buffer.empty()) && pad_and_write_image_data_locked(lg, buffer);
 
-            if (force_state || !output.has_cursor() || changed_orientation)
+            if (force_state || !output.has_cursor() || changed_buffer)
             {
                 if (!output.set_cursor(buffer) || !output.has_cursor())
                     set_on_all_outputs = false;
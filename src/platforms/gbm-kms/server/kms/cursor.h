@@ -80,6 +80,7 @@ public:
 private:
     enum ForceCursorState { UpdateState, ForceState };
     struct GBMBOWrapper;
+    struct PaddedImage;
     void for_each_used_output(std::function<void(KMSOutput& output, DisplayConfigurationOutput const& conf)> const& f);
     void place_cursor_at(geometry::Point position, ForceCursorState force_state);
     void place_cursor_at_locked(std::lock_guard<std::mutex> const&, geometry::Point position, ForceCursorState force_state);
@@ -88,9 +89,14 @@ private:
         gbm_bo* buffer,
         void const* data,
         size_t count);
-    void pad_and_write_image_data_locked(
+    auto pad_and_write_image_data_locked(
         std::lock_guard<std::mutex> const&,
-        GBMBOWrapper& buffer);
+        GBMBOWrapper& buffer) -> bool;
+    auto padded_image_locked(
+        std::lock_guard<std::mutex> const&,
+        MirOrientation orientation,
+        uint32_t buffer_stride,
+        uint32_t buffer_height) -> std::shared_ptr<PaddedImage const>;
     void clear(std::lock_guard<std::mutex> const&);
 
     GBMBOWrapper& buffer_for_output(KMSOutput const& output);
@@ -101,11 +107,31 @@ private:
     geometry::Point current_position;
     geometry::Displacement hotspot;
     geometry::Size size;
-    std::vector<uint8_t> argb8888;
+    std::vector<uint32_t> argb8888;
+    size_t argb8888_hash{0};
+
+    /// A cursor image laid out (padded and rotated) for a particular buffer geometry
+    struct PaddedImage
+    {
+        geometry::Size size;
+        std::vector<uint32_t> argb8888;
+        size_t argb8888_hash;
+        MirOrientation orientation;
+        uint32_t buffer_stride;
+        uint32_t buffer_height;
+        std::vector<uint32_t> pixels;
+    };
+
+    /// Recently used cursor images, most recently used first. Switching between a
+    /// handful of cursor shapes (or orientations) then only costs a BO write.
+    std::vector<std::shared_ptr<PaddedImage const>> padded_images;
 
     bool visible;
     bool last_set_failed;
 
+    /// A pair of cursor buffers for an output. The front buffer is the one to display; a new
+    /// image is written to the back buffer (so the displayed one is never written to) which
+    /// then becomes the front. The back buffer is only created once the image first changes.
     struct GBMBOWrapper
     {
         GBMBOWrapper(int fd, MirOrientation orientation);
@@ -114,13 +140,25 @@ private:
         auto orientation() const -> MirOrientation { return current_orientation; }
         auto change_orientation(MirOrientation new_orientation) -> bool;
 
+        /// Makes the front buffer hold \a image, writing it to the back buffer unless one already holds it.
+        /// \returns whether the front buffer changed
+        auto present(
+            std::shared_ptr<PaddedImage const> const& image,
+            std::function<void(gbm_bo*, PaddedImage const&)> const& write) -> bool;
+        /// Whether no image has been written yet
+        auto empty() const -> bool { return !image; }
+
         ~GBMBOWrapper();
 
         GBMBOWrapper(GBMBOWrapper&& from);
     private:
+        int fd;
         gbm_device* device;
         gbm_bo* buffer;
+        gbm_bo* back_buffer{nullptr};
         MirOrientation current_orientation;
+        std::shared_ptr<PaddedImage const> image;
+        std::shared_ptr<PaddedImage const> back_image;
         GBMBOWrapper(GBMBOWrapper const&) = delete;
         GBMBOWrapper& operator=(GBMBOWrapper const&) = delete;
     };
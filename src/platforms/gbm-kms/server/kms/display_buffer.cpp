@@ -591,6 +591,14 @@ void mgg::DisplayBuffer::post()
      */
     wait_for_page_flip();
 
+    /*
+     * This post's frame is only known once its flip completes, which
+     * wait_for_page_flip() records below. Until then (SetCrtc, or a wait
+     * deferred to the next post) report it as now with no MSC rather
+     * than pass off the previous flip's hardware timestamp.
+     */
+    posted_frame = Frame{0, Frame::Timestamp::now(CLOCK_MONOTONIC)};
+
     std::shared_ptr<mgg::FBHandle const> bufobj;
     if (bypass_buf)
     {
@@ -687,6 +695,18 @@ std::chrono::milliseconds mgg::DisplayBuffer::recommended_sleep() const
     return recommend_sleep;
 }
 
+mg::Frame mgg::DisplayBuffer::last_frame() const
+{
+    return posted_frame;
+}
+
+mg::Frame mgg::DisplayBuffer::wait_for_last_frame()
+{
+    // In clone mode post() leaves this to the next post(), doing it now just brings it forward
+    wait_for_page_flip();
+    return posted_frame;
+}
+
 bool mgg::DisplayBuffer::schedule_page_flip(FBHandle const& bufobj)
 {
     /*
@@ -706,9 +726,20 @@ void mgg::DisplayBuffer::wait_for_page_flip()
 {
     if (page_flips_pending)
     {
+        // The content is on screen once the last of the clones has flipped
+        Frame flipped;
         for (auto& output : outputs)
+        {
             output->wait_for_page_flip();
 
+            auto const frame = output->last_frame();
+            if (frame.msc == 0 || (flipped.msc != 0 && frame.ust <= flipped.ust))
+                continue;
+            flipped = frame;
+        }
+        if (flipped.msc != 0)
+            posted_frame = flipped;
+
         // The previously-scheduled FB has been page-flipped, and is now visible
         visible_fb = std::move(scheduled_fb);
         scheduled_fb = nullptr;
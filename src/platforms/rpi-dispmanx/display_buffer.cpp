@@ -276,11 +276,14 @@ bool mg::rpi::DisplayBuffer::overlay(mg::RenderableList const& renderlist)
             renderable->screen_position().size.height.as_uint32_t());
 
         // …but source rect coödinates are in 16.16 fixed point.
+        auto const src_bounds = renderable->src_bounds();
+        auto const to_fixed = [](double value) { return static_cast<uint32_t>(value * (1 << 16)); };
         vc_dispmanx_rect_set(
             &src_rect,
-            0, 0,
-            renderable->buffer()->size().width.as_uint32_t() << 16,
-            renderable->buffer()->size().height.as_uint32_t() << 16);
+            to_fixed(src_bounds.top_left.x.as_value()),
+            to_fixed(src_bounds.top_left.y.as_value()),
+            to_fixed(src_bounds.size.width.as_value()),
+            to_fixed(src_bounds.size.height.as_value()));
 
         VC_DISPMANX_ALPHA_T alpha_flags = {
             static_cast<DISPMANX_FLAGS_ALPHA_T>(DISPMANX_FLAGS_ALPHA_FROM_SOURCE | DISPMANX_FLAGS_ALPHA_MIX),
@@ -18,26 +18,25 @@
 #include "mir/renderer/gl/context.h"
 #include "mir/renderer/sw/pixel_source.h"
 #include "mir/graphics/egl_error.h"
+#include "mir/graphics/egl_extensions.h"
+#include "mir/graphics/dmabuf_buffer.h"
 
 #include <boost/throw_exception.hpp>
 #include <GLES2/gl2ext.h>
+#include <drm_fourcc.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <system_error>
 
 namespace mg = mir::graphics;
 namespace mrg = mir::renderer::gl;
 namespace mrs = mir::renderer::software;
 
-mrg::BasicBufferRenderTarget::Framebuffer::Framebuffer(geometry::Size const& size)
-    : size{size}
+namespace
+{
+void check_framebuffer_complete()
 {
-    glGenRenderbuffers(1, &colour_buffer);
-    glGenFramebuffers(1, &fbo);
-
-    glBindRenderbuffer(GL_RENDERBUFFER, colour_buffer);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8_OES, size.width.as_int(), size.height.as_int());
-
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colour_buffer);
-
     auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
     if (status != GL_FRAMEBUFFER_COMPLETE)
     {
@@ -69,10 +68,69 @@ mrg::BasicBufferRenderTarget::Framebuffer::Framebuffer(geometry::Size const& siz
             std::runtime_error{
                 std::string{"Unknown GL framebuffer error code: "} + std::to_string(status)}));
     }
+}
+
+struct EGLPlaneAttribs
+{
+    EGLint fd, offset, pitch, modifier_lo, modifier_hi;
+};
+
+EGLPlaneAttribs const egl_plane_attribs[] = {
+    {
+        EGL_DMA_BUF_PLANE0_FD_EXT,
+        EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE0_PITCH_EXT,
+        EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT
+    },
+    {
+        EGL_DMA_BUF_PLANE1_FD_EXT,
+        EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE1_PITCH_EXT,
+        EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT
+    },
+    {
+        EGL_DMA_BUF_PLANE2_FD_EXT,
+        EGL_DMA_BUF_PLANE2_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE2_PITCH_EXT,
+        EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT
+    },
+    {
+        EGL_DMA_BUF_PLANE3_FD_EXT,
+        EGL_DMA_BUF_PLANE3_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE3_PITCH_EXT,
+        EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT
+    },
+};
 
-    // gl::Renderer can only set glViewport if there is a current EGL surface to get the size from. Since we don't bind
-    // an EGL surface when rendering to a buffer, we have to set the viewport ourselves.
-    glViewport(0, 0, size.width.as_int(), size.height.as_int());
+/// Identifies the memory behind a dmabuf, which (unlike its fd) is the same every time a buffer is sent
+auto inode_of(mg::DMABufBuffer const& buffer) -> ino_t
+{
+    struct stat info;
+    if (buffer.planes().empty() || fstat(buffer.planes().front().dma_buf, &info) != 0)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to stat dmabuf"}));
+    }
+    return info.st_ino;
+}
+}
+
+mrg::BasicBufferRenderTarget::Framebuffer::Framebuffer(geometry::Size const& size)
+    : size{size}
+{
+    glGenRenderbuffers(1, &colour_buffer);
+    glGenFramebuffers(1, &fbo);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, colour_buffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8_OES, size.width.as_int(), size.height.as_int());
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colour_buffer);
+
+    check_framebuffer_complete();
 }
 
 mrg::BasicBufferRenderTarget::Framebuffer::~Framebuffer()
@@ -81,7 +139,9 @@ mrg::BasicBufferRenderTarget::Framebuffer::~Framebuffer()
     glDeleteRenderbuffers(1, &colour_buffer);
 }
 
-void mrg::BasicBufferRenderTarget::Framebuffer::copy_to(software::WriteMappableBuffer& buffer)
+void mrg::BasicBufferRenderTarget::Framebuffer::copy_to(
+    software::WriteMappableBuffer& buffer,
+    geometry::Rectangle const& region)
 {
     glBindFramebuffer(GL_FRAMEBUFFER, fbo);
     auto mapping = buffer.map_writeable();
@@ -97,10 +157,29 @@ void mrg::BasicBufferRenderTarget::Framebuffer::copy_to(software::WriteMappableB
     {
         BOOST_THROW_EXCEPTION(std::logic_error("invalid pixel format " + std::to_string(mapping->format())));
     }
-    glReadPixels(
-        0, 0,
-        size.width.as_int(), size.height.as_int(),
-        GL_BGRA_EXT, GL_UNSIGNED_BYTE, mapping->data());
+
+    auto const width = region.size.width.as_int();
+    auto const height = region.size.height.as_int();
+    auto const stride = mapping->stride().as_int();
+    // Rows are read bottom-up, so the buffer ends up bottom-up too and the region's rows are counted from its bottom
+    auto const first_row = size.height.as_int() - region.top_left.y.as_int() - height;
+    auto const dest = reinterpret_cast<unsigned char*>(mapping->data()) +
+        first_row * stride + region.top_left.x.as_int() * 4;
+
+    if (width == size.width.as_int())
+    {
+        glReadPixels(0, 0, width, height, GL_BGRA_EXT, GL_UNSIGNED_BYTE, dest);
+    }
+    else
+    {
+        // GLES2 can't read into a sub-rectangle of a larger image, so go via staging memory
+        staging.resize(width * height * 4);
+        glReadPixels(0, 0, width, height, GL_BGRA_EXT, GL_UNSIGNED_BYTE, staging.data());
+        for (auto row = 0; row != height; ++row)
+        {
+            std::copy_n(staging.data() + row * width * 4, width * 4, dest + row * stride);
+        }
+    }
 }
 
 void mrg::BasicBufferRenderTarget::Framebuffer::bind()
@@ -108,27 +187,191 @@ void mrg::BasicBufferRenderTarget::Framebuffer::bind()
     glBindFramebuffer(GL_FRAMEBUFFER, fbo);
 }
 
+class mrg::BasicBufferRenderTarget::ImportedFramebuffer
+{
+public:
+    ImportedFramebuffer(mg::EGLExtensions const& extensions, mg::DMABufBuffer const& buffer)
+        : size{buffer.size()},
+          dpy{eglGetCurrentDisplay()},
+          extensions{extensions.base(dpy)}
+    {
+        if (!this->extensions.glEGLImageTargetRenderbufferStorageOES)
+        {
+            BOOST_THROW_EXCEPTION((std::runtime_error{"GL driver can't render to an EGLImage"}));
+        }
+
+        std::vector<EGLint> attributes{
+            EGL_WIDTH, size.width.as_int(),
+            EGL_HEIGHT, size.height.as_int(),
+            EGL_LINUX_DRM_FOURCC_EXT, static_cast<EGLint>(buffer.drm_fourcc())};
+        auto const& planes = buffer.planes();
+        for (auto i = 0u; i < planes.size() && i < std::size(egl_plane_attribs); ++i)
+        {
+            auto const& names = egl_plane_attribs[i];
+            attributes.insert(end(attributes), {
+                names.fd, static_cast<int>(planes[i].dma_buf),
+                names.offset, static_cast<EGLint>(planes[i].offset),
+                names.pitch, static_cast<EGLint>(planes[i].stride)});
+            if (auto const modifier = buffer.modifier(); modifier && modifier.value() != DRM_FORMAT_MOD_INVALID)
+            {
+                attributes.insert(end(attributes), {
+                    names.modifier_lo, static_cast<EGLint>(modifier.value() & 0xFFFFFFFF),
+                    names.modifier_hi, static_cast<EGLint>(modifier.value() >> 32)});
+            }
+        }
+        attributes.push_back(EGL_NONE);
+
+        image = this->extensions.eglCreateImageKHR(
+            dpy,
+            EGL_NO_CONTEXT,
+            EGL_LINUX_DMA_BUF_EXT,
+            nullptr,
+            attributes.data());
+        if (image == EGL_NO_IMAGE_KHR)
+        {
+            BOOST_THROW_EXCEPTION((mg::egl_error("Failed to import dmabuf to render into")));
+        }
+
+        glGenRenderbuffers(1, &colour_buffer);
+        glGenFramebuffers(1, &fbo);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, colour_buffer);
+        this->extensions.glEGLImageTargetRenderbufferStorageOES(GL_RENDERBUFFER, image);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colour_buffer);
+
+        try
+        {
+            check_framebuffer_complete();
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    ~ImportedFramebuffer()
+    {
+        release();
+    }
+
+    void bind()
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    }
+
+    geometry::Size const size;
+
+private:
+    ImportedFramebuffer(ImportedFramebuffer const&) = delete;
+    ImportedFramebuffer& operator=(ImportedFramebuffer const&) = delete;
+
+    void release()
+    {
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteRenderbuffers(1, &colour_buffer);
+        extensions.eglDestroyImageKHR(dpy, image);
+    }
+
+    EGLDisplay const dpy;
+    mg::EGLExtensions::BaseExtensions const& extensions;
+    EGLImageKHR image;
+    GLuint colour_buffer;
+    GLuint fbo;
+};
+
 mrg::BasicBufferRenderTarget::BasicBufferRenderTarget(std::shared_ptr<Context> const& ctx)
     : ctx{ctx}
 {
 }
 
+mrg::BasicBufferRenderTarget::~BasicBufferRenderTarget() = default;
+
 void mrg::BasicBufferRenderTarget::set_buffer(std::shared_ptr<software::WriteMappableBuffer> const& buffer)
 {
+    set_buffer_region(buffer, {{}, buffer->size()});
+}
+
+void mrg::BasicBufferRenderTarget::set_buffer_region(
+    std::shared_ptr<software::WriteMappableBuffer> const& buffer,
+    geometry::Rectangle const& region)
+{
+    if (!geometry::Rectangle{{}, buffer->size()}.contains(region))
+    {
+        BOOST_THROW_EXCEPTION(std::logic_error("region is not within the buffer"));
+    }
+
+    auto const previous_size = size();
+    gpu_buffer.reset();
     this->buffer = buffer;
-    if (framebuffer && framebuffer->size == buffer->size())
+    this->region = region;
+    bool const reallocate = !framebuffer || framebuffer->size != buffer->size();
+    if (reallocate)
     {
-        return;
+        framebuffer.reset();
+        framebuffer.emplace(buffer->size());
+    }
+
+    if (reallocate || size() != previous_size)
+    {
+        // gl::Renderer can only set glViewport if there is a current EGL surface to get the size from. Since we don't
+        // bind an EGL surface when rendering to a buffer, we have to set the viewport ourselves. Only the region is
+        // rendered, into the corner of the framebuffer at its origin.
+        glViewport(0, 0, region.size.width.as_int(), region.size.height.as_int());
+    }
+}
+
+void mrg::BasicBufferRenderTarget::set_gpu_buffer(std::shared_ptr<graphics::Buffer> const& buffer)
+{
+    auto const dmabuf = dynamic_cast<mg::DMABufBuffer*>(buffer->native_buffer_base());
+    if (!dmabuf)
+    {
+        BOOST_THROW_EXCEPTION(std::logic_error("GPU buffer is not a dmabuf"));
+    }
+
+    auto const previous_size = size();
+    auto const inode = inode_of(*dmabuf);
+    auto imported = std::find_if(
+        begin(imported_framebuffers),
+        end(imported_framebuffers),
+        [&](auto const& entry){ return entry.first == inode; });
+    if (imported == end(imported_framebuffers))
+    {
+        if (imported_framebuffers.size() >= 4)
+        {
+            imported_framebuffers.erase(begin(imported_framebuffers));
+        }
+        if (!egl_extensions)
+        {
+            egl_extensions = std::make_shared<mg::EGLExtensions>();
+        }
+        imported_framebuffers.emplace_back(inode, std::make_unique<ImportedFramebuffer>(*egl_extensions, *dmabuf));
+    }
+    else
+    {
+        std::rotate(imported, std::next(imported), end(imported_framebuffers));
+    }
+
+    this->buffer.reset();
+    gpu_buffer = buffer;
+
+    if (size() != previous_size)
+    {
+        glViewport(0, 0, size().width.as_int(), size().height.as_int());
     }
-    framebuffer.reset();
-    framebuffer.emplace(buffer->size());
 }
 
 auto mrg::BasicBufferRenderTarget::size() const -> geometry::Size
 {
-    if (framebuffer)
+    if (gpu_buffer)
+    {
+        return imported_framebuffers.back().second->size;
+    }
+    else if (framebuffer)
     {
-        return framebuffer.value().size;
+        return region.size;
     }
     else
     {
@@ -148,15 +391,26 @@ void mrg::BasicBufferRenderTarget::release_current()
 
 void mrg::BasicBufferRenderTarget::swap_buffers()
 {
+    if (gpu_buffer)
+    {
+        // The rendering is done once the buffer is handed back, so make sure it has landed
+        glFinish();
+        return;
+    }
     if (!framebuffer || !buffer)
     {
         BOOST_THROW_EXCEPTION(std::logic_error("swap_buffers() called when buffer unset"));
     }
-    framebuffer->copy_to(*buffer);
+    framebuffer->copy_to(*buffer, region);
 }
 
 void mrg::BasicBufferRenderTarget::bind()
 {
+    if (gpu_buffer)
+    {
+        imported_framebuffers.back().second->bind();
+        return;
+    }
     if (!framebuffer)
     {
         BOOST_THROW_EXCEPTION(std::logic_error("bind() called without framebuffer"));
@@ -19,6 +19,7 @@
 #include "mir/compositor/buffer_stream.h"
 #include "mir/graphics/renderable.h"
 #include "mir/graphics/buffer.h"
+#include "mir/graphics/solid_colour_buffer.h"
 #include "mir/graphics/display_buffer.h"
 #include "mir/gl/tessellation_helpers.h"
 #include "mir/log.h"
@@ -35,6 +36,8 @@
 
 #include <boost/throw_exception.hpp>
 #include <stdexcept>
+#include <limits>
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include <mutex>
@@ -146,6 +149,15 @@ const GLchar* const vertex_shader_src =
     "   v_texcoord = texcoord;\n"
     "}\n"
 };
+
+/// Solid colour buffers have no texture, so their "sampling" is just the colour uniform
+const GLchar* const solid_colour_fragment_src =
+{
+    "uniform vec4 colour;\n"
+    "vec4 sample_to_rgba(in vec2 texcoord) {\n"
+    "    return colour;\n"
+    "}\n"
+};
 }
 
 class mrg::Renderer::ProgramFactory : public mir::graphics::gl::ProgramFactory
@@ -300,6 +312,7 @@ mrg::Renderer::Program::Program(GLuint program_id)
     transform_uniform = glGetUniformLocation(id, "transform");
     screen_to_gl_coords_uniform = glGetUniformLocation(id, "screen_to_gl_coords");
     alpha_uniform = glGetUniformLocation(id, "alpha");
+    colour_uniform = glGetUniformLocation(id, "colour");
 }
 
 mrg::Renderer::Renderer(RenderTarget& render_target)
@@ -366,8 +379,50 @@ mrg::Renderer::~Renderer()
 void mrg::Renderer::tessellate(std::vector<mgl::Primitive>& primitives,
                                 mg::Renderable const& renderable) const
 {
-    primitives.resize(1);
-    primitives[0] = mgl::tessellate_renderable_into_rectangle(renderable, geom::Displacement{0,0});
+    primitives.clear();
+
+    // With window translucency nothing can be drawn without blending. (Unshaped
+    // renderables are drawn unblended anyway, so splitting them is harmless.)
+    std::vector<geom::Rectangle> opaque_region;
+    if (renderable.alpha() == 1.0f)
+        opaque_region = renderable.opaque_region();
+
+    auto const texture = std::dynamic_pointer_cast<mg::gl::Texture>(renderable.buffer());
+    bool const flipped = texture && texture->layout() == mg::gl::Texture::Layout::TopRowFirst;
+    if (flipped)
+    {
+        // draw() flips these textures by mirroring the geometry, so the content
+        // of each cell comes from the mirror image of where it is tessellated.
+        auto const& rect = renderable.screen_position();
+        for (auto& opaque : opaque_region)
+        {
+            opaque.top_left.y = rect.top() + (rect.bottom() - opaque.bottom());
+        }
+    }
+
+    mgl::tessellate_renderable_by_opacity(primitives, renderable, geom::Displacement{0,0}, opaque_region);
+
+    if (flipped)
+    {
+        // Likewise a source crop of [top, bottom] has to sample [1-bottom, 1-top]
+        auto tex_top = std::numeric_limits<GLfloat>::max();
+        auto tex_bottom = std::numeric_limits<GLfloat>::lowest();
+        for (auto const& p : primitives)
+        {
+            for (auto i = 0; i != p.nvertices; ++i)
+            {
+                tex_top = std::min(tex_top, p.vertices[i].texcoord[1]);
+                tex_bottom = std::max(tex_bottom, p.vertices[i].texcoord[1]);
+            }
+        }
+
+        auto const shift = 1.0f - tex_top - tex_bottom;
+        for (auto& p : primitives)
+        {
+            for (auto i = 0; i != p.nvertices; ++i)
+                p.vertices[i].texcoord[1] += shift;
+        }
+    }
 }
 
 void mrg::Renderer::render(mg::RenderableList const& renderables) const
@@ -408,17 +463,22 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
         );
     }
 
+    auto const solid_colour = std::dynamic_pointer_cast<mg::SolidColourBuffer>(renderable.buffer());
     auto const texture = std::dynamic_pointer_cast<mg::gl::Texture>(renderable.buffer());
-    if (!texture)
+    if (!texture && !solid_colour)
     {
         mir::log_error("Buffer does not support GL rendering!");
         return;
     }
 
     auto const& prog =
-        [this, &texture](bool alpha) -> Program const&
+        [this, &texture, &solid_colour](bool alpha) -> Program const&
         {
-                auto const& family = static_cast<::Program const&>(texture->shader(*program_factory));
+                static int const solid_colour_shader_id{0};
+                auto const& family = static_cast<::Program const&>(
+                    solid_colour ?
+                        program_factory->compile_fragment_shader(&solid_colour_shader_id, "", solid_colour_fragment_src) :
+                        texture->shader(*program_factory));
                 if (alpha)
                 {
                     return family.alpha;
@@ -454,7 +514,7 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
     glUniform2f(prog.centre_uniform, centrex, centrey);
 
     glm::mat4 transform = renderable.transformation();
-    if (texture->layout() == mg::gl::Texture::Layout::TopRowFirst)
+    if (texture && texture->layout() == mg::gl::Texture::Layout::TopRowFirst)
     {
         // GL textures have (0,0) at bottom-left rather than top-left
         // We have to invert this texture to get it the way up GL expects.
@@ -472,8 +532,13 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
     if (prog.alpha_uniform >= 0)
         glUniform1f(prog.alpha_uniform, renderable.alpha());
 
+    if (solid_colour && prog.colour_uniform >= 0)
+        glUniform4fv(prog.colour_uniform, 1, solid_colour->colour().data());
+
+    // The solid colour shader ignores texcoord, so the compiler may drop the attribute
     glEnableVertexAttribArray(prog.position_attr);
-    glEnableVertexAttribArray(prog.texcoord_attr);
+    if (prog.texcoord_attr >= 0)
+        glEnableVertexAttribArray(prog.texcoord_attr);
 
     primitives.clear();
     tessellate(primitives, renderable);
@@ -513,14 +578,23 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
             BlendSeparate blend;
 
             blend = client_blend;
-            texture->bind();
+            if (p.opaque)  // Translucent format, but the client says these texels are opaque
+            {
+                blend = {GL_ONE,  GL_ZERO,
+                         GL_ZERO, GL_ONE};
+            }
+            if (texture)
+                texture->bind();
 
             glVertexAttribPointer(prog.position_attr, 3, GL_FLOAT,
                                   GL_FALSE, sizeof(mgl::Vertex),
                                   &p.vertices[0].position);
-            glVertexAttribPointer(prog.texcoord_attr, 2, GL_FLOAT,
-                                  GL_FALSE, sizeof(mgl::Vertex),
-                                  &p.vertices[0].texcoord);
+            if (prog.texcoord_attr >= 0)
+            {
+                glVertexAttribPointer(prog.texcoord_attr, 2, GL_FLOAT,
+                                      GL_FALSE, sizeof(mgl::Vertex),
+                                      &p.vertices[0].texcoord);
+            }
 
             if (blend.dst_rgb == GL_ZERO)
             {
@@ -536,7 +610,8 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
             glDrawArrays(p.type, 0, p.nvertices);
 
             // We're done with the texture for now
-            texture->add_syncpoint();
+            if (texture)
+                texture->add_syncpoint();
         }
     }
     catch (std::exception const& ex)
@@ -544,7 +619,8 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
         report_exception();
     }
 
-    glDisableVertexAttribArray(prog.texcoord_attr);
+    if (prog.texcoord_attr >= 0)
+        glDisableVertexAttribArray(prog.texcoord_attr);
     glDisableVertexAttribArray(prog.position_attr);
     if (renderable.clip_area())
     {
@@ -82,6 +82,7 @@ public:
         GLint transform_uniform = -1;
         GLint screen_to_gl_coords_uniform = -1;
         GLint alpha_uniform = -1;
+        GLint colour_uniform = -1;
         mutable long long last_used_frameno = 0;
 
         Program(GLuint program_id);
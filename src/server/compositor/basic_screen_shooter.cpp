@@ -20,10 +20,13 @@
 #include "mir/renderer/gl/context.h"
 #include "mir/compositor/scene_element.h"
 #include "mir/compositor/scene.h"
+#include "mir/compositor/compositor_report.h"
+#include "mir/scene/scene_change_notification.h"
 #include "mir/log.h"
 #include "mir/executor.h"
 
 namespace mc = mir::compositor;
+namespace ms = mir::scene;
 namespace mr = mir::renderer;
 namespace mg = mir::graphics;
 namespace mrg = mir::renderer::gl;
@@ -33,21 +36,85 @@ namespace geom = mir::geometry;
 mc::BasicScreenShooter::Self::Self(
     std::shared_ptr<Scene> const& scene,
     std::shared_ptr<time::Clock> const& clock,
+    std::shared_ptr<CompositorReport> const& report,
     std::unique_ptr<mrg::BufferRenderTarget>&& render_target,
     std::unique_ptr<mr::Renderer>&& renderer)
     : scene{scene},
       render_target{std::move(render_target)},
       renderer{std::move(renderer)},
-      clock{clock}
+      clock{clock},
+      report{report}
 {
 }
 
 auto mc::BasicScreenShooter::Self::render(
     std::shared_ptr<mrs::WriteMappableBuffer> const& buffer,
+    geom::Rectangle const& area,
+    std::optional<geom::Rectangle> const& stale_area) -> time::Timestamp
+{
+    // Only a buffer at the scale of the scene can be partially updated, otherwise stale pixels would not line up
+    // with whole logical pixels
+    bool const partial = stale_area && buffer->size() == area.size;
+    auto const update = partial ? intersection_of(stale_area.value(), area) : area;
+    if (partial && update.size == geom::Size{})
+    {
+        // Nothing the buffer holds is out of date
+        report->captured_area(area, std::chrono::nanoseconds{0}, false);
+        return clock->now();
+    }
+
+    std::lock_guard lock{mutex};
+    auto const start = clock->now();
+
+    if (partial)
+    {
+        // The framebuffer will only hold part of the area afterwards
+        last_render.reset();
+        auto const captured_time = render_scene(update, [&]()
+            {
+                render_target->set_buffer_region(buffer, {as_point(update.top_left - area.top_left), update.size});
+            });
+        report->captured_area(area, clock->now() - start, true);
+        return captured_time;
+    }
+
+    auto const generation = scene_generation.load();
+    if (last_render &&
+        last_render->area == area &&
+        last_render->buffer_size == buffer->size() &&
+        last_render->scene_generation == generation)
+    {
+        // Nothing has changed since this area was last rendered, so just copy that out again
+        render_target->make_current();
+        render_target->set_buffer(buffer);
+        render_target->swap_buffers();
+        render_target->release_current();
+        report->captured_area(area, clock->now() - start, false);
+        return last_render->captured_time;
+    }
+
+    last_render.reset();
+    auto const captured_time = render_scene(area, [&](){ render_target->set_buffer(buffer); });
+    last_render = LastRender{area, buffer->size(), generation, captured_time};
+    report->captured_area(area, clock->now() - start, true);
+    return captured_time;
+}
+
+auto mc::BasicScreenShooter::Self::render(
+    std::shared_ptr<mg::Buffer> const& buffer,
     geom::Rectangle const& area) -> time::Timestamp
 {
     std::lock_guard lock{mutex};
+    auto const start = clock->now();
+    auto const captured_time = render_scene(area, [&](){ render_target->set_gpu_buffer(buffer); });
+    report->captured_area(area, clock->now() - start, true);
+    return captured_time;
+}
 
+auto mc::BasicScreenShooter::Self::render_scene(
+    geom::Rectangle const& area,
+    std::function<void()> const& set_target) -> time::Timestamp
+{
     auto scene_elements = scene->scene_elements_for(this);
     auto const captured_time = clock->now();
     mg::RenderableList renderable_list;
@@ -59,7 +126,7 @@ auto mc::BasicScreenShooter::Self::render(
     scene_elements.clear();
 
     render_target->make_current();
-    render_target->set_buffer(buffer);
+    set_target();
 
     render_target->bind();
     renderer->set_viewport(area);
@@ -74,28 +141,78 @@ auto mc::BasicScreenShooter::Self::render(
 mc::BasicScreenShooter::BasicScreenShooter(
     std::shared_ptr<Scene> const& scene,
     std::shared_ptr<time::Clock> const& clock,
+    std::shared_ptr<CompositorReport> const& report,
     Executor& executor,
     std::unique_ptr<mrg::BufferRenderTarget>&& render_target,
     std::unique_ptr<mr::Renderer>&& renderer)
-    : self{std::make_shared<Self>(scene, clock, std::move(render_target), std::move(renderer))},
-      executor{executor}
+    : self{std::make_shared<Self>(scene, clock, report, std::move(render_target), std::move(renderer))},
+      executor{executor},
+      scene_observer{[weak_self=std::weak_ptr<Self>{self}]()
+          {
+              auto const bump = [weak_self]()
+                  {
+                      if (auto const self = weak_self.lock())
+                      {
+                          self->scene_generation++;
+                      }
+                  };
+              return std::make_shared<ms::SceneChangeNotification>(
+                  bump,
+                  [bump](int, geom::Rectangle const&){ bump(); });
+          }()}
+{
+    self->scene->add_observer(scene_observer);
+}
+
+mc::BasicScreenShooter::~BasicScreenShooter()
 {
+    self->scene->remove_observer(scene_observer);
 }
 
 void mc::BasicScreenShooter::capture(
     std::shared_ptr<mrs::WriteMappableBuffer> const& buffer,
     geom::Rectangle const& area,
     std::function<void(std::optional<time::Timestamp>)>&& callback)
+{
+    spawn_render(
+        [buffer, area](Self& self){ return self.render(buffer, area, std::nullopt); },
+        std::move(callback));
+}
+
+void mc::BasicScreenShooter::capture_update(
+    std::shared_ptr<mrs::WriteMappableBuffer> const& buffer,
+    geom::Rectangle const& area,
+    geom::Rectangle const& stale_area,
+    std::function<void(std::optional<time::Timestamp>)>&& callback)
+{
+    spawn_render(
+        [buffer, area, stale_area](Self& self){ return self.render(buffer, area, stale_area); },
+        std::move(callback));
+}
+
+void mc::BasicScreenShooter::capture_gpu_buffer(
+    std::shared_ptr<mg::Buffer> const& buffer,
+    geom::Rectangle const& area,
+    std::function<void(std::optional<time::Timestamp>)>&& callback)
+{
+    spawn_render(
+        [buffer, area](Self& self){ return self.render(buffer, area); },
+        std::move(callback));
+}
+
+void mc::BasicScreenShooter::spawn_render(
+    std::function<time::Timestamp(Self&)>&& render,
+    std::function<void(std::optional<time::Timestamp>)>&& callback)
 {
     // TODO: use an atomic to keep track of number of in-flight captures, and error if it's too many
 
-    executor.spawn([weak_self=std::weak_ptr<Self>{self}, buffer, area, callback=std::move(callback)]
+    executor.spawn([weak_self=std::weak_ptr<Self>{self}, render=std::move(render), callback=std::move(callback)]
         {
             if (auto const self = weak_self.lock())
             {
                 try
                 {
-                    callback(self->render(buffer, area));
+                    callback(render(*self));
                     return;
                 }
                 catch (...)
@@ -20,11 +20,16 @@
 #include "mir/compositor/screen_shooter.h"
 #include "mir/time/clock.h"
 
+#include <atomic>
 #include <mutex>
 
 namespace mir
 {
 class Executor;
+namespace scene
+{
+class Observer;
+}
 namespace renderer
 {
 class Renderer;
@@ -36,6 +41,7 @@ class BufferRenderTarget;
 namespace compositor
 {
 class Scene;
+class CompositorReport;
 
 class BasicScreenShooter: public ScreenShooter
 {
@@ -43,36 +49,78 @@ public:
     BasicScreenShooter(
         std::shared_ptr<Scene> const& scene,
         std::shared_ptr<time::Clock> const& clock,
+        std::shared_ptr<CompositorReport> const& report,
         Executor& executor,
         std::unique_ptr<renderer::gl::BufferRenderTarget>&& render_target,
         std::unique_ptr<renderer::Renderer>&& renderer);
+    ~BasicScreenShooter();
 
     void capture(
         std::shared_ptr<renderer::software::WriteMappableBuffer> const& buffer,
         geometry::Rectangle const& area,
         std::function<void(std::optional<time::Timestamp>)>&& callback) override;
 
+    void capture_update(
+        std::shared_ptr<renderer::software::WriteMappableBuffer> const& buffer,
+        geometry::Rectangle const& area,
+        geometry::Rectangle const& stale_area,
+        std::function<void(std::optional<time::Timestamp>)>&& callback) override;
+
+    void capture_gpu_buffer(
+        std::shared_ptr<graphics::Buffer> const& buffer,
+        geometry::Rectangle const& area,
+        std::function<void(std::optional<time::Timestamp>)>&& callback) override;
+
 private:
     struct Self
     {
         Self(
             std::shared_ptr<Scene> const& scene,
             std::shared_ptr<time::Clock> const& clock,
+            std::shared_ptr<CompositorReport> const& report,
             std::unique_ptr<renderer::gl::BufferRenderTarget>&& render_target,
             std::unique_ptr<renderer::Renderer>&& renderer);
 
         auto render(
             std::shared_ptr<renderer::software::WriteMappableBuffer> const& buffer,
+            geometry::Rectangle const& area,
+            std::optional<geometry::Rectangle> const& stale_area) -> time::Timestamp;
+        auto render(
+            std::shared_ptr<graphics::Buffer> const& buffer,
             geometry::Rectangle const& area) -> time::Timestamp;
+        /// Renders area of the scene into whatever set_target() points the render target at. Must hold the mutex.
+        auto render_scene(
+            geometry::Rectangle const& area,
+            std::function<void()> const& set_target) -> time::Timestamp;
 
         std::mutex mutex;
         std::shared_ptr<Scene> const scene;
         std::unique_ptr<renderer::gl::BufferRenderTarget> const render_target;
         std::unique_ptr<renderer::Renderer> const renderer;
         std::shared_ptr<time::Clock> const clock;
+        std::shared_ptr<CompositorReport> const report;
+
+        /// Bumped on every change to the scene
+        std::atomic<uint64_t> scene_generation{0};
+
+        /// What the render target's framebuffer holds, so that several clients capturing the same area each
+        /// compositor frame share a single render
+        struct LastRender
+        {
+            geometry::Rectangle area;
+            geometry::Size buffer_size;
+            uint64_t scene_generation;
+            time::Timestamp captured_time;
+        };
+        std::optional<LastRender> last_render;
     };
+    void spawn_render(
+        std::function<time::Timestamp(Self&)>&& render,
+        std::function<void(std::optional<time::Timestamp>)>&& callback);
+
     std::shared_ptr<Self> const self;
     Executor& executor;
+    std::shared_ptr<scene::Observer> const scene_observer;
 };
 }
 }
@@ -32,6 +32,7 @@
 #include "mir/log.h"
 
 #include "mir/options/configuration.h"
+#include "mir/thread_scheduling_options.h"
 
 namespace mc = mir::compositor;
 namespace ms = mir::scene;
@@ -72,8 +73,9 @@ mir::DefaultServerConfiguration::the_compositor()
     return compositor(
         [this]()
         {
+            auto const options = the_options();
             std::chrono::milliseconds const composite_delay(
-                the_options()->get<int>(options::composite_delay_opt));
+                options->get<int>(options::composite_delay_opt));
 
             return std::make_shared<mc::MultiThreadedCompositor>(
                 the_display(),
@@ -82,7 +84,11 @@ mir::DefaultServerConfiguration::the_compositor()
                 the_shell(),
                 the_compositor_report(),
                 composite_delay,
-                true);
+                true,
+                thread_scheduling_from(
+                    *options,
+                    options::compositor_thread_priority_opt,
+                    options::compositor_thread_cpus_opt));
         });
 }
 
@@ -107,6 +113,7 @@ auto mir::DefaultServerConfiguration::the_screen_shooter() -> std::shared_ptr<co
                 return std::make_shared<compositor::BasicScreenShooter>(
                     the_scene(),
                     the_clock(),
+                    the_compositor_report(),
                     thread_pool_executor,
                     std::move(render_target),
                     std::move(renderer));
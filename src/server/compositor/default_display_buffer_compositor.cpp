@@ -21,6 +21,7 @@
 #include "mir/graphics/renderable.h"
 #include "mir/graphics/display_buffer.h"
 #include "mir/graphics/buffer.h"
+#include "mir/graphics/frame.h"
 #include "mir/renderer/renderer.h"
 #include "occlusion.h"
 
@@ -53,6 +54,8 @@ void mc::DefaultDisplayBufferCompositor::composite(mc::SceneElementSequence&& sc
     {
         element->rendered();
         renderable_list.push_back(element->renderable());
+        if (auto callback = element->presentation_callback())
+            awaiting_presentation.push_back(std::move(callback));
     }
 
     /*
@@ -65,7 +68,8 @@ void mc::DefaultDisplayBufferCompositor::composite(mc::SceneElementSequence&& sc
      */
     scene_elements.clear();  // Those in use are still in renderable_list
 
-    if (display_buffer.overlay(renderable_list))
+    zero_copy = display_buffer.overlay(renderable_list);
+    if (zero_copy)
     {
         report->renderables_in_frame(this, renderable_list);
         renderer->suspend();
@@ -95,3 +99,17 @@ void mc::DefaultDisplayBufferCompositor::composite(mc::SceneElementSequence&& sc
 
     report->finished_frame(this);
 }
+
+auto mc::DefaultDisplayBufferCompositor::awaits_presentation() const -> bool
+{
+    return !awaiting_presentation.empty();
+}
+
+void mc::DefaultDisplayBufferCompositor::frame_presented(mg::Frame const& frame)
+{
+    auto const& view_area = display_buffer.view_area();
+    for (auto const& callback : awaiting_presentation)
+        callback(view_area, frame, zero_copy);
+
+    awaiting_presentation.clear();
+}
@@ -19,7 +19,9 @@
 
 #include "mir/compositor/display_buffer_compositor.h"
 #include "mir/compositor/compositor_report.h"
+#include "mir/compositor/scene_element.h"
 #include <memory>
+#include <vector>
 
 namespace mir
 {
@@ -45,11 +47,16 @@ public:
         std::shared_ptr<CompositorReport> const& report);
 
     void composite(SceneElementSequence&& scene_sequence) override;
+    void frame_presented(graphics::Frame const& frame) override;
+    auto awaits_presentation() const -> bool override;
 
 private:
     graphics::DisplayBuffer& display_buffer;
     std::shared_ptr<renderer::Renderer> const renderer;
     std::shared_ptr<CompositorReport> const report;
+
+    std::vector<SceneElement::PresentationCallback> awaiting_presentation;
+    bool zero_copy{false};
 };
 
 }
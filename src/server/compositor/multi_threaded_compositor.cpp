@@ -31,6 +31,7 @@
 #include "mir/thread_name.h"
 #include "mir/executor.h"
 
+#include <algorithm>
 #include <thread>
 #include <chrono>
 #include <condition_variable>
@@ -56,7 +57,8 @@ public:
         std::shared_ptr<mc::Scene> const& scene,
         std::shared_ptr<DisplayListener> const& display_listener,
         std::chrono::milliseconds fixed_composite_delay,
-        std::shared_ptr<CompositorReport> const& report) :
+        std::shared_ptr<CompositorReport> const& report,
+        mir::ThreadScheduling const& thread_scheduling) :
         compositor_factory{db_compositor_factory},
         group(group),
         scene(scene),
@@ -65,6 +67,7 @@ public:
         force_sleep{fixed_composite_delay},
         display_listener{display_listener},
         report{report},
+        thread_scheduling{thread_scheduling},
         started_future{started.get_future()},
         stopped_future{stopped.get_future()}
     {
@@ -74,6 +77,8 @@ public:
     try
     {
         mir::set_thread_name("Mir/Comp");
+        // The thread is borrowed from the pool, so has its scheduling put back when compositing stops
+        mir::ScopedThreadScheduling const scheduling{thread_scheduling, "compositor"};
         auto const signal_when_stopped = mir::raii::paired_calls(
             [](){},
             [this]()
@@ -148,6 +153,21 @@ public:
                     }
                     group.post();
 
+                    /*
+                     * Where post() returns before the flip (clone mode) the frame
+                     * isn't known yet. Only wait for it if a client asked when its
+                     * content was presented, otherwise keep the deferred wait.
+                     */
+                    auto frame = group.last_frame();
+                    if (frame.msc == 0 &&
+                        std::any_of(compositors.begin(), compositors.end(),
+                            [](auto const& tuple) { return std::get<1>(tuple)->awaits_presentation(); }))
+                    {
+                        frame = group.wait_for_last_frame();
+                    }
+                    for (auto& tuple : compositors)
+                        std::get<1>(tuple)->frame_presented(frame);
+
                     /*
                      * "Predictive bypass" optimization: If the last frame was
                      * bypassed/overlayed or you simply have a fast GPU, it is
@@ -256,6 +276,7 @@ private:
     std::condition_variable run_cv;
     std::shared_ptr<DisplayListener> const display_listener;
     std::shared_ptr<CompositorReport> const report;
+    mir::ThreadScheduling const thread_scheduling;
     std::promise<void> started;
     std::future<void> started_future;
     std::promise<void> stopped;
@@ -274,6 +295,27 @@ mc::MultiThreadedCompositor::MultiThreadedCompositor(
     std::shared_ptr<CompositorReport> const& compositor_report,
     std::chrono::milliseconds fixed_composite_delay,
     bool compose_on_start)
+    : MultiThreadedCompositor(
+        display,
+        scene,
+        db_compositor_factory,
+        display_listener,
+        compositor_report,
+        fixed_composite_delay,
+        compose_on_start,
+        ThreadScheduling{})
+{
+}
+
+mc::MultiThreadedCompositor::MultiThreadedCompositor(
+    std::shared_ptr<mg::Display> const& display,
+    std::shared_ptr<mc::Scene> const& scene,
+    std::shared_ptr<DisplayBufferCompositorFactory> const& db_compositor_factory,
+    std::shared_ptr<DisplayListener> const& display_listener,
+    std::shared_ptr<CompositorReport> const& compositor_report,
+    std::chrono::milliseconds fixed_composite_delay,
+    bool compose_on_start,
+    ThreadScheduling const& thread_scheduling)
     : display{display},
       scene{scene},
       display_buffer_compositor_factory{db_compositor_factory},
@@ -281,7 +323,8 @@ mc::MultiThreadedCompositor::MultiThreadedCompositor(
       report{compositor_report},
       state{CompositorState::stopped},
       fixed_composite_delay{fixed_composite_delay},
-      compose_on_start{compose_on_start}
+      compose_on_start{compose_on_start},
+      thread_scheduling{thread_scheduling}
 {
     observer = std::make_shared<ms::SceneChangeNotification>(
     [this]()
@@ -375,7 +418,7 @@ void mc::MultiThreadedCompositor::create_compositing_threads()
     {
         auto thread_functor = std::make_unique<mc::CompositingFunctor>(
             display_buffer_compositor_factory, group, scene, display_listener,
-            fixed_composite_delay, report);
+            fixed_composite_delay, report, thread_scheduling);
 
         mir::thread_pool_executor.spawn(std::ref(*thread_functor));
         thread_functors.push_back(std::move(thread_functor));
@@ -19,6 +19,7 @@
 
 #include "mir/compositor/compositor.h"
 #include "mir/geometry/forward.h"
+#include "mir/thread_scheduling.h"
 
 #include <mutex>
 #include <memory>
@@ -66,6 +67,16 @@ public:
         std::shared_ptr<CompositorReport> const& compositor_report,
         std::chrono::milliseconds fixed_composite_delay,  // -1 = automatic
         bool compose_on_start);
+    /// As above, but the compositing threads run with thread_scheduling
+    MultiThreadedCompositor(
+        std::shared_ptr<graphics::Display> const& display,
+        std::shared_ptr<Scene> const& scene,
+        std::shared_ptr<DisplayBufferCompositorFactory> const& db_compositor_factory,
+        std::shared_ptr<DisplayListener> const& display_listener,
+        std::shared_ptr<CompositorReport> const& compositor_report,
+        std::chrono::milliseconds fixed_composite_delay,
+        bool compose_on_start,
+        ThreadScheduling const& thread_scheduling);
     ~MultiThreadedCompositor();
 
     void start();
@@ -86,6 +97,7 @@ private:
     std::atomic<CompositorState> state;
     std::chrono::milliseconds fixed_composite_delay;
     bool compose_on_start;
+    ThreadScheduling const thread_scheduling;
 
     void schedule_compositing(int number_composites);
     void schedule_compositing(int number_composites, geometry::Rectangle const& damage) const;
@@ -19,6 +19,7 @@
 #include "mir/executor.h"
 
 namespace mc = mir::compositor;
+namespace mg = mir::graphics;
 namespace mrs = mir::renderer::software;
 namespace geom = mir::geometry;
 
@@ -38,3 +39,20 @@ void mc::NullScreenShooter::capture(
             callback(std::nullopt);
         });
 }
+
+void mc::NullScreenShooter::capture_update(
+    std::shared_ptr<mrs::WriteMappableBuffer> const& buffer,
+    geom::Rectangle const& area,
+    geom::Rectangle const&,
+    std::function<void(std::optional<time::Timestamp>)>&& callback)
+{
+    capture(buffer, area, std::move(callback));
+}
+
+void mc::NullScreenShooter::capture_gpu_buffer(
+    std::shared_ptr<mg::Buffer> const&,
+    geom::Rectangle const& area,
+    std::function<void(std::optional<time::Timestamp>)>&& callback)
+{
+    capture(nullptr, area, std::move(callback));
+}
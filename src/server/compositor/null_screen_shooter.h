@@ -36,6 +36,17 @@ public:
         geometry::Rectangle const& area,
         std::function<void(std::optional<time::Timestamp>)>&& callback) override;
 
+    void capture_update(
+        std::shared_ptr<renderer::software::WriteMappableBuffer> const& buffer,
+        geometry::Rectangle const& area,
+        geometry::Rectangle const& stale_area,
+        std::function<void(std::optional<time::Timestamp>)>&& callback) override;
+
+    void capture_gpu_buffer(
+        std::shared_ptr<graphics::Buffer> const& buffer,
+        geometry::Rectangle const& area,
+        std::function<void(std::optional<time::Timestamp>)>&& callback) override;
+
 private:
     Executor& executor;
 };
@@ -14,13 +14,11 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "mir/geometry/rectangle.h"
+#include "mir/geometry/region.h"
 #include "mir/compositor/scene_element.h"
 #include "mir/graphics/renderable.h"
 #include "occlusion.h"
 
-#include <vector>
-
 using namespace mir::geometry;
 using namespace mir::graphics;
 using namespace mir::compositor;
@@ -30,7 +28,7 @@ namespace
 bool renderable_is_occluded(
     Renderable const& renderable, 
     Rectangle const& area,
-    std::vector<Rectangle>& coverage)
+    Region& coverage)
 {
     static glm::mat4 const identity(1);
     static Rectangle const empty{};
@@ -44,19 +42,26 @@ bool renderable_is_occluded(
     if (clipped_window == empty)
         return true;  // Not in the area; definitely occluded.
 
-    bool occluded = false;
-    for (auto const& r : coverage)
+    // The coverage of several windows together can hide one that none of them hides alone
+    bool const occluded = coverage.contains(clipped_window);
+
+    if (!occluded && renderable.alpha() == 1.0f)
     {
-        if (r.contains(clipped_window))
+        if (!renderable.shaped())
+        {
+            coverage.add(clipped_window);
+        }
+        else
         {
-            occluded = true;
-            break;
+            // The client told us which parts of its translucent buffer are opaque
+            Region opaque{renderable.opaque_region()};
+            opaque.intersect(clipped_window);
+            if (auto const clip_area = renderable.clip_area())
+                opaque.intersect(clip_area.value());
+            coverage.add(opaque);
         }
     }
 
-    if (!occluded && renderable.alpha() == 1.0f && !renderable.shaped())
-        coverage.push_back(clipped_window);
-
     return occluded;
 }
 }
@@ -66,7 +71,7 @@ SceneElementSequence mir::compositor::filter_occlusions_from(
     Rectangle const& area)
 {
     SceneElementSequence occluded;
-    std::vector<Rectangle> coverage;
+    Region coverage;
 
     auto it = elements.rbegin();
     while (it != elements.rend())
@@ -41,7 +41,8 @@ mc::Stream::Stream(
     latest_buffer_size(size),
     pf(pf),
     first_frame_posted(false),
-    frame_callback{[](auto){}}
+    frame_callback{[](auto){}},
+    presented_callback{[](auto, auto const&, auto const&, auto){}}
 {
 }
 
@@ -84,6 +85,23 @@ void mc::Stream::set_frame_posted_callback(
     frame_callback = callback;
 }
 
+void mc::Stream::set_frame_presented_callback(
+    std::function<void(mg::BufferID, geom::Rectangle const&, mg::Frame const&, bool)> const& callback)
+{
+    std::lock_guard lock{callback_mutex};
+    presented_callback = callback;
+}
+
+void mc::Stream::frame_presented(
+    mg::BufferID buffer,
+    geom::Rectangle const& output_area,
+    mg::Frame const& frame,
+    bool zero_copy)
+{
+    std::lock_guard lock{callback_mutex};
+    presented_callback(buffer, output_area, frame, zero_copy);
+}
+
 std::shared_ptr<mg::Buffer> mc::Stream::lock_compositor_buffer(void const* id)
 {
     return arbiter->compositor_acquire(id);
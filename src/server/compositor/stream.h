@@ -43,6 +43,17 @@ public:
     MirPixelFormat pixel_format() const override;
     void set_frame_posted_callback(
         std::function<void(geometry::Size const&)> const& callback) override;
+    void set_frame_presented_callback(
+        std::function<void(
+            graphics::BufferID,
+            geometry::Rectangle const&,
+            graphics::Frame const&,
+            bool)> const& callback) override;
+    void frame_presented(
+        graphics::BufferID buffer,
+        geometry::Rectangle const& output_area,
+        graphics::Frame const& frame,
+        bool zero_copy) override;
     std::shared_ptr<graphics::Buffer>
         lock_compositor_buffer(void const* user_id) override;
     geometry::Size stream_size() override;
@@ -68,6 +79,8 @@ private:
 
     std::mutex callback_mutex;
     std::function<void(geometry::Size const&)> frame_callback;
+    std::function<void(graphics::BufferID, geometry::Rectangle const&, graphics::Frame const&, bool)>
+        presented_callback;
 };
 }
 }
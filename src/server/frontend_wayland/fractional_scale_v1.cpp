@@ -0,0 +1,267 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fractional_scale_v1.h"
+
+#include "wl_surface.h"
+#include "output_manager.h"
+#include "mir/scene/surface.h"
+#include "mir/scene/null_surface_observer.h"
+#include "mir/graphics/display_configuration.h"
+#include "mir/executor.h"
+#include "mir/wayland/protocol_error.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace ms = mir::scene;
+namespace geom = mir::geometry;
+namespace mw = mir::wayland;
+
+namespace
+{
+/// preferred_scale is sent in 120ths
+uint32_t const scale_denominator = 120;
+}
+
+auto mf::scale_of_output_showing(
+    std::optional<geom::Rectangle> const& area,
+    mg::DisplayConfiguration const& config) -> float
+{
+    std::optional<float> largest_scale;
+    std::optional<float> covering_scale;
+    long covered{0};
+
+    config.for_each_output([&](mg::DisplayConfigurationOutput const& output)
+        {
+            if (!output.used)
+                return;
+
+            if (!largest_scale || output.scale > *largest_scale)
+                largest_scale = output.scale;
+
+            if (area)
+            {
+                auto const overlap = intersection_of(*area, output.extents());
+                long const overlap_area = static_cast<long>(overlap.size.width.as_int()) * overlap.size.height.as_int();
+                if (overlap_area > covered)
+                {
+                    covered = overlap_area;
+                    covering_scale = output.scale;
+                }
+            }
+        });
+
+    return covering_scale.value_or(largest_scale.value_or(1.0f));
+}
+
+auto mf::PreferredScale::update(float scale) -> std::optional<uint32_t>
+{
+    auto const numerator = static_cast<uint32_t>(std::lround(scale * scale_denominator));
+    if (numerator == sent)
+        return std::nullopt;
+
+    sent = numerator;
+    return numerator;
+}
+
+/// Every fractional scale object, so they can all be updated when the display configuration changes
+class mf::FractionalScales : public DisplayConfigListener
+{
+public:
+    FractionalScales(std::shared_ptr<Executor> const& wayland_executor, OutputManager* output_manager)
+        : wayland_executor{wayland_executor},
+          output_manager{output_manager}
+    {
+    }
+
+    /// The Wayland thread, where scene surface observers are notified
+    auto executor() const -> Executor& { return *wayland_executor; }
+
+    /// Registers with the output manager; the global unregisters before the output manager is destroyed
+    void start_listening() { output_manager->add_listener(this); }
+    void stop_listening() { output_manager->remove_listener(this); }
+
+    void add(WpFractionalScaleV1* scale) { scales.push_back(scale); }
+
+    void remove(WpFractionalScaleV1* scale)
+    {
+        scales.erase(std::remove(scales.begin(), scales.end(), scale), scales.end());
+    }
+
+    auto preferred_scale_for(std::optional<geom::Rectangle> const& area) const -> float
+    {
+        return scale_of_output_showing(area, output_manager->current_config());
+    }
+
+private:
+    void display_config_changed(mg::DisplayConfiguration const&) override
+    {
+        for (auto const scale : scales)
+        {
+            scale->update_preferred_scale();
+        }
+    }
+
+    std::shared_ptr<Executor> const wayland_executor;
+    OutputManager* const output_manager;
+    std::vector<WpFractionalScaleV1*> scales;
+};
+
+namespace
+{
+class FractionalScaleManagerV1Global : public mw::FractionalScaleManagerV1::Global
+{
+public:
+    FractionalScaleManagerV1Global(
+        wl_display* display,
+        std::shared_ptr<mir::Executor> const& wayland_executor,
+        mf::OutputManager* output_manager)
+        : Global{display, Version<1>()},
+          scales{std::make_shared<mf::FractionalScales>(wayland_executor, output_manager)}
+    {
+        scales->start_listening();
+    }
+
+    ~FractionalScaleManagerV1Global()
+    {
+        scales->stop_listening();
+    }
+
+private:
+    class Instance : public mw::FractionalScaleManagerV1
+    {
+    public:
+        Instance(wl_resource* new_resource, std::shared_ptr<mf::FractionalScales> const& scales)
+            : mw::FractionalScaleManagerV1{new_resource, Version<1>()},
+              scales{scales}
+        {
+        }
+
+    private:
+        void get_fractional_scale(wl_resource* id, wl_resource* surface) override
+        {
+            auto const wl_surface = mf::WlSurface::from(surface);
+            if (wl_surface->has_fractional_scale())
+            {
+                BOOST_THROW_EXCEPTION(mw::ProtocolError(
+                    resource,
+                    Error::fractional_scale_exists,
+                    "Surface already has a fractional scale object"));
+            }
+            new mf::WpFractionalScaleV1{id, wl_surface, scales};
+        }
+
+        std::shared_ptr<mf::FractionalScales> const scales;
+    };
+
+    void bind(wl_resource* new_resource) override
+    {
+        new Instance{new_resource, scales};
+    }
+
+    std::shared_ptr<mf::FractionalScales> const scales;
+};
+}
+
+/// Runs on the Wayland thread (it is registered with the Wayland executor)
+class mf::WpFractionalScaleV1::SceneSurfaceObserver : public ms::NullSurfaceObserver
+{
+public:
+    SceneSurfaceObserver(WpFractionalScaleV1* scale)
+        : scale{scale}
+    {
+    }
+
+    void moved_to(ms::Surface const*, geom::Point const&) override { update(); }
+    void window_resized_to(ms::Surface const*, geom::Size const&) override { update(); }
+    void content_resized_to(ms::Surface const*, geom::Size const&) override { update(); }
+
+private:
+    void update()
+    {
+        if (scale)
+            scale.value().update_preferred_scale();
+    }
+
+    mw::Weak<WpFractionalScaleV1> const scale;
+};
+
+mf::WpFractionalScaleV1::WpFractionalScaleV1(
+    wl_resource* new_resource,
+    WlSurface* surface,
+    std::shared_ptr<FractionalScales> const& scales)
+    : mw::FractionalScaleV1{new_resource, Version<1>()},
+      surface{surface},
+      scales{scales},
+      observer{std::make_shared<SceneSurfaceObserver>(this)}
+{
+    surface->set_fractional_scale(this);
+    scales->add(this);
+    update_preferred_scale();
+}
+
+mf::WpFractionalScaleV1::~WpFractionalScaleV1()
+{
+    observe(nullptr);
+    scales->remove(this);
+}
+
+void mf::WpFractionalScaleV1::update_preferred_scale()
+{
+    if (!surface)
+        return;
+
+    // Subsurfaces share their parent's scene surface, which is as good a guide to the output as any
+    std::shared_ptr<ms::Surface> scene_surface;
+    if (auto const s = surface.value().scene_surface())
+        scene_surface = s.value();
+    observe(scene_surface);
+
+    std::optional<geom::Rectangle> area;
+    if (scene_surface)
+        area = geom::Rectangle{scene_surface->top_left(), scene_surface->window_size()};
+
+    if (auto const numerator = preferred_scale.update(scales->preferred_scale_for(area)))
+        send_preferred_scale_event(*numerator);
+}
+
+void mf::WpFractionalScaleV1::observe(std::shared_ptr<scene::Surface> const& scene_surface)
+{
+    auto const previous = observed_surface.lock();
+    if (previous == scene_surface)
+        return;
+
+    if (previous)
+        previous->unregister_interest(*observer);
+    if (scene_surface)
+        scene_surface->register_interest(observer, scales->executor());
+    observed_surface = scene_surface;
+}
+
+auto mf::create_fractional_scale_manager_v1(
+    wl_display* display,
+    std::shared_ptr<Executor> const& wayland_executor,
+    OutputManager* output_manager)
+-> std::shared_ptr<mw::FractionalScaleManagerV1::Global>
+{
+    return std::make_shared<FractionalScaleManagerV1Global>(display, wayland_executor, output_manager);
+}
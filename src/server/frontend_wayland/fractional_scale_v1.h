@@ -0,0 +1,91 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_FRACTIONAL_SCALE_V1_H_
+#define MIR_FRONTEND_FRACTIONAL_SCALE_V1_H_
+
+#include "fractional-scale-v1_wrapper.h"
+#include "mir/wayland/weak.h"
+#include "mir/geometry/rectangle.h"
+
+#include <memory>
+#include <optional>
+
+namespace mir
+{
+class Executor;
+namespace graphics
+{
+class DisplayConfiguration;
+}
+namespace scene
+{
+class Surface;
+}
+namespace frontend
+{
+class OutputManager;
+class WlSurface;
+class FractionalScales;
+
+/// The scale of the output showing most of area, or if it is on none (or unknown) the largest scale of any output
+auto scale_of_output_showing(
+    std::optional<geometry::Rectangle> const& area,
+    graphics::DisplayConfiguration const& config) -> float;
+
+/// Tracks the preferred scale last sent, so it is only sent again when it changes
+class PreferredScale
+{
+public:
+    /// The preferred_scale (in 120ths) to send for scale, or nullopt if that is what was sent last
+    auto update(float scale) -> std::optional<uint32_t>;
+
+private:
+    std::optional<uint32_t> sent;
+};
+
+/// Tells the client the scale of the output its surface is (mostly) on, so it can render at that scale exactly
+class WpFractionalScaleV1 : public wayland::FractionalScaleV1
+{
+public:
+    WpFractionalScaleV1(wl_resource* new_resource, WlSurface* surface, std::shared_ptr<FractionalScales> const& scales);
+    ~WpFractionalScaleV1();
+
+    /// Sends preferred_scale if it differs from the last one sent
+    void update_preferred_scale();
+
+private:
+    class SceneSurfaceObserver;
+
+    /// Follows the scene surface the surface is (now) shown in, so moving or resizing it updates the scale
+    void observe(std::shared_ptr<scene::Surface> const& scene_surface);
+
+    wayland::Weak<WlSurface> const surface;
+    std::shared_ptr<FractionalScales> const scales;
+    std::shared_ptr<SceneSurfaceObserver> const observer;
+    std::weak_ptr<scene::Surface> observed_surface;
+    PreferredScale preferred_scale;
+};
+
+auto create_fractional_scale_manager_v1(
+    wl_display* display,
+    std::shared_ptr<Executor> const& wayland_executor,
+    OutputManager* output_manager)
+-> std::shared_ptr<wayland::FractionalScaleManagerV1::Global>;
+}
+}
+
+#endif // MIR_FRONTEND_FRACTIONAL_SCALE_V1_H_
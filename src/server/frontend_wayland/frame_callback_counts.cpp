@@ -0,0 +1,34 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "frame_callback_counts.h"
+
+namespace mf = mir::frontend;
+
+mir::time::Duration const mf::FrameCallbackCounts::log_interval = std::chrono::minutes{1};
+
+auto mf::FrameCallbackCounts::due_for_logging(time::Timestamp now) -> std::optional<Counts>
+{
+    if (totals.throttled == throttled_when_logged)
+        return std::nullopt;
+
+    if (last_logged && now - *last_logged < log_interval)
+        return std::nullopt;
+
+    last_logged = now;
+    throttled_when_logged = totals.throttled;
+    return totals;
+}
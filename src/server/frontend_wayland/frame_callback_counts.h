@@ -0,0 +1,60 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_FRAME_CALLBACK_COUNTS_H
+#define MIR_FRONTEND_FRAME_CALLBACK_COUNTS_H
+
+#include <mir/time/types.h>
+
+#include <cstdint>
+#include <optional>
+
+namespace mir
+{
+namespace frontend
+{
+/// wl_surface.frame callbacks sent to a client, and how often they were held back because the surface could not be
+/// seen
+class FrameCallbackCounts
+{
+public:
+    struct Counts
+    {
+        uint64_t sent{0};
+        uint64_t throttled{0};
+    };
+
+    /// How often the counts are logged while callbacks are being held back
+    static time::Duration const log_interval;
+
+    void sent(uint64_t count) { totals.sent += count; }
+    void throttled() { ++totals.throttled; }
+
+    auto counts() const -> Counts { return totals; }
+
+    /// The counts, if they are due to be logged at \a now: callbacks have been held back since they were last
+    /// logged, and that was at least log_interval ago
+    auto due_for_logging(time::Timestamp now) -> std::optional<Counts>;
+
+private:
+    Counts totals;
+    uint64_t throttled_when_logged{0};
+    std::optional<time::Timestamp> last_logged;
+};
+}
+}
+
+#endif // MIR_FRONTEND_FRAME_CALLBACK_COUNTS_H
@@ -17,57 +17,89 @@
 #include "frame_executor.h"
 
 #include <mir/main_loop.h>
+#include <mir/time/clock.h>
 
+#include <map>
 #include <mutex>
 #include <vector>
 
 namespace mf = mir::frontend;
 
-namespace
-{
-auto const delay = std::chrono::milliseconds{16};
-}
+mir::time::Duration const mf::FrameExecutor::fallback_delay = std::chrono::milliseconds{16};
 
 struct mf::FrameExecutor::Callbacks
 {
+    explicit Callbacks(std::shared_ptr<time::Clock> const& clock)
+        : clock{clock}
+    {
+    }
+
+    std::shared_ptr<time::Clock> const clock;
     std::mutex mutex;
-    std::vector<std::function<void()>> queued;
+    std::multimap<time::Timestamp, std::function<void()>> queued;
+    time::Alarm* alarm{nullptr}; ///< Cleared (under the mutex) before the alarm is destroyed
 };
 
-mf::FrameExecutor::FrameExecutor(time::AlarmFactory& alarm_factory)
-    : callbacks{std::make_shared<Callbacks>()},
+mf::FrameExecutor::FrameExecutor(std::shared_ptr<time::Clock> const& clock, time::AlarmFactory& alarm_factory)
+    : callbacks{std::make_shared<Callbacks>(clock)},
       alarm{alarm_factory.create_alarm([weak_callbacks = std::weak_ptr<Callbacks>{callbacks}]()
           {
               fire_callbacks(weak_callbacks);
           })}
 {
+    callbacks->alarm = alarm.get();
+}
+
+mf::FrameExecutor::~FrameExecutor()
+{
+    std::lock_guard lock{callbacks->mutex};
+    callbacks->alarm = nullptr;
 }
 
 void mf::FrameExecutor::spawn(std::function<void()>&& work)
 {
-    std::unique_lock lock{callbacks->mutex};
-    bool const needs_alarm = callbacks->queued.empty();
-    callbacks->queued.push_back(std::move(work));
-    lock.unlock();
+    spawn_at(callbacks->clock->now() + fallback_delay, std::move(work));
+}
+
+void mf::FrameExecutor::spawn_at(time::Timestamp deadline, std::function<void()>&& work)
+{
+    std::lock_guard lock{callbacks->mutex};
+    bool const needs_alarm = callbacks->queued.empty() || deadline < callbacks->queued.begin()->first;
+    callbacks->queued.emplace(deadline, std::move(work));
 
+    // Rescheduling under the lock keeps a concurrent fire_callbacks() from replacing this with a later deadline
     if (needs_alarm)
     {
-        alarm->reschedule_in(delay);
+        callbacks->alarm->reschedule_for(deadline);
     }
 }
 
 void mf::FrameExecutor::fire_callbacks(std::weak_ptr<Callbacks> const& weak_callbacks)
 {
-    if (auto const callbacks = weak_callbacks.lock())
+    auto const callbacks = weak_callbacks.lock();
+    if (!callbacks)
+    {
+        return;
+    }
+
+    auto const now = callbacks->clock->now();
+
+    std::unique_lock lock{callbacks->mutex};
+    auto const first_pending = callbacks->queued.upper_bound(now);
+    std::vector<std::function<void()>> due;
+    for (auto i = callbacks->queued.begin(); i != first_pending; ++i)
+    {
+        due.push_back(std::move(i->second));
+    }
+    callbacks->queued.erase(callbacks->queued.begin(), first_pending);
+    if (!callbacks->queued.empty() && callbacks->alarm)
+    {
+        callbacks->alarm->reschedule_for(callbacks->queued.begin()->first);
+    }
+    lock.unlock();
+
+    for (auto const& callback : due)
     {
-        std::unique_lock lock{callbacks->mutex};
-        auto const queued = std::move(callbacks->queued);
-        callbacks->queued.clear();
-        lock.unlock();
-
-        for (auto const& callback : queued)
-        {
-            callback();
-        }
+        callback();
     }
 }
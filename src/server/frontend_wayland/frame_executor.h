@@ -18,8 +18,10 @@
 #define MIR_FRONTEND_FRAME_CALLBACK_EXECUTOR_H
 
 #include <mir/executor.h>
+#include <mir/time/types.h>
 
 #include <memory>
+#include <optional>
 
 namespace mir
 {
@@ -27,25 +29,59 @@ namespace time
 {
 class Alarm;
 class AlarmFactory;
+class Clock;
 }
 
 namespace frontend
 {
 
+/// How often frame callbacks are sent for surfaces nobody can see (occluded, offscreen or minimised)
+class HiddenSurfaceFramePolicy
+{
+public:
+    /// A positive rate_hz sends callbacks at most that often, 0 holds them until the surface is seen again and a
+    /// negative value does not throttle at all
+    explicit HiddenSurfaceFramePolicy(int rate_hz)
+        : rate_hz{rate_hz}
+    {
+    }
+
+    auto throttles() const -> bool { return rate_hz >= 0; }
+
+    /// When callbacks held back for a hidden surface are released, or nullopt if they wait for it to be seen
+    auto release_time(time::Timestamp last_sent) const -> std::optional<time::Timestamp>
+    {
+        if (rate_hz <= 0)
+            return std::nullopt;
+        return last_sent + std::chrono::duration_cast<time::Duration>(std::chrono::seconds{1}) / rate_hz;
+    }
+
+private:
+    int const rate_hz;
+};
+
 /// Runs frame callbacks that do not have a buffer to be attached to.
 class FrameExecutor : public Executor
 {
 public:
-    explicit FrameExecutor(time::AlarmFactory& alarm_factory);
+    FrameExecutor(std::shared_ptr<time::Clock> const& clock, time::AlarmFactory& alarm_factory);
+    ~FrameExecutor();
 
-    // This can be called from any thread. Given callback is run on the main loop thread. The wayland executor is NOT
-    // automatically used.
+    /// How long spawn() waits. Only used when there is no output refresh to align to.
+    static time::Duration const fallback_delay;
+
+    // This can be called from any thread. Given callback is run on the main loop thread after fallback_delay. The
+    // wayland executor is NOT automatically used.
     void spawn(std::function<void()>&& work) override;
 
+    /// As spawn(), but the callback is run at the given time (typically an output's next vblank) rather than after
+    /// the fallback delay. Work due at the same time is batched into a single wakeup.
+    void spawn_at(time::Timestamp deadline, std::function<void()>&& work);
+
 private:
     struct Callbacks;
 
-    std::shared_ptr<Callbacks> const callbacks; // shared_ptr so it can potentially outlive this object
+    std::shared_ptr<Callbacks> const callbacks; // shared_ptr so it can outlive this object in an alarm mid-dispatch
     std::unique_ptr<time::Alarm> const alarm;
 
     static void fire_callbacks(std::weak_ptr<Callbacks> const& weak_callbacks);
@@ -26,16 +26,12 @@
 struct MirEvent;
 struct MirKeyboardEvent;
 
-// from <xkbcommon/xkbcommon.h>
-struct xkb_keymap;
-struct xkb_state;
-struct xkb_context;
-
 namespace mir
 {
 namespace input
 {
 class Keymap;
+class CompiledKeymap;
 class Seat;
 }
 
@@ -82,8 +78,8 @@ private:
     std::shared_ptr<input::Seat> const mir_seat;
     MirXkbModifiers modifiers;
     std::shared_ptr<mir::input::Keymap> current_keymap;
-    std::unique_ptr<xkb_keymap, void (*)(xkb_keymap *)> compiled_keymap;
-    std::unique_ptr<xkb_context, void (*)(xkb_context *)> const context;
+    /// Shared with every other keyboard using the same keymap
+    std::shared_ptr<mir::input::CompiledKeymap const> compiled_keymap;
 };
 }
 }
@@ -305,6 +305,18 @@ auto mf::OutputManager::output_for(graphics::DisplayConfigurationOutputId id) ->
         return std::nullopt;
 }
 
+void mf::OutputManager::add_listener(DisplayConfigListener* listener)
+{
+    listeners.push_back(listener);
+}
+
+void mf::OutputManager::remove_listener(DisplayConfigListener* listener)
+{
+    listeners.erase(
+        std::remove_if(listeners.begin(), listeners.end(), [&](auto candidate) { return candidate == listener; }),
+        listeners.end());
+}
+
 void mf::OutputManager::handle_configuration_change(std::shared_ptr<mg::DisplayConfiguration const> const& config)
 {
     display_config = config;
@@ -327,4 +339,9 @@ void mf::OutputManager::handle_configuration_change(std::shared_ptr<mg::DisplayC
                 outputs[output_config.id] = std::make_unique<OutputGlobal>(display, output_config);
             }
         });
+
+    for (auto const& listener : listeners)
+    {
+        listener->display_config_changed(*config);
+    }
 }
@@ -50,6 +50,18 @@ public:
     OutputConfigListener& operator=(OutputConfigListener const&) = delete;
 };
 
+class DisplayConfigListener
+{
+public:
+    /// Called once the output globals have been updated for a new display configuration
+    virtual void display_config_changed(graphics::DisplayConfiguration const& config) = 0;
+
+    DisplayConfigListener() = default;
+    virtual ~DisplayConfigListener() = default;
+    DisplayConfigListener(DisplayConfigListener const&) = delete;
+    DisplayConfigListener& operator=(DisplayConfigListener const&) = delete;
+};
+
 class OutputInstance : public wayland::Output, OutputConfigListener
 {
 public:
@@ -105,6 +117,9 @@ public:
     auto output_for(graphics::DisplayConfigurationOutputId id) -> std::optional<OutputGlobal*>;
     auto current_config() -> graphics::DisplayConfiguration const& { return *display_config; }
 
+    void add_listener(DisplayConfigListener* listener);
+    void remove_listener(DisplayConfigListener* listener);
+
 private:
     void handle_configuration_change(std::shared_ptr<graphics::DisplayConfiguration const> const& config);
 
@@ -115,6 +130,7 @@ private:
     std::shared_ptr<DisplayConfigObserver> const display_config_observer;
     std::unordered_map<graphics::DisplayConfigurationOutputId, std::unique_ptr<OutputGlobal>> outputs;
     std::shared_ptr<graphics::DisplayConfiguration const> display_config;
+    std::vector<DisplayConfigListener*> listeners;
 };
 }
 }
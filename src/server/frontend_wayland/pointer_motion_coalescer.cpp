@@ -0,0 +1,96 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pointer_motion_coalescer.h"
+#include "frame_executor.h"
+
+#include <mir/executor.h>
+
+namespace mf = mir::frontend;
+
+struct mf::PointerMotionCoalescer::State
+{
+    State(std::function<void(Motion const&)>&& send_motion, std::function<void()>&& end_frame)
+        : send_motion{std::move(send_motion)},
+          end_frame{std::move(end_frame)}
+    {
+    }
+
+    void flush()
+    {
+        if (held)
+        {
+            auto const motion = *held;
+            held = std::nullopt;
+            send_motion(motion);
+        }
+    }
+
+    std::function<void(Motion const&)> const send_motion;
+    std::function<void()> const end_frame;
+    std::optional<Motion> held;
+    bool flush_scheduled{false};
+};
+
+mf::PointerMotionCoalescer::PointerMotionCoalescer(
+    std::shared_ptr<Executor> const& wayland_executor,
+    std::shared_ptr<FrameExecutor> const& frame_executor,
+    std::function<void(Motion const&)> send_motion,
+    std::function<void()> end_frame)
+    : wayland_executor{wayland_executor},
+      frame_executor{frame_executor},
+      state{std::make_shared<State>(std::move(send_motion), std::move(end_frame))}
+{
+}
+
+void mf::PointerMotionCoalescer::hold(Motion const& motion, std::optional<time::Timestamp> due)
+{
+    state->held = motion;
+
+    if (state->flush_scheduled)
+        return;
+    state->flush_scheduled = true;
+
+    auto send_due_motion = [executor = wayland_executor, weak_state = std::weak_ptr<State>{state}]()
+        {
+            executor->spawn([weak_state]()
+                {
+                    if (auto const state = weak_state.lock())
+                    {
+                        state->flush_scheduled = false;
+                        if (state->held)
+                        {
+                            state->flush();
+                            state->end_frame();
+                        }
+                    }
+                });
+        };
+
+    if (due)
+    {
+        frame_executor->spawn_at(*due, std::move(send_due_motion));
+    }
+    else
+    {
+        send_due_motion();
+    }
+}
+
+void mf::PointerMotionCoalescer::flush()
+{
+    state->flush();
+}
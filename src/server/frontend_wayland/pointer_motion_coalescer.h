@@ -0,0 +1,74 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_POINTER_MOTION_COALESCER_H
+#define MIR_FRONTEND_POINTER_MOTION_COALESCER_H
+
+#include <mir/time/types.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace mir
+{
+class Executor;
+namespace frontend
+{
+class FrameExecutor;
+
+/// Holds back plain pointer motion so that a client is sent at most one motion per composite of its surface
+class PointerMotionCoalescer
+{
+public:
+    struct Motion
+    {
+        uint32_t timestamp;                 ///< As sent to the client
+        std::pair<float, float> position;   ///< On the surface under the pointer
+        std::chrono::nanoseconds event_time; ///< Of the input event, for latency reporting
+    };
+
+    /// send_motion sends a motion without a frame. end_frame is called after a motion sent because it was due.
+    /// Both are only called on the Wayland thread.
+    PointerMotionCoalescer(
+        std::shared_ptr<Executor> const& wayland_executor,
+        std::shared_ptr<FrameExecutor> const& frame_executor,
+        std::function<void(Motion const&)> send_motion,
+        std::function<void()> end_frame);
+
+    /// Holds motion back in place of any already held. It is sent at due or, if nothing is known to align it to, as
+    /// soon as the main loop gets to it (which still merges a burst of events arriving together). A flush already
+    /// scheduled is not moved.
+    void hold(Motion const& motion, std::optional<time::Timestamp> due);
+
+    /// Sends the held motion now, if there is any, so that it precedes whatever is sent next
+    void flush();
+
+private:
+    struct State;
+
+    std::shared_ptr<Executor> const wayland_executor;
+    std::shared_ptr<FrameExecutor> const frame_executor;
+    /// shared_ptr so a scheduled flush can tell this has been destroyed
+    std::shared_ptr<State> const state;
+};
+}
+}
+
+#endif // MIR_FRONTEND_POINTER_MOTION_COALESCER_H
@@ -0,0 +1,162 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "presentation_time.h"
+
+#include "wl_surface.h"
+#include "output_manager.h"
+#include "wayland_timespec.h"
+#include "mir/graphics/frame.h"
+#include "mir/graphics/display_configuration.h"
+
+#include <chrono>
+#include <ctime>
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace geom = mir::geometry;
+namespace mw = mir::wayland;
+
+namespace
+{
+/// All timestamps we hand out are on this clock; KMS page flip events are reported on it
+clockid_t const presentation_clock = CLOCK_MONOTONIC;
+
+class PresentationGlobal : public mw::Presentation::Global
+{
+public:
+    PresentationGlobal(wl_display* display, mf::OutputManager* output_manager)
+        : Global{display, Version<1>()},
+          output_manager{output_manager}
+    {
+    }
+
+private:
+    class Instance : public mw::Presentation
+    {
+    public:
+        Instance(wl_resource* new_resource, mf::OutputManager* output_manager)
+            : mw::Presentation{new_resource, Version<1>()},
+              output_manager{output_manager}
+        {
+            send_clock_id_event(presentation_clock);
+        }
+
+    private:
+        void feedback(wl_resource* surface, wl_resource* callback) override
+        {
+            auto const feedback = new mf::WpPresentationFeedback{callback, output_manager};
+            mf::WlSurface::from(surface)->add_presentation_feedback(feedback);
+        }
+
+        mf::OutputManager* const output_manager;
+    };
+
+    void bind(wl_resource* new_resource) override
+    {
+        new Instance{new_resource, output_manager};
+    }
+
+    mf::OutputManager* const output_manager;
+};
+}
+
+mf::WpPresentationFeedback::WpPresentationFeedback(wl_resource* new_resource, OutputManager* output_manager)
+    : mw::PresentationFeedback{new_resource, Version<1>()},
+      output_manager{output_manager}
+{
+}
+
+void mf::WpPresentationFeedback::presented(
+    geom::Rectangle const& output_area,
+    mg::Frame const& frame,
+    bool zero_copy,
+    bool predicted)
+{
+    std::chrono::nanoseconds refresh{0};
+    bool synced{false};
+    output_manager->current_config().for_each_output([&](mg::DisplayConfigurationOutput const& output)
+        {
+            // Clones share an area, but presentation is only ever synchronised to one output
+            if (synced || !output.used || output.extents() != output_area)
+                return;
+
+            synced = true;
+            if (output.current_mode_index < output.modes.size())
+            {
+                auto const hz = output.modes[output.current_mode_index].vrefresh_hz;
+                if (hz > 0)
+                    refresh = std::chrono::nanoseconds{static_cast<int64_t>(1e9 / hz)};
+            }
+
+            if (auto const global = output_manager->output_for(output.id))
+            {
+                global.value()->for_each_output_bound_by(
+                    client,
+                    [&](OutputInstance* instance)
+                    {
+                        send_sync_output_event(instance->resource);
+                    });
+            }
+        });
+
+    uint32_t flags{0};
+    auto timestamp = frame.ust;
+    if (frame.msc != 0 && timestamp.clock_id == presentation_clock && predicted)
+    {
+        // Stepped on from a real flip in whole refresh periods
+        flags |= Kind::vsync;
+    }
+    else if (frame.msc != 0 && timestamp.clock_id == presentation_clock)
+    {
+        // A real flip: the kernel timestamped the vblank the content was latched on
+        flags |= Kind::vsync | Kind::hw_clock | Kind::hw_completion;
+    }
+    else if (timestamp.clock_id != presentation_clock)
+    {
+        timestamp = mg::Frame::Timestamp::now(presentation_clock);
+    }
+    if (zero_copy)
+        flags |= Kind::zero_copy;
+
+    // steady_clock is CLOCK_MONOTONIC, so the timestamp converts directly
+    WaylandTimespec const timespec{time::Timestamp{timestamp.nanoseconds}};
+    uint64_t const seq = frame.msc;
+
+    send_presented_event(
+        timespec.tv_sec_hi,
+        timespec.tv_sec_lo,
+        timespec.tv_nsec,
+        refresh.count(),
+        seq >> 32,
+        seq & 0xffffffff,
+        flags);
+    destroy_and_delete();
+}
+
+void mf::WpPresentationFeedback::discarded()
+{
+    send_discarded_event();
+    destroy_and_delete();
+}
+
+auto mf::create_presentation_time(
+    wl_display* display,
+    OutputManager* output_manager)
+-> std::shared_ptr<mw::Presentation::Global>
+{
+    return std::make_shared<PresentationGlobal>(display, output_manager);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_PRESENTATION_TIME_H_
+#define MIR_FRONTEND_PRESENTATION_TIME_H_
+
+#include "presentation-time_wrapper.h"
+#include "mir/geometry/forward.h"
+
+#include <memory>
+
+namespace mir
+{
+namespace graphics
+{
+struct Frame;
+}
+namespace frontend
+{
+class OutputManager;
+
+/// Feedback for a single wl_surface content update, delivered once
+class WpPresentationFeedback : public wayland::PresentationFeedback
+{
+public:
+    WpPresentationFeedback(wl_resource* new_resource, OutputManager* output_manager);
+
+    /// Sends sync_output for the output covering output_area, then presented, and destroys the feedback.
+    /// A predicted frame is one worked out from earlier flips, so is vblank aligned but not hardware timestamped.
+    void presented(
+        geometry::Rectangle const& output_area,
+        graphics::Frame const& frame,
+        bool zero_copy,
+        bool predicted = false);
+    /// Sends discarded and destroys the feedback
+    void discarded();
+
+private:
+    OutputManager* const output_manager;
+};
+
+auto create_presentation_time(
+    wl_display* display,
+    OutputManager* output_manager)
+-> std::shared_ptr<wayland::Presentation::Global>;
+}
+}
+
+#endif // MIR_FRONTEND_PRESENTATION_TIME_H_
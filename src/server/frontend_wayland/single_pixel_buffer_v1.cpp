@@ -0,0 +1,83 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "single_pixel_buffer_v1.h"
+
+#include <limits>
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace mw = mir::wayland;
+
+namespace
+{
+auto as_channel(uint32_t value) -> float
+{
+    return static_cast<float>(static_cast<double>(value) / std::numeric_limits<uint32_t>::max());
+}
+
+class SinglePixelBufferManagerV1Global : public mw::SinglePixelBufferManagerV1::Global
+{
+public:
+    SinglePixelBufferManagerV1Global(wl_display* display)
+        : Global{display, Version<1>()}
+    {
+    }
+
+private:
+    class Instance : public mw::SinglePixelBufferManagerV1
+    {
+    public:
+        Instance(wl_resource* new_resource)
+            : mw::SinglePixelBufferManagerV1{new_resource, Version<1>()}
+        {
+        }
+
+    private:
+        void create_u32_rgba_buffer(wl_resource* id, uint32_t r, uint32_t g, uint32_t b, uint32_t a) override
+        {
+            // The values are already premultiplied, which is what SolidColourBuffer wants
+            new mf::SinglePixelBuffer{id, {as_channel(r), as_channel(g), as_channel(b), as_channel(a)}};
+        }
+    };
+
+    void bind(wl_resource* new_resource) override
+    {
+        new Instance{new_resource};
+    }
+};
+}
+
+mf::SinglePixelBuffer::SinglePixelBuffer(wl_resource* new_resource, mg::SolidColourBuffer::Colour const& colour)
+    : Buffer{new_resource, Version<1>{}},
+      colour_{colour}
+{
+}
+
+auto mf::SinglePixelBuffer::from(wl_resource* resource) -> SinglePixelBuffer*
+{
+    if (auto buffer = wayland::Buffer::from(resource))
+    {
+        return dynamic_cast<SinglePixelBuffer*>(buffer);
+    }
+    return nullptr;
+}
+
+auto mf::create_single_pixel_buffer_manager_v1(wl_display* display)
+-> std::shared_ptr<mw::SinglePixelBufferManagerV1::Global>
+{
+    return std::make_shared<SinglePixelBufferManagerV1Global>(display);
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_SINGLE_PIXEL_BUFFER_V1_H_
+#define MIR_FRONTEND_SINGLE_PIXEL_BUFFER_V1_H_
+
+#include "single-pixel-buffer-v1_wrapper.h"
+#include "wayland_wrapper.h"
+#include "mir/graphics/solid_colour_buffer.h"
+
+#include <memory>
+
+namespace mir
+{
+namespace frontend
+{
+/// A 1x1 wl_buffer of a single colour, which has no storage to map or upload
+class SinglePixelBuffer : public wayland::Buffer
+{
+public:
+    SinglePixelBuffer(wl_resource* new_resource, graphics::SolidColourBuffer::Colour const& colour);
+
+    auto colour() const -> graphics::SolidColourBuffer::Colour const& { return colour_; }
+
+    static auto from(wl_resource* resource) -> SinglePixelBuffer*;
+
+private:
+    graphics::SolidColourBuffer::Colour const colour_;
+};
+
+auto create_single_pixel_buffer_manager_v1(wl_display* display)
+-> std::shared_ptr<wayland::SinglePixelBufferManagerV1::Global>;
+}
+}
+
+#endif // MIR_FRONTEND_SINGLE_PIXEL_BUFFER_V1_H_
@@ -0,0 +1,124 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "touch_resampler.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace mf = mir::frontend;
+
+mir::time::Duration const mf::TouchResampler::latency = std::chrono::milliseconds{5};
+mir::time::Duration const mf::TouchResampler::max_prediction = std::chrono::milliseconds{8};
+
+namespace
+{
+/// Samples closer together than this are too noisy to predict from
+auto const min_prediction_interval = std::chrono::milliseconds{2};
+/// Samples further apart than this are not a continuous movement to predict from
+auto const max_prediction_interval = std::chrono::milliseconds{20};
+/// Enough history to interpolate across a frame of latency at any plausible digitiser rate
+std::size_t const max_history{8};
+
+auto lerp(mf::TouchResampler::Position const& a, mf::TouchResampler::Position const& b, float alpha)
+    -> mf::TouchResampler::Position
+{
+    return {a.first + (b.first - a.first) * alpha, a.second + (b.second - a.second) * alpha};
+}
+
+auto ratio(mir::time::Duration numerator, mir::time::Duration denominator) -> float
+{
+    return std::chrono::duration<float>{numerator} / std::chrono::duration<float>{denominator};
+}
+}
+
+void mf::TouchResampler::add(int32_t touch_id, time::Timestamp time, Position position)
+{
+    auto& samples = history[touch_id];
+
+    // Samples must be in time order to interpolate between them, a duplicate or late one replaces the latest
+    if (!samples.empty() && time <= samples.back().time)
+    {
+        samples.back().position = position;
+        return;
+    }
+
+    samples.push_back({time, position});
+    if (samples.size() > max_history)
+    {
+        samples.pop_front();
+    }
+}
+
+void mf::TouchResampler::remove(int32_t touch_id)
+{
+    history.erase(touch_id);
+}
+
+auto mf::TouchResampler::latest(int32_t touch_id) const -> std::optional<time::Timestamp>
+{
+    auto const found = history.find(touch_id);
+    if (found == history.end() || found->second.empty())
+        return std::nullopt;
+    return found->second.back().time;
+}
+
+auto mf::TouchResampler::prediction(std::deque<Sample> const& samples, time::Timestamp time) -> time::Duration
+{
+    if (samples.size() < 2 || time <= samples.back().time)
+        return time::Duration::zero();
+
+    auto const& newest = samples.back();
+    auto const& previous = samples[samples.size() - 2];
+    auto const interval = newest.time - previous.time;
+    if (interval < min_prediction_interval || interval > max_prediction_interval)
+        return time::Duration::zero();
+
+    // Predicting more than half an interval ahead overshoots too readily when the contact changes direction
+    return std::min({time - newest.time, interval / 2, max_prediction});
+}
+
+auto mf::TouchResampler::predicts(int32_t touch_id, time::Timestamp time) const -> bool
+{
+    auto const found = history.find(touch_id);
+    return found != history.end() && prediction(found->second, time) > time::Duration::zero();
+}
+
+auto mf::TouchResampler::position_at(int32_t touch_id, time::Timestamp time) const -> std::optional<Position>
+{
+    auto const found = history.find(touch_id);
+    if (found == history.end() || found->second.empty())
+        return std::nullopt;
+    auto const& samples = found->second;
+
+    if (time <= samples.front().time)
+        return samples.front().position;
+
+    auto const after = std::find_if(samples.begin(), samples.end(), [&](auto const& s) { return s.time >= time; });
+    if (after != samples.end())
+    {
+        auto const before = std::prev(after);
+        return lerp(before->position, after->position, ratio(time - before->time, after->time - before->time));
+    }
+
+    auto const& newest = samples.back();
+    auto const predicted = prediction(samples, time);
+    if (predicted == time::Duration::zero())
+        return newest.position;
+
+    auto const& previous = samples[samples.size() - 2];
+    return lerp(previous.position, newest.position, 1.0f + ratio(predicted, newest.time - previous.time));
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_TOUCH_RESAMPLER_H
+#define MIR_FRONTEND_TOUCH_RESAMPLER_H
+
+#include <mir/time/types.h>
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace mir
+{
+namespace frontend
+{
+/// Estimates where each touch contact was at an arbitrary time from the samples the digitiser reported, so that
+/// contacts can be sent once per display frame rather than at the digitiser's rate (which beats against it).
+class TouchResampler
+{
+public:
+    /// How far behind the frame contacts are sampled, so that there is usually a later sample to interpolate towards
+    static time::Duration const latency;
+    /// The furthest a position is extrapolated beyond the latest sample
+    static time::Duration const max_prediction;
+
+    using Position = std::pair<float, float>;
+
+    void add(int32_t touch_id, time::Timestamp time, Position position);
+    void remove(int32_t touch_id);
+
+    /// The position of the touch at the given time. Between samples this is interpolated and beyond the latest it is
+    /// extrapolated (by at most max_prediction, and only if the latest samples are close enough together to predict
+    /// from). nullopt if the touch is unknown.
+    auto position_at(int32_t touch_id, time::Timestamp time) const -> std::optional<Position>;
+    /// Whether position_at() the given time is extrapolated, rather than interpolated or held at the latest sample
+    auto predicts(int32_t touch_id, time::Timestamp time) const -> bool;
+    /// When the touch's latest sample was taken, or nullopt if the touch is unknown
+    auto latest(int32_t touch_id) const -> std::optional<time::Timestamp>;
+
+private:
+    struct Sample
+    {
+        time::Timestamp time;
+        Position position;
+    };
+
+    /// How far beyond the latest sample the position at time is extrapolated (zero if it isn't)
+    static auto prediction(std::deque<Sample> const& samples, time::Timestamp time) -> time::Duration;
+
+    std::unordered_map<int32_t, std::deque<Sample>> history;
+};
+}
+}
+
+#endif // MIR_FRONTEND_TOUCH_RESAMPLER_H
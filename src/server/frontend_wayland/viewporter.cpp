@@ -0,0 +1,143 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "viewporter.h"
+
+#include "wl_surface.h"
+#include "mir/wayland/protocol_error.h"
+
+#include <boost/throw_exception.hpp>
+
+namespace mf = mir::frontend;
+namespace geom = mir::geometry;
+namespace mw = mir::wayland;
+
+namespace
+{
+class ViewporterGlobal : public mw::Viewporter::Global
+{
+public:
+    ViewporterGlobal(wl_display* display)
+        : Global{display, Version<1>()}
+    {
+    }
+
+private:
+    class Instance : public mw::Viewporter
+    {
+    public:
+        Instance(wl_resource* new_resource)
+            : mw::Viewporter{new_resource, Version<1>()}
+        {
+        }
+
+    private:
+        void get_viewport(wl_resource* id, wl_resource* surface) override
+        {
+            auto const wl_surface = mf::WlSurface::from(surface);
+            if (wl_surface->has_viewport())
+            {
+                BOOST_THROW_EXCEPTION(mw::ProtocolError(
+                    resource,
+                    Error::viewport_exists,
+                    "Surface already has a viewport"));
+            }
+            new mf::WpViewport{id, wl_surface};
+        }
+    };
+
+    void bind(wl_resource* new_resource) override
+    {
+        new Instance{new_resource};
+    }
+};
+}
+
+mf::WpViewport::WpViewport(wl_resource* new_resource, WlSurface* surface)
+    : mw::Viewport{new_resource, Version<1>()},
+      surface{surface}
+{
+    surface->set_viewport(this);
+}
+
+mf::WpViewport::~WpViewport()
+{
+    // The crop and scale state goes away with the next commit
+    if (surface)
+    {
+        surface.value().set_pending_viewport_source(std::nullopt);
+        surface.value().set_pending_viewport_destination(std::nullopt);
+    }
+}
+
+void mf::WpViewport::set_source(double x, double y, double width, double height)
+{
+    auto& target = surface_or_throw();
+
+    if (x == -1 && y == -1 && width == -1 && height == -1)
+    {
+        target.set_pending_viewport_source(std::nullopt);
+        return;
+    }
+
+    if (x < 0 || y < 0 || width <= 0 || height <= 0)
+    {
+        BOOST_THROW_EXCEPTION(mw::ProtocolError(
+            resource,
+            Error::bad_value,
+            "Invalid source rectangle %fx%f+%f+%f", width, height, x, y));
+    }
+
+    target.set_pending_viewport_source(geom::RectangleD{{x, y}, {width, height}});
+}
+
+void mf::WpViewport::set_destination(int32_t width, int32_t height)
+{
+    auto& target = surface_or_throw();
+
+    if (width == -1 && height == -1)
+    {
+        target.set_pending_viewport_destination(std::nullopt);
+        return;
+    }
+
+    if (width <= 0 || height <= 0)
+    {
+        BOOST_THROW_EXCEPTION(mw::ProtocolError(
+            resource,
+            Error::bad_value,
+            "Invalid destination size %dx%d", width, height));
+    }
+
+    target.set_pending_viewport_destination(geom::Size{width, height});
+}
+
+auto mf::WpViewport::surface_or_throw() const -> WlSurface&
+{
+    if (!surface)
+    {
+        BOOST_THROW_EXCEPTION(mw::ProtocolError(
+            resource,
+            Error::no_surface,
+            "Surface of viewport has been destroyed"));
+    }
+    return surface.value();
+}
+
+auto mf::create_viewporter(wl_display* display) -> std::shared_ptr<mw::Viewporter::Global>
+{
+    return std::make_shared<ViewporterGlobal>(display);
+}
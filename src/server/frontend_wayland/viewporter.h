@@ -0,0 +1,52 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_VIEWPORTER_H_
+#define MIR_FRONTEND_VIEWPORTER_H_
+
+#include "viewporter_wrapper.h"
+#include "mir/wayland/weak.h"
+
+#include <memory>
+
+namespace mir
+{
+namespace frontend
+{
+class WlSurface;
+
+/// Crop and scale state for a single wl_surface
+class WpViewport : public wayland::Viewport
+{
+public:
+    WpViewport(wl_resource* new_resource, WlSurface* surface);
+    ~WpViewport();
+
+private:
+    void set_source(double x, double y, double width, double height) override;
+    void set_destination(int32_t width, int32_t height) override;
+
+    /// Raises no_surface if the surface has been destroyed
+    auto surface_or_throw() const -> WlSurface&;
+
+    wayland::Weak<WlSurface> const surface;
+};
+
+auto create_viewporter(wl_display* display) -> std::shared_ptr<wayland::Viewporter::Global>;
+}
+}
+
+#endif // MIR_FRONTEND_VIEWPORTER_H_
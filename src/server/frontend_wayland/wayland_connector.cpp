@@ -64,12 +64,16 @@ public:
     WlCompositor(
         struct wl_display* display,
         std::shared_ptr<mir::Executor> const& wayland_executor,
-        std::shared_ptr<mir::Executor> const& frame_callback_executor,
-        std::shared_ptr<mg::GraphicBufferAllocator> const& allocator)
+        std::shared_ptr<FrameExecutor> const& frame_callback_executor,
+        HiddenSurfaceFramePolicy const& hidden_frame_policy,
+        std::shared_ptr<mg::GraphicBufferAllocator> const& allocator,
+        std::shared_ptr<mi::InputLatencyReport> const& input_latency_report)
         : Global(display, Version<4>()),
           allocator{allocator},
           wayland_executor{wayland_executor},
-          frame_callback_executor{frame_callback_executor}
+          frame_callback_executor{frame_callback_executor},
+          hidden_frame_policy{hidden_frame_policy},
+          input_latency_report{input_latency_report}
     {
     }
 
@@ -78,7 +82,9 @@ public:
 private:
     std::shared_ptr<mg::GraphicBufferAllocator> const allocator;
     std::shared_ptr<mir::Executor> const wayland_executor;
-    std::shared_ptr<mir::Executor> const frame_callback_executor;
+    std::shared_ptr<FrameExecutor> const frame_callback_executor;
+    HiddenSurfaceFramePolicy const hidden_frame_policy;
+    std::shared_ptr<mi::InputLatencyReport> const input_latency_report;
     std::map<std::pair<wl_client*, uint32_t>, std::vector<std::function<void(WlSurface*)>>> surface_callbacks;
 
     class Instance : wayland::Compositor
@@ -122,7 +128,9 @@ void WlCompositor::Instance::create_surface(wl_resource* new_surface)
         new_surface,
         compositor->wayland_executor,
         compositor->frame_callback_executor,
-        compositor->allocator};
+        compositor->hidden_frame_policy,
+        compositor->allocator,
+        compositor->input_latency_report};
     auto const key = std::make_pair(wl_resource_get_client(new_surface), wl_resource_get_id(new_surface));
     auto const callbacks = compositor->surface_callbacks.find(key);
     if (callbacks != compositor->surface_callbacks.end())
@@ -219,6 +227,7 @@ mf::WaylandConnector::WaylandConnector(
     std::shared_ptr<time::Clock> const& clock,
     std::shared_ptr<mi::InputDeviceHub> const& input_hub,
     std::shared_ptr<mi::Seat> const& seat,
+    std::shared_ptr<mi::InputLatencyReport> const& input_latency_report,
     std::shared_ptr<ObserverRegistrar<input::KeyboardObserver>> const& keyboard_observer_registrar,
     std::shared_ptr<mi::InputDeviceRegistry> const& input_device_registry,
     std::shared_ptr<mi::CompositeEventFilter> const& composite_event_filter,
@@ -235,7 +244,10 @@ mf::WaylandConnector::WaylandConnector(
     bool arw_socket,
     std::unique_ptr<WaylandExtensions> extensions_,
     WaylandProtocolExtensionFilter const& extension_filter,
-    bool enable_key_repeat)
+    bool enable_key_repeat,
+    int hidden_surface_frame_rate,
+    bool coalesce_pointer_motion,
+    bool resample_touch)
     : extension_filter{extension_filter},
       display{wl_display_create(), &cleanup_display},
       pause_signal{eventfd(0, EFD_CLOEXEC | EFD_SEMAPHORE)},
@@ -273,11 +285,14 @@ mf::WaylandConnector::WaylandConnector(
      * So far I've only found ones which expect wl_compositor before anything else,
      * so stick that first.
      */
+    auto const frame_executor = std::make_shared<FrameExecutor>(clock, *main_loop);
     compositor_global = std::make_unique<mf::WlCompositor>(
         display.get(),
         executor,
-        std::make_shared<FrameExecutor>(*main_loop),
-        this->allocator);
+        frame_executor,
+        HiddenSurfaceFramePolicy{hidden_surface_frame_rate},
+        this->allocator,
+        input_latency_report);
     subcompositor_global = std::make_unique<mf::WlSubcompositor>(display.get());
     seat_global = std::make_unique<mf::WlSeat>(
         display.get(),
@@ -286,6 +301,13 @@ mf::WaylandConnector::WaylandConnector(
         input_hub,
         keyboard_observer_registrar,
         seat,
+        input_latency_report,
+        coalesce_pointer_motion ?
+            std::optional<WlPointer::MotionCoalescing>{{executor, frame_executor, input_latency_report}} :
+            std::nullopt,
+        resample_touch ?
+            std::optional<WlTouch::Resampling>{{executor, frame_executor}} :
+            std::nullopt,
         enable_key_repeat);
     output_manager = std::make_unique<mf::OutputManager>(
         display.get(),
@@ -42,6 +42,7 @@ class InputDeviceRegistry;
 class Seat;
 class CompositeEventFilter;
 class KeyboardObserver;
+class InputLatencyReport;
 }
 namespace graphics
 {
@@ -125,6 +126,7 @@ public:
         std::shared_ptr<time::Clock> const& clock,
         std::shared_ptr<input::InputDeviceHub> const& input_hub,
         std::shared_ptr<input::Seat> const& seat,
+        std::shared_ptr<input::InputLatencyReport> const& input_latency_report,
         std::shared_ptr<ObserverRegistrar<input::KeyboardObserver>> const& keyboard_observer_registrar,
         std::shared_ptr<input::InputDeviceRegistry> const& input_device_registry,
         std::shared_ptr<input::CompositeEventFilter> const& composite_event_filter,
@@ -141,7 +143,10 @@ public:
         bool arw_socket,
         std::unique_ptr<WaylandExtensions> extensions,
         WaylandProtocolExtensionFilter const& extension_filter,
-        bool enable_key_repeat);
+        bool enable_key_repeat,
+        int hidden_surface_frame_rate,
+        bool coalesce_pointer_motion,
+        bool resample_touch);
 
     ~WaylandConnector() override;
 
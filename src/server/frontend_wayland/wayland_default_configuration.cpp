@@ -37,6 +37,10 @@
 #include "idle_inhibit_v1.h"
 #include "wlr_screencopy_v1.h"
 #include "primary_selection_v1.h"
+#include "presentation_time.h"
+#include "viewporter.h"
+#include "fractional_scale_v1.h"
+#include "single_pixel_buffer_v1.h"
 
 #include "mir/graphics/platform.h"
 #include "mir/options/default_configuration.h"
@@ -173,6 +177,22 @@ std::vector<ExtensionBuilder> const internal_extension_builders = {
         {
             return mf::create_primary_selection_device_manager_v1(ctx.display, ctx.wayland_executor, ctx.primary_selection_clipboard);
         }),
+    make_extension_builder<mw::Presentation>([](auto const& ctx)
+        {
+            return mf::create_presentation_time(ctx.display, ctx.output_manager);
+        }),
+    make_extension_builder<mw::Viewporter>([](auto const& ctx)
+        {
+            return mf::create_viewporter(ctx.display);
+        }),
+    make_extension_builder<mw::FractionalScaleManagerV1>([](auto const& ctx)
+        {
+            return mf::create_fractional_scale_manager_v1(ctx.display, ctx.wayland_executor, ctx.output_manager);
+        }),
+    make_extension_builder<mw::SinglePixelBufferManagerV1>([](auto const& ctx)
+        {
+            return mf::create_single_pixel_buffer_manager_v1(ctx.display);
+        }),
 };
 
 ExtensionBuilder const xwayland_builder {
@@ -270,7 +290,11 @@ auto mf::get_standard_extensions() -> std::vector<std::string>
         mw::XdgOutputManagerV1::interface_name,
         mw::TextInputManagerV1::interface_name,
         mw::TextInputManagerV2::interface_name,
-        mw::TextInputManagerV3::interface_name};
+        mw::TextInputManagerV3::interface_name,
+        mw::Presentation::interface_name,
+        mw::Viewporter::interface_name,
+        mw::FractionalScaleManagerV1::interface_name,
+        mw::SinglePixelBufferManagerV1::interface_name};
 }
 
 auto mf::get_supported_extensions() -> std::vector<std::string>
@@ -303,6 +327,7 @@ std::shared_ptr<mf::Connector>
                 the_clock(),
                 the_input_device_hub(),
                 the_seat(),
+                the_input_latency_report(),
                 the_keyboard_observer_registrar(),
                 the_input_device_registry(),
                 the_composite_event_filter(),
@@ -322,7 +347,10 @@ std::shared_ptr<mf::Connector>
                     options->is_set(mo::x11_display_opt),
                     wayland_extension_hooks),
                 wayland_extension_filter,
-                enable_repeat);
+                enable_repeat,
+                options->get<int>(options::hidden_surface_frame_rate_opt),
+                options->get<bool>(options::coalesce_pointer_motion_opt),
+                options->get<bool>(options::resample_touch_opt));
         });
 }
 
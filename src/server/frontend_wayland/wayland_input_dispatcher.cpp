@@ -20,8 +20,11 @@
 #include "wl_pointer.h"
 #include "wl_keyboard.h"
 #include "wl_touch.h"
+#include "wl_client.h"
 
 #include <mir/input/keymap.h>
+#include <mir/input/input_latency_report.h>
+#include <mir/events/input_event.h>
 #include <mir/wayland/client.h>
 #include <mir/events/pointer_event.h>
 #include <mir/events/touch_event.h>
@@ -47,6 +50,8 @@ void mf::WaylandInputDispatcher::handle_event(std::shared_ptr<MirInputEvent cons
         return;
     }
 
+    bool sent{false};
+
     switch (mir_input_event_get_type(event.get()))
     {
     case mir_input_event_type_pointer:
@@ -54,7 +59,9 @@ void mf::WaylandInputDispatcher::handle_event(std::shared_ptr<MirInputEvent cons
         auto const pointer_event = dynamic_pointer_cast<MirPointerEvent const>(event);
         seat->for_each_listener(wl_surface.value().client, [&](WlPointer* pointer)
             {
-                pointer->event(pointer_event, wl_surface.value());
+                // Held back motion is reported as sent when the pointer flushes it
+                if (pointer->event(pointer_event, wl_surface.value()))
+                    sent = true;
             });
     }   break;
 
@@ -64,6 +71,7 @@ void mf::WaylandInputDispatcher::handle_event(std::shared_ptr<MirInputEvent cons
         seat->for_each_listener(wl_surface.value().client, [&](WlTouch* touch)
             {
                 touch->event(touch_event, wl_surface.value());
+                sent = true;
             });
     }   break;
 
@@ -72,4 +80,11 @@ void mf::WaylandInputDispatcher::handle_event(std::shared_ptr<MirInputEvent cons
     default:
         break;
     }
+
+    if (sent)
+    {
+        auto const event_time = event->event_time();
+        seat->input_latency_report().sent_event(event_time);
+        WlClient::from(wl_surface.value().client->raw_client()).unanswered_input_time() = event_time;
+    }
 }
@@ -108,10 +108,15 @@ void mf::WaylandSurfaceObserver::input_consumed(ms::Surface const*, std::shared_
 {
     if (mir_event_get_type(event.get()) == mir_event_type_input)
     {
-        run_on_wayland_thread_unless_window_destroyed(
-            [event](Impl* impl, WindowWlSurfaceRole*)
+        // Input is by far the most frequent notification, so this avoids the extra std::function (and allocation)
+        // that run_on_wayland_thread_unless_window_destroyed() wraps around the work
+        wayland_executor.spawn(
+            [impl=impl, event=std::dynamic_pointer_cast<MirInputEvent const>(event)]
             {
-                impl->input_dispatcher->handle_event(std::dynamic_pointer_cast<MirInputEvent const>(event));
+                if (impl->window)
+                {
+                    impl->input_dispatcher->handle_event(event);
+                }
             });
     }
 }
@@ -23,6 +23,7 @@
 #include "mir/shell/shell.h"
 #include "mir/scene/session.h"
 #include "mir/fatal.h"
+#include "mir/log.h"
 
 #include <wayland-server-core.h>
 
@@ -94,12 +95,39 @@ void mf::WlClient::setup_new_client_handler(
     wl_display_add_destroy_listener(display, &context->display_destruction_listener);
 }
 
+namespace
+{
+void log_frame_callback_counts(mir::scene::Session const& session, mf::FrameCallbackCounts::Counts const& counts)
+{
+    mir::log_debug(
+        "Client %s: %lu frame callbacks sent, held back %lu times while hidden",
+        session.name().c_str(),
+        static_cast<unsigned long>(counts.sent),
+        static_cast<unsigned long>(counts.throttled));
+}
+}
+
 mf::WlClient::~WlClient()
 {
+    auto const counts = frame_callback_counts_.counts();
+    if (counts.throttled)
+        log_frame_callback_counts(*session, counts);
     shell->close_session(session);
     unregister_client(client);
 }
 
+void mf::WlClient::frame_callbacks_throttled()
+{
+    frame_callback_counts_.throttled();
+    if (auto const counts = frame_callback_counts_.due_for_logging(std::chrono::steady_clock::now()))
+        log_frame_callback_counts(*session, *counts);
+}
+
+auto mf::WlClient::from(wl_client* client) -> WlClient&
+{
+    return static_cast<WlClient&>(wayland::Client::from(client));
+}
+
 auto mf::WlClient::next_serial(std::shared_ptr<MirEvent const> event) -> uint32_t
 {
     auto const serial = wl_display_next_serial(display);
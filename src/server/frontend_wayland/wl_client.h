@@ -20,11 +20,14 @@
 struct wl_listener;
 struct wl_display;
 
+#include <chrono>
 #include <memory>
 #include <functional>
 #include <optional>
 #include <deque>
+#include <cstdint>
 
+#include "frame_callback_counts.h"
 #include "mir/wayland/client.h"
 
 struct MirEvent;
@@ -53,6 +56,9 @@ public:
 
     ~WlClient();
 
+    /// Every Wayland client is a WlClient
+    static auto from(wl_client* client) -> WlClient&;
+
     auto raw_client() const -> wl_client* override { return client; }
 
     auto is_being_destroyed() const -> bool override { return !owned_self; }
@@ -66,6 +72,17 @@ public:
     void set_output_geometry_scale(float scale) override { output_geometry_scale_ = scale; }
     auto output_geometry_scale() -> float override { return output_geometry_scale_; }
 
+    /// Counts frame callbacks sent to the client
+    void frame_callbacks_sent(uint64_t count) { frame_callback_counts_.sent(count); }
+    /// Counts frame callbacks held back because the surface could not be seen. The counts are logged periodically
+    /// while this happens, and when the client disconnects.
+    void frame_callbacks_throttled();
+    auto frame_callback_counts() const -> FrameCallbackCounts::Counts { return frame_callback_counts_.counts(); }
+
+    /// The time of the latest input event sent to the client since it last committed a buffer, which that buffer
+    /// is taken to answer when reporting input latency
+    auto unanswered_input_time() -> std::optional<std::chrono::nanoseconds>& { return unanswered_input_time_; }
+
 private:
     WlClient(wl_client* client, std::shared_ptr<scene::Session> const& session, shell::Shell* shell);
 
@@ -81,6 +98,8 @@ private:
     std::shared_ptr<WlClient> owned_self;
     std::deque<std::pair<uint32_t, std::shared_ptr<MirEvent const>>> serial_event_pairs;
     float output_geometry_scale_{1};
+    FrameCallbackCounts frame_callback_counts_;
+    std::optional<std::chrono::nanoseconds> unanswered_input_time_;
 };
 }
 }
@@ -17,6 +17,8 @@
 #include "wl_pointer.h"
 
 #include "wayland_utils.h"
+#include "pointer_motion_coalescer.h"
+#include "wl_client.h"
 #include "wl_surface.h"
 #include "wl_seat.h"
 #include "relative-pointer-unstable-v1_wrapper.h"
@@ -32,11 +34,12 @@
 #include "mir/renderer/sw/pixel_source.h"
 #include "mir/compositor/buffer_stream.h"
 #include "mir/events/pointer_event.h"
+#include "mir/input/input_latency_report.h"
 #include "mir/wayland/client.h"
 
 #include <linux/input-event-codes.h>
 #include <boost/throw_exception.hpp>
-#include <string.h> // memcpy
+#include <algorithm>
 
 namespace mf = mir::frontend;
 namespace ms = mir::scene;
@@ -52,18 +55,21 @@ class BufferCursorImage : public mg::CursorImage
 {
 public:
     BufferCursorImage(std::shared_ptr<mg::Buffer> buffer, geom::Displacement const& hotspot)
-        : BufferCursorImage(buffer_to_mapping_if_possible(buffer), hotspot)
+        : buffer{read_mappable_if_possible(std::move(buffer))},
+          mapping{this->buffer->map_readable()},
+          hotspot_{hotspot}
     {
     }
 
+    // The pixels are read straight from the client's buffer: the cursor consumes them when it's shown
     auto as_argb_8888() const -> void const* override
     {
-        return data.get();
+        return mapping->data();
     }
 
     auto size() const -> geom::Size override
     {
-        return size_;
+        return mapping->size();
     }
 
     auto hotspot() const -> geom::Displacement override
@@ -72,29 +78,21 @@ public:
     }
 
 private:
-    BufferCursorImage(std::unique_ptr<mrs::Mapping<unsigned char const>> mapping, geom::Displacement const& hotspot)
-        : size_{mapping->size()},
-          data{std::make_unique<unsigned char[]>(mapping->len())},
-          hotspot_{hotspot}
-    {
-        ::memcpy(data.get(), mapping->data(), mapping->len());
-    }
-
-    static auto buffer_to_mapping_if_possible(std::shared_ptr<mg::Buffer> const& buffer)
-        -> std::unique_ptr<mrs::Mapping<unsigned char const>>
+    static auto read_mappable_if_possible(std::shared_ptr<mg::Buffer> buffer)
+        -> std::shared_ptr<mrs::ReadMappableBuffer>
     {
-        auto const mappable_buffer = mrs::as_read_mappable_buffer(buffer);
+        auto mappable_buffer = mrs::as_read_mappable_buffer(std::move(buffer));
         if (!mappable_buffer)
         {
             BOOST_THROW_EXCEPTION(
                 std::runtime_error{
                     "Attempt to create cursor from non-CPU-readable buffer. Rendering will be incomplete"});
         }
-        return mappable_buffer->map_readable();
+        return mappable_buffer;
     }
 
-    geom::Size const size_;
-    std::unique_ptr<unsigned char[]> const data;
+    std::shared_ptr<mrs::ReadMappableBuffer> const buffer;
+    std::unique_ptr<mrs::Mapping<unsigned char const>> const mapping;
     geom::Displacement const hotspot_;
 };
 
@@ -114,6 +112,12 @@ auto timestamp_of(std::shared_ptr<MirPointerEvent const> const& event) -> uint32
     return mir_input_event_get_wayland_timestamp(mir_pointer_event_input_event(event.get()));
 }
 
+/// Whether the event carries any scrolling, which must not overtake the motion before it
+auto scrolls(MirPointerEvent const& event) -> bool
+{
+    return event.h_scroll() != mir::events::ScrollAxisH{} || event.v_scroll() != mir::events::ScrollAxisV{};
+}
+
 auto wayland_axis_source(MirPointerAxisSource mir_source) -> std::optional<uint32_t>
 {
     switch (mir_source)
@@ -174,9 +178,22 @@ auto mf::WlPointer::linux_button_to_mir_button(int linux_button) -> std::optiona
     return std::nullopt;
 }
 
-mf::WlPointer::WlPointer(wl_resource* new_resource)
+mf::WlPointer::WlPointer(wl_resource* new_resource, std::optional<MotionCoalescing> const& motion_coalescing)
     : Pointer(new_resource, Version<8>()),
-      cursor{std::make_unique<NullCursor>()}
+      cursor{std::make_unique<NullCursor>()},
+      motion_coalescer{motion_coalescing ?
+          std::make_unique<PointerMotionCoalescer>(
+              motion_coalescing->wayland_executor,
+              motion_coalescing->frame_executor,
+              [this, report = motion_coalescing->input_latency_report](PointerMotionCoalescer::Motion const& motion)
+              {
+                  send_motion_event(motion.timestamp, motion.position.first, motion.position.second);
+                  needs_frame = true;
+                  report->sent_event(motion.event_time);
+                  WlClient::from(client->raw_client()).unanswered_input_time() = motion.event_time;
+              },
+              [this]() { maybe_frame(); }) :
+          nullptr}
 {
 }
 
@@ -191,24 +208,34 @@ void mir::frontend::WlPointer::set_relative_pointer(mir::wayland::RelativePointe
     relative_pointer = make_weak(relative_ptr);
 }
 
-void mir::frontend::WlPointer::event(std::shared_ptr<MirPointerEvent const> const& event, WlSurface& root_surface)
+auto mir::frontend::WlPointer::event(std::shared_ptr<MirPointerEvent const> const& event, WlSurface& root_surface)
+    -> bool
 {
-    switch(mir_pointer_event_action(event.get()))
+    auto const action = mir_pointer_event_action(event.get());
+
+    // Only plain motion is held back, anything else is sent after the motion that preceded it
+    bool const hold_motion = motion_coalescer && action == mir_pointer_action_motion && !scrolls(*event);
+    if (!hold_motion)
+    {
+        send_pending_motion();
+    }
+
+    switch(action)
     {
         case mir_pointer_action_button_down:
         case mir_pointer_action_button_up:
-            enter_or_motion(event, root_surface);
+            enter_or_motion(event, root_surface, false);
             buttons(event);
             break;
         case mir_pointer_action_enter:
-            enter_or_motion(event, root_surface);
+            enter_or_motion(event, root_surface, false);
             axes(event);
             break;
         case mir_pointer_action_leave:
             leave(event);
             break;
         case mir_pointer_action_motion:
-            enter_or_motion(event, root_surface);
+            enter_or_motion(event, root_surface, hold_motion);
             relative_motion(event);
             axes(event);
             break;
@@ -216,13 +243,16 @@ void mir::frontend::WlPointer::event(std::shared_ptr<MirPointerEvent const> cons
             break;
     }
 
+    bool const sent = needs_frame;
     maybe_frame();
+    return sent;
 }
 
 void mf::WlPointer::leave(std::optional<std::shared_ptr<MirPointerEvent const>> const& event)
 {
     if (!surface_under_cursor)
         return;
+    send_pending_motion();
     surface_under_cursor.value().remove_destroy_listener(destroy_listener_id);
     auto const serial = client->next_serial(event.value_or(nullptr));
     send_leave_event(
@@ -311,7 +341,10 @@ void mf::WlPointer::axes(std::shared_ptr<MirPointerEvent const> const& event)
     }
 }
 
-void mf::WlPointer::enter_or_motion(std::shared_ptr<MirPointerEvent const> const& event, WlSurface& root_surface)
+void mf::WlPointer::enter_or_motion(
+    std::shared_ptr<MirPointerEvent const> const& event,
+    WlSurface& root_surface,
+    bool hold_motion)
 {
     auto const root_position = std::make_pair(
         mir_pointer_event_axis_value(event.get(), mir_pointer_axis_x),
@@ -364,12 +397,23 @@ void mf::WlPointer::enter_or_motion(std::shared_ptr<MirPointerEvent const> const
             break;
 
         default:
-            send_motion_event(
-                timestamp_of(event),
-                position_on_target.first,
-                position_on_target.second);
+            if (hold_motion)
+            {
+                // Sent as the compositor snapshots the surface, so the client has a whole frame to respond in
+                auto due = root_surface.next_composite();
+                if (!due)
+                    due = root_surface.next_vblank();
+                motion_coalescer->hold({timestamp_of(event), position_on_target, event->event_time()}, due);
+            }
+            else
+            {
+                send_motion_event(
+                    timestamp_of(event),
+                    position_on_target.first,
+                    position_on_target.second);
+                needs_frame = true;
+            }
             current_position = position_on_target;
-            needs_frame = true;
         }
     }
 }
@@ -403,6 +447,14 @@ void mf::WlPointer::maybe_frame()
     needs_frame = false;
 }
 
+void mf::WlPointer::send_pending_motion()
+{
+    if (motion_coalescer)
+    {
+        motion_coalescer->flush();
+    }
+}
+
 namespace
 {
 struct CursorSurfaceRole : mf::NullWlSurfaceRole
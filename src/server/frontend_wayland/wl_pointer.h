@@ -26,6 +26,7 @@
 
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <set>
 
@@ -43,10 +44,16 @@ class Client;
 }
 
 class Executor;
+namespace input
+{
+class InputLatencyReport;
+}
 
 namespace frontend
 {
 class WlSurface;
+class PointerMotionCoalescer;
+class FrameExecutor;
 
 class CommitHandler
 {
@@ -65,15 +72,27 @@ class WlPointer : public wayland::Pointer, private CommitHandler
 public:
     static auto linux_button_to_mir_button(int linux_button) -> std::optional<MirPointerButtons>;
 
-    WlPointer(wl_resource* new_resource);
+    /// Holds back plain motion so that a client is sent at most one motion per composite of its surface. Relative
+    /// motion is still sent as it arrives.
+    struct MotionCoalescing
+    {
+        std::shared_ptr<Executor> wayland_executor;
+        std::shared_ptr<FrameExecutor> frame_executor;
+        /// Held back motion is reported as sent when it is flushed
+        std::shared_ptr<input::InputLatencyReport> input_latency_report;
+    };
+
+    /// Motion is coalesced if motion_coalescing is given, otherwise every motion is sent as it arrives
+    WlPointer(wl_resource* new_resource, std::optional<MotionCoalescing> const& motion_coalescing);
 
     ~WlPointer();
 
     void set_relative_pointer(wayland::RelativePointerV1* relative_ptr);
 
     /// Convert the Mir event into Wayland events and send them to the client. root_surface is the one that received
-    /// the Mir event, but the final Wayland event may be sent to a subsurface.
-    void event(std::shared_ptr<MirPointerEvent const> const& event, WlSurface& root_surface);
+    /// the Mir event, but the final Wayland event may be sent to a subsurface. Returns false if nothing was sent
+    /// (including when the motion is held back).
+    auto event(std::shared_ptr<MirPointerEvent const> const& event, WlSurface& root_surface) -> bool;
 
     struct Cursor;
 
@@ -88,11 +107,17 @@ private:
     void axes(std::shared_ptr<MirPointerEvent const> const& event);
     /// Handles finding the correct subsurface and position on that subsurface if needed
     /// Giving it an already transformed surface and position is also fine
-    void enter_or_motion(std::shared_ptr<MirPointerEvent const> const& event, WlSurface& root_surface);
+    /// If hold_motion is true a motion is left pending rather than sent
+    void enter_or_motion(
+        std::shared_ptr<MirPointerEvent const> const& event,
+        WlSurface& root_surface,
+        bool hold_motion);
     /// Sends relative motion only if the relative pointer is set
     void relative_motion(std::shared_ptr<MirPointerEvent const> const& event);
     /// Sends a frame event only if needed, leaves needs_frame false
     void maybe_frame();
+    /// Sends the motion being held back, if any
+    void send_pending_motion();
     /// The cursor surface has committed
     void on_commit(WlSurface* surface) override;
 
@@ -114,6 +139,9 @@ private:
     std::unique_ptr<Cursor> cursor;
     wayland::Weak<wayland::RelativePointerV1> relative_pointer;
     geometry::Displacement cursor_hotspot;
+
+    /// Held back motion is already reflected in current_position
+    std::unique_ptr<PointerMotionCoalescer> const motion_coalescer;
 };
 
 }
@@ -19,7 +19,7 @@
 
 #include "wayland_wrapper.h"
 
-#include "mir/geometry/rectangle.h"
+#include "mir/geometry/region.h"
 
 #include <vector>
 
@@ -42,7 +42,7 @@ private:
     void add(int32_t x, int32_t y, int32_t width, int32_t height) override;
     void subtract(int32_t x, int32_t y, int32_t width, int32_t height) override;
 
-    std::vector<geometry::Rectangle> rects;
+    geometry::Region region;
 };
 
 }
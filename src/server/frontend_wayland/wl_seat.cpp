@@ -192,6 +192,9 @@ mf::WlSeat::WlSeat(
     std::shared_ptr<mi::InputDeviceHub> const& input_hub,
     std::shared_ptr<ObserverRegistrar<input::KeyboardObserver>> const& keyboard_observer_registrar,
     std::shared_ptr<mi::Seat> const& seat,
+    std::shared_ptr<mi::InputLatencyReport> const& input_latency_report,
+    std::optional<WlPointer::MotionCoalescing> const& pointer_motion_coalescing,
+    std::optional<WlTouch::Resampling> const& touch_resampling,
     bool enable_key_repeat)
     :   Global(display, Version<8>()),
         keymap{std::make_shared<input::ParameterKeymap>()},
@@ -211,6 +214,9 @@ mf::WlSeat::WlSeat(
         clock{clock},
         input_hub{input_hub},
         seat{seat},
+        latency_report{input_latency_report},
+        pointer_motion_coalescing{pointer_motion_coalescing},
+        touch_resampling{touch_resampling},
         enable_key_repeat{enable_key_repeat}
 {
     input_hub->add_observer(config_observer);
@@ -311,7 +317,7 @@ mf::WlSeat::Instance::Instance(wl_resource* new_resource, mf::WlSeat* seat)
 
 void mf::WlSeat::Instance::get_pointer(wl_resource* new_pointer)
 {
-    auto const pointer = new WlPointer{new_pointer};
+    auto const pointer = new WlPointer{new_pointer, seat->pointer_motion_coalescing};
     seat->pointer_listeners->register_listener(client, pointer);
     pointer->add_destroy_listener(
         [listeners = seat->pointer_listeners, listener = pointer, client = client]()
@@ -334,7 +340,7 @@ void mf::WlSeat::Instance::get_keyboard(wl_resource* new_keyboard)
 
 void mf::WlSeat::Instance::get_touch(wl_resource* new_touch)
 {
-    auto const touch = new WlTouch{new_touch, seat->clock};
+    auto const touch = new WlTouch{new_touch, seat->clock, seat->touch_resampling};
     seat->touch_listeners->register_listener(client, touch);
     touch->add_destroy_listener(
         [listeners = seat->touch_listeners, listener = touch, client = client]()
@@ -18,11 +18,14 @@
 #define MIR_FRONTEND_WL_SEAT_H
 
 #include "wayland_wrapper.h"
+#include "wl_pointer.h"
+#include "wl_touch.h"
 #include "mir/wayland/weak.h"
 
 #include <unordered_map>
 #include <vector>
 #include <functional>
+#include <optional>
 
 namespace mir
 {
@@ -35,6 +38,7 @@ class InputDeviceHub;
 class Seat;
 class Keymap;
 class KeyboardObserver;
+class InputLatencyReport;
 }
 namespace time
 {
@@ -59,6 +63,9 @@ public:
         std::shared_ptr<mir::input::InputDeviceHub> const& input_hub,
         std::shared_ptr<ObserverRegistrar<input::KeyboardObserver>> const& keyboard_observer_registrar,
         std::shared_ptr<mir::input::Seat> const& seat,
+        std::shared_ptr<input::InputLatencyReport> const& input_latency_report,
+        std::optional<WlPointer::MotionCoalescing> const& pointer_motion_coalescing,
+        std::optional<WlTouch::Resampling> const& touch_resampling,
         bool enable_key_repeat);
 
     ~WlSeat();
@@ -88,6 +95,8 @@ public:
     void add_focus_listener(wayland::Client* client, FocusListener* listener);
     void remove_focus_listener(wayland::Client* client, FocusListener* listener);
 
+    auto input_latency_report() const -> input::InputLatencyReport& { return *latency_report; }
+
 private:
     void set_focus_to(WlSurface* surface);
 
@@ -116,6 +125,9 @@ private:
     std::shared_ptr<time::Clock> const clock;
     std::shared_ptr<input::InputDeviceHub> const input_hub;
     std::shared_ptr<input::Seat> const seat;
+    std::shared_ptr<input::InputLatencyReport> const latency_report;
+    std::optional<WlPointer::MotionCoalescing> const pointer_motion_coalescing;
+    std::optional<WlTouch::Resampling> const touch_resampling;
     bool const enable_key_repeat;
 
     void bind(wl_resource* new_wl_seat) override;
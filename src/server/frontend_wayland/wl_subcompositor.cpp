@@ -165,6 +165,14 @@ void mf::WlSubsurface::refresh_surface_data_now()
     }
 }
 
+void mf::WlSubsurface::surface_data_changed()
+{
+    if (parent)
+    {
+        parent.value().drop_cached_surface_data();
+    }
+}
+
 void mf::WlSubsurface::commit(WlSurfaceState const& state)
 {
     if (!cached_state)
@@ -75,6 +75,7 @@ private:
     void set_desync() override;
 
     void refresh_surface_data_now() override;
+    void surface_data_changed() override;
     virtual void commit(WlSurfaceState const& state) override;
     void surface_destroyed() override;
 
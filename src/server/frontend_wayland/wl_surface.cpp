@@ -20,6 +20,11 @@
 #include "wl_surface_role.h"
 #include "wl_subcompositor.h"
 #include "wl_region.h"
+#include "presentation_time.h"
+#include "viewporter.h"
+#include "fractional_scale_v1.h"
+#include "single_pixel_buffer_v1.h"
+#include "wl_client.h"
 #include "shm.h"
 #include "deleted_for_resource.h"
 
@@ -30,15 +35,18 @@
 #include "mir/wayland/protocol_error.h"
 #include "mir/wayland/client.h"
 #include "mir/graphics/buffer_properties.h"
+#include "mir/graphics/frame.h"
 #include "mir/scene/session.h"
 #include "mir/frontend/wayland.h"
 #include "mir/compositor/buffer_stream.h"
 #include "mir/executor.h"
 #include "mir/graphics/graphic_buffer_allocator.h"
+#include "mir/input/input_latency_report.h"
 #include "mir/scene/surface.h"
 #include "mir/shell/surface_specification.h"
 #include "mir/log.h"
 
+#include <algorithm>
 #include <chrono>
 #include <boost/throw_exception.hpp>
 #include <wayland-server-protocol.h>
@@ -67,10 +75,23 @@ void mf::WlSurfaceState::update_from(WlSurfaceState const& source)
     if (source.input_shape)
         input_shape = source.input_shape;
 
+    if (source.opaque_region)
+        opaque_region = source.opaque_region;
+
+    if (source.viewport_source)
+        viewport_source = source.viewport_source;
+
+    if (source.viewport_destination)
+        viewport_destination = source.viewport_destination;
+
     frame_callbacks.insert(end(frame_callbacks),
                            begin(source.frame_callbacks),
                            end(source.frame_callbacks));
 
+    presentation_feedbacks.insert(end(presentation_feedbacks),
+                                  begin(source.presentation_feedbacks),
+                                  end(source.presentation_feedbacks));
+
     if (source.surface_data_invalidated)
         surface_data_invalidated = true;
 }
@@ -79,20 +100,33 @@ bool mf::WlSurfaceState::surface_data_needs_refresh() const
 {
     return offset ||
            input_shape ||
+           opaque_region ||
+           viewport_source ||
+           viewport_destination ||
            surface_data_invalidated;
 }
 
+struct mf::WlSurface::SurfaceData
+{
+    std::vector<msh::StreamSpecification> streams;
+    std::vector<geom::Rectangle> input_shape;
+};
+
 mf::WlSurface::WlSurface(
     wl_resource* new_resource,
     std::shared_ptr<Executor> const& wayland_executor,
-    std::shared_ptr<Executor> const& frame_callback_executor,
-    std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator)
+    std::shared_ptr<FrameExecutor> const& frame_callback_executor,
+    HiddenSurfaceFramePolicy const& hidden_frame_policy,
+    std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator,
+    std::shared_ptr<input::InputLatencyReport> const& input_latency_report)
     : Surface(new_resource, Version<4>()),
         session{client->client_session()},
         stream{session->create_buffer_stream({{}, mir_pixel_format_invalid, graphics::BufferUsage::undefined})},
         allocator{allocator},
         wayland_executor{wayland_executor},
         frame_callback_executor{frame_callback_executor},
+        hidden_frame_policy{hidden_frame_policy},
+        input_latency_report{input_latency_report},
         null_role{this},
         role{&null_role}
 {
@@ -107,6 +141,25 @@ mf::WlSurface::~WlSurface()
     // all bases and non-variant members have already been destroyed."
     try
     {
+        for (auto const& awaiting : awaiting_presentation)
+        {
+            for (auto const& feedback : awaiting.feedbacks)
+            {
+                if (feedback)
+                    feedback.value().discarded();
+            }
+        }
+        for (auto const& feedback : awaiting_next_frame)
+        {
+            if (feedback)
+                feedback.value().discarded();
+        }
+        for (auto const& feedback : pending.presentation_feedbacks)
+        {
+            if (feedback)
+                feedback.value().discarded();
+        }
+
         // Destroy the buffer stream first, as surface_destroyed() may throw
         session->destroy_buffer_stream(stream);
         role->surface_destroyed();
@@ -176,6 +229,7 @@ void mf::WlSurface::add_subsurface(WlSubsurface* child)
     }
 
     children.push_back(child);
+    drop_cached_surface_data();
 }
 
 void mf::WlSurface::remove_subsurface(WlSubsurface* child)
@@ -186,6 +240,7 @@ void mf::WlSurface::remove_subsurface(WlSubsurface* child)
             children.end(),
             child),
         children.end());
+    drop_cached_surface_data();
 }
 
 void mf::WlSurface::refresh_surface_data_now()
@@ -197,17 +252,57 @@ void mf::WlSurface::populate_surface_data(std::vector<shell::StreamSpecification
                                           std::vector<geom::Rectangle>& input_shape_accumulator,
                                           geometry::Displacement const& parent_offset) const
 {
-    geometry::Displacement offset = parent_offset + offset_;
+    if (!cached_surface_data)
+    {
+        // Subsurfaces that haven't changed since keep theirs, so only the changed branch is walked
+        cached_surface_data = std::make_unique<SurfaceData>();
+        build_surface_data(cached_surface_data->streams, cached_surface_data->input_shape);
+    }
+
+    auto const offset = parent_offset + offset_;
+    for (auto stream_spec : cached_surface_data->streams)
+    {
+        stream_spec.displacement = stream_spec.displacement + offset;
+        buffer_streams.push_back(std::move(stream_spec));
+    }
+    for (auto rect : cached_surface_data->input_shape)
+    {
+        // Empty rectangles (clipped away, or standing in for an empty input shape) don't go anywhere
+        if (rect != geom::Rectangle{})
+            rect.top_left = rect.top_left + offset;
+        input_shape_accumulator.push_back(rect);
+    }
+}
+
+void mf::WlSurface::drop_cached_surface_data()
+{
+    cached_surface_data.reset();
+    role->surface_data_changed();
+}
 
-    buffer_streams.push_back(msh::StreamSpecification{stream, offset, {}});
-    geom::Rectangle surface_rect = {geom::Point{} + offset, buffer_size_.value_or(geom::Size{})};
+void mf::WlSurface::build_surface_data(std::vector<shell::StreamSpecification>& buffer_streams,
+                                       std::vector<geom::Rectangle>& input_shape_accumulator) const
+{
+    msh::StreamSpecification stream_spec{stream, {}, {}, opaque_region};
+    if (buffer_size_ && (viewport_source || viewport_destination))
+    {
+        stream_spec.size = buffer_size_.value();
+    }
+    if (viewport_source)
+    {
+        // The crop is in surface coordinates before scaling, which are the buffer's divided by its scale
+        auto const& source = viewport_source.value();
+        stream_spec.src_bounds = geom::RectangleD{
+            {source.left().as_value() * buffer_scale, source.top().as_value() * buffer_scale},
+            {source.size.width.as_value() * buffer_scale, source.size.height.as_value() * buffer_scale}};
+    }
+    buffer_streams.push_back(stream_spec);
+    geom::Rectangle const surface_rect = {{}, buffer_size_.value_or(geom::Size{})};
     if (input_shape)
     {
-        for (auto rect : input_shape.value())
+        for (auto const& rect : input_shape.value())
         {
-            rect.top_left = rect.top_left + offset;
-            rect = intersection_of(rect, surface_rect); // clip to surface
-            input_shape_accumulator.push_back(rect);
+            input_shape_accumulator.push_back(intersection_of(rect, surface_rect)); // clip to surface
         }
 
         // If we have an explicity specified empty input shape all inport should be ignored
@@ -226,7 +321,7 @@ void mf::WlSurface::populate_surface_data(std::vector<shell::StreamSpecification
 
     for (WlSubsurface* subsurface : children)
     {
-        subsurface->populate_surface_data(buffer_streams, input_shape_accumulator, offset);
+        subsurface->populate_surface_data(buffer_streams, input_shape_accumulator, {});
     }
 }
 
@@ -238,17 +333,435 @@ mf::WlSurface* mf::WlSurface::from(wl_resource* resource)
 
 void mf::WlSurface::send_frame_callbacks()
 {
+    auto const now = std::chrono::steady_clock::now();
+    uint64_t sent{0};
     for (auto const& frame : frame_callbacks)
     {
         if (frame)
         {
-            auto const timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::steady_clock::now().time_since_epoch());
+            auto const timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch());
             frame.value().send_done_event(timestamp_ms.count());
             frame.value().destroy_and_delete();
+            ++sent;
         }
     }
     frame_callbacks.clear();
+    frame_callbacks_await_vblank = false;
+    frame_callbacks_throttled = false;
+
+    if (sent)
+    {
+        frame_callbacks_last_sent = now;
+        WlClient::from(client->raw_client()).frame_callbacks_sent(sent);
+    }
+}
+
+void mf::WlSurface::send_frame_callbacks_unless_hidden()
+{
+    if (hidden_frame_policy.throttles() && hidden())
+    {
+        throttle_frame_callbacks();
+    }
+    else
+    {
+        send_frame_callbacks();
+    }
+}
+
+void mf::WlSurface::throttle_frame_callbacks()
+{
+    if (frame_callbacks.empty() || frame_callbacks_throttled)
+        return;
+
+    frame_callbacks_throttled = true;
+    WlClient::from(client->raw_client()).frame_callbacks_throttled();
+
+    // Without a release time the callbacks wait until the surface is next presented (see frame_presented())
+    if (auto const release = hidden_frame_policy.release_time(frame_callbacks_last_sent))
+    {
+        frame_callback_executor->spawn_at(
+            *release,
+            [executor = wayland_executor, weak_self = mw::make_weak(this)]()
+            {
+                executor->spawn([weak_self]()
+                    {
+                        if (weak_self && weak_self.value().frame_callbacks_throttled)
+                        {
+                            weak_self.value().send_frame_callbacks();
+                        }
+                    });
+            });
+    }
+    update_presentation_tracking();
+}
+
+auto mf::WlSurface::hidden() const -> bool
+{
+    auto const scene = scene_surface();
+    if (!scene)
+        return false;
+
+    auto const& surface = scene.value();
+    switch (surface->state())
+    {
+    case mir_window_state_minimized:
+    case mir_window_state_hidden:
+        return true;
+
+    default:
+        // RenderingTracker marks surfaces occluded (including offscreen) once no compositor has rendered them
+        return surface->visible() && surface->query(mir_window_attrib_visibility) == mir_window_visibility_occluded;
+    }
+}
+
+void mf::WlSurface::update_presentation_tracking()
+{
+    // Presentations drive frame callbacks and feedback, but are only worth a round trip to the Wayland thread while
+    // someone is waiting on one
+    bool const wanted = !awaiting_presentation.empty() || !awaiting_next_frame.empty() || !frame_callbacks.empty();
+    if (wanted == tracking_presentation)
+        return;
+
+    tracking_presentation = wanted;
+    if (wanted)
+    {
+        stream->set_frame_presented_callback(
+            [executor = wayland_executor, weak_self = mw::make_weak(this)](
+                graphics::BufferID presented_buffer,
+                geom::Rectangle const& output_area,
+                graphics::Frame const& frame,
+                bool zero_copy)
+            {
+                executor->spawn([weak_self, presented_buffer, output_area, frame, zero_copy]()
+                    {
+                        if (weak_self)
+                        {
+                            weak_self.value().frame_presented(presented_buffer, output_area, frame, zero_copy);
+                        }
+                    });
+            });
+    }
+    else
+    {
+        stream->set_frame_presented_callback([](auto, auto const&, auto const&, auto){});
+    }
+}
+
+auto mf::WlSurface::next_vblank(std::optional<time::Timestamp> after) const -> std::optional<time::Timestamp>
+{
+    auto const now = after.value_or(std::chrono::steady_clock::now());
+    std::optional<time::Timestamp> earliest;
+    for (auto const& timing : output_timings)
+    {
+        if (!timing.refresh)
+            continue;
+
+        // Step forward from the last flip we saw in whole refresh periods
+        time::Timestamp vblank{timing.last_frame.ust.nanoseconds};
+        if (vblank <= now)
+        {
+            auto const periods = (now - vblank) / *timing.refresh + 1;
+            vblank += periods * *timing.refresh;
+        }
+
+        if (!earliest || vblank < *earliest)
+            earliest = vblank;
+    }
+    return earliest;
+}
+
+auto mf::WlSurface::next_composite() const -> std::optional<time::Timestamp>
+{
+    if (!composite_lead)
+        return std::nullopt;
+
+    // The first vblank whose composite has not started yet
+    auto const now = std::chrono::steady_clock::now();
+    if (auto const vblank = next_vblank(now + *composite_lead))
+        return *vblank - *composite_lead;
+
+    return std::nullopt;
+}
+
+void mf::WlSurface::add_presentation_feedback(WpPresentationFeedback* feedback)
+{
+    pending.presentation_feedbacks.push_back(wayland::make_weak(feedback));
+}
+
+void mf::WlSurface::set_viewport(WpViewport* viewport)
+{
+    this->viewport = wayland::make_weak(viewport);
+}
+
+void mf::WlSurface::set_fractional_scale(WpFractionalScaleV1* fractional_scale)
+{
+    this->fractional_scale = wayland::make_weak(fractional_scale);
+}
+
+void mf::WlSurface::set_pending_viewport_source(std::optional<geom::RectangleD> const& source)
+{
+    pending.viewport_source = source;
+}
+
+void mf::WlSurface::set_pending_viewport_destination(std::optional<geom::Size> const& destination)
+{
+    pending.viewport_destination = destination;
+}
+
+auto mf::WlSurface::viewport_size(geom::Size content_size) const -> geom::Size
+{
+    // A viewport destroyed since this state was committed is going away anyway, so its
+    // state is ignored rather than being reported against a resource that no longer exists
+    if (!viewport)
+        return content_size;
+
+    if (viewport_source)
+    {
+        auto const& source = viewport_source.value();
+        if (source.right().as_value() > content_size.width.as_int() ||
+            source.bottom().as_value() > content_size.height.as_int())
+        {
+            BOOST_THROW_EXCEPTION(mw::ProtocolError(
+                viewport.value().resource,
+                mw::Viewport::Error::out_of_buffer,
+                "Source rectangle %fx%f+%f+%f extends outside the %dx%d buffer",
+                source.size.width.as_value(), source.size.height.as_value(),
+                source.left().as_value(), source.top().as_value(),
+                content_size.width.as_int(), content_size.height.as_int()));
+        }
+    }
+
+    if (viewport_destination)
+        return viewport_destination.value();
+
+    if (viewport_source)
+    {
+        auto const& size = viewport_source.value().size;
+        geom::Size const whole_size{size};
+        if (whole_size.width.as_int() != size.width.as_value() || whole_size.height.as_int() != size.height.as_value())
+        {
+            BOOST_THROW_EXCEPTION(mw::ProtocolError(
+                viewport.value().resource,
+                mw::Viewport::Error::bad_size,
+                "Source size %fx%f is not integral and there is no destination size",
+                size.width.as_value(), size.height.as_value()));
+        }
+        return whole_size;
+    }
+
+    return content_size;
+}
+
+void mf::WlSurface::update_buffer_size(WlSurfaceState const& state)
+{
+    auto const new_buffer_size = viewport_size(stream->stream_size());
+
+    if (!input_shape && std::make_optional(new_buffer_size) != buffer_size_)
+    {
+        state.invalidate_surface_data(); // input shape needs to be recalculated for the new size
+    }
+
+    buffer_size_ = new_buffer_size;
+}
+
+void mf::WlSurface::await_presentation(
+    graphics::BufferID buffer,
+    std::vector<wayland::Weak<WpPresentationFeedback>> const& feedbacks,
+    std::optional<std::chrono::nanoseconds> answered_input)
+{
+    if (feedbacks.empty() && !answered_input)
+        return;
+
+    if (!awaiting_presentation.empty() && awaiting_presentation.back().buffer == buffer)
+    {
+        auto& awaiting = awaiting_presentation.back();
+        awaiting.feedbacks.insert(end(awaiting.feedbacks), begin(feedbacks), end(feedbacks));
+        if (!awaiting.answered_input)
+            awaiting.answered_input = answered_input;
+    }
+    else
+    {
+        awaiting_presentation.push_back({buffer, feedbacks, answered_input});
+    }
+}
+
+void mf::WlSurface::frame_presented(
+    graphics::BufferID buffer,
+    geom::Rectangle const& output_area,
+    graphics::Frame const& frame,
+    bool zero_copy)
+{
+    if (frame.ust.clock_id == CLOCK_MONOTONIC)
+    {
+        auto const known = std::find_if(
+            begin(output_timings),
+            end(output_timings),
+            [&](auto const& timing) { return timing.output_area == output_area; });
+
+        if (known == end(output_timings))
+        {
+            output_timings.push_back({output_area, frame, std::nullopt});
+        }
+        else if (frame.msc > known->last_frame.msc && frame.ust.nanoseconds > known->last_frame.ust.nanoseconds)
+        {
+            if (known->last_frame.msc != 0)
+            {
+                known->refresh =
+                    (frame.ust.nanoseconds - known->last_frame.ust.nanoseconds) / (frame.msc - known->last_frame.msc);
+            }
+            known->last_frame = frame;
+        }
+
+        // The buffer consumed last is the one shown on this frame (consumption happens as the frame is composited).
+        // Only a real flip says when the frame was due.
+        if (last_consumed && frame.msc != 0)
+        {
+            auto const lead = time::Timestamp{frame.ust.nanoseconds} - *last_consumed;
+            if (lead > time::Duration::zero() && lead < std::chrono::seconds{1})
+                composite_lead = lead;
+            last_consumed = std::nullopt;
+        }
+
+        // Forget outputs the surface has not been shown on for a while (e.g. it has moved)
+        auto const stale = frame.ust.nanoseconds - std::chrono::seconds{1};
+        output_timings.erase(
+            std::remove_if(
+                begin(output_timings),
+                end(output_timings),
+                [&](auto const& timing) { return timing.last_frame.ust.nanoseconds < stale; }),
+            end(output_timings));
+    }
+
+    if (frame_callbacks_await_vblank || frame_callbacks_throttled)
+    {
+        // Being presented means being seen
+        send_frame_callbacks();
+    }
+
+    if (!awaiting_next_frame.empty() &&
+        (frame.ust.clock_id != CLOCK_MONOTONIC || time::Timestamp{frame.ust.nanoseconds} >= awaiting_next_frame_since))
+    {
+        for (auto const& feedback : awaiting_next_frame)
+        {
+            if (feedback)
+                feedback.value().presented(output_area, frame, zero_copy);
+        }
+        awaiting_next_frame.clear();
+    }
+
+    if (latest_buffer && buffer == *latest_buffer)
+        latest_buffer_presented = true;
+
+    auto const presented = std::find_if(
+        begin(awaiting_presentation),
+        end(awaiting_presentation),
+        [buffer](auto const& awaiting) { return awaiting.buffer == buffer; });
+
+    if (presented == end(awaiting_presentation))
+    {
+        // Either a buffer already reported (e.g. on another output) or one nobody asked about
+        update_presentation_tracking();
+        return;
+    }
+
+    // Anything submitted before the presented buffer was superseded without reaching the screen
+    for (auto awaiting = begin(awaiting_presentation); awaiting != presented; ++awaiting)
+    {
+        for (auto const& feedback : awaiting->feedbacks)
+        {
+            if (feedback)
+                feedback.value().discarded();
+        }
+    }
+
+    // ...but the input those buffers answered is answered by this one too
+    auto const presentation_time = frame.ust.clock_id == CLOCK_MONOTONIC ?
+        frame.ust.nanoseconds :
+        std::chrono::steady_clock::now().time_since_epoch();
+    for (auto awaiting = begin(awaiting_presentation); awaiting != std::next(presented); ++awaiting)
+    {
+        if (awaiting->answered_input)
+            input_latency_report->presented_after_event(*awaiting->answered_input, presentation_time);
+    }
+
+    for (auto const& feedback : presented->feedbacks)
+    {
+        if (feedback)
+            feedback.value().presented(output_area, frame, zero_copy);
+    }
+
+    awaiting_presentation.erase(begin(awaiting_presentation), std::next(presented));
+    update_presentation_tracking();
+}
+
+void mf::WlSurface::await_next_frame(std::vector<wayland::Weak<WpPresentationFeedback>> const& feedbacks)
+{
+    if (feedbacks.empty())
+        return;
+
+    if (awaiting_next_frame.empty())
+        awaiting_next_frame_since = std::chrono::steady_clock::now();
+    awaiting_next_frame.insert(end(awaiting_next_frame), begin(feedbacks), end(feedbacks));
+
+    // If nothing is composited the content is still on screen at the next vblank, so answer it then
+    if (auto const vblank = next_vblank())
+    {
+        frame_callback_executor->spawn_at(
+            *vblank,
+            [executor = wayland_executor, weak_self = mw::make_weak(this)]()
+            {
+                executor->spawn([weak_self]()
+                    {
+                        if (weak_self)
+                        {
+                            weak_self.value().present_unchanged_content();
+                        }
+                    });
+            });
+    }
+    else
+    {
+        present_unchanged_content();
+    }
+}
+
+void mf::WlSurface::present_unchanged_content()
+{
+    if (awaiting_next_frame.empty())
+        return;
+
+    // The most recent vblank of the outputs we know the timing of, stepped on from their last flip
+    auto const now = time::Timestamp{std::chrono::steady_clock::now().time_since_epoch()};
+    std::optional<std::pair<geom::Rectangle, graphics::Frame>> latest;
+    for (auto const& timing : output_timings)
+    {
+        if (!timing.refresh || timing.last_frame.msc == 0)
+            continue;
+
+        time::Timestamp const last_flip{timing.last_frame.ust.nanoseconds};
+        auto const periods = last_flip < now ? (now - last_flip) / *timing.refresh : 0;
+        graphics::Frame const frame{
+            timing.last_frame.msc + periods,
+            graphics::Frame::Timestamp{
+                CLOCK_MONOTONIC,
+                timing.last_frame.ust.nanoseconds + periods * *timing.refresh}};
+
+        if (!latest || frame.ust.nanoseconds > latest->second.ust.nanoseconds)
+            latest = std::make_pair(timing.output_area, frame);
+    }
+
+    for (auto const& feedback : awaiting_next_frame)
+    {
+        if (!feedback)
+            continue;
+
+        if (latest)
+            feedback.value().presented(latest->first, latest->second, false, true);
+        else
+            feedback.value().discarded();   // We don't know of an output showing the surface
+    }
+    awaiting_next_frame.clear();
+    update_presentation_tracking();
 }
 
 void mf::WlSurface::attach(std::optional<wl_resource*> const& buffer, int32_t x, int32_t y)
@@ -287,8 +800,11 @@ void mf::WlSurface::frame(wl_resource* new_callback)
 
 void mf::WlSurface::set_opaque_region(std::optional<wl_resource*> const& region)
 {
-    (void)region;
-    // This isn't essential, but could enable optimizations
+    // A null region means nothing is known to be opaque
+    if (region)
+        pending.opaque_region = WlRegion::from(region.value())->rectangle_vector();
+    else
+        pending.opaque_region = std::vector<geom::Rectangle>{};
 }
 
 void mf::WlSurface::set_input_region(std::optional<wl_resource*> const& region)
@@ -306,6 +822,42 @@ void mf::WlSurface::set_input_region(std::optional<wl_resource*> const& region)
     }
 }
 
+void mf::WlSurface::schedule_frame_callbacks_at_vblank()
+{
+    frame_callbacks_await_vblank = true;
+
+    auto const executor_send_vblank_callbacks = [executor = wayland_executor, weak_self = mw::make_weak(this)]()
+        {
+            executor->spawn([weak_self]()
+                {
+                    // If a buffer has been committed since, the callbacks wait for that instead
+                    if (weak_self && weak_self.value().frame_callbacks_await_vblank)
+                    {
+                        weak_self.value().send_frame_callbacks();
+                    }
+                });
+        };
+
+    // Visible surfaces are paced by the outputs showing them: by the next composite (see frame_presented()) or,
+    // if nothing is composited, by when the output would next have flipped. Surfaces nobody can see are paced
+    // by the hidden surface policy, or fall back to a fixed rate.
+    auto const scene = scene_surface();
+    bool const exposed =
+        scene && scene.value()->query(mir_window_attrib_visibility) == mir_window_visibility_exposed;
+    if (hidden_frame_policy.throttles() && hidden())
+    {
+        throttle_frame_callbacks();
+    }
+    else if (auto const vblank = exposed ? next_vblank() : std::nullopt)
+    {
+        frame_callback_executor->spawn_at(*vblank, std::move(executor_send_vblank_callbacks));
+    }
+    else
+    {
+        frame_callback_executor->spawn(std::move(executor_send_vblank_callbacks));
+    }
+}
+
 void mf::WlSurface::commit(WlSurfaceState const& state)
 {
     // We're going to lose the value of state, so copy the frame_callbacks first. We have to maintain a list of
@@ -313,22 +865,50 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
     // callbacks should be sent at once.
     frame_callbacks.insert(end(frame_callbacks), begin(state.frame_callbacks), end(state.frame_callbacks));
 
+    auto const previous_buffer_size = buffer_size_;
+    auto const previous_buffer_scale = buffer_scale;
+
+    // New content is the client's answer to the input it has been sent since its last commit
+    std::optional<std::chrono::nanoseconds> answered_input;
+    if (state.buffer && *state.buffer)
+    {
+        auto& unanswered_input = WlClient::from(client->raw_client()).unanswered_input_time();
+        if (unanswered_input)
+            input_latency_report->committed_after_event(*unanswered_input);
+        answered_input = std::exchange(unanswered_input, std::nullopt);
+    }
+
     if (state.offset)
         offset_ = state.offset.value();
 
     if (state.input_shape)
         input_shape = state.input_shape.value();
 
+    if (state.opaque_region)
+        opaque_region = state.opaque_region.value();
+
     if (state.scale)
-        stream->set_scale(state.scale.value());
+    {
+        buffer_scale = state.scale.value();
+        stream->set_scale(buffer_scale);
+    }
+
+    if (state.viewport_source)
+        viewport_source = state.viewport_source.value();
+
+    if (state.viewport_destination)
+        viewport_destination = state.viewport_destination.value();
 
     auto const executor_send_frame_callbacks = [executor = wayland_executor, weak_self = mw::make_weak(this)]()
         {
-            executor->spawn([weak_self]()
+            // Called as the compositor takes the buffer for a frame
+            time::Timestamp const consumed = std::chrono::steady_clock::now();
+            executor->spawn([weak_self, consumed]()
                 {
                     if (weak_self)
                     {
-                        weak_self.value().send_frame_callbacks();
+                        weak_self.value().last_consumed = consumed;
+                        weak_self.value().send_frame_callbacks_unless_hidden();
                     }
                 });
         };
@@ -341,7 +921,29 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
         {
             // TODO: unmap surface, and unmap all subsurfaces
             buffer_size_ = std::nullopt;
+            latest_buffer = std::nullopt;
             send_frame_callbacks();
+            for (auto const& feedback : state.presentation_feedbacks)
+            {
+                if (feedback)
+                    feedback.value().discarded();
+            }
+        }
+        else if (auto const single_pixel = SinglePixelBuffer::from(buffer))
+        {
+            // The colour was copied when the buffer was created, so the client can have it straight back
+            wl_resource_post_event(buffer, wayland::Buffer::Opcode::release);
+
+            auto const mir_buffer = std::make_shared<graphics::SolidColourBuffer>(single_pixel->colour());
+            stream->submit_buffer(mir_buffer);
+            latest_buffer = mir_buffer->id();
+            latest_buffer_presented = false;
+            await_presentation(mir_buffer->id(), state.presentation_feedbacks, answered_input);
+            update_buffer_size(state);
+
+            // Nothing is uploaded, so there is no consumption to send the frame callbacks on
+            if (!frame_callbacks.empty())
+                schedule_frame_callbacks_at_vblank();
         }
         else
         {
@@ -380,19 +982,53 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
             }
 
             stream->submit_buffer(mir_buffer);
-            auto const new_buffer_size = stream->stream_size();
+            // Any callbacks committed without a buffer now go out with this one
+            frame_callbacks_await_vblank = false;
+            latest_buffer = mir_buffer->id();
+            latest_buffer_presented = false;
+            await_presentation(mir_buffer->id(), state.presentation_feedbacks, answered_input);
+            update_buffer_size(state);
+        }
+    }
+    else if (!frame_callbacks.empty())
+    {
+        schedule_frame_callbacks_at_vblank();
+    }
 
-            if (!input_shape && std::make_optional(new_buffer_size) != buffer_size_)
+    if (!state.buffer && buffer_size_ && (state.viewport_source || state.viewport_destination))
+    {
+        // Cropping or scaling the current buffer resizes the surface
+        update_buffer_size(state);
+    }
+
+    if (!state.buffer)
+    {
+        // Without new content the feedback is for the buffer on (or on its way to) the screen
+        if (latest_buffer && latest_buffer_presented)
+        {
+            await_next_frame(state.presentation_feedbacks);
+        }
+        else if (latest_buffer)
+        {
+            await_presentation(*latest_buffer, state.presentation_feedbacks, std::nullopt);
+        }
+        else
+        {
+            for (auto const& feedback : state.presentation_feedbacks)
             {
-                state.invalidate_surface_data(); // input shape needs to be recalculated for the new size
+                if (feedback)
+                    feedback.value().discarded();
             }
-
-            buffer_size_ = new_buffer_size;
         }
     }
-    else
+
+    update_presentation_tracking();
+
+    if (state.surface_data_needs_refresh() ||
+        buffer_size_ != previous_buffer_size ||
+        buffer_scale != previous_buffer_scale)
     {
-        frame_callback_executor->spawn(std::move(executor_send_frame_callbacks));
+        drop_cached_surface_data();
     }
 
     for (WlSubsurface* child: children)
@@ -412,10 +1048,18 @@ void mf::WlSurface::commit()
     if (pending.input_shape && *pending.input_shape == input_shape)
         pending.input_shape = std::nullopt;
 
+    // Toolkits tend to resend an unchanged opaque region with every frame
+    if (pending.opaque_region && *pending.opaque_region == opaque_region)
+        pending.opaque_region = std::nullopt;
+
     // order is important
     auto const state = std::move(pending);
     pending = WlSurfaceState();
     role->commit(state);
+
+    // The role may have just mapped the surface, or moved it onto another output
+    if (fractional_scale)
+        fractional_scale.value().update_preferred_scale();
 }
 
 void mf::WlSurface::set_buffer_transform(int32_t transform)
@@ -21,11 +21,15 @@
 #include "mir/wayland/weak.h"
 
 #include "wl_surface_role.h"
+#include "frame_executor.h"
 
 #include "mir/geometry/displacement.h"
 #include "mir/geometry/size.h"
 #include "mir/geometry/point.h"
 #include "mir/geometry/rectangle.h"
+#include "mir/graphics/buffer_id.h"
+#include "mir/graphics/frame.h"
+#include "mir/time/types.h"
 
 #include <vector>
 #include <map>
@@ -50,10 +54,17 @@ namespace compositor
 {
 class BufferStream;
 }
+namespace input
+{
+class InputLatencyReport;
+}
 namespace frontend
 {
 class WlSurface;
 class WlSubsurface;
+class WpPresentationFeedback;
+class WpViewport;
+class WpFractionalScaleV1;
 
 struct WlSurfaceState
 {
@@ -78,7 +89,13 @@ struct WlSurfaceState
     std::optional<int> scale;
     std::optional<geometry::Displacement> offset;
     std::optional<std::optional<std::vector<geometry::Rectangle>>> input_shape;
+    std::optional<std::vector<geometry::Rectangle>> opaque_region;
+    /// wp_viewport crop, in surface coordinates before scaling; the inner optional is unset for no crop
+    std::optional<std::optional<geometry::RectangleD>> viewport_source;
+    /// wp_viewport surface size; the inner optional is unset for no scaling
+    std::optional<std::optional<geometry::Size>> viewport_destination;
     std::vector<wayland::Weak<Callback>> frame_callbacks;
+    std::vector<wayland::Weak<WpPresentationFeedback>> presentation_feedbacks;
 
 private:
     // only set to true if invalidate_surface_data() is called
@@ -106,8 +123,10 @@ class WlSurface : public wayland::Surface
 public:
     WlSurface(wl_resource* new_resource,
               std::shared_ptr<mir::Executor> const& wayland_executor,
-              std::shared_ptr<mir::Executor> const& frame_callback_executor,
-              std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator);
+              std::shared_ptr<FrameExecutor> const& frame_callback_executor,
+              HiddenSurfaceFramePolicy const& hidden_frame_policy,
+              std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator,
+              std::shared_ptr<input::InputLatencyReport> const& input_latency_report);
 
     ~WlSurface();
 
@@ -126,11 +145,25 @@ public:
     void remove_subsurface(WlSubsurface* child);
     void refresh_surface_data_now();
     void pending_invalidate_surface_data() { pending.invalidate_surface_data(); }
+    /// Appends the streams and input shape of this surface and its mapped subsurfaces
     void populate_surface_data(std::vector<shell::StreamSpecification>& buffer_streams,
                                std::vector<mir::geometry::Rectangle>& input_shape_accumulator,
                                geometry::Displacement const& parent_offset) const;
+    /// Forgets the surface data of this surface (and so of its ancestors), to be rebuilt when next populated
+    void drop_cached_surface_data();
     void commit(WlSurfaceState const& state);
     auto confine_pointer_state() const -> MirPointerConfinementState;
+    void add_presentation_feedback(WpPresentationFeedback* feedback);
+    auto has_viewport() const -> bool { return static_cast<bool>(viewport); }
+    void set_viewport(WpViewport* viewport);
+    void set_pending_viewport_source(std::optional<geometry::RectangleD> const& source);
+    void set_pending_viewport_destination(std::optional<geometry::Size> const& destination);
+    auto has_fractional_scale() const -> bool { return static_cast<bool>(fractional_scale); }
+    void set_fractional_scale(WpFractionalScaleV1* fractional_scale);
+    /// The earliest vblank after the given time (by default, now) of the outputs the surface is visible on, if known
+    auto next_vblank(std::optional<time::Timestamp> after = std::nullopt) const -> std::optional<time::Timestamp>;
+    /// When the compositor is next expected to take the surface's content for a frame, if known
+    auto next_composite() const -> std::optional<time::Timestamp>;
 
     std::shared_ptr<scene::Session> const session;
     std::shared_ptr<compositor::BufferStream> const stream;
@@ -140,7 +173,9 @@ public:
 private:
     std::shared_ptr<mir::graphics::GraphicBufferAllocator> const allocator;
     std::shared_ptr<mir::Executor> const wayland_executor;
-    std::shared_ptr<mir::Executor> const frame_callback_executor;
+    std::shared_ptr<FrameExecutor> const frame_callback_executor;
+    HiddenSurfaceFramePolicy const hidden_frame_policy;
+    std::shared_ptr<input::InputLatencyReport> const input_latency_report;
 
     NullWlSurfaceRole null_role;
     WlSurfaceRole* role;
@@ -151,8 +186,85 @@ private:
     std::optional<geometry::Size> buffer_size_;
     std::vector<wayland::Weak<WlSurfaceState::Callback>> frame_callbacks;
     std::optional<std::vector<mir::geometry::Rectangle>> input_shape;
+    std::vector<mir::geometry::Rectangle> opaque_region;
+    int buffer_scale{1};
+    wayland::Weak<WpViewport> viewport;
+    std::optional<geometry::RectangleD> viewport_source;
+    std::optional<geometry::Size> viewport_destination;
+    wayland::Weak<WpFractionalScaleV1> fractional_scale;
+
+    struct SurfaceData;
+    /// The surface data of this surface and its subsurfaces relative to this surface, null until populated
+    std::unique_ptr<SurfaceData> mutable cached_surface_data;
+
+    struct AwaitingPresentation
+    {
+        graphics::BufferID buffer;
+        std::vector<wayland::Weak<WpPresentationFeedback>> feedbacks;
+        /// The time of the input event the buffer answers, if any (see WlClient::unanswered_input_time())
+        std::optional<std::chrono::nanoseconds> answered_input;
+    };
+    /// In the order the buffers were submitted
+    std::vector<AwaitingPresentation> awaiting_presentation;
+    std::optional<graphics::BufferID> latest_buffer;
+    /// latest_buffer has reached the screen, so feedback committed without a buffer is for the next frame
+    bool latest_buffer_presented{false};
+    /// Feedback for content already on screen, answered by the next frame (see present_unchanged_content())
+    std::vector<wayland::Weak<WpPresentationFeedback>> awaiting_next_frame;
+    /// When the first of awaiting_next_frame was committed; frames presented before then don't answer it
+    time::Timestamp awaiting_next_frame_since;
+
+    /// The vblank timing of an output the surface has recently been presented on
+    struct OutputTiming
+    {
+        geometry::Rectangle output_area;
+        graphics::Frame last_frame;
+        std::optional<time::Duration> refresh; ///< Estimated from successive flips, nullopt until known
+    };
+    std::vector<OutputTiming> output_timings;
+    /// When the compositor last consumed a buffer, until that buffer's frame is presented
+    std::optional<time::Timestamp> last_consumed;
+    /// How long before a vblank the compositor consumes the surface's content for it, nullopt until known
+    std::optional<time::Duration> composite_lead;
+    /// Whether we are notified of presentations of our stream
+    bool tracking_presentation{false};
+    /// Frame callbacks were committed without a buffer, so are sent at the next vblank rather than on consumption
+    bool frame_callbacks_await_vblank{false};
+    /// Frame callbacks are being held back because the surface can't be seen
+    bool frame_callbacks_throttled{false};
+    time::Timestamp frame_callbacks_last_sent;
+
+    /// Appends the surface data of this surface and its mapped subsurfaces, relative to this surface
+    void build_surface_data(std::vector<shell::StreamSpecification>& buffer_streams,
+                            std::vector<mir::geometry::Rectangle>& input_shape_accumulator) const;
+    /// The surface size for content of the given size, once cropped and scaled by any viewport
+    auto viewport_size(geometry::Size content_size) const -> geometry::Size;
+    /// Updates buffer_size_ from the stream and viewport, invalidating surface data if it changes
+    void update_buffer_size(WlSurfaceState const& state);
 
     void send_frame_callbacks();
+    /// Sends the frame callbacks, unless the surface is hidden and the policy says to hold them back
+    void send_frame_callbacks_unless_hidden();
+    void throttle_frame_callbacks();
+    /// Sends the frame callbacks once the outputs showing the surface next refresh
+    void schedule_frame_callbacks_at_vblank();
+    /// Occluded everywhere, offscreen or minimised
+    auto hidden() const -> bool;
+    void update_presentation_tracking();
+    void await_presentation(
+        graphics::BufferID buffer,
+        std::vector<wayland::Weak<WpPresentationFeedback>> const& feedbacks,
+        std::optional<std::chrono::nanoseconds> answered_input);
+    void frame_presented(
+        graphics::BufferID buffer,
+        geometry::Rectangle const& output_area,
+        graphics::Frame const& frame,
+        bool zero_copy);
+    /// Queues feedback committed without a buffer once the latest buffer is already on screen
+    void await_next_frame(std::vector<wayland::Weak<WpPresentationFeedback>> const& feedbacks);
+    /// Answers awaiting_next_frame with the latest vblank of the outputs showing the surface, if nothing has been
+    /// composited to answer it since
+    void present_unchanged_content();
 
     void attach(std::optional<wl_resource*> const& buffer, int32_t x, int32_t y) override;
     void damage(int32_t x, int32_t y, int32_t width, int32_t height) override;
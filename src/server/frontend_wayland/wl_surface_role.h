@@ -42,6 +42,8 @@ public:
     virtual auto total_offset() const -> geometry::Displacement { return {}; }
     virtual auto scene_surface() const -> std::optional<std::shared_ptr<scene::Surface>> = 0;
     virtual void refresh_surface_data_now() = 0;
+    /// The surface data of the surface or one of its subsurfaces has changed
+    virtual void surface_data_changed() {}
     virtual void commit(WlSurfaceState const& state) = 0;
     virtual void surface_destroyed() = 0;
 
@@ -17,6 +17,7 @@
 #include "wl_touch.h"
 
 #include "wayland_utils.h"
+#include "frame_executor.h"
 #include "wl_surface.h"
 #include "wl_seat.h"
 
@@ -27,13 +28,30 @@
 #include "mir/time/clock.h"
 #include "mir/wayland/client.h"
 
+#include <algorithm>
+
 namespace mf = mir::frontend;
 namespace mw = mir::wayland;
 namespace geom = mir::geometry;
 
-mf::WlTouch::WlTouch(wl_resource* new_resource, std::shared_ptr<time::Clock> const& clock)
+namespace
+{
+/// How long before an output refresh resampled motion is sent, to give the client a chance to draw in response
+auto const resampled_motion_lead = std::chrono::milliseconds{2};
+
+auto wayland_timestamp(mir::time::Timestamp time) -> std::chrono::milliseconds
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch());
+}
+}
+
+mf::WlTouch::WlTouch(
+    wl_resource* new_resource,
+    std::shared_ptr<time::Clock> const& clock,
+    std::optional<Resampling> const& resampling)
     : Touch(new_resource, Version<8>()),
-      clock{clock}
+      clock{clock},
+      resampling{resampling}
 {
 }
 
@@ -51,6 +69,7 @@ mf::WlTouch::~WlTouch()
 void mf::WlTouch::event(std::shared_ptr<MirTouchEvent const> const& event, WlSurface& root_surface)
 {
     std::chrono::milliseconds timestamp{mir_input_event_get_wayland_timestamp(mir_touch_event_input_event(event.get()))};
+    time::Timestamp const sample_time{event->event_time()};
 
     for (auto i = 0u; i < mir_touch_event_point_count(event.get()); ++i)
     {
@@ -66,16 +85,35 @@ void mf::WlTouch::event(std::shared_ptr<MirTouchEvent const> const& event, WlSur
         {
             auto const serial = client->next_serial(event);
             down(serial, timestamp, touch_id, root_surface, position);
+            if (resampling)
+            {
+                resampler.add(touch_id, sample_time, position);
+                sent_sample_time[touch_id] = sample_time;
+            }
         }   break;
 
         case mir_touch_action_up:
         {
+            if (resampling)
+            {
+                // The client must be left with the contact where it actually lifted
+                send_latest_motion(touch_id);
+            }
             auto const serial = client->next_serial(event);
             up(serial, timestamp, touch_id);
         }   break;
 
         case mir_touch_action_change:
-            motion(timestamp, touch_id, position);
+            if (resampling)
+            {
+                resampler.add(touch_id, sample_time, position);
+                pending_motion.insert(touch_id);
+                predicted_motion.erase(touch_id);
+            }
+            else
+            {
+                motion(timestamp, touch_id, position);
+            }
             break;
 
         case mir_touch_actions:;
@@ -83,6 +121,12 @@ void mf::WlTouch::event(std::shared_ptr<MirTouchEvent const> const& event, WlSur
     }
 
     maybe_frame();
+
+    if (!pending_motion.empty())
+    {
+        resample_surface = mw::make_weak(&root_surface);
+        schedule_resampled_motion(root_surface);
+    }
 }
 
 void mf::WlTouch::down(
@@ -153,6 +197,11 @@ void mf::WlTouch::motion(
 
 void mf::WlTouch::up(uint32_t serial, std::chrono::milliseconds const& ms, int32_t touch_id)
 {
+    resampler.remove(touch_id);
+    sent_sample_time.erase(touch_id);
+    pending_motion.erase(touch_id);
+    predicted_motion.erase(touch_id);
+
     auto const touch = touch_id_to_surface.find(touch_id);
     if (touch != touch_id_to_surface.end())
     {
@@ -181,3 +230,105 @@ void mf::WlTouch::maybe_frame()
         needs_frame = false;
     }
 }
+
+void mf::WlTouch::send_resampled_motion(std::optional<time::Timestamp> sample_time)
+{
+    for (auto touch_id = pending_motion.begin(); touch_id != pending_motion.end();)
+    {
+        auto const latest = resampler.latest(*touch_id).value();
+        auto const time = sample_time.value_or(latest);
+        auto& sent = sent_sample_time[*touch_id];
+
+        if (predicted_motion.erase(*touch_id))
+        {
+            // No sample has arrived since the client was sent where the contact was heading, so it has stopped. Leave
+            // it where it actually is rather than at the overshoot.
+            motion(
+                wayland_timestamp(std::max(time, sent)),
+                *touch_id,
+                resampler.position_at(*touch_id, latest).value());
+            sent = latest;
+            touch_id = pending_motion.erase(touch_id);
+            continue;
+        }
+
+        // Sampling behind the frame can land before what the client already has, there is nothing newer to send yet
+        if (time > sent)
+        {
+            motion(wayland_timestamp(time), *touch_id, resampler.position_at(*touch_id, time).value());
+            sent = time;
+            if (resampler.predicts(*touch_id, time))
+            {
+                predicted_motion.insert(*touch_id);
+            }
+        }
+
+        if (sent >= latest && !predicted_motion.contains(*touch_id))
+        {
+            touch_id = pending_motion.erase(touch_id);
+        }
+        else
+        {
+            ++touch_id;
+        }
+    }
+}
+
+void mf::WlTouch::send_latest_motion(int32_t touch_id)
+{
+    auto const latest = resampler.latest(touch_id);
+    auto const sent = sent_sample_time.find(touch_id);
+    if (latest && sent != sent_sample_time.end() && sent->second != *latest)
+    {
+        motion(wayland_timestamp(*latest), touch_id, resampler.position_at(touch_id, *latest).value());
+        sent->second = *latest;
+    }
+}
+
+void mf::WlTouch::schedule_resampled_motion(WlSurface& root_surface)
+{
+    if (resample_scheduled)
+        return;
+    resample_scheduled = true;
+
+    // Without a refresh to align to (the surface hasn't been shown yet) the latest samples go out as soon as the main
+    // loop gets to them, which still merges a burst of events arriving together
+    auto const now = std::chrono::steady_clock::now();
+    auto deadline = now;
+    std::optional<time::Timestamp> frame;
+    if (auto const vblank = root_surface.next_vblank(resampled_frame ? std::max(now, *resampled_frame) : now))
+    {
+        deadline = std::max(now, *vblank - resampled_motion_lead);
+        frame = vblank;
+    }
+
+    resampling->frame_executor->spawn_at(
+        deadline,
+        [executor = resampling->wayland_executor, weak_self = mw::make_weak(this), frame]()
+        {
+            executor->spawn([weak_self, frame]()
+                {
+                    if (weak_self)
+                    {
+                        auto& self = weak_self.value();
+                        self.resample_scheduled = false;
+                        if (frame)
+                        {
+                            self.resampled_frame = frame;
+                            self.send_resampled_motion(*frame - TouchResampler::latency);
+                        }
+                        else
+                        {
+                            self.send_resampled_motion(std::nullopt);
+                        }
+                        self.maybe_frame();
+
+                        // Contacts sampled behind this frame still have newer samples for the next one
+                        if (!self.pending_motion.empty() && self.resample_surface)
+                        {
+                            self.schedule_resampled_motion(self.resample_surface.value());
+                        }
+                    }
+                });
+        });
+}
@@ -18,12 +18,16 @@
 #define MIR_FRONTEND_WL_TOUCH_H
 
 #include "wayland_wrapper.h"
+#include "touch_resampler.h"
 #include "mir/wayland/weak.h"
 #include "mir/geometry/point.h"
 
 #include <unordered_map>
 #include <functional>
 #include <chrono>
+#include <memory>
+#include <optional>
+#include <set>
 
 struct MirTouchEvent;
 
@@ -42,11 +46,24 @@ class Client;
 namespace frontend
 {
 class WlSurface;
+class FrameExecutor;
 
 class WlTouch : public wayland::Touch
 {
 public:
-    WlTouch(wl_resource* new_resource, std::shared_ptr<time::Clock> const& clock);
+    /// Resamples contact motion to a single update per output frame, sent just before the frame is due. Contacts
+    /// going down or up are still sent as they arrive.
+    struct Resampling
+    {
+        std::shared_ptr<Executor> wayland_executor;
+        std::shared_ptr<FrameExecutor> frame_executor;
+    };
+
+    /// Motion is resampled if resampling is given, otherwise every motion is sent as it arrives
+    WlTouch(
+        wl_resource* new_resource,
+        std::shared_ptr<time::Clock> const& clock,
+        std::optional<Resampling> const& resampling);
 
     ~WlTouch();
 
@@ -79,6 +96,28 @@ private:
         std::pair<float, float> const& root_position);
     void up(uint32_t serial, std::chrono::milliseconds const& ms, int32_t touch_id);
     void maybe_frame();
+    /// Sends each contact with newer samples than the client has seen, resampled to sample_time (or at its latest
+    /// sample if there is no frame to resample to). A contact predicted last time with no newer sample is sent at
+    /// its latest sample.
+    void send_resampled_motion(std::optional<time::Timestamp> sample_time);
+    /// Sends the contact's latest sample if the client was last sent anything else
+    void send_latest_motion(int32_t touch_id);
+    /// Arranges for resampled motion to be sent just before root_surface's outputs next refresh
+    void schedule_resampled_motion(WlSurface& root_surface);
+
+    std::optional<Resampling> const resampling;
+    TouchResampler resampler;
+    /// The sample time each contact was last sent to the client at
+    std::unordered_map<int32_t, time::Timestamp> sent_sample_time;
+    /// Contacts with samples the client has not been sent, or that need settling after a prediction
+    std::set<int32_t> pending_motion;
+    /// Contacts the client was last sent an extrapolated position for. If no sample arrives by the next frame they
+    /// are sent at their latest sample instead.
+    std::set<int32_t> predicted_motion;
+    wayland::Weak<WlSurface> resample_surface;
+    /// The frame motion was last resampled for, so the next resampling is for a later one
+    std::optional<time::Timestamp> resampled_frame;
+    bool resample_scheduled{false};
 };
 
 }
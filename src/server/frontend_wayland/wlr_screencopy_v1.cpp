@@ -20,9 +20,10 @@
 #include "mir/graphics/graphic_buffer_allocator.h"
 #include "mir/renderer/sw/pixel_source.h"
 #include "mir/graphics/buffer.h"
+#include "mir/graphics/dmabuf_buffer.h"
 #include "mir/scene/scene_change_notification.h"
 #include "mir/frontend/surface_stack.h"
-#include "mir/geometry/rectangles.h"
+#include "mir/geometry/region.h"
 #include "mir/wayland/weak.h"
 #include "mir/wayland/protocol_error.h"
 #include "mir/executor.h"
@@ -30,8 +31,12 @@
 #include "wayland_timespec.h"
 #include "output_manager.h"
 #include "shm.h"
+#include "deleted_for_resource.h"
+#include "wayland_utils.h"
 
+#include <drm_fourcc.h>
 #include <boost/throw_exception.hpp>
+#include <algorithm>
 #include <mutex>
 #include <optional>
 
@@ -57,6 +62,21 @@ auto translate_and_scale(
     rect.top_left.y = output_space.top_left.y + displacement.dy * y_scale;
     return rect;
 }
+
+auto translate_and_scale(
+    geom::Region const& region,
+    geom::Rectangle input_space,
+    geom::Rectangle output_space) -> geom::Region
+{
+    // Scaling can make neighbouring rectangles overlap, so build the result anew rather than transforming in place
+    std::vector<geom::Rectangle> rects;
+    rects.reserve(region.size());
+    for (auto const& rect : region)
+    {
+        rects.push_back(translate_and_scale(rect, input_space, output_space));
+    }
+    return geom::Region{rects};
+}
 }
 
 class mf::WlrScreencopyV1DamageTracker::Area
@@ -81,7 +101,7 @@ private:
     /// The amount of damage since the last frame was captured (should be none unless pending_frame is null)
     DamageAmount damage_amount;
     /// Only has meaning when damage_amount is partial
-    geom::Rectangle output_space_damage;
+    geom::Region output_space_damage;
     /// The frame that will be captured once this capture area takes damage
     wayland::Weak<Frame> pending_frame;
 };
@@ -120,6 +140,15 @@ public:
 
     void capture_on_damage(WlrScreencopyV1DamageTracker::Frame* frame);
 
+    /// Returns the output space area that has gone out of date in buffer since it was last captured into with the
+    /// same params, or nullopt if its content is not known. The buffer is then taken to be up to date again.
+    auto take_stale_area(
+        ShmBuffer& buffer,
+        WlrScreencopyV1DamageTracker::FrameParams const& params,
+        geom::Region const& buffer_space_damage) -> std::optional<geom::Region>;
+    /// The content of buffer is no longer known
+    void forget_buffer(ShmBuffer& buffer);
+
 private:
     /// From wayland::WlrScreencopyManagerV1
     /// @{
@@ -134,6 +163,17 @@ private:
 
     std::shared_ptr<WlrScreencopyV1Ctx> const ctx;
     WlrScreencopyV1DamageTracker damage_tracker;
+
+    /// Clients cycle through a few buffers when copying with damage, so remember what each one was last filled with
+    /// and only the parts that have changed since need to be captured again
+    struct CapturedBuffer
+    {
+        wayland::Weak<ShmBuffer> buffer;
+        WlrScreencopyV1DamageTracker::FrameParams params;
+        /// In output space, empty if the buffer is up to date
+        geom::Region stale_area;
+    };
+    std::vector<CapturedBuffer> captured_buffers;
 };
 
 class WlrScreencopyFrameV1
@@ -151,12 +191,14 @@ public:
     /// @{
     auto destroyed_flag() const -> std::shared_ptr<bool const> override { return LifetimeTracker::destroyed_flag(); }
     auto parameters() const -> WlrScreencopyV1DamageTracker::FrameParams const& override { return params; }
-    void capture(geometry::Rectangle buffer_space_damage) override;
+    void capture(geometry::Region const& buffer_space_damage) override;
     /// @}
 
 private:
     void prepare_target(wl_resource* buffer);
-    void report_result(std::optional<time::Timestamp> captured_time, geom::Rectangle buffer_space_damage);
+    void prepare_shm_target(ShmBuffer* shm_buffer);
+    void prepare_dmabuf_target(wl_resource* buffer);
+    void report_result(std::optional<time::Timestamp> captured_time, geom::Region const& buffer_space_damage);
 
     /// From wayland::WlrScreencopyFrameV1
     /// @{
@@ -174,6 +216,9 @@ private:
     bool copy_has_been_called{false};
     bool should_send_damage{false};
     std::shared_ptr<renderer::software::WriteMappableBuffer> target;
+    /// Set instead of target when the client gave us a dmabuf, which is rendered into directly
+    std::shared_ptr<graphics::Buffer> gpu_target;
+    wayland::Weak<ShmBuffer> target_buffer;
     /// @}
 };
 }
@@ -281,7 +326,7 @@ void mf::WlrScreencopyV1DamageTracker::Area::apply_damage(std::optional<geom::Re
         {
             if (damage_amount == DamageAmount::partial)
             {
-                output_space_damage = geom::Rectangles{output_space_damage, intersection}.bounding_rectangle();
+                output_space_damage.add(intersection);
             }
             else // damage_amount == DamageAmount::none
             {
@@ -324,7 +369,7 @@ void mf::WlrScreencopyV1DamageTracker::Area::capture_frame()
     {
     case DamageAmount::none:
     {
-        // Capture with a zero-sized damage rect
+        // Capture with no damage
         pending_frame.value().capture({});
     }   break;
 
@@ -370,6 +415,68 @@ void mf::WlrScreencopyManagerV1::capture_on_damage(WlrScreencopyV1DamageTracker:
     damage_tracker.capture_on_damage(frame);
 }
 
+auto mf::WlrScreencopyManagerV1::take_stale_area(
+    ShmBuffer& buffer,
+    WlrScreencopyV1DamageTracker::FrameParams const& params,
+    geom::Region const& buffer_space_damage) -> std::optional<geom::Region>
+{
+    captured_buffers.erase(
+        std::remove_if(
+            begin(captured_buffers),
+            end(captured_buffers),
+            [](auto const& captured){ return !captured.buffer; }),
+        end(captured_buffers));
+
+    if (!buffer_space_damage.empty())
+    {
+        auto const damage = translate_and_scale(
+            buffer_space_damage,
+            params.full_buffer_space_damage(),
+            params.output_space_area);
+        for (auto& captured : captured_buffers)
+        {
+            if (captured.params == params)
+            {
+                captured.stale_area.add(damage);
+            }
+        }
+    }
+
+    auto const captured = std::find_if(
+        begin(captured_buffers),
+        end(captured_buffers),
+        [&](auto const& captured){ return captured.buffer.is(buffer); });
+    if (captured == end(captured_buffers))
+    {
+        // Clients don't use many buffers at once, so one we haven't seen for a while is probably gone
+        if (captured_buffers.size() >= 8)
+        {
+            captured_buffers.erase(begin(captured_buffers));
+        }
+        captured_buffers.push_back({mw::make_weak(&buffer), params, {}});
+        return std::nullopt;
+    }
+
+    std::optional<geom::Region> stale_area;
+    if (captured->params == params)
+    {
+        stale_area = captured->stale_area;
+    }
+    captured->params = params;
+    captured->stale_area = {};
+    return stale_area;
+}
+
+void mf::WlrScreencopyManagerV1::forget_buffer(ShmBuffer& buffer)
+{
+    captured_buffers.erase(
+        std::remove_if(
+            begin(captured_buffers),
+            end(captured_buffers),
+            [&](auto const& captured){ return captured.buffer.is(buffer); }),
+        end(captured_buffers));
+}
+
 void mf::WlrScreencopyManagerV1::capture_output(
     wl_resource* frame,
     int32_t overlay_cursor,
@@ -414,20 +521,25 @@ mf::WlrScreencopyFrameV1::WlrScreencopyFrameV1(
         params.buffer_size.width.as_uint32_t(),
         params.buffer_size.height.as_uint32_t(),
         stride.as_uint32_t());
+    // Rendering straight into a dmabuf keeps screen recording on the GPU
+    send_linux_dmabuf_event_if_supported(
+        DRM_FORMAT_XRGB8888,
+        params.buffer_size.width.as_uint32_t(),
+        params.buffer_size.height.as_uint32_t());
     send_buffer_done_event_if_supported();
 }
 
-void mf::WlrScreencopyFrameV1::capture(geom::Rectangle buffer_space_damage)
+void mf::WlrScreencopyFrameV1::capture(geom::Region const& buffer_space_damage)
 {
-    if (!target)
+    if (!target && !gpu_target)
     {
         fatal_error(
             "WlrScreencopyFrameV1::capture() called without a target, copy %s been called",
             copy_has_been_called ? "has" : "has not");
     }
-    ctx->screen_shooter->capture(std::move(target), params.output_space_area,
-        [wayland_executor=ctx->wayland_executor, buffer_space_damage, self=mw::make_weak(this)]
-            (std::optional<time::Timestamp> captured_time)
+
+    auto callback = [wayland_executor=ctx->wayland_executor, buffer_space_damage, self=mw::make_weak(this)]
+        (std::optional<time::Timestamp> captured_time)
         {
             wayland_executor->spawn([self, captured_time, buffer_space_damage]()
                 {
@@ -436,7 +548,40 @@ void mf::WlrScreencopyFrameV1::capture(geom::Rectangle buffer_space_damage)
                         self.value().report_result(captured_time, buffer_space_damage);
                     }
                 });
-        });
+        };
+
+    if (gpu_target)
+    {
+        ctx->screen_shooter->capture_gpu_buffer(std::move(gpu_target), params.output_space_area, std::move(callback));
+        return;
+    }
+
+    std::optional<geom::Region> stale_area;
+    if (manager && target_buffer)
+    {
+        if (should_send_damage)
+        {
+            stale_area = manager.value().take_stale_area(target_buffer.value(), params, buffer_space_damage);
+        }
+        else
+        {
+            manager.value().forget_buffer(target_buffer.value());
+        }
+    }
+
+    if (stale_area)
+    {
+        // The client's buffer still holds the last frame captured into it, so only what has changed needs copying
+        ctx->screen_shooter->capture_update(
+            std::move(target),
+            params.output_space_area,
+            stale_area.value().bounding_rectangle(),
+            std::move(callback));
+    }
+    else
+    {
+        ctx->screen_shooter->capture(std::move(target), params.output_space_area, std::move(callback));
+    }
 }
 
 void mf::WlrScreencopyFrameV1::prepare_target(wl_resource* buffer)
@@ -449,14 +594,18 @@ void mf::WlrScreencopyFrameV1::prepare_target(wl_resource* buffer)
             "Attempted to copy frame multiple times"));
     }
     copy_has_been_called = true;
-    auto shm_buffer = mf::ShmBuffer::from(buffer);
-    if (!shm_buffer)
+    if (auto const shm_buffer = mf::ShmBuffer::from(buffer))
     {
-        BOOST_THROW_EXCEPTION(mw::ProtocolError(
-            resource,
-            Error::invalid_buffer,
-            "Copy target is not a wl_shm buffer"));
+        prepare_shm_target(shm_buffer);
+    }
+    else
+    {
+        prepare_dmabuf_target(buffer);
     }
+}
+
+void mf::WlrScreencopyFrameV1::prepare_shm_target(ShmBuffer* shm_buffer)
+{
     auto shm_data = shm_buffer->data();
     if (shm_data->format() != mir_pixel_format_argb_8888)
     {
@@ -487,6 +636,7 @@ void mf::WlrScreencopyFrameV1::prepare_target(wl_resource* buffer)
             stride.as_int()));
     }
 
+    target_buffer = mw::make_weak(shm_buffer);
     target = std::shared_ptr<mir::renderer::software::WriteMappableBuffer>{
         shm_data.get(),
         [shm_data, weak_buffer = mw::make_weak(shm_buffer), executor = ctx->wayland_executor](auto*)
@@ -504,9 +654,68 @@ void mf::WlrScreencopyFrameV1::prepare_target(wl_resource* buffer)
     };
 }
 
+void mf::WlrScreencopyFrameV1::prepare_dmabuf_target(wl_resource* buffer)
+{
+    std::shared_ptr<graphics::Buffer> mir_buffer;
+    try
+    {
+        auto const buffer_destroyed = deleted_flag_for_resource(buffer);
+        mir_buffer = ctx->allocator->buffer_from_resource(
+            buffer,
+            [](){},
+            [executor = ctx->wayland_executor, buffer, destroyed = buffer_destroyed]()
+            {
+                executor->spawn(run_unless(
+                    destroyed,
+                    [buffer](){ wl_resource_post_event(buffer, wayland::Buffer::Opcode::release); }));
+            });
+    }
+    catch (std::exception const&)
+    {
+        // Not a kind of buffer the allocator knows about, which is reported below
+    }
+
+    auto const dmabuf = mir_buffer ? dynamic_cast<graphics::DMABufBuffer*>(mir_buffer->native_buffer_base()) : nullptr;
+    if (!dmabuf)
+    {
+        BOOST_THROW_EXCEPTION(mw::ProtocolError(
+            resource,
+            Error::invalid_buffer,
+            "Copy target is neither a wl_shm nor a linux-dmabuf buffer"));
+    }
+    switch (dmabuf->drm_fourcc())
+    {
+    case DRM_FORMAT_XRGB8888:
+    case DRM_FORMAT_ARGB8888:
+    case DRM_FORMAT_XBGR8888:
+    case DRM_FORMAT_ABGR8888:
+        break;
+
+    default:
+        BOOST_THROW_EXCEPTION(mw::ProtocolError(
+            resource,
+            Error::invalid_buffer,
+            "Invalid dmabuf format 0x%x",
+            dmabuf->drm_fourcc()));
+    }
+    if (dmabuf->size() != params.buffer_size)
+    {
+        BOOST_THROW_EXCEPTION(mw::ProtocolError(
+            resource,
+            Error::invalid_buffer,
+            "Invalid buffer size %dx%d, should be %dx%d",
+            dmabuf->size().width.as_int(),
+            dmabuf->size().height.as_int(),
+            params.buffer_size.width.as_int(),
+            params.buffer_size.height.as_int()));
+    }
+
+    gpu_target = std::move(mir_buffer);
+}
+
 void mf::WlrScreencopyFrameV1::report_result(
     std::optional<time::Timestamp> captured_time,
-    geom::Rectangle buffer_space_damage)
+    geom::Region const& buffer_space_damage)
 {
     if (captured_time)
     {
@@ -514,11 +723,15 @@ void mf::WlrScreencopyFrameV1::report_result(
 
         if (should_send_damage)
         {
-            send_damage_event(
-                buffer_space_damage.top_left.x.as_uint32_t(),
-                buffer_space_damage.top_left.y.as_uint32_t(),
-                buffer_space_damage.size.width.as_uint32_t(),
-                buffer_space_damage.size.height.as_uint32_t());
+            // The damage event may be sent several times per frame, so send each rectangle rather than their bounds
+            for (auto const& rect : buffer_space_damage)
+            {
+                send_damage_event(
+                    rect.top_left.x.as_uint32_t(),
+                    rect.top_left.y.as_uint32_t(),
+                    rect.size.width.as_uint32_t(),
+                    rect.size.height.as_uint32_t());
+            }
         }
 
         WaylandTimespec const timespec{captured_time.value()};
@@ -529,6 +742,10 @@ void mf::WlrScreencopyFrameV1::report_result(
     }
     else
     {
+        if (manager && target_buffer)
+        {
+            manager.value().forget_buffer(target_buffer.value());
+        }
         send_failed_event();
     }
 }
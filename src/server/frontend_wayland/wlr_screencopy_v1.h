@@ -18,7 +18,7 @@
 #define MIR_FRONTEND_WLR_SCREENCOPY_V1_H
 
 #include "wlr-screencopy-unstable-v1_wrapper.h"
-#include "mir/geometry/rectangle.h"
+#include "mir/geometry/region.h"
 
 #include <memory>
 
@@ -79,7 +79,7 @@ public:
         virtual ~Frame() = default;
         virtual auto destroyed_flag() const -> std::shared_ptr<bool const> = 0;
         virtual auto parameters() const -> FrameParams const& = 0;
-        virtual void capture(geometry::Rectangle buffer_space_damage) = 0;
+        virtual void capture(geometry::Region const& buffer_space_damage) = 0;
     };
 
     WlrScreencopyV1DamageTracker(Executor& wayland_executor, SurfaceStack& surface_stack);
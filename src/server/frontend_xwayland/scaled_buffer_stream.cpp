@@ -36,6 +36,16 @@ void mf::ScaledBufferStream::set_frame_posted_callback(std::function<void(geomet
     inner->set_frame_posted_callback(callback);
 }
 
+void mf::ScaledBufferStream::set_frame_presented_callback(
+    std::function<void(
+        graphics::BufferID,
+        geometry::Rectangle const&,
+        graphics::Frame const&,
+        bool)> const& callback)
+{
+    inner->set_frame_presented_callback(callback);
+}
+
 void mf::ScaledBufferStream::with_most_recent_buffer_do(std::function<void(graphics::Buffer&)> const& exec)
 {
     inner->with_most_recent_buffer_do(exec);
@@ -88,4 +98,13 @@ auto mf::ScaledBufferStream::framedropping() const -> bool
     return inner->framedropping();
 }
 
+void mf::ScaledBufferStream::frame_presented(
+    graphics::BufferID buffer,
+    geometry::Rectangle const& output_area,
+    graphics::Frame const& frame,
+    bool zero_copy)
+{
+    inner->frame_presented(buffer, output_area, frame, zero_copy);
+}
+
 
@@ -37,6 +37,12 @@ public:
     /// @{
     void submit_buffer(std::shared_ptr<graphics::Buffer> const& buffer);
     void set_frame_posted_callback(std::function<void(geometry::Size const&)> const& callback);
+    void set_frame_presented_callback(
+        std::function<void(
+            graphics::BufferID,
+            geometry::Rectangle const&,
+            graphics::Frame const&,
+            bool)> const& callback);
     void with_most_recent_buffer_do(std::function<void(graphics::Buffer&)> const& exec);
     MirPixelFormat pixel_format() const;
     void allow_framedropping(bool allow);
@@ -51,6 +57,11 @@ public:
     void drop_old_buffers();
     auto has_submitted_buffer() const -> bool;
     auto framedropping() const -> bool;
+    void frame_presented(
+        graphics::BufferID buffer,
+        geometry::Rectangle const& output_area,
+        graphics::Frame const& frame,
+        bool zero_copy);
     /// @}
 
 private:
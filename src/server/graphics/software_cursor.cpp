@@ -74,6 +74,11 @@ public:
         return buffer_;
     }
 
+    geom::RectangleD src_bounds() const override
+    {
+        return {{0, 0}, geom::SizeD{buffer_->size()}};
+    }
+
     geom::Rectangle screen_position() const override
     {
         std::lock_guard lock{position_mutex};
@@ -100,6 +105,11 @@ public:
         return true;
     }
 
+    std::vector<geom::Rectangle> opaque_region() const override
+    {
+        return {};
+    }
+
     void move_to(geom::Point new_position)
     {
         std::lock_guard lock{position_mutex};
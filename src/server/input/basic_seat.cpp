@@ -17,6 +17,8 @@
 #include "basic_seat.h"
 #include "mir/input/device.h"
 #include "mir/input/input_sink.h"
+#include "mir/input/input_latency_report.h"
+#include "mir/events/input_event.h"
 #include "mir/graphics/display_configuration_observer.h"
 #include "mir/graphics/display_configuration.h"
 #include "mir/geometry/rectangle.h"
@@ -171,7 +173,9 @@ mi::BasicSeat::BasicSeat(std::shared_ptr<mi::InputDispatcher> const& dispatcher,
                          std::shared_ptr<Registrar> const& registrar,
                          std::shared_ptr<mi::KeyMapper> const& key_mapper,
                          std::shared_ptr<time::Clock> const& clock,
-                         std::shared_ptr<mi::SeatObserver> const& observer) :
+                         std::shared_ptr<mi::SeatObserver> const& observer,
+                         std::shared_ptr<mi::InputLatencyReport> const& latency_report) :
+      latency_report{latency_report},
       input_state_tracker{dispatcher,
                           touch_visualizer,
                           cursor_listener,
@@ -199,7 +203,16 @@ void mi::BasicSeat::remove_device(input::Device const& device)
 
 void mi::BasicSeat::dispatch_event(std::shared_ptr<MirEvent> const& event)
 {
+    if (event->type() != mir_event_type_input)
+    {
+        input_state_tracker.dispatch(event);
+        return;
+    }
+
+    auto const event_time = event->to_input()->event_time();
+    latency_report->received_event(event_time);
     input_state_tracker.dispatch(event);
+    latency_report->dispatched_event(event_time);
 }
 
 geom::Rectangle mi::BasicSeat::bounding_rectangle() const
@@ -41,6 +41,7 @@ class CursorListener;
 class InputDispatcher;
 class KeyMapper;
 class SeatObserver;
+class InputLatencyReport;
 
 class BasicSeat : public Seat
 {
@@ -52,7 +53,8 @@ public:
               std::shared_ptr<Registrar> const& registrar,
               std::shared_ptr<KeyMapper> const& key_mapper,
               std::shared_ptr<time::Clock> const& clock,
-              std::shared_ptr<SeatObserver> const& observer);
+              std::shared_ptr<SeatObserver> const& observer,
+              std::shared_ptr<InputLatencyReport> const& latency_report);
     // Seat methods:
     void add_device(Device const& device) override;
     void remove_device(Device const& device) override;
@@ -68,6 +70,7 @@ public:
     void set_pointer_state(Device const& dev, MirPointerButtons buttons) override;
     void set_cursor_position(float cursor_x, float cursor_y) override;
 private:
+    std::shared_ptr<InputLatencyReport> const latency_report;
     SeatInputDeviceTracker input_state_tracker;
     struct OutputTracker;
     std::shared_ptr<OutputTracker> const output_tracker;
@@ -30,6 +30,7 @@
 #include "default_input_manager.h"
 #include "surface_input_dispatcher.h"
 #include "basic_seat.h"
+#include "recording_seat.h"
 #include "seat_observer_multiplexer.h"
 #include "idle_poking_dispatcher.h"
 
@@ -37,6 +38,7 @@
 #include "mir/input/input_probe.h"
 #include "mir/input/platform.h"
 #include "mir/input/xkb_mapper.h"
+#include "mir/input/input_recording.h"
 #include "mir/input/vt_filter.h"
 #include "mir/options/configuration.h"
 #include "mir/options/option.h"
@@ -50,6 +52,7 @@
 #include "mir/shared_library.h"
 #include "mir/dispatch/action_queue.h"
 #include "mir/console_services.h"
+#include "mir/thread_scheduling_options.h"
 
 #include "mir_toolkit/cursors.h"
 
@@ -270,7 +273,10 @@ mir::DefaultServerConfiguration::the_input_manager()
                         *the_shared_library_prober_report());
                 }
 
-                return std::make_shared<mi::DefaultInputManager>(the_input_reading_multiplexer(), std::move(platform));
+                return std::make_shared<mi::DefaultInputManager>(
+                    the_input_reading_multiplexer(),
+                    std::move(platform),
+                    thread_scheduling_from(*options, options::input_thread_priority_opt, options::input_thread_cpus_opt));
             }
         }
     );
@@ -290,16 +296,27 @@ mir::DefaultServerConfiguration::the_input_reading_multiplexer()
 std::shared_ptr<mi::Seat> mir::DefaultServerConfiguration::the_seat()
 {
     return seat(
-        [this]()
+        [this]() -> std::shared_ptr<mi::Seat>
         {
-            return std::make_shared<mi::BasicSeat>(
+            auto const basic_seat = std::make_shared<mi::BasicSeat>(
                     the_input_dispatcher(),
                     the_touch_visualizer(),
                     the_cursor_listener(),
                     the_display_configuration_observer_registrar(),
                     the_key_mapper(),
                     the_clock(),
-                    the_seat_observer());
+                    the_seat_observer(),
+                    the_input_latency_report());
+
+            auto const options = the_options();
+            if (!options->is_set(options::input_record_opt))
+                return basic_seat;
+
+            auto const path = options->get<std::string>(options::input_record_opt);
+            mir::log_info("Recording input to %s", path.c_str());
+            return std::make_shared<mi::RecordingSeat>(
+                basic_seat,
+                std::make_shared<mi::InputRecordingWriter>(path));
         });
 }
 
@@ -331,7 +348,9 @@ std::shared_ptr<mi::DefaultInputDeviceHub> mir::DefaultServerConfiguration::the_
                the_clock(),
                the_cookie_authority(),
                the_key_mapper(),
-               the_server_status_listener());
+               the_server_status_listener(),
+               the_input_report(),
+               the_options()->get<int>(options::input_motion_rate_limit_opt));
 
            // lp:1675357: KeyRepeatDispatcher must be informed about removed input devices, otherwise
            // pressed keys get repeated indefinitely
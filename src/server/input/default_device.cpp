@@ -234,6 +234,11 @@ mir::optional_value<MirTouchscreenConfig> mi::DefaultDevice::touchscreen_configu
     return MirTouchscreenConfig(settings.output_id, settings.mapping_mode);
 }
 
+mi::InputDeviceStatistics mi::DefaultDevice::statistics() const
+{
+    return recorded_statistics.snapshot();
+}
+
 void mi::DefaultDevice::apply_touchscreen_configuration(MirTouchscreenConfig const& config)
 {
     if (!touchscreen.is_set())
@@ -17,6 +17,8 @@
 #ifndef MIR_INPUT_DEFAULT_DEVICE_H_
 #define MIR_INPUT_DEFAULT_DEVICE_H_
 
+#include "input_statistics.h"
+
 #include "mir_toolkit/event.h"
 #include "mir/input/device.h"
 #include "mir/input/input_device_info.h"
@@ -73,9 +75,12 @@ public:
     void apply_keyboard_configuration(MirKeyboardConfig const&) override;
     optional_value<MirTouchscreenConfig> touchscreen_configuration() const override;
     void apply_touchscreen_configuration(MirTouchscreenConfig const&) override;
+    InputDeviceStatistics statistics() const override;
 
     MirInputDevice config() const;
     void disable_queue();
+    /// Where the input thread records the statistics as it handles the device's events
+    auto input_statistics() -> InputStatistics& { return recorded_statistics; }
 private:
     void set_pointer_configuration(MirPointerConfig const&);
     void set_touchpad_configuration(MirTouchpadConfig const&);
@@ -93,6 +98,7 @@ private:
     std::shared_ptr<KeyMapper> const key_mapper;
     std::function<void(Device*)> device_changed_callback;
     std::mutex mutable config_mutex;
+    InputStatistics recorded_statistics;
 };
 
 }
@@ -19,6 +19,7 @@
 
 #include "mir/input/input_device.h"
 #include "mir/input/input_device_observer.h"
+#include "mir/input/input_report.h"
 #include "mir/input/mir_pointer_config.h"
 #include "mir/input/mir_touchpad_config.h"
 #include "mir/input/mir_keyboard_config.h"
@@ -26,8 +27,10 @@
 #include "mir/server_status_listener.h"
 #include "mir/dispatch/multiplexing_dispatchable.h"
 #include "mir/dispatch/action_queue.h"
+#include "mir/dispatch/readable_fd.h"
 #include "mir/server_action_queue.h"
 #include "mir/cookie/authority.h"
+#include "mir/time/clock.h"
 #define MIR_LOG_COMPONENT "Input"
 #include "mir/log.h"
 
@@ -35,7 +38,14 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
 #include <memory>
+#include <system_error>
+
+#include <sys/timerfd.h>
+#include <unistd.h>
 
 namespace mi = mir::input;
 
@@ -185,7 +195,9 @@ mi::DefaultInputDeviceHub::DefaultInputDeviceHub(
     std::shared_ptr<time::Clock> const& clock,
     std::shared_ptr<mir::cookie::Authority> const& cookie_authority,
     std::shared_ptr<mi::KeyMapper> const& key_mapper,
-    std::shared_ptr<mir::ServerStatusListener> const& server_status_listener)
+    std::shared_ptr<mir::ServerStatusListener> const& server_status_listener,
+    std::shared_ptr<InputReport> const& input_report,
+    int max_motion_rate)
     : seat{seat},
       input_dispatchable{input_multiplexer},
       device_queue(std::make_shared<dispatch::ActionQueue>()),
@@ -193,6 +205,8 @@ mi::DefaultInputDeviceHub::DefaultInputDeviceHub(
       cookie_authority(cookie_authority),
       key_mapper(key_mapper),
       server_status_listener(server_status_listener),
+      input_report(input_report),
+      max_motion_rate(max_motion_rate),
       device_id_generator{0}
 {
     input_dispatchable->add_watch(device_queue);
@@ -223,7 +237,9 @@ auto mi::DefaultInputDeviceHub::add_device(std::shared_ptr<InputDevice> const& d
             queue,
             clock,
             cookie_authority,
-            handle));
+            handle,
+            input_report,
+            max_motion_rate));
 
         auto const& dev = devices.back();
         add_device_handle(lock, handle);
@@ -281,14 +297,45 @@ mi::DefaultInputDeviceHub::RegisteredDevice::RegisteredDevice(
     std::shared_ptr<dispatch::ActionQueue> const& queue,
     std::shared_ptr<time::Clock> const& clock,
     std::shared_ptr<mir::cookie::Authority> const& cookie_authority,
-    std::shared_ptr<mi::DefaultDevice> const& handle)
+    std::shared_ptr<mi::DefaultDevice> const& handle,
+    std::shared_ptr<InputReport> const& input_report,
+    int max_motion_rate)
     : handle(handle),
       device_id(device_id),
       clock(clock),
       cookie_authority(cookie_authority),
       device(dev),
-      queue(queue)
+      queue(queue),
+      input_report(input_report),
+      report_statistics{input_report->wants_device_statistics()}
 {
+    auto const create_timer = [](char const* purpose)
+        {
+            mir::Fd timer{timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)};
+            if (timer == mir::Fd::invalid)
+            {
+                BOOST_THROW_EXCEPTION((std::system_error{
+                    errno,
+                    std::system_category(),
+                    std::string{"Failed to create "} + purpose}));
+            }
+            return timer;
+        };
+
+    if (max_motion_rate > 0)
+    {
+        motion_rate_limiter.emplace(max_motion_rate);
+        motion_flush_timer = std::make_shared<dispatch::ReadableFd>(
+            create_timer("motion flush timer"),
+            [this] { flush_motion(); });
+    }
+
+    if (report_statistics)
+    {
+        statistics_timer = std::make_shared<dispatch::ReadableFd>(
+            create_timer("input statistics timer"),
+            [this] { report_statistics_if_due(); });
+    }
 }
 
 MirInputDeviceId mi::DefaultInputDeviceHub::create_new_device_id(std::lock_guard<std::recursive_mutex> const&)
@@ -312,7 +359,47 @@ void mi::DefaultInputDeviceHub::RegisteredDevice::handle_input(std::shared_ptr<M
     if (!seat)
         return;
 
-    seat->dispatch_event(event);
+    auto& statistics = handle->input_statistics();
+
+    // Timing the handling costs more clock reads than anything else here, so is only done for the report
+    if (!report_statistics)
+    {
+        statistics.received(clock->now());
+        if (admit(*event))
+            seat->dispatch_event(event);
+        return;
+    }
+
+    // Handling costs are measured on the steady clock, the injected clock only paces the measurement periods
+    auto const start = std::chrono::steady_clock::now();
+    auto const period_complete = statistics.received(clock->now());
+
+    if (!admit(*event))
+    {
+        statistics.handled(std::chrono::steady_clock::now() - start, {}, {});
+    }
+    else
+    {
+        InputStatistics::FilterTimeScope filters;
+        auto const seat_start = std::chrono::steady_clock::now();
+        seat->dispatch_event(event);
+        auto const end = std::chrono::steady_clock::now();
+        statistics.handled(end - start, filters.filter_time(), end - seat_start - filters.filter_time());
+    }
+
+    if (period_complete)
+        input_report->device_statistics(handle->name().c_str(), statistics.snapshot());
+    schedule_statistics_report();
+}
+
+auto mi::DefaultInputDeviceHub::RegisteredDevice::admit(MirEvent& event) -> bool
+{
+    if (!motion_rate_limiter || motion_rate_limiter->admit(event))
+        return true;
+
+    handle->input_statistics().dropped();
+    schedule_motion_flush();
+    return false;
 }
 
 bool mi::DefaultInputDeviceHub::RegisteredDevice::device_matches(std::shared_ptr<InputDevice> const& dev) const
@@ -320,9 +407,91 @@ bool mi::DefaultInputDeviceHub::RegisteredDevice::device_matches(std::shared_ptr
     return dev == device;
 }
 
+void mi::DefaultInputDeviceHub::RegisteredDevice::schedule_motion_flush()
+{
+    // Event times are on CLOCK_MONOTONIC, so the timer can be set for when the limiter wants flushing
+    auto const due = motion_rate_limiter->flush_due();
+    if (!due || due == motion_flush_due)
+        return;
+
+    motion_flush_due = due;
+    auto const seconds = std::chrono::duration_cast<std::chrono::seconds>(*due);
+    itimerspec const deadline{
+        {0, 0},
+        {static_cast<time_t>(seconds.count()), static_cast<long>((*due - seconds).count())}};
+    if (timerfd_settime(motion_flush_timer->watch_fd(), TFD_TIMER_ABSTIME, &deadline, nullptr) < 0)
+    {
+        // Better to send the motion early than to hold it back until some later event
+        log_warning("Failed to set motion flush timer: %s", std::strerror(errno));
+        motion_flush_due.reset();
+        if (!seat)
+            return;
+        while (auto const event = motion_rate_limiter->flush())
+        {
+            seat->dispatch_event(event);
+        }
+    }
+}
+
+void mi::DefaultInputDeviceHub::RegisteredDevice::flush_motion()
+{
+    // Nothing to read if the timer was rearmed since it fired, the flush is then due later
+    uint64_t expirations;
+    if (read(motion_flush_timer->watch_fd(), &expirations, sizeof expirations) < 0)
+        return;
+
+    motion_flush_due.reset();
+    if (!seat)
+        return;
+
+    // Nothing is held back if a later event was admitted with the motion in the meantime
+    while (auto const event = motion_rate_limiter->flush())
+    {
+        seat->dispatch_event(event);
+    }
+}
+
+void mi::DefaultInputDeviceHub::RegisteredDevice::schedule_statistics_report()
+{
+    auto const due = handle->input_statistics().period_end();
+    if (!due || due == statistics_due)
+        return;
+
+    // The injected clock is steady_clock (CLOCK_MONOTONIC) outside of tests
+    statistics_due = due;
+    auto const since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(due->time_since_epoch());
+    auto const seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+    itimerspec const deadline{
+        {0, 0},
+        {static_cast<time_t>(seconds.count()), static_cast<long>((since_epoch - seconds).count())}};
+    if (timerfd_settime(statistics_timer->watch_fd(), TFD_TIMER_ABSTIME, &deadline, nullptr) < 0)
+    {
+        // The statistics are still reported as events arrive, just not once the device goes quiet
+        log_warning("Failed to set input statistics timer: %s", std::strerror(errno));
+        statistics_due.reset();
+    }
+}
+
+void mi::DefaultInputDeviceHub::RegisteredDevice::report_statistics_if_due()
+{
+    uint64_t expirations;
+    if (read(statistics_timer->watch_fd(), &expirations, sizeof expirations) < 0)
+        return;
+
+    statistics_due.reset();
+    auto& statistics = handle->input_statistics();
+    if (statistics.elapsed(clock->now()))
+        input_report->device_statistics(handle->name().c_str(), statistics.snapshot());
+    schedule_statistics_report();
+}
+
 void mi::DefaultInputDeviceHub::RegisteredDevice::start(std::shared_ptr<Seat> const& seat, std::shared_ptr<dispatch::MultiplexingDispatchable> const& multiplexer)
 {
     multiplexer->add_watch(queue);
+    if (motion_flush_timer)
+        multiplexer->add_watch(motion_flush_timer);
+    if (statistics_timer)
+        multiplexer->add_watch(statistics_timer);
 
     this->seat = seat;
     builder = std::make_unique<DefaultEventBuilder>(device_id, clock, cookie_authority);
@@ -332,6 +501,10 @@ void mi::DefaultInputDeviceHub::RegisteredDevice::start(std::shared_ptr<Seat> co
 void mi::DefaultInputDeviceHub::RegisteredDevice::stop(std::shared_ptr<dispatch::MultiplexingDispatchable> const& multiplexer)
 {
     multiplexer->remove_watch(queue);
+    if (motion_flush_timer)
+        multiplexer->remove_watch(motion_flush_timer);
+    if (statistics_timer)
+        multiplexer->remove_watch(statistics_timer);
     handle->disable_queue();
 
     device->stop();
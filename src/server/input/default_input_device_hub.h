@@ -18,6 +18,7 @@
 #define MIR_INPUT_DEFAULT_INPUT_DEVICE_HUB_H_
 
 #include "default_event_builder.h"
+#include "motion_rate_limiter.h"
 
 #include "mir/input/input_device_registry.h"
 #include "mir/input/input_sink.h"
@@ -27,10 +28,12 @@
 #include "mir/input/input_device_info.h"
 #include "mir/input/mir_input_config.h"
 #include "mir/thread_safe_list.h"
+#include "mir/time/types.h"
 
 #include "mir_toolkit/event.h"
 
 #include <linux/input.h>
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <mutex>
@@ -53,11 +56,13 @@ namespace dispatch
 class Dispatchable;
 class MultiplexingDispatchable;
 class ActionQueue;
+class ReadableFd;
 }
 namespace input
 {
 class InputSink;
 class InputDeviceObserver;
+class InputReport;
 class DefaultDevice;
 class Seat;
 class KeyMapper;
@@ -91,7 +96,9 @@ public:
         std::shared_ptr<time::Clock> const& clock,
         std::shared_ptr<cookie::Authority> const& cookie_authority,
         std::shared_ptr<KeyMapper> const& key_mapper,
-        std::shared_ptr<ServerStatusListener> const& server_status_listener);
+        std::shared_ptr<ServerStatusListener> const& server_status_listener,
+        std::shared_ptr<InputReport> const& input_report,
+        int max_motion_rate);
 
     // InputDeviceRegistry - calls from mi::Platform
     auto add_device(std::shared_ptr<InputDevice> const& device) -> std::weak_ptr<Device> override;
@@ -124,6 +131,9 @@ private:
     std::shared_ptr<cookie::Authority> const cookie_authority;
     std::shared_ptr<KeyMapper> const key_mapper;
     std::shared_ptr<ServerStatusListener> const server_status_listener;
+    std::shared_ptr<InputReport> const input_report;
+    /// Motion events per second taken from each device, or 0 for no limit
+    int const max_motion_rate;
     ThreadSafeList<std::shared_ptr<InputDeviceObserver>> observers;
 
     /// Does not guarantee it's own threadsafety, non-const methods should not be called from multiple threads at once
@@ -136,7 +146,9 @@ private:
             std::shared_ptr<dispatch::ActionQueue> const& multiplexer,
             std::shared_ptr<time::Clock> const& clock,
             std::shared_ptr<cookie::Authority> const& cookie_authority,
-            std::shared_ptr<DefaultDevice> const& handle);
+            std::shared_ptr<DefaultDevice> const& handle,
+            std::shared_ptr<InputReport> const& input_report,
+            int max_motion_rate);
         void handle_input(std::shared_ptr<MirEvent> const& event) override;
         geometry::Rectangle bounding_rectangle() const override;
         input::OutputInfo output_info(uint32_t output_id) const override;
@@ -156,6 +168,23 @@ private:
         std::shared_ptr<cookie::Authority> cookie_authority;
         std::shared_ptr<InputDevice> const device;
         std::shared_ptr<dispatch::ActionQueue> queue;
+        std::shared_ptr<InputReport> const input_report;
+        std::optional<MotionRateLimiter> motion_rate_limiter;
+        /// Fires when motion held back by the rate limiter is due, so it isn't lost if no later event carries it
+        std::shared_ptr<dispatch::ReadableFd> motion_flush_timer;
+        std::optional<std::chrono::nanoseconds> motion_flush_due;
+        /// Whether the input report wants the device statistics, and so the handling of each event timed
+        bool const report_statistics;
+        /// Fires at the end of each measurement period while the device has a rate, so it is reported when quiet
+        std::shared_ptr<dispatch::ReadableFd> statistics_timer;
+        std::optional<time::Timestamp> statistics_due;
+
+        /// Passes the event through the motion rate limiter, returning whether it should be dispatched now
+        auto admit(MirEvent& event) -> bool;
+        void schedule_motion_flush();
+        void flush_motion();
+        void schedule_statistics_report();
+        void report_statistics_if_due();
     };
 
     // Needs to be a recursive mutex so that initial device notifications can be sent under lock in add_observer()
@@ -32,10 +32,12 @@ namespace mi = mir::input;
 
 mi::DefaultInputManager::DefaultInputManager(
     std::shared_ptr<dispatch::MultiplexingDispatchable> const& multiplexer,
-    std::shared_ptr<Platform> const& platform) :
+    std::shared_ptr<Platform> const& platform,
+    ThreadScheduling const& thread_scheduling) :
     platform{platform},
     multiplexer{multiplexer},
     queue{std::make_shared<mir::dispatch::ActionQueue>()},
+    thread_scheduling{thread_scheduling},
     state{State::stopped}
 {
 }
@@ -80,6 +82,8 @@ void mi::DefaultInputManager::start()
      */
     queue->enqueue([this,promise = std::move(started_promise)]()
                    {
+                        // This is the first thing run on the new input thread
+                        apply_thread_scheduling(thread_scheduling, "input");
                         start_platforms();
                         promise->set_value();
                    });
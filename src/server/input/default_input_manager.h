@@ -18,6 +18,7 @@
 #define MIR_INPUT_DEFAULT_INPUT_MANAGER_H_
 
 #include "mir/input/input_manager.h"
+#include "mir/thread_scheduling.h"
 
 #include <atomic>
 #include <memory>
@@ -41,7 +42,8 @@ class DefaultInputManager : public InputManager
 public:
     DefaultInputManager(
         std::shared_ptr<dispatch::MultiplexingDispatchable> const& multiplexer,
-        std::shared_ptr<Platform> const& platform);
+        std::shared_ptr<Platform> const& platform,
+        ThreadScheduling const& thread_scheduling);
     ~DefaultInputManager();
 
     void start() override;
@@ -55,6 +57,7 @@ private:
     std::shared_ptr<dispatch::MultiplexingDispatchable> const multiplexer;
     std::shared_ptr<dispatch::ActionQueue> const queue;
     std::unique_ptr<dispatch::ThreadedDispatcher> input_thread;
+    ThreadScheduling const thread_scheduling;
 
     enum class State
     {
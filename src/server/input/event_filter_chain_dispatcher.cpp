@@ -15,6 +15,9 @@
  */
 
 #include "event_filter_chain_dispatcher.h"
+#include "input_statistics.h"
+
+#include <chrono>
 
 namespace mi = mir::input;
 
@@ -62,7 +65,19 @@ void mi::EventFilterChainDispatcher::prepend(std::weak_ptr<EventFilter> const& f
 
 bool mi::EventFilterChainDispatcher::dispatch(std::shared_ptr<MirEvent const> const& event)
 {
-    if (!handle(*event))
+    bool consumed;
+    if (InputStatistics::filters_timed())
+    {
+        auto const start = std::chrono::steady_clock::now();
+        consumed = handle(*event);
+        InputStatistics::filtered(std::chrono::steady_clock::now() - start);
+    }
+    else
+    {
+        consumed = handle(*event);
+    }
+
+    if (!consumed)
         return next_dispatcher->dispatch(event);
     return true;
 }
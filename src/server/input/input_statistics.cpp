@@ -0,0 +1,120 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_statistics.h"
+
+namespace mi = mir::input;
+
+mir::time::Duration const mi::InputStatistics::period = std::chrono::seconds{1};
+
+namespace
+{
+thread_local mi::InputStatistics::FilterTimeScope* current_scope{nullptr};
+}
+
+mi::InputStatistics::FilterTimeScope::FilterTimeScope()
+    : outer{current_scope}
+{
+    current_scope = this;
+}
+
+mi::InputStatistics::FilterTimeScope::~FilterTimeScope()
+{
+    current_scope = outer;
+}
+
+void mi::InputStatistics::filtered(std::chrono::nanoseconds duration)
+{
+    if (current_scope)
+        current_scope->filter_time_ += duration;
+}
+
+auto mi::InputStatistics::filters_timed() -> bool
+{
+    return current_scope != nullptr;
+}
+
+auto mi::InputStatistics::received(time::Timestamp now) -> bool
+{
+    events.fetch_add(1, std::memory_order_relaxed);
+
+    auto const now_period = now.time_since_epoch() / period;
+    auto const completed = complete_periods_before(now_period);
+
+    if (!current_period)
+        current_period = now_period;
+    ++period_events;
+
+    return completed;
+}
+
+auto mi::InputStatistics::elapsed(time::Timestamp now) -> bool
+{
+    return complete_periods_before(now.time_since_epoch() / period);
+}
+
+auto mi::InputStatistics::period_end() const -> std::optional<time::Timestamp>
+{
+    if (!current_period)
+        return std::nullopt;
+
+    return time::Timestamp{(*current_period + 1) * period};
+}
+
+auto mi::InputStatistics::complete_periods_before(int64_t period_index) -> bool
+{
+    if (!current_period || period_index <= *current_period)
+        return false;
+
+    // The last complete period is the one being measured, unless periods without events have passed since
+    uint64_t const rate = period_index == *current_period + 1 ?
+        period_events * std::chrono::nanoseconds{std::chrono::seconds{1}}.count() /
+            std::chrono::duration_cast<std::chrono::nanoseconds>(period).count() :
+        0;
+    events_per_second.store(rate, std::memory_order_relaxed);
+
+    // While there is a rate, keep measuring even if the device stays quiet, so the rate drops to zero
+    current_period = rate > 0 ? std::make_optional(period_index) : std::nullopt;
+    period_events = 0;
+    return true;
+}
+
+void mi::InputStatistics::dropped()
+{
+    dropped_events.fetch_add(1, std::memory_order_relaxed);
+}
+
+void mi::InputStatistics::handled(
+    std::chrono::nanoseconds handle_input_time,
+    std::chrono::nanoseconds event_filter_time,
+    std::chrono::nanoseconds seat_time)
+{
+    handle_input_ns.fetch_add(handle_input_time.count(), std::memory_order_relaxed);
+    event_filter_ns.fetch_add(event_filter_time.count(), std::memory_order_relaxed);
+    seat_ns.fetch_add(seat_time.count(), std::memory_order_relaxed);
+}
+
+auto mi::InputStatistics::snapshot() const -> InputDeviceStatistics
+{
+    InputDeviceStatistics result;
+    result.events = events.load(std::memory_order_relaxed);
+    result.dropped_events = dropped_events.load(std::memory_order_relaxed);
+    result.events_per_second = events_per_second.load(std::memory_order_relaxed);
+    result.handle_input_time = std::chrono::nanoseconds{handle_input_ns.load(std::memory_order_relaxed)};
+    result.event_filter_time = std::chrono::nanoseconds{event_filter_ns.load(std::memory_order_relaxed)};
+    result.seat_time = std::chrono::nanoseconds{seat_ns.load(std::memory_order_relaxed)};
+    return result;
+}
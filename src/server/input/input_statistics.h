@@ -0,0 +1,98 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_INPUT_STATISTICS_H_
+#define MIR_INPUT_INPUT_STATISTICS_H_
+
+#include "mir/input/input_device_statistics.h"
+#include "mir/time/types.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace mir
+{
+namespace input
+{
+/// Accumulates the statistics of a device. Recorded on the input thread, and read from any thread.
+class InputStatistics
+{
+public:
+    /// How often events_per_second is measured (and the statistics reported). Periods are fixed windows of the
+    /// clock, so every event in one period is counted towards the same rate.
+    static time::Duration const period;
+
+    /// Collects the time spent in event filters on this thread while in scope. Dispatch from the seat through the
+    /// filters is synchronous, so this attributes filter time to the device whose event is being handled.
+    class FilterTimeScope
+    {
+    public:
+        FilterTimeScope();
+        ~FilterTimeScope();
+
+        auto filter_time() const -> std::chrono::nanoseconds { return filter_time_; }
+
+    private:
+        FilterTimeScope(FilterTimeScope const&) = delete;
+        FilterTimeScope& operator=(FilterTimeScope const&) = delete;
+
+        friend class InputStatistics;
+        FilterTimeScope* const outer;
+        std::chrono::nanoseconds filter_time_{0};
+    };
+
+    /// Adds time spent in the event filters to the innermost FilterTimeScope on this thread, if any. (An event
+    /// dispatched from within a filter is timed in its own scope, and is also part of the outer filter time.)
+    static void filtered(std::chrono::nanoseconds duration);
+    /// Whether there is a FilterTimeScope on this thread, so the event filters need timing
+    static auto filters_timed() -> bool;
+
+    /// Records an event received at \a now. Returns true when this completes a measurement period.
+    auto received(time::Timestamp now) -> bool;
+    /// Completes the measurement period if it has ended by \a now, without an event to do so. Returns true when
+    /// this completes a measurement period.
+    auto elapsed(time::Timestamp now) -> bool;
+    /// When the period being measured ends. Nullopt while the device is quiet: once a period without events has
+    /// been completed, the rate stays zero until the next event.
+    auto period_end() const -> std::optional<time::Timestamp>;
+    void dropped();
+    void handled(
+        std::chrono::nanoseconds handle_input_time,
+        std::chrono::nanoseconds event_filter_time,
+        std::chrono::nanoseconds seat_time);
+
+    auto snapshot() const -> InputDeviceStatistics;
+
+private:
+    std::atomic<uint64_t> events{0};
+    std::atomic<uint64_t> dropped_events{0};
+    std::atomic<uint64_t> events_per_second{0};
+    std::atomic<int64_t> handle_input_ns{0};
+    std::atomic<int64_t> event_filter_ns{0};
+    std::atomic<int64_t> seat_ns{0};
+
+    // Only used on the input thread
+    std::optional<int64_t> current_period; ///< The period being measured, counted in periods since the epoch
+    uint64_t period_events{0};
+
+    auto complete_periods_before(int64_t period_index) -> bool;
+};
+}
+}
+
+#endif /* MIR_INPUT_INPUT_STATISTICS_H_ */
@@ -0,0 +1,146 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "motion_rate_limiter.h"
+
+#include "mir/events/event_builders.h"
+#include "mir/events/event_private.h"
+#include "mir/events/pointer_event.h"
+#include "mir/events/touch_event.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace mi = mir::input;
+namespace mev = mir::events;
+
+mi::MotionRateLimiter::MotionRateLimiter(int max_rate)
+    : min_interval{[max_rate]
+        {
+            if (max_rate <= 0)
+                BOOST_THROW_EXCEPTION(std::invalid_argument("Motion rate limit must be positive"));
+            return std::chrono::nanoseconds{std::chrono::seconds{1}} / max_rate;
+        }()}
+{
+}
+
+auto mi::MotionRateLimiter::admit(MirEvent& event) -> bool
+{
+    if (event.type() != mir_event_type_input)
+        return true;
+
+    auto const input = event.to_input();
+    switch (input->input_type())
+    {
+    case mir_input_event_type_pointer:
+        return admit(*input->to_pointer());
+
+    case mir_input_event_type_touch:
+        return admit(*input->to_touch());
+
+    default:
+        return true;
+    }
+}
+
+auto mi::MotionRateLimiter::admit(MirPointerEvent& event) -> bool
+{
+    auto const time = event.event_time();
+    auto const only_motion =
+        event.action() == mir_pointer_action_motion &&
+        event.buttons() == last_buttons &&
+        event.h_scroll() == mev::ScrollAxisH{} &&
+        event.v_scroll() == mev::ScrollAxisV{};
+
+    if (only_motion && too_soon(last_pointer_time, time))
+    {
+        pending_motion = pending_motion + event.motion();
+        held_pointer = mev::share_event(mev::clone_event(event));
+        pointer_held = true;
+        return false;
+    }
+
+    event.set_motion(event.motion() + pending_motion);
+    pending_motion = {};
+    pointer_held = false;
+    last_buttons = event.buttons();
+    last_pointer_time = time;
+    return true;
+}
+
+auto mi::MotionRateLimiter::admit(MirTouchEvent const& event) -> bool
+{
+    auto const time = event.event_time();
+
+    auto only_motion = true;
+    for (size_t i = 0; i != event.pointer_count(); ++i)
+    {
+        if (event.action(i) != mir_touch_action_change)
+            only_motion = false;
+    }
+
+    if (only_motion && too_soon(last_touch_time, time))
+    {
+        held_touch = mev::share_event(mev::clone_event(event));
+        touch_held = true;
+        return false;
+    }
+
+    touch_held = false;
+    last_touch_time = time;
+    return true;
+}
+
+auto mi::MotionRateLimiter::flush_due() const -> std::optional<std::chrono::nanoseconds>
+{
+    std::optional<std::chrono::nanoseconds> due;
+    if (pointer_held)
+        due = *last_pointer_time + min_interval;
+    if (touch_held)
+        due = std::min(due.value_or(std::chrono::nanoseconds::max()), *last_touch_time + min_interval);
+    return due;
+}
+
+auto mi::MotionRateLimiter::flush() -> std::shared_ptr<MirEvent>
+{
+    if (pointer_held)
+    {
+        pointer_held = false;
+        auto& event = *held_pointer->to_input()->to_pointer();
+        event.set_motion(pending_motion);
+        pending_motion = {};
+        last_pointer_time = event.event_time();
+        return std::move(held_pointer);
+    }
+
+    if (touch_held)
+    {
+        touch_held = false;
+        last_touch_time = held_touch->to_input()->event_time();
+        return std::move(held_touch);
+    }
+
+    return nullptr;
+}
+
+auto mi::MotionRateLimiter::too_soon(
+    std::optional<std::chrono::nanoseconds> const& last,
+    std::chrono::nanoseconds time) const -> bool
+{
+    return last && time - *last < min_interval;
+}
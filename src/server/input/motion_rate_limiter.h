@@ -0,0 +1,74 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_MOTION_RATE_LIMITER_H_
+#define MIR_INPUT_MOTION_RATE_LIMITER_H_
+
+#include "mir/geometry/displacement.h"
+#include "mir_toolkit/event.h"
+
+#include <chrono>
+#include <memory>
+#include <optional>
+
+namespace mir
+{
+namespace input
+{
+/// Limits the rate of motion from a device (such as a high polling rate mouse) by dropping motion events that arrive
+/// too soon after the last one passed on. Dropped pointer motion is merged into the next pointer event passed on, so
+/// no movement is lost; dropped touch motion is superseded by the next touch event. If motion stops before another
+/// event is passed on, flush() gives what was held back. Events that change anything else (buttons, scrolling,
+/// touches going down or up) are always passed on.
+class MotionRateLimiter
+{
+public:
+    /// \param max_rate motion events per second
+    explicit MotionRateLimiter(int max_rate);
+
+    /// Whether to pass \a event on. A pointer event passed on may have been given the motion of dropped ones.
+    auto admit(MirEvent& event) -> bool;
+
+    /// When flush() should be called if nothing is admitted first (on the clock of the event times), or nullopt if
+    /// no motion is being held back
+    auto flush_due() const -> std::optional<std::chrono::nanoseconds>;
+    /// Motion held back from dropped events, as an event to pass on in their place. Pointer motion comes as a single
+    /// event with the motion of all of them; touch motion as the latest. Null once there is nothing (more) to send.
+    auto flush() -> std::shared_ptr<MirEvent>;
+
+private:
+    auto admit(MirPointerEvent& event) -> bool;
+    auto admit(MirTouchEvent const& event) -> bool;
+    auto too_soon(std::optional<std::chrono::nanoseconds> const& last, std::chrono::nanoseconds time) const -> bool;
+
+    std::chrono::nanoseconds const min_interval;
+
+    std::optional<std::chrono::nanoseconds> last_pointer_time;
+    MirPointerButtons last_buttons{0};
+    geometry::DisplacementF pending_motion;
+    /// The latest dropped pointer event, to flush with pending_motion
+    std::shared_ptr<MirEvent> held_pointer;
+    bool pointer_held{false};
+
+    std::optional<std::chrono::nanoseconds> last_touch_time;
+    /// The latest dropped touch event, to flush if no other touch event supersedes it
+    std::shared_ptr<MirEvent> held_touch;
+    bool touch_held{false};
+};
+}
+}
+
+#endif /* MIR_INPUT_MOTION_RATE_LIMITER_H_ */
@@ -0,0 +1,94 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "recording_seat.h"
+#include "mir/input/device.h"
+#include "mir/input/input_recording.h"
+#include "mir/input/input_sink.h"
+
+namespace mi = mir::input;
+namespace geom = mir::geometry;
+
+mi::RecordingSeat::RecordingSeat(
+    std::shared_ptr<Seat> const& next,
+    std::shared_ptr<InputRecordingWriter> const& writer)
+    : next{next},
+      writer{writer}
+{
+}
+
+void mi::RecordingSeat::add_device(Device const& device)
+{
+    writer->device_added(device.id(), device.name(), device.unique_id(), device.capabilities().value());
+    next->add_device(device);
+}
+
+void mi::RecordingSeat::remove_device(Device const& device)
+{
+    writer->device_removed(device.id());
+    next->remove_device(device);
+}
+
+void mi::RecordingSeat::dispatch_event(std::shared_ptr<MirEvent> const& event)
+{
+    writer->record(*event);
+    next->dispatch_event(event);
+}
+
+mir::EventUPtr mi::RecordingSeat::create_device_state()
+{
+    return next->create_device_state();
+}
+
+auto mi::RecordingSeat::xkb_modifiers() const -> MirXkbModifiers
+{
+    return next->xkb_modifiers();
+}
+
+void mi::RecordingSeat::set_key_state(Device const& dev, std::vector<uint32_t> const& scan_codes)
+{
+    next->set_key_state(dev, scan_codes);
+}
+
+void mi::RecordingSeat::set_pointer_state(Device const& dev, MirPointerButtons buttons)
+{
+    next->set_pointer_state(dev, buttons);
+}
+
+void mi::RecordingSeat::set_cursor_position(float cursor_x, float cursor_y)
+{
+    next->set_cursor_position(cursor_x, cursor_y);
+}
+
+void mi::RecordingSeat::set_confinement_regions(geom::Rectangles const& regions)
+{
+    next->set_confinement_regions(regions);
+}
+
+void mi::RecordingSeat::reset_confinement_regions()
+{
+    next->reset_confinement_regions();
+}
+
+geom::Rectangle mi::RecordingSeat::bounding_rectangle() const
+{
+    return next->bounding_rectangle();
+}
+
+mi::OutputInfo mi::RecordingSeat::output_info(uint32_t output_id) const
+{
+    return next->output_info(output_id);
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_RECORDING_SEAT_H_
+#define MIR_INPUT_RECORDING_SEAT_H_
+
+#include "mir/input/seat.h"
+
+namespace mir
+{
+namespace input
+{
+class InputRecordingWriter;
+
+/// Records the devices and input events reaching the seat (see --input-record) before passing them on
+class RecordingSeat : public Seat
+{
+public:
+    RecordingSeat(std::shared_ptr<Seat> const& next, std::shared_ptr<InputRecordingWriter> const& writer);
+
+    void add_device(Device const& device) override;
+    void remove_device(Device const& device) override;
+    void dispatch_event(std::shared_ptr<MirEvent> const& event) override;
+    EventUPtr create_device_state() override;
+    auto xkb_modifiers() const -> MirXkbModifiers override;
+
+    void set_key_state(Device const& dev, std::vector<uint32_t> const& scan_codes) override;
+    void set_pointer_state(Device const& dev, MirPointerButtons buttons) override;
+    void set_cursor_position(float cursor_x, float cursor_y) override;
+    void set_confinement_regions(geometry::Rectangles const& regions) override;
+    void reset_confinement_regions() override;
+
+    geometry::Rectangle bounding_rectangle() const override;
+    input::OutputInfo output_info(uint32_t output_id) const override;
+
+private:
+    std::shared_ptr<Seat> const next;
+    std::shared_ptr<InputRecordingWriter> const writer;
+};
+}
+}
+
+#endif // MIR_INPUT_RECORDING_SEAT_H_
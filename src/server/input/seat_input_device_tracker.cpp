@@ -32,6 +32,7 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <cstring>
 #include <tuple>
 #include <numeric>
 
@@ -39,6 +40,26 @@ namespace mi = mir::input;
 namespace mev = mir::events;
 namespace geom = mir::geometry;
 
+namespace
+{
+auto pack_cursor(float x, float y) -> uint64_t
+{
+    uint32_t x_bits, y_bits;
+    memcpy(&x_bits, &x, sizeof x_bits);
+    memcpy(&y_bits, &y, sizeof y_bits);
+    return uint64_t{x_bits} << 32 | y_bits;
+}
+
+auto unpack_cursor(uint64_t packed) -> std::pair<float, float>
+{
+    uint32_t const x_bits = packed >> 32, y_bits = packed;
+    float x, y;
+    memcpy(&x, &x_bits, sizeof x);
+    memcpy(&y, &y_bits, sizeof y);
+    return {x, y};
+}
+}
+
 mi::SeatInputDeviceTracker::SeatInputDeviceTracker(std::shared_ptr<InputDispatcher> const& dispatcher,
                                                    std::shared_ptr<TouchVisualizer> const& touch_visualizer,
                                                    std::shared_ptr<CursorListener> const& cursor_listener,
@@ -98,7 +119,7 @@ void mi::SeatInputDeviceTracker::dispatch(std::shared_ptr<MirEvent> const& event
 
         key_mapper->map_event(*event);
 
-        if (mir_input_event_type_pointer == mir_input_event_get_type(input_event))
+        if (mir_input_event_get_type(input_event) == mir_input_event_type_pointer)
         {
             mev::set_cursor_position(*event, cursor_x, cursor_y);
             mev::set_button_state(*event, buttons);
@@ -195,12 +216,12 @@ void mi::SeatInputDeviceTracker::update_states()
                               end(device_data),
                               MirPointerButtons{0},
                               [](auto const& acc, auto const& item) { return acc | item.second.buttons; });
+    publish_buttons();
 }
 
 MirPointerButtons mi::SeatInputDeviceTracker::button_state() const
 {
-    std::lock_guard lock(device_state_mutex);
-    return buttons;
+    return published_buttons.load(std::memory_order_acquire);
 }
 
 void mi::SeatInputDeviceTracker::set_confinement_regions(geometry::Rectangles const& regions)
@@ -208,6 +229,7 @@ void mi::SeatInputDeviceTracker::set_confinement_regions(geometry::Rectangles co
     {
         std::lock_guard lg(region_mutex);
         confined_region = regions;
+        ++regions_version;
     }
     observer->seat_set_confinement_region_called(regions);
 }
@@ -217,21 +239,31 @@ void mi::SeatInputDeviceTracker::reset_confinement_regions()
     {
         std::lock_guard lg(region_mutex);
         confined_region.clear();
+        ++regions_version;
     }
     observer->seat_reset_confinement_regions();
 }
 
 void mi::SeatInputDeviceTracker::update_outputs(geom::Rectangles const& output_regions)
 {
-    std::lock_guard lg(output_mutex);
+    std::lock_guard lg(region_mutex);
     input_region = output_regions;
+    ++regions_version;
 }
 
-void mi::SeatInputDeviceTracker::confine_function(mir::geometry::Point& p) const
+void mi::SeatInputDeviceTracker::confine_function(mir::geometry::Point& p)
 {
-    std::lock_guard lg(region_mutex);
-    input_region.confine(p);
-    confined_region.confine(p);
+    // The regions rarely change, so motion only takes region_mutex to pick up a change
+    if (auto const version = regions_version.load(); version != dispatch_regions_version)
+    {
+        std::lock_guard lg(region_mutex);
+        dispatch_input_region = input_region;
+        dispatch_confined_region = confined_region;
+        dispatch_regions_version = regions_version;
+    }
+
+    dispatch_input_region.confine(p);
+    dispatch_confined_region.confine(p);
 }
 
 void mi::SeatInputDeviceTracker::confine_pointer()
@@ -257,18 +289,28 @@ void mi::SeatInputDeviceTracker::update_cursor(MirPointerEvent const* event)
     }
 
     confine_pointer();
+    publish_cursor();
 
     cursor_listener->cursor_moved_to(cursor_x, cursor_y);
 }
 
-mir::EventUPtr mi::SeatInputDeviceTracker::create_device_state() const
+void mi::SeatInputDeviceTracker::publish_cursor()
 {
-    std::lock_guard lock(device_state_mutex);
-    std::vector<mev::InputDeviceState> devices;
-    devices.reserve(device_data.size());
+    published_cursor.store(pack_cursor(cursor_x, cursor_y), std::memory_order_release);
+}
+
+void mi::SeatInputDeviceTracker::publish_buttons()
+{
+    published_buttons.store(buttons, std::memory_order_release);
+}
+
+auto mi::SeatInputDeviceTracker::device_states() const -> std::vector<mev::InputDeviceState>
+{
+    std::vector<mev::InputDeviceState> states;
+    states.reserve(device_data.size());
     for (auto const& item : device_data)
     {
-        devices.push_back({item.first, item.second.scan_codes, item.second.buttons});
+        states.push_back({item.first, item.second.scan_codes, item.second.buttons});
         auto lock_state = key_mapper->device_modifiers(item.first);
 
         bool caps_lock_active = (lock_state & mir_input_event_modifier_caps_lock);
@@ -291,29 +333,42 @@ mir::EventUPtr mi::SeatInputDeviceTracker::create_device_state() const
 
         if (caps_lock_active && !contains_caps_lock_pressed)
         {
-            devices.back().pressed_keys.push_back(KEY_CAPSLOCK);
-            devices.back().pressed_keys.push_back(KEY_CAPSLOCK);
+            states.back().pressed_keys.push_back(KEY_CAPSLOCK);
+            states.back().pressed_keys.push_back(KEY_CAPSLOCK);
         }
         if (num_lock_active && !contains_num_lock_pressed)
         {
-            devices.back().pressed_keys.push_back(KEY_NUMLOCK);
-            devices.back().pressed_keys.push_back(KEY_NUMLOCK);
+            states.back().pressed_keys.push_back(KEY_NUMLOCK);
+            states.back().pressed_keys.push_back(KEY_NUMLOCK);
         }
         if (scroll_lock_active && !contains_scroll_lock_pressed)
         {
-            devices.back().pressed_keys.push_back(KEY_SCROLLLOCK);
-            devices.back().pressed_keys.push_back(KEY_SCROLLLOCK);
+            states.back().pressed_keys.push_back(KEY_SCROLLLOCK);
+            states.back().pressed_keys.push_back(KEY_SCROLLLOCK);
         }
     }
-    auto out_ev = mev::make_input_configure_event(
+
+    return states;
+}
+
+mir::EventUPtr mi::SeatInputDeviceTracker::create_device_state() const
+{
+    auto const [x, y] = unpack_cursor(published_cursor.load(std::memory_order_acquire));
+
+    // Only queried when focus changes, so gathering the key state here keeps it off the per event path
+    std::vector<mev::InputDeviceState> devices;
+    {
+        std::lock_guard lock(device_state_mutex);
+        devices = device_states();
+    }
+
+    return mev::make_input_configure_event(
         clock->now().time_since_epoch(),
-        buttons,
+        button_state(),
         key_mapper->modifiers(),
-        cursor_x,
-        cursor_y,
+        x,
+        y,
         std::move(devices));
-
-    return out_ev;
 }
 
 auto mi::SeatInputDeviceTracker::xkb_modifiers() const -> MirXkbModifiers
@@ -352,8 +407,8 @@ void mi::SeatInputDeviceTracker::set_pointer_state(MirInputDeviceId id, MirPoint
         std::lock_guard lock(device_state_mutex);
         auto device = device_data.find(id);
 
-        if (device != end(device_data))
-            device->second.update_button_state(buttons);
+        if (device != end(device_data) && device->second.update_button_state(buttons))
+            update_states();
     }
 
     observer->seat_set_pointer_state(id, buttons);
@@ -365,6 +420,7 @@ void mi::SeatInputDeviceTracker::set_cursor_position(float x, float y)
         std::lock_guard lock(device_state_mutex);
         cursor_x = x;
         cursor_y = y;
+        publish_cursor();
     }
 
     observer->seat_set_cursor_position(x, y);
@@ -24,11 +24,14 @@
 #include "mir/optional_value.h"
 #include "mir_toolkit/event.h"
 #include "mir/events/xkb_modifiers.h"
+#include "mir/events/input_device_state.h"
 
 #include <atomic>
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace mir
 {
@@ -85,8 +88,12 @@ private:
     void update_spots();
     void update_states();
     bool filter_input_event(MirInputEvent const* event);
-    void confine_function(mir::geometry::Point& p) const;
+    void confine_function(mir::geometry::Point& p);
     void confine_pointer();
+    void publish_cursor();
+    void publish_buttons();
+    /// Requires device_state_mutex
+    auto device_states() const -> std::vector<events::InputDeviceState>;
 
     std::shared_ptr<InputDispatcher> const dispatcher;
     std::shared_ptr<TouchVisualizer> const touch_visualizer;
@@ -111,6 +118,11 @@ private:
         mir::optional_value<uint32_t> output_id;
     };
 
+    /*
+     * The state events update, guarded by device_state_mutex. Dispatch only does constant time bookkeeping under it,
+     * the per device key state is only gathered up when create_device_state() asks for it.
+     */
+
     // Libinput's acceleration curve means the cursor moves by non-integer
     // increments, and often less than 1.0, so float is required...
     float cursor_x = 0.0f, cursor_y = 0.0f;
@@ -119,13 +131,31 @@ private:
     MirPointerButtons buttons;
     std::unordered_map<MirInputDeviceId, DeviceData> device_data;
     std::vector<TouchVisualizer::Spot> spots;
-    mir::geometry::Rectangles confined_region;
+
+    /// The confinement in effect for dispatch, copied from the regions below when regions_version changes
+    geometry::Rectangles dispatch_input_region;
+    geometry::Rectangles dispatch_confined_region;
+    uint64_t dispatch_regions_version{0};
 
     std::mutex mutable device_state_mutex;
-    std::mutex mutable region_mutex;
 
-    std::mutex mutable output_mutex;
+    /*
+     * The state published for queries, so they never wait on dispatch. Modifiers are not copied here, the key mapper
+     * tracks them (including across keymap changes made directly on it) and is asked when they are queried.
+     */
+
+    /// Both cursor coordinates packed together, so they are read consistently without a lock
+    std::atomic<uint64_t> published_cursor{0};
+    /// Stored only when the buttons change
+    std::atomic<MirPointerButtons> published_buttons{0};
+
+    /*
+     * Confinement set by the shell and display configuration, which dispatch picks up without locking
+     */
+    std::mutex mutable region_mutex;
     geometry::Rectangles input_region;
+    mir::geometry::Rectangles confined_region;
+    std::atomic<uint64_t> regions_version{0};
 };
 
 }
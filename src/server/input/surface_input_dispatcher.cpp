@@ -125,7 +125,7 @@ void deliver_without_relative_motion(
     mev::transform_positions(*to_deliver, geom::Displacement{bounds.top_left.x.as_int(), bounds.top_left.y.as_int()});
     if (!drag_and_drop_handle.empty())
         mev::set_drag_and_drop_handle(*to_deliver, drag_and_drop_handle);
-    surface->consume(std::move(to_deliver));
+    surface->consume(mev::share_event(std::move(to_deliver)));
 }
 
 void deliver(
@@ -140,7 +140,7 @@ void deliver(
 
     auto const& bounds = surface->input_bounds();
     mev::transform_positions(*to_deliver, geom::Displacement{bounds.top_left.x.as_int(), bounds.top_left.y.as_int()});
-    surface->consume(std::move(to_deliver));
+    surface->consume(mev::share_event(std::move(to_deliver)));
 }
 
 }
@@ -58,6 +58,11 @@ public:
         return buffer_;
     }
     
+    geom::RectangleD src_bounds() const override
+    {
+        return {{0, 0}, geom::SizeD{buffer_->size()}};
+    }
+
     geom::Rectangle screen_position() const override
     {
         return {position, buffer_->size()};
@@ -83,6 +88,11 @@ public:
         return true;
     }
 
+    std::vector<geom::Rectangle> opaque_region() const override
+    {
+        return {};
+    }
+
 // TouchspotRenderable    
     void move_center_to(geom::Point pos)
     {
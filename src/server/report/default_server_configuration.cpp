@@ -86,6 +86,16 @@ auto mir::DefaultServerConfiguration::the_input_report() -> std::shared_ptr<mi::
         });
 }
 
+auto mir::DefaultServerConfiguration::the_input_latency_report() -> std::shared_ptr<mi::InputLatencyReport>
+{
+    // Latency is part of what --input-report covers, rather than needing an option of its own
+    return input_latency_report(
+        [this]()->std::shared_ptr<mi::InputLatencyReport>
+        {
+            return report_factory(options::input_report_opt)->create_input_latency_report();
+        });
+}
+
 auto mir::DefaultServerConfiguration::the_scene_report() -> std::shared_ptr<ms::SceneReport>
 {
     return scene_report(
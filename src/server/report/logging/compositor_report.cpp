@@ -17,6 +17,8 @@
 #include "compositor_report.h"
 #include "mir/logging/logger.h"
 
+#include <algorithm>
+
 using namespace mir::time;
 namespace ml = mir::logging;
 namespace mrl = mir::report::logging;
@@ -152,6 +154,10 @@ void mrl::CompositorReport::finished_frame(SubCompositorId id)
 
         for (auto& i : instance)
             i.second.log(*logger, i.first);
+
+        for (auto const& c : captures)
+            c.log(*logger);
+        captures.clear();
     }
 
     if (inst.bypassed != inst.prev_bypassed || inst.nframes == 1)
@@ -182,3 +188,43 @@ void mrl::CompositorReport::scheduled()
     std::lock_guard lock(mutex);
     last_scheduled = now();
 }
+
+void mrl::CompositorReport::captured_area(
+    mir::geometry::Rectangle const& area,
+    std::chrono::nanoseconds cost,
+    bool rendered)
+{
+    std::lock_guard lock(mutex);
+    auto c = std::find_if(captures.begin(), captures.end(), [&](auto const& c) { return c.area == area; });
+    if (c == captures.end())
+    {
+        captures.push_back({area});
+        c = captures.end() - 1;
+    }
+
+    c->ncaptures++;
+    if (rendered)
+        c->nrendered++;
+    c->cost_sum += cost;
+}
+
+void mrl::CompositorReport::Captures::log(ml::Logger& logger) const
+{
+    long long const avg_cost_usec =
+        std::chrono::duration_cast<std::chrono::microseconds>(cost_sum).count() / ncaptures;
+
+    char msg[128];
+    snprintf(msg, sizeof msg, "Capture of %dx%d%+d%+d: "
+             "%ld captures from %ld renders, "
+             "%lld.%03lld ms/capture",
+             area.size.width.as_int(),
+             area.size.height.as_int(),
+             area.top_left.x.as_int(),
+             area.top_left.y.as_int(),
+             ncaptures,
+             nrendered,
+             avg_cost_usec / 1000,
+             avg_cost_usec % 1000);
+
+    logger.log(ml::Severity::informational, msg, component);
+}
@@ -22,6 +22,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 #include <chrono>
 
 namespace mir
@@ -48,6 +49,7 @@ public:
     void started() override;
     void stopped() override;
     void scheduled() override;
+    void captured_area(geometry::Rectangle const& area, std::chrono::nanoseconds cost, bool rendered) override;
 
 private:
     std::shared_ptr<mir::logging::Logger> const logger;
@@ -77,8 +79,20 @@ private:
         void log(mir::logging::Logger& logger, SubCompositorId id);
     };
 
+    /// Screen captures of one area since it was last reported
+    struct Captures
+    {
+        geometry::Rectangle area;
+        long ncaptures = 0;
+        long nrendered = 0;
+        std::chrono::nanoseconds cost_sum{0};
+
+        void log(mir::logging::Logger& logger) const;
+    };
+
     std::mutex mutex; // Protects the following...
     std::unordered_map<SubCompositorId, Instance> instance;
+    std::vector<Captures> captures;
     TimePoint last_scheduled;
     TimePoint last_report;
 };
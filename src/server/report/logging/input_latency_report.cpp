@@ -0,0 +1,145 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_latency_report.h"
+
+#include "mir/logging/logger.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace mrl = mir::report::logging;
+namespace ml = mir::logging;
+
+namespace
+{
+char const* const component = "input-latency";
+auto const min_report_interval = std::chrono::seconds(1);
+
+auto bucket_for(std::chrono::nanoseconds latency, int bucket_count) -> int
+{
+    auto const us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    int bucket = 0;
+    while (bucket < bucket_count - 1 && (2L << bucket) <= us)
+        ++bucket;
+    return bucket;
+}
+
+/// Formats a duration as milliseconds with three decimals (without floating point, like the compositor report)
+struct Milliseconds
+{
+    explicit Milliseconds(std::chrono::nanoseconds duration)
+    {
+        auto const us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        snprintf(text, sizeof text, "%ld.%03ld", static_cast<long>(us / 1000), static_cast<long>(us % 1000));
+    }
+
+    char text[32];
+};
+}
+
+void mrl::InputLatencyReport::Histogram::add(std::chrono::nanoseconds latency)
+{
+    // Events stamped on another clock (or from the future) still count, just not towards the latency
+    latency = std::max(latency, std::chrono::nanoseconds{0});
+
+    ++buckets[bucket_for(latency, bucket_count)];
+    ++count;
+    sum += latency;
+    max = std::max(max, latency);
+}
+
+auto mrl::InputLatencyReport::Histogram::percentile(double fraction) const -> std::chrono::nanoseconds
+{
+    long const wanted = static_cast<long>(fraction * count + 0.5);
+    long seen = 0;
+    for (int bucket = 0; bucket != bucket_count - 1; ++bucket)
+    {
+        seen += buckets[bucket];
+        if (seen >= wanted)
+            return std::min<std::chrono::nanoseconds>(std::chrono::microseconds{2L << bucket}, max);
+    }
+    return max;
+}
+
+void mrl::InputLatencyReport::Histogram::log(ml::Logger& logger, char const* stage) const
+{
+    char msg[192];
+    snprintf(msg, sizeof msg, "Latency to %s: %ld events, mean %s ms, 50%% under %s ms, 99%% under %s ms, max %s ms",
+             stage,
+             count,
+             Milliseconds{sum / count}.text,
+             Milliseconds{percentile(0.5)}.text,
+             Milliseconds{percentile(0.99)}.text,
+             Milliseconds{max}.text);
+    logger.log(ml::Severity::informational, msg, component);
+}
+
+mrl::InputLatencyReport::InputLatencyReport(
+    std::shared_ptr<ml::Logger> const& logger,
+    std::shared_ptr<time::Clock> const& clock)
+    : logger{logger},
+      clock{clock},
+      last_report{clock->now()}
+{
+}
+
+void mrl::InputLatencyReport::received_event(std::chrono::nanoseconds event_time)
+{
+    record(received, clock->now().time_since_epoch() - event_time);
+}
+
+void mrl::InputLatencyReport::dispatched_event(std::chrono::nanoseconds event_time)
+{
+    record(dispatched, clock->now().time_since_epoch() - event_time);
+}
+
+void mrl::InputLatencyReport::sent_event(std::chrono::nanoseconds event_time)
+{
+    record(sent, clock->now().time_since_epoch() - event_time);
+}
+
+void mrl::InputLatencyReport::committed_after_event(std::chrono::nanoseconds event_time)
+{
+    record(committed, clock->now().time_since_epoch() - event_time);
+}
+
+void mrl::InputLatencyReport::presented_after_event(
+    std::chrono::nanoseconds event_time,
+    std::chrono::nanoseconds presentation_time)
+{
+    record(presented, presentation_time - event_time);
+}
+
+void mrl::InputLatencyReport::record(Stage stage, std::chrono::nanoseconds latency)
+{
+    static char const* const stage_names[stage_count]{"seat", "dispatch", "client", "commit", "screen"};
+
+    std::lock_guard lock{mutex};
+    histograms[stage].add(latency);
+
+    auto const now = clock->now();
+    if (now - last_report < min_report_interval)
+        return;
+
+    last_report = now;
+    for (int i = 0; i != stage_count; ++i)
+    {
+        if (histograms[i].count)
+            histograms[i].log(*logger, stage_names[i]);
+        histograms[i] = Histogram{};
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_LOGGING_INPUT_LATENCY_REPORT_H_
+#define MIR_REPORT_LOGGING_INPUT_LATENCY_REPORT_H_
+
+#include "mir/input/input_latency_report.h"
+#include "mir/time/clock.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+
+namespace mir
+{
+namespace logging
+{
+class Logger;
+}
+namespace report
+{
+namespace logging
+{
+
+/// Collects a histogram of the latency of each stage, and logs a summary of them about once a second
+class InputLatencyReport : public input::InputLatencyReport
+{
+public:
+    InputLatencyReport(
+        std::shared_ptr<mir::logging::Logger> const& logger,
+        std::shared_ptr<time::Clock> const& clock);
+
+    void received_event(std::chrono::nanoseconds event_time) override;
+    void dispatched_event(std::chrono::nanoseconds event_time) override;
+    void sent_event(std::chrono::nanoseconds event_time) override;
+    void committed_after_event(std::chrono::nanoseconds event_time) override;
+    void presented_after_event(
+        std::chrono::nanoseconds event_time,
+        std::chrono::nanoseconds presentation_time) override;
+
+private:
+    enum Stage
+    {
+        received,
+        dispatched,
+        sent,
+        committed,
+        presented,
+        stage_count
+    };
+
+    /// Latencies since the stage was last logged, in power-of-two buckets from 1µs
+    struct Histogram
+    {
+        static int constexpr bucket_count{20};
+        std::array<long, bucket_count> buckets{};
+        long count{0};
+        std::chrono::nanoseconds sum{0};
+        std::chrono::nanoseconds max{0};
+
+        void add(std::chrono::nanoseconds latency);
+        /// The upper bound of the bucket holding the given fraction of the samples
+        auto percentile(double fraction) const -> std::chrono::nanoseconds;
+        void log(mir::logging::Logger& logger, char const* stage) const;
+    };
+
+    void record(Stage stage, std::chrono::nanoseconds latency);
+
+    std::shared_ptr<mir::logging::Logger> const logger;
+    std::shared_ptr<time::Clock> const clock;
+
+    std::mutex mutex; // Protects the following...
+    std::array<Histogram, stage_count> histograms;
+    time::Timestamp last_report;
+};
+
+}
+}
+}
+
+#endif /* MIR_REPORT_LOGGING_INPUT_LATENCY_REPORT_H_ */
@@ -169,3 +169,24 @@ void mrl::InputReport::failed_to_open_input_device(char const* device_name, char
 
     logger->log(ml::Severity::informational, ss.str(), component());
 }
+
+void mrl::InputReport::device_statistics(char const* device_name, mir::input::InputDeviceStatistics const& statistics)
+{
+    auto const microseconds = [](std::chrono::nanoseconds duration)
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        };
+
+    std::stringstream ss;
+
+    ss << "Input device statistics"
+       << " name=" << device_name
+       << " events_per_second=" << statistics.events_per_second
+       << " events=" << statistics.events
+       << " dropped=" << statistics.dropped_events
+       << " handle_input_us=" << microseconds(statistics.handle_input_time)
+       << " event_filter_us=" << microseconds(statistics.event_filter_time)
+       << " seat_us=" << microseconds(statistics.seat_time);
+
+    logger->log(ml::Severity::informational, ss.str(), component());
+}
@@ -45,6 +45,7 @@ public:
 
     void opened_input_device(char const* device_name, char const* input_platform) override;
     void failed_to_open_input_device(char const* device_name, char const* input_platform) override;
+    void device_statistics(char const* device_name, input::InputDeviceStatistics const& statistics) override;
 private:
     char const* component();
     std::shared_ptr<mir::logging::Logger> const logger;
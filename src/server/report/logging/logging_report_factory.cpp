@@ -21,6 +21,7 @@
 #include "scene_report.h"
 #include "shell_report.h"
 #include "input_report.h"
+#include "input_latency_report.h"
 #include "seat_report.h"
 #include "mir/logging/shared_library_prober_report.h"
 
@@ -53,6 +54,11 @@ std::shared_ptr<mir::input::InputReport> mr::LoggingReportFactory::create_input_
     return std::make_shared<logging::InputReport>(logger);
 }
 
+std::shared_ptr<mir::input::InputLatencyReport> mr::LoggingReportFactory::create_input_latency_report()
+{
+    return std::make_shared<logging::InputLatencyReport>(logger, clock);
+}
+
 std::shared_ptr<mir::input::SeatObserver> mr::LoggingReportFactory::create_seat_report()
 {
     return std::make_shared<logging::SeatReport>(logger);
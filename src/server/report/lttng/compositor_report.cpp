@@ -60,3 +60,19 @@ void mir::report::lttng::CompositorReport::finished_frame(SubCompositorId id)
 {
     mir_tracepoint(mir_server_compositor, finished_frame, id);
 }
+
+void mir::report::lttng::CompositorReport::captured_area(
+    geometry::Rectangle const& area,
+    std::chrono::nanoseconds cost,
+    bool rendered)
+{
+    mir_tracepoint(
+        mir_server_compositor,
+        captured_area,
+        area.top_left.x.as_int(),
+        area.top_left.y.as_int(),
+        area.size.width.as_int(),
+        area.size.height.as_int(),
+        cost.count(),
+        rendered);
+}
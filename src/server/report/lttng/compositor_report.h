@@ -41,6 +41,7 @@ public:
     void started() override;
     void stopped() override;
     void scheduled() override;
+    void captured_area(geometry::Rectangle const& area, std::chrono::nanoseconds cost, bool rendered) override;
 private:
     ServerTracepointProvider tp_provider;
 };
@@ -88,6 +88,20 @@ TRACEPOINT_EVENT(
     )
 )
 
+TRACEPOINT_EVENT(
+    mir_server_compositor,
+    captured_area,
+    TP_ARGS(int, x, int, y, int, width, int, height, int64_t, cost_ns, int, rendered),
+    TP_FIELDS(
+        ctf_integer(int, x, x)
+        ctf_integer(int, y, y)
+        ctf_integer(int, width, width)
+        ctf_integer(int, height, height)
+        ctf_integer(int64_t, cost_ns, cost_ns)
+        ctf_integer(int, rendered, rendered)
+    )
+)
+
 #endif /* MIR_LTTNG_COMPOSITOR_REPORT_TP_H_ */
 
 #include <lttng/tracepoint-event.h>
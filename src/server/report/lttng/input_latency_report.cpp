@@ -0,0 +1,63 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/report/lttng/mir_tracepoint.h"
+
+#include "input_latency_report.h"
+
+#define TRACEPOINT_DEFINE
+#define TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#include "input_latency_report_tp.h"
+
+namespace
+{
+auto latency_now(std::chrono::nanoseconds event_time) -> int64_t
+{
+    // Input platforms stamp events on CLOCK_MONOTONIC, which is what steady_clock reads
+    return (std::chrono::steady_clock::now().time_since_epoch() - event_time).count();
+}
+}
+
+void mir::report::lttng::InputLatencyReport::received_event(std::chrono::nanoseconds event_time)
+{
+    mir_tracepoint(mir_server_input_latency, received_event, event_time.count(), latency_now(event_time));
+}
+
+void mir::report::lttng::InputLatencyReport::dispatched_event(std::chrono::nanoseconds event_time)
+{
+    mir_tracepoint(mir_server_input_latency, dispatched_event, event_time.count(), latency_now(event_time));
+}
+
+void mir::report::lttng::InputLatencyReport::sent_event(std::chrono::nanoseconds event_time)
+{
+    mir_tracepoint(mir_server_input_latency, sent_event, event_time.count(), latency_now(event_time));
+}
+
+void mir::report::lttng::InputLatencyReport::committed_after_event(std::chrono::nanoseconds event_time)
+{
+    mir_tracepoint(mir_server_input_latency, committed_after_event, event_time.count(), latency_now(event_time));
+}
+
+void mir::report::lttng::InputLatencyReport::presented_after_event(
+    std::chrono::nanoseconds event_time,
+    std::chrono::nanoseconds presentation_time)
+{
+    mir_tracepoint(
+        mir_server_input_latency,
+        presented_after_event,
+        event_time.count(),
+        (presentation_time - event_time).count());
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER mir_server_input_latency
+
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "./input_latency_report_tp.h"
+
+#if !defined(MIR_LTTNG_INPUT_LATENCY_REPORT_TP_H_) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define MIR_LTTNG_INPUT_LATENCY_REPORT_TP_H_
+
+#include "lttng_utils.h"
+
+TRACEPOINT_EVENT_CLASS(
+    mir_server_input_latency,
+    stage_reached,
+    TP_ARGS(int64_t, event_time, int64_t, latency_ns),
+    TP_FIELDS(
+        ctf_integer(int64_t, event_time, event_time)
+        ctf_integer(int64_t, latency_ns, latency_ns)
+    )
+)
+
+#define INPUT_LATENCY_TRACE_POINT(name)\
+    TRACEPOINT_EVENT_INSTANCE(\
+        mir_server_input_latency,\
+        stage_reached,\
+        name,\
+        TP_ARGS(int64_t, event_time, int64_t, latency_ns))
+
+INPUT_LATENCY_TRACE_POINT(received_event)
+INPUT_LATENCY_TRACE_POINT(dispatched_event)
+INPUT_LATENCY_TRACE_POINT(sent_event)
+INPUT_LATENCY_TRACE_POINT(committed_after_event)
+INPUT_LATENCY_TRACE_POINT(presented_after_event)
+
+#undef INPUT_LATENCY_TRACE_POINT
+
+#endif /* MIR_LTTNG_INPUT_LATENCY_REPORT_TP_H_ */
+
+#include <lttng/tracepoint-event.h>
@@ -46,3 +46,13 @@ void mir::report::lttng::InputReport::failed_to_open_input_device(char const* na
 {
     mir_tracepoint(mir_server_input, failed_to_open_input_device, name, platform);
 }
+
+void mir::report::lttng::InputReport::device_statistics(
+    char const* name,
+    mir::input::InputDeviceStatistics const& statistics)
+{
+    mir_tracepoint(
+        mir_server_input, device_statistics, name,
+        statistics.events, statistics.dropped_events, statistics.events_per_second,
+        statistics.handle_input_time.count(), statistics.event_filter_time.count(), statistics.seat_time.count());
+}
@@ -41,6 +41,7 @@ public:
 
     void opened_input_device(char const* device_name, char const* input_platform) override;
     void failed_to_open_input_device(char const* device_name, char const* input_platform) override;
+    void device_statistics(char const* device_name, input::InputDeviceStatistics const& statistics) override;
 private:
     ServerTracepointProvider tp_provider;
 };
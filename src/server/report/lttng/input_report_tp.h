@@ -86,6 +86,24 @@ TRACEPOINT_EVENT_INSTANCE(
     TP_ARGS(const char*, device, const char*, platform)
 )
 
+TRACEPOINT_EVENT(
+    mir_server_input,
+    device_statistics,
+    TP_ARGS(
+        const char*, device,
+        uint64_t, events, uint64_t, dropped_events, uint64_t, events_per_second,
+        int64_t, handle_input_ns, int64_t, event_filter_ns, int64_t, seat_ns),
+    TP_FIELDS(
+        ctf_string(device, device)
+        ctf_integer(uint64_t, events, events)
+        ctf_integer(uint64_t, dropped_events, dropped_events)
+        ctf_integer(uint64_t, events_per_second, events_per_second)
+        ctf_integer(int64_t, handle_input_ns, handle_input_ns)
+        ctf_integer(int64_t, event_filter_ns, event_filter_ns)
+        ctf_integer(int64_t, seat_ns, seat_ns)
+    )
+)
+
 #endif /* MIR_LTTNG_DISPLAY_REPORT_TP_H_ */
 
 #include <lttng/tracepoint-event.h>
@@ -19,6 +19,7 @@
 #include "compositor_report.h"
 #include "display_report.h"
 #include "input_report.h"
+#include "input_latency_report.h"
 #include "scene_report.h"
 #include "shared_library_prober_report.h"
 #include <boost/throw_exception.hpp>
@@ -43,6 +44,11 @@ std::shared_ptr<mir::input::InputReport> mir::report::LttngReportFactory::create
     return std::make_shared<lttng::InputReport>();
 }
 
+std::shared_ptr<mir::input::InputLatencyReport> mir::report::LttngReportFactory::create_input_latency_report()
+{
+    return std::make_shared<lttng::InputLatencyReport>();
+}
+
 std::shared_ptr<mir::input::SeatObserver> mir::report::LttngReportFactory::create_seat_report()
 {
     BOOST_THROW_EXCEPTION(std::logic_error("Not implemented"));
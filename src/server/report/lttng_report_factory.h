@@ -31,6 +31,7 @@ public:
     std::shared_ptr<scene::SceneReport> create_scene_report() override;
 
     std::shared_ptr<input::InputReport> create_input_report() override;
+    std::shared_ptr<input::InputLatencyReport> create_input_latency_report() override;
     std::shared_ptr<input::SeatObserver> create_seat_report() override;
     std::shared_ptr<SharedLibraryProberReport> create_shared_library_prober_report() override;
     std::shared_ptr<shell::ShellReport> create_shell_report() override;
@@ -49,3 +49,7 @@ void mrn::CompositorReport::stopped()
 void mrn::CompositorReport::scheduled()
 {
 }
+
+void mrn::CompositorReport::captured_area(mir::geometry::Rectangle const&, std::chrono::nanoseconds, bool)
+{
+}
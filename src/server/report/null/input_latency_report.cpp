@@ -0,0 +1,41 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_latency_report.h"
+
+namespace mrn = mir::report::null;
+
+void mrn::InputLatencyReport::received_event(std::chrono::nanoseconds /* event_time */)
+{
+}
+
+void mrn::InputLatencyReport::dispatched_event(std::chrono::nanoseconds /* event_time */)
+{
+}
+
+void mrn::InputLatencyReport::sent_event(std::chrono::nanoseconds /* event_time */)
+{
+}
+
+void mrn::InputLatencyReport::committed_after_event(std::chrono::nanoseconds /* event_time */)
+{
+}
+
+void mrn::InputLatencyReport::presented_after_event(
+    std::chrono::nanoseconds /* event_time */,
+    std::chrono::nanoseconds /* presentation_time */)
+{
+}
@@ -37,3 +37,12 @@ void mrn::InputReport::opened_input_device(char const* /* name */, char const* /
 void mrn::InputReport::failed_to_open_input_device(char const* /* name */, char const* /* platform */)
 {
 }
+
+void mrn::InputReport::device_statistics(char const* /* name */, mir::input::InputDeviceStatistics const& /* statistics */)
+{
+}
+
+auto mrn::InputReport::wants_device_statistics() const -> bool
+{
+    return false;
+}
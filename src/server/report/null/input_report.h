@@ -40,6 +40,8 @@ public:
 
     void opened_input_device(char const* device_name, char const* input_platform) override;
     void failed_to_open_input_device(char const* device_name, char const* input_platform) override;
+    void device_statistics(char const* device_name, input::InputDeviceStatistics const& statistics) override;
+    auto wants_device_statistics() const -> bool override;
 };
 
 }
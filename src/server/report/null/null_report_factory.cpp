@@ -19,6 +19,7 @@
 #include "compositor_report.h"
 #include "display_report.h"
 #include "input_report.h"
+#include "input_latency_report.h"
 #include "seat_report.h"
 #include "shell_report.h"
 #include "scene_report.h"
@@ -44,6 +45,11 @@ std::shared_ptr<mir::input::InputReport> mir::report::NullReportFactory::create_
     return std::make_shared<null::InputReport>();
 }
 
+std::shared_ptr<mir::input::InputLatencyReport> mir::report::NullReportFactory::create_input_latency_report()
+{
+    return std::make_shared<null::InputLatencyReport>();
+}
+
 std::shared_ptr<mir::input::SeatObserver> mir::report::NullReportFactory::create_seat_report()
 {
     return std::make_shared<null::SeatReport>();
@@ -82,6 +88,11 @@ std::shared_ptr<mir::input::InputReport> mir::report::null_input_report()
     return NullReportFactory{}.create_input_report();
 }
 
+std::shared_ptr<mir::input::InputLatencyReport> mir::report::null_input_latency_report()
+{
+    return NullReportFactory{}.create_input_latency_report();
+}
+
 std::shared_ptr<mir::input::SeatObserver> mir::report::null_seat_report()
 {
     return NullReportFactory{}.create_seat_report();
@@ -30,6 +30,7 @@ public:
     std::shared_ptr<graphics::DisplayReport> create_display_report() override;
     std::shared_ptr<scene::SceneReport> create_scene_report() override;
     std::shared_ptr<input::InputReport> create_input_report() override;
+    std::shared_ptr<input::InputLatencyReport> create_input_latency_report() override;
     std::shared_ptr<input::SeatObserver> create_seat_report() override;
     std::shared_ptr<mir::SharedLibraryProberReport> create_shared_library_prober_report() override;
     std::shared_ptr<shell::ShellReport> create_shell_report() override;
@@ -39,6 +40,7 @@ std::shared_ptr<compositor::CompositorReport> null_compositor_report();
 std::shared_ptr<graphics::DisplayReport> null_display_report();
 std::shared_ptr<scene::SceneReport> null_scene_report();
 std::shared_ptr<input::InputReport> null_input_report();
+std::shared_ptr<input::InputLatencyReport> null_input_latency_report();
 std::shared_ptr<input::SeatObserver> null_seat_report();
 std::shared_ptr<mir::SharedLibraryProberReport> null_shared_library_prober_report();
 
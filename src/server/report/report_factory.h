@@ -33,6 +33,7 @@ class DisplayReport;
 namespace input
 {
 class InputReport;
+class InputLatencyReport;
 class SeatObserver;
 }
 namespace scene
@@ -52,6 +53,7 @@ public:
     virtual std::shared_ptr<scene::SceneReport> create_scene_report() = 0;
 
     virtual std::shared_ptr<input::InputReport> create_input_report() = 0;
+    virtual std::shared_ptr<input::InputLatencyReport> create_input_latency_report() = 0;
     virtual std::shared_ptr<input::SeatObserver> create_seat_report() = 0;
     virtual std::shared_ptr<SharedLibraryProberReport> create_shared_library_prober_report() = 0;
     virtual std::shared_ptr<shell::ShellReport> create_shell_report() = 0;
@@ -144,6 +144,11 @@ public:
     {
         for_each_observer(&SurfaceObserver::application_id_set_to, surf, application_id);
     }
+
+    void input_region_set_to(Surface const* surf, std::vector<geom::Rectangle> const& region) override
+    {
+        for_each_observer(&SurfaceObserver::input_region_set_to, surf, region);
+    }
 };
 
 namespace
@@ -158,6 +163,16 @@ std::shared_ptr<mc::BufferStream> default_stream(std::list<ms::StreamInfo> const
         return layers.front().stream;
 }
 
+/// Whether the frame posted callback set up for one layer is right for the other
+auto same_placement(ms::StreamInfo const& a, ms::StreamInfo const& b) -> bool
+{
+    return a.stream == b.stream && a.displacement == b.displacement && a.size == b.size;
+}
+
+auto same_layer(ms::StreamInfo const& a, ms::StreamInfo const& b) -> bool
+{
+    return same_placement(a, b) && a.opaque_region == b.opaque_region && a.src_bounds == b.src_bounds;
+}
 }
 
 ms::BasicSurface::BasicSurface(
@@ -280,7 +295,21 @@ std::shared_ptr<mf::BufferStream> ms::BasicSurface::primary_buffer_stream() cons
 
 void ms::BasicSurface::set_input_region(std::vector<geom::Rectangle> const& input_rectangles)
 {
-    synchronised_state.lock()->custom_input_rectangles = input_rectangles;
+    auto state = synchronised_state.lock();
+    if (state->custom_input_rectangles != input_rectangles)
+    {
+        state->custom_input_rectangles = input_rectangles;
+        state->custom_input_region = geom::Region{input_rectangles};
+
+        state.drop();
+
+        observers->input_region_set_to(this, input_rectangles);
+    }
+}
+
+auto ms::BasicSurface::input_region() const -> std::vector<geom::Rectangle>
+{
+    return synchronised_state.lock()->custom_input_rectangles;
 }
 
 void ms::BasicSurface::resize(geom::Size const& desired_size)
@@ -336,13 +365,8 @@ bool ms::BasicSurface::input_area_contains(geom::Point const& point) const
     else
     {
         auto local_point = as_point(point - content_top_left(*state));
-        for (auto const& rectangle : state->custom_input_rectangles)
-        {
-            if (rectangle.contains(local_point))
-                return true;
-        }
+        return state->custom_input_region.contains(local_point);
     }
-    return false;
 }
 
 void ms::BasicSurface::set_alpha(float alpha)
@@ -679,16 +703,20 @@ public:
     SurfaceSnapshot(
         std::shared_ptr<mc::BufferStream> const& stream,
         void const* compositor_id,
+        mir::optional_value<geom::RectangleD> const& src_bounds,
         geom::Rectangle const& position,
         std::optional<geom::Rectangle> const& clip_area,
+        std::vector<geom::Rectangle> opaque_region,
         glm::mat4 const& transform,
         float alpha,
         mg::Renderable::ID id)
     : underlying_buffer_stream{stream},
       compositor_id{compositor_id},
       alpha_{alpha},
+      src_bounds_(src_bounds),
       screen_position_(position),
       clip_area_(clip_area),
+      opaque_region_(std::move(opaque_region)),
       transformation_(transform),
       id_(id)
     {
@@ -705,6 +733,13 @@ public:
         return compositor_buffer;
     }
 
+    geom::RectangleD src_bounds() const override
+    {
+        if (src_bounds_.is_set())
+            return src_bounds_.value();
+        return {{0, 0}, geom::SizeD{buffer()->size()}};
+    }
+
     geom::Rectangle screen_position() const override
     { return screen_position_; }
 
@@ -720,6 +755,9 @@ public:
     bool shaped() const override
     { return mg::contains_alpha(underlying_buffer_stream->pixel_format()); }
 
+    std::vector<geom::Rectangle> opaque_region() const override
+    { return shaped() ? opaque_region_ : std::vector<geom::Rectangle>{}; }
+
     mg::Renderable::ID id() const override
     { return id_; }
 private:
@@ -727,8 +765,10 @@ private:
     std::shared_ptr<mg::Buffer> mutable compositor_buffer;
     void const*const compositor_id;
     float const alpha_;
+    mir::optional_value<geom::RectangleD> const src_bounds_;
     geom::Rectangle const screen_position_;
     std::optional<geom::Rectangle> const clip_area_;
+    std::vector<geom::Rectangle> const opaque_region_;
     glm::mat4 const transformation_;
     mg::Renderable::ID const id_;
 };
@@ -766,9 +806,27 @@ void ms::BasicSurface::set_streams(std::list<scene::StreamInfo> const& s)
     geom::Point surface_top_left;
     {
         auto state = synchronised_state.lock();
-        clear_frame_posted_callbacks(*state);
-        state->layers = s;
-        update_frame_posted_callbacks(*state);
+        auto& layers = state->layers;
+
+        // Clients with subsurfaces resend their whole stream list on every change to any of them
+        if (std::equal(begin(layers), end(layers), begin(s), end(s), same_layer))
+            return;
+
+        for (auto const& layer : layers)
+        {
+            auto const kept = [&](StreamInfo const& info) { return info.stream == layer.stream; };
+            if (std::none_of(begin(s), end(s), kept))
+                layer.stream->set_frame_posted_callback([](auto){});
+        }
+        for (auto const& layer : s)
+        {
+            auto const unchanged = [&](StreamInfo const& info) { return same_placement(info, layer); };
+            if (std::none_of(begin(layers), end(layers), unchanged))
+                update_frame_posted_callback(*state, layer);
+        }
+
+        // Copy assignment reuses the existing list nodes
+        layers = s;
         surface_top_left = state->surface_rect.top_left;
     }
     observers->moved_to(this, surface_top_left);
@@ -797,16 +855,56 @@ mg::RenderableList ms::BasicSurface::generate_renderables(mc::CompositorID id) c
             else
                 size = info.stream->stream_size();
 
+            geom::Rectangle const position{content_top_left_ + info.displacement, size};
+
+            std::vector<geom::Rectangle> opaque_region;
+            opaque_region.reserve(info.opaque_region.size());
+            for (auto const& rect : info.opaque_region)
+            {
+                auto const on_screen = intersection_of(
+                    geom::Rectangle{position.top_left + as_displacement(rect.top_left), rect.size},
+                    position);
+                if (on_screen != geom::Rectangle{})
+                    opaque_region.push_back(on_screen);
+            }
+
             list.emplace_back(std::make_shared<SurfaceSnapshot>(
                 info.stream, id,
-                geom::Rectangle{content_top_left_ + info.displacement, std::move(size)},
+                info.src_bounds,
+                position,
                 state->clip_area,
+                std::move(opaque_region),
                 state->transformation_matrix, state->surface_alpha, info.stream.get()));
         }
     }
     return list;
 }
 
+void ms::BasicSurface::buffer_presented(
+    mg::Renderable::ID stream,
+    mg::BufferID buffer,
+    geom::Rectangle const& output_area,
+    mg::Frame const& frame,
+    bool zero_copy)
+{
+    std::shared_ptr<mc::BufferStream> presented_stream;
+    {
+        auto const state = synchronised_state.lock();
+        for (auto const& info : state->layers)
+        {
+            if (info.stream.get() == stream)
+            {
+                presented_stream = info.stream;
+                break;
+            }
+        }
+    }
+
+    // The stream may have been removed from the surface since it was rendered
+    if (presented_stream)
+        presented_stream->frame_presented(buffer, output_area, frame, zero_copy);
+}
+
 void ms::BasicSurface::set_confine_pointer_state(MirPointerConfinementState state)
 {
     synchronised_state.lock()->confine_pointer_state = state;
@@ -946,22 +1044,27 @@ void mir::scene::BasicSurface::clear_frame_posted_callbacks(State& state)
 
 void mir::scene::BasicSurface::update_frame_posted_callbacks(State& state)
 {
-    for (auto& layer : state.layers)
+    for (auto const& layer : state.layers)
     {
-        auto const position = geom::Point{} + state.margins.left + state.margins.top + layer.displacement;
-        layer.stream->set_frame_posted_callback(
-            [this, observers=std::weak_ptr{observers}, position, explicit_size=layer.size, stream=layer.stream.get()]
-                (auto const&)
-            {
-                auto const logical_size = explicit_size ? explicit_size.value() : stream->stream_size();
-                if (auto const o = observers.lock())
-                {
-                    o->frame_posted(this, 1, geom::Rectangle{position, logical_size});
-                }
-            });
+        update_frame_posted_callback(state, layer);
     }
 }
 
+void mir::scene::BasicSurface::update_frame_posted_callback(State const& state, StreamInfo const& layer)
+{
+    auto const position = geom::Point{} + state.margins.left + state.margins.top + layer.displacement;
+    layer.stream->set_frame_posted_callback(
+        [this, observers=std::weak_ptr{observers}, position, explicit_size=layer.size, stream=layer.stream.get()]
+            (auto const&)
+        {
+            auto const logical_size = explicit_size ? explicit_size.value() : stream->stream_size();
+            if (auto const o = observers.lock())
+            {
+                o->frame_posted(this, 1, geom::Rectangle{position, logical_size});
+            }
+        });
+}
+
 auto mir::scene::BasicSurface::content_size(State const& state) const -> geometry::Size
 {
     return geom::Size{
@@ -21,6 +21,7 @@
 #include "mir/proof_of_mutex_lock.h"
 #include "mir/wayland/weak.h"
 #include "mir/geometry/rectangle.h"
+#include "mir/geometry/region.h"
 #include "mir_toolkit/common.h"
 #include "mir/synchronised.h"
 
@@ -98,6 +99,7 @@ public:
     void set_reception_mode(input::InputReceptionMode mode) override;
 
     void set_input_region(std::vector<geometry::Rectangle> const& input_rectangles) override;
+    auto input_region() const -> std::vector<geometry::Rectangle> override;
 
     void resize(geometry::Size const& size) override;
     geometry::Point top_left() const override;
@@ -111,6 +113,12 @@ public:
     bool visible() const override;
 
     graphics::RenderableList generate_renderables(compositor::CompositorID id) const override;
+    void buffer_presented(
+        graphics::Renderable::ID stream,
+        graphics::BufferID buffer,
+        geometry::Rectangle const& output_area,
+        graphics::Frame const& frame,
+        bool zero_copy) override;
     int buffers_ready_for_compositor(void const* compositor_id) const override;
 
     MirWindowType type() const override;
@@ -179,6 +187,7 @@ private:
     MirOrientationMode set_preferred_orientation(MirOrientationMode mode);
     void clear_frame_posted_callbacks(State& state);
     void update_frame_posted_callbacks(State& state);
+    void update_frame_posted_callback(State const& state, StreamInfo const& layer);
     auto content_size(State const& state) const -> geometry::Size;
     auto content_top_left(State const& state) const -> geometry::Point;
 
@@ -191,6 +200,8 @@ private:
         bool hidden;
         input::InputReceptionMode input_mode;
         std::vector<geometry::Rectangle> custom_input_rectangles{};
+        /// The same area as custom_input_rectangles, for hit testing
+        geometry::Region custom_input_region{};
         std::shared_ptr<graphics::CursorImage> cursor_image;
 
         std::list<StreamInfo> layers;
@@ -38,3 +38,4 @@ void ms::NullSurfaceObserver::input_consumed(Surface const*, std::shared_ptr<Mir
 void ms::NullSurfaceObserver::start_drag_and_drop(Surface const*, std::vector<uint8_t> const&) {}
 void ms::NullSurfaceObserver::depth_layer_set_to(Surface const*, MirDepthLayer) {}
 void ms::NullSurfaceObserver::application_id_set_to(Surface const*, std::string const&) {}
+void ms::NullSurfaceObserver::input_region_set_to(Surface const*, std::vector<geometry::Rectangle> const&) {}
@@ -58,6 +58,11 @@ void ms::SurfaceChangeNotification::frame_posted(
     geometry::Rectangle const& damage)
 {
     std::unique_lock lock{mutex};
+    if (occluded)
+    {
+        // If the frame would be seen the occlusion has changed, and whatever changed it triggers compositing
+        return;
+    }
     geom::Rectangle global_damage{top_left + as_displacement(damage.top_left), damage.size};
     lock.unlock();
     notify_buffer_change(frames_available, global_damage);
@@ -82,3 +87,12 @@ void ms::SurfaceChangeNotification::renamed(Surface const*, std::string const&)
 {
     notify_scene_change();
 }
+
+void ms::SurfaceChangeNotification::attrib_changed(Surface const*, MirWindowAttrib attrib, int value)
+{
+    if (attrib == mir_window_attrib_visibility)
+    {
+        std::lock_guard lock{mutex};
+        occluded = value == mir_window_visibility_occluded;
+    }
+}
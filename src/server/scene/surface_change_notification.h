@@ -42,6 +42,7 @@ public:
     void transformation_set_to(Surface const* surf, glm::mat4 const&) override;
     void reception_mode_set_to(Surface const* surf, input::InputReceptionMode mode) override;
     void renamed(Surface const* surf, std::string const&) override;
+    void attrib_changed(Surface const* surf, MirWindowAttrib attrib, int value) override;
 
 private:
     std::function<void()> const notify_scene_change;
@@ -49,6 +50,8 @@ private:
 
     std::mutex mutex;
     geometry::Point top_left;
+    /// New frames of a surface that is occluded everywhere don't need compositing
+    bool occluded{false};
 };
 }
 }
@@ -0,0 +1,166 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "surface_input_index.h"
+
+#include <algorithm>
+
+namespace ms = mir::scene;
+namespace geom = mir::geometry;
+
+namespace
+{
+/// Rounds towards negative infinity, so cells are the same size either side of the origin
+auto cell_of(int coordinate) -> int
+{
+    int const size = ms::SurfaceInputIndex::cell_size;
+    return coordinate >= 0 ? coordinate / size : (coordinate - size + 1) / size;
+}
+
+auto key_of(int cell_x, int cell_y) -> uint64_t
+{
+    return (uint64_t{static_cast<uint32_t>(cell_x)} << 32) | static_cast<uint32_t>(cell_y);
+}
+
+/// The first and last cells (inclusive) covered by a non-empty rectangle
+struct CellRange
+{
+    CellRange(geom::Rectangle const& rect)
+        : left{cell_of(rect.left().as_int())},
+          top{cell_of(rect.top().as_int())},
+          right{cell_of(rect.right().as_int() - 1)},
+          bottom{cell_of(rect.bottom().as_int() - 1)}
+    {
+    }
+
+    auto count() const -> int64_t
+    {
+        return (int64_t{right} - left + 1) * (int64_t{bottom} - top + 1);
+    }
+
+    int const left;
+    int const top;
+    int const right;
+    int const bottom;
+};
+
+auto is_empty(geom::Rectangle const& rect) -> bool
+{
+    return rect.size.width <= geom::Width{0} || rect.size.height <= geom::Height{0};
+}
+}
+
+void ms::SurfaceInputIndex::insert(Surface const* surface, geometry::Rectangle const& new_bounds)
+{
+    auto const existing = bounds.find(surface);
+    if (existing != bounds.end())
+    {
+        if (existing->second == new_bounds)
+            return;
+
+        remove_from_cells(surface, existing->second);
+        existing->second = new_bounds;
+    }
+    else
+    {
+        bounds.emplace(surface, new_bounds);
+    }
+
+    add_to_cells(surface, new_bounds);
+}
+
+void ms::SurfaceInputIndex::erase(Surface const* surface)
+{
+    auto const existing = bounds.find(surface);
+    if (existing != bounds.end())
+    {
+        remove_from_cells(surface, existing->second);
+        bounds.erase(existing);
+    }
+}
+
+auto ms::SurfaceInputIndex::contains(Surface const* surface) const -> bool
+{
+    return bounds.find(surface) != bounds.end();
+}
+
+auto ms::SurfaceInputIndex::surfaces_at(geometry::Point point) const -> std::vector<Surface const*>
+{
+    std::vector<Surface const*> result;
+    auto const add_if_under_point = [&](Surface const* surface)
+        {
+            if (bounds.at(surface).contains(point))
+                result.push_back(surface);
+        };
+
+    auto const cell = cells.find(key_of(cell_of(point.x.as_int()), cell_of(point.y.as_int())));
+    if (cell != cells.end())
+    {
+        std::for_each(cell->second.begin(), cell->second.end(), add_if_under_point);
+    }
+    std::for_each(oversized.begin(), oversized.end(), add_if_under_point);
+
+    return result;
+}
+
+void ms::SurfaceInputIndex::add_to_cells(Surface const* surface, geometry::Rectangle const& surface_bounds)
+{
+    if (is_empty(surface_bounds))
+        return;
+
+    CellRange const range{surface_bounds};
+    if (range.count() > max_cells_per_surface)
+    {
+        oversized.push_back(surface);
+        return;
+    }
+
+    for (auto x = range.left; x <= range.right; ++x)
+    {
+        for (auto y = range.top; y <= range.bottom; ++y)
+        {
+            cells[key_of(x, y)].push_back(surface);
+        }
+    }
+}
+
+void ms::SurfaceInputIndex::remove_from_cells(Surface const* surface, geometry::Rectangle const& surface_bounds)
+{
+    if (is_empty(surface_bounds))
+        return;
+
+    CellRange const range{surface_bounds};
+    if (range.count() > max_cells_per_surface)
+    {
+        oversized.erase(std::remove(oversized.begin(), oversized.end(), surface), oversized.end());
+        return;
+    }
+
+    for (auto x = range.left; x <= range.right; ++x)
+    {
+        for (auto y = range.top; y <= range.bottom; ++y)
+        {
+            auto const cell = cells.find(key_of(x, y));
+            if (cell == cells.end())
+                continue;
+
+            auto& surfaces = cell->second;
+            surfaces.erase(std::remove(surfaces.begin(), surfaces.end(), surface), surfaces.end());
+            if (surfaces.empty())
+                cells.erase(cell);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_SCENE_SURFACE_INPUT_INDEX_H_
+#define MIR_SCENE_SURFACE_INPUT_INDEX_H_
+
+#include "mir/geometry/rectangle.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace mir
+{
+namespace scene
+{
+
+class Surface;
+
+/**
+ * A uniform grid over the input bounds of surfaces
+ *
+ * Finding the surfaces under a point only looks at the ones sharing its grid cell, rather than all of them.
+ * Not threadsafe, the owner must serialise access.
+ */
+class SurfaceInputIndex
+{
+public:
+    /// Adds the surface with the given bounds, or moves it there if it is already indexed
+    void insert(Surface const* surface, geometry::Rectangle const& bounds);
+    void erase(Surface const* surface);
+    auto contains(Surface const* surface) const -> bool;
+
+    /// The surfaces with bounds containing point, in no particular order
+    auto surfaces_at(geometry::Point point) const -> std::vector<Surface const*>;
+
+    /// Width and height of a grid cell
+    static int constexpr cell_size{256};
+    /// Surfaces with bounds covering more cells than this are kept out of the grid and checked for every point
+    static int constexpr max_cells_per_surface{1024};
+
+private:
+    using CellKey = uint64_t;
+
+    void add_to_cells(Surface const* surface, geometry::Rectangle const& bounds);
+    void remove_from_cells(Surface const* surface, geometry::Rectangle const& bounds);
+
+    std::unordered_map<Surface const*, geometry::Rectangle> bounds;
+    std::unordered_map<CellKey, std::vector<Surface const*>> cells;
+    std::vector<Surface const*> oversized;
+};
+}
+}
+
+#endif /* MIR_SCENE_SURFACE_INPUT_INDEX_H_ */
@@ -21,6 +21,7 @@
 #include "mir/scene/scene_report.h"
 #include "mir/compositor/scene_element.h"
 #include "mir/graphics/renderable.h"
+#include "mir/graphics/buffer.h"
 #include "mir/depth_layer.h"
 #include "mir/executor.h"
 
@@ -30,6 +31,7 @@
 #include <cassert>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 
 namespace ms = mir::scene;
@@ -45,14 +47,15 @@ class SurfaceSceneElement : public mc::SceneElement
 {
 public:
     SurfaceSceneElement(
-        std::string name,
+        std::shared_ptr<ms::Surface> const& surface,
         std::shared_ptr<mg::Renderable> const& renderable,
         std::shared_ptr<ms::RenderingTracker> const& tracker,
         mc::CompositorID id)
         : renderable_{renderable},
           tracker{tracker},
           cid{id},
-          surface_name(name)
+          surface{surface},
+          surface_name(surface->name())
     {
     }
 
@@ -71,10 +74,25 @@ public:
         tracker->occluded_in(cid);
     }
 
+    auto presentation_callback() const -> PresentationCallback override
+    {
+        auto const buffer = renderable_->buffer();
+        if (!buffer)
+            return {};
+
+        return [surface = surface, stream = renderable_->id(), buffer_id = buffer->id()](
+            geom::Rectangle const& output_area, mg::Frame const& frame, bool zero_copy)
+            {
+                if (auto const s = surface.lock())
+                    s->buffer_presented(stream, buffer_id, output_area, frame, zero_copy);
+            };
+    }
+
 private:
     std::shared_ptr<mg::Renderable> const renderable_;
     std::shared_ptr<ms::RenderingTracker> const tracker;
     mc::CompositorID cid;
+    std::weak_ptr<ms::Surface> const surface;
     std::string const surface_name;
 };
 
@@ -101,16 +119,21 @@ public:
     {
     }
 
+    auto presentation_callback() const -> PresentationCallback override
+    {
+        return {};
+    }
+
 private:
     std::shared_ptr<mg::Renderable> const renderable_;
 };
 
 /**
- * A SurfaceDepthLayerObserver must not outlive the SurfaceStack it was created for
+ * A StackedSurfaceObserver must not outlive the SurfaceStack it was created for
  */
-struct SurfaceDepthLayerObserver : ms::NullSurfaceObserver
+struct StackedSurfaceObserver : ms::NullSurfaceObserver
 {
-    SurfaceDepthLayerObserver(ms::SurfaceStack* stack)
+    StackedSurfaceObserver(ms::SurfaceStack* stack)
         : stack{stack}
     {
     }
@@ -121,17 +144,63 @@ struct SurfaceDepthLayerObserver : ms::NullSurfaceObserver
         stack->raise(surface);
     }
 
+    void moved_to(ms::Surface const* surface, geom::Point const&) override
+    {
+        stack->input_bounds_changed(surface);
+    }
+
+    void content_resized_to(ms::Surface const* surface, geom::Size const&) override
+    {
+        stack->input_bounds_changed(surface);
+    }
+
+    void input_region_set_to(ms::Surface const* surface, std::vector<geom::Rectangle> const&) override
+    {
+        stack->input_bounds_changed(surface);
+    }
+
 private:
     ms::SurfaceStack* stack;
 };
 
+/// Everywhere surface->input_area_contains() could be true, ignoring its visibility and clip area
+auto input_bounds_of(ms::Surface const* surface) -> geom::Rectangle
+{
+    auto const content = surface->input_bounds();
+    auto const region = surface->input_region();
+    if (region.empty())
+        return content;
+
+    std::optional<geom::Rectangle> bounds;
+    for (auto const& rect : region)
+    {
+        if (rect.size.width <= geom::Width{0} || rect.size.height <= geom::Height{0})
+            continue;
+
+        geom::Rectangle const on_screen{content.top_left + as_displacement(rect.top_left), rect.size};
+        if (!bounds)
+        {
+            bounds = on_screen;
+        }
+        else
+        {
+            auto const left = std::min(bounds->left(), on_screen.left());
+            auto const top = std::min(bounds->top(), on_screen.top());
+            auto const right = std::max(bounds->right(), on_screen.right());
+            auto const bottom = std::max(bounds->bottom(), on_screen.bottom());
+            bounds = geom::Rectangle{{left, top}, {as_width(right - left), as_height(bottom - top)}};
+        }
+    }
+    return bounds.value_or(geom::Rectangle{});
+}
+
 }
 
 ms::SurfaceStack::SurfaceStack(
     std::shared_ptr<SceneReport> const& report) :
     report{report},
     scene_changed{false},
-    surface_observer{std::make_shared<SurfaceDepthLayerObserver>(this)}
+    surface_observer{std::make_shared<StackedSurfaceObserver>(this)}
 {
 }
 
@@ -163,7 +232,7 @@ mc::SceneElementSequence ms::SurfaceStack::scene_elements_for(mc::CompositorID i
                 {
                     elements.emplace_back(
                         std::make_shared<SurfaceSceneElement>(
-                            surface->name(),
+                            surface,
                             renderable,
                             rendering_trackers[surface.get()],
                             id));
@@ -267,6 +336,7 @@ void ms::SurfaceStack::add_surface(
         RecursiveWriteLock lg(guard);
         insert_surface_at_top_of_depth_layer(surface);
         create_rendering_tracker_for(surface);
+        input_index.insert(surface.get(), input_bounds_of(surface.get()));
         surface->register_interest(surface_observer, immediate_executor);
     }
     surface->set_reception_mode(input_mode);
@@ -291,6 +361,7 @@ void ms::SurfaceStack::remove_surface(std::weak_ptr<Surface> const& surface)
             {
                 layer.erase(surface);
                 rendering_trackers.erase(keep_alive.get());
+                input_index.erase(keep_alive.get());
                 keep_alive->unregister_interest(*surface_observer);
                 found_surface = true;
                 break;
@@ -323,16 +394,30 @@ auto ms::SurfaceStack::surface_at(geometry::Point cursor) const
 -> std::shared_ptr<Surface>
 {
     RecursiveReadLock lg(guard);
+
+    // Only the surfaces that could be under the cursor are asked, which saves locking every surface
+    auto candidates = input_index.surfaces_at(cursor);
     for (auto const& layer : in_reverse(surface_layers))
     {
+        if (candidates.empty())
+            break;
+
         for (auto const& surface : in_reverse(layer))
         {
+            auto const candidate = std::find(candidates.begin(), candidates.end(), surface.get());
+            if (candidate == candidates.end())
+                continue;
+
             // TODO There's a lack of clarity about how the input area will
             // TODO be maintained and whether this test will detect clicks on
             // TODO decorations (it should) as these may be outside the area
             // TODO known to the client.  But it works for now.
             if (surface->input_area_contains(cursor))
                     return surface;
+
+            candidates.erase(candidate);
+            if (candidates.empty())
+                break;
         }
     }
 
@@ -351,6 +436,17 @@ void ms::SurfaceStack::for_each(std::function<void(std::shared_ptr<mi::Surface>
     }
 }
 
+void ms::SurfaceStack::input_bounds_changed(Surface const* surface)
+{
+    RecursiveWriteLock lg(guard);
+
+    // The notification could come after the surface has been removed
+    if (input_index.contains(surface))
+    {
+        input_index.insert(surface, input_bounds_of(surface));
+    }
+}
+
 void ms::SurfaceStack::raise(Surface const* surface)
 {
     SurfaceSet affected_surfaces;
@@ -24,6 +24,7 @@
 #include "mir/scene/observer.h"
 #include "mir/input/scene.h"
 #include "mir/recursive_read_write_mutex.h"
+#include "surface_input_index.h"
 
 #include "mir/basic_observers.h"
 #include "mir/scene/surface_observer.h"
@@ -87,6 +88,8 @@ public:
     virtual void remove_surface(std::weak_ptr<Surface> const& surface) override;
 
     void raise(Surface const* surface);
+    /// Updates where surface_at() looks for the surface
+    void input_bounds_changed(Surface const* surface);
     virtual void raise(std::weak_ptr<Surface> const& surface) override;
     void raise(SurfaceSet const& surfaces) override;
 
@@ -127,6 +130,7 @@ private:
      */
     std::vector<std::vector<std::shared_ptr<Surface>>> surface_layers;
     std::map<Surface*,std::shared_ptr<RenderingTracker>> rendering_trackers;
+    SurfaceInputIndex input_index;
     std::set<compositor::CompositorID> registered_compositors;
     
     std::vector<std::shared_ptr<graphics::Renderable>> overlays;
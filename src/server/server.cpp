@@ -32,6 +32,7 @@
 #include "mir/report_exception.h"
 #include "mir/run_mir.h"
 #include "mir/cookie/authority.h"
+#include "mir/thread_scheduling.h"
 
 // TODO these are used to frig a stub renderer when running headless
 #include "mir/renderer/renderer.h"
@@ -92,6 +93,7 @@ struct TemporaryCompositeEventFilter : public mi::CompositeEventFilter
     MACRO(display_buffer_compositor_factory)\
     MACRO(gl_config)\
     MACRO(input_dispatcher)\
+    MACRO(input_latency_report)\
     MACRO(input_targeter)\
     MACRO(logger)\
     MACRO(prompt_session_listener)\
@@ -405,6 +407,12 @@ void mir::Server::run()
 
         self->pre_init_callback();
 
+        // Before the input and compositor threads start, so that nothing they touch is paged out
+        if (self->server_config->the_options()->is_set(mo::lock_memory_opt))
+        {
+            lock_process_memory();
+        }
+
         run_mir(
             *self->server_config,
             [&](DisplayServer&)
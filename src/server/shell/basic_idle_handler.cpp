@@ -60,6 +60,11 @@ public:
         return buffer_;
     }
 
+    auto src_bounds() const -> geom::RectangleD override
+    {
+        return {{0, 0}, geom::SizeD{buffer_->size()}};
+    }
+
     auto screen_position() const -> geom::Rectangle override
     {
         return {{-coverage_size / 2, -coverage_size / 2}, {coverage_size, coverage_size}};
@@ -85,6 +90,11 @@ public:
         return false;
     }
 
+    auto opaque_region() const -> std::vector<geom::Rectangle> override
+    {
+        return {};
+    }
+
 private:
     std::shared_ptr<mg::Buffer> const buffer_;
 };
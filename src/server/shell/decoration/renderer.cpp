@@ -20,6 +20,7 @@
 #include "input.h"
 
 #include "mir/graphics/graphic_buffer_allocator.h"
+#include "mir/graphics/solid_colour_buffer.h"
 #include "mir/renderer/sw/pixel_source.h"
 #include "mir/geometry/displacement.h"
 #include "mir/log.h"
@@ -49,6 +50,17 @@ static constexpr auto color(unsigned char r, unsigned char g, unsigned char b, u
            ((uint32_t)a << 24);
 }
 
+/// The premultiplied colour of an ARGB pixel
+auto as_solid_colour(uint32_t pixel) -> mg::SolidColourBuffer::Colour
+{
+    float const alpha = ((pixel >> 24) & 0xFF) / 255.0f;
+    return {
+        ((pixel >> 16) & 0xFF) / 255.0f * alpha,
+        ((pixel >>  8) & 0xFF) / 255.0f * alpha,
+        ((pixel >>  0) & 0xFF) / 255.0f * alpha,
+        alpha};
+}
+
 uint32_t const default_focused_background   = color(0x32, 0x32, 0x32);
 uint32_t const default_unfocused_background = color(0x80, 0x80, 0x80);
 uint32_t const default_focused_text         = color(0xFF, 0xFF, 0xFF);
@@ -483,17 +495,6 @@ void msd::Renderer::update_state(WindowState const& window_state, InputState con
     right_border_size = window_state.right_border_rect().size;
     bottom_border_size = window_state.bottom_border_rect().size;
 
-    size_t length{0};
-    length = std::max(length, area(left_border_size));
-    length = std::max(length, area(right_border_size));
-    length = std::max(length, area(bottom_border_size));
-
-    if (length != solid_color_pixels_length)
-    {
-        solid_color_pixels_length = length;
-        solid_color_pixels.reset(); // force a reallocation next time it's needed
-    }
-
     if (window_state.titlebar_rect().size != titlebar_size)
     {
         titlebar_size = window_state.titlebar_rect().size;
@@ -508,7 +509,6 @@ void msd::Renderer::update_state(WindowState const& window_state, InputState con
     {
         current_theme = new_theme;
         needs_titlebar_redraw = true;
-        needs_solid_color_redraw = true;
     }
 
     if (window_state.window_name() != name)
@@ -615,43 +615,27 @@ auto msd::Renderer::render_left_border() -> std::optional<std::shared_ptr<mg::Bu
 {
     if (!area(left_border_size))
         return std::nullopt;
-    update_solid_color_pixels();
-    return make_buffer(solid_color_pixels.get(), left_border_size);
+    return make_solid_color_buffer(left_border_size);
 }
 
 auto msd::Renderer::render_right_border() -> std::optional<std::shared_ptr<mg::Buffer>>
 {
     if (!area(right_border_size))
         return std::nullopt;
-    update_solid_color_pixels();
-    return make_buffer(solid_color_pixels.get(), right_border_size);
+    return make_solid_color_buffer(right_border_size);
 }
 
 auto msd::Renderer::render_bottom_border() -> std::optional<std::shared_ptr<mg::Buffer>>
 {
     if (!area(bottom_border_size))
         return std::nullopt;
-    update_solid_color_pixels();
-    return make_buffer(solid_color_pixels.get(), bottom_border_size);
+    return make_solid_color_buffer(bottom_border_size);
 }
 
-void msd::Renderer::update_solid_color_pixels()
+auto msd::Renderer::make_solid_color_buffer(geometry::Size size) const -> std::shared_ptr<mg::Buffer>
 {
-    if (!solid_color_pixels)
-    {
-        solid_color_pixels = alloc_pixels(geom::Size{solid_color_pixels_length, 1});
-        needs_solid_color_redraw = true;
-    }
-
-    if (needs_solid_color_redraw)
-    {
-        render_row(
-            solid_color_pixels.get(), geom::Size{solid_color_pixels_length, 1},
-            geom::Point{}, geom::Width{solid_color_pixels_length},
-            current_theme->background_color);
-    }
-
-    needs_solid_color_redraw = false;
+    // Borders are a single colour, so there is nothing to allocate, fill or upload
+    return std::make_shared<mg::SolidColourBuffer>(as_solid_colour(current_theme->background_color), size);
 }
 
 auto msd::Renderer::make_buffer(
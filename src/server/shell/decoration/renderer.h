@@ -110,12 +110,9 @@ private:
     std::map<ButtonFunction, Icon const> button_icons;
     std::shared_ptr<StaticGeometry const> const static_geometry;
 
-    bool needs_solid_color_redraw{true};
     geometry::Size left_border_size;
     geometry::Size right_border_size;
     geometry::Size bottom_border_size;
-    size_t solid_color_pixels_length{0};
-    std::unique_ptr<Pixel[]> solid_color_pixels; // can be nullptr
 
     geometry::Size titlebar_size{};
     std::unique_ptr<Pixel[]> titlebar_pixels; // can be nullptr
@@ -127,7 +124,7 @@ private:
 
     std::shared_ptr<Text> const text;
 
-    void update_solid_color_pixels();
+    auto make_solid_color_buffer(geometry::Size size) const -> std::shared_ptr<graphics::Buffer>;
     auto make_buffer(
         Pixel const* pixels,
         geometry::Size size) -> std::optional<std::shared_ptr<graphics::Buffer>>;
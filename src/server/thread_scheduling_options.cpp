@@ -0,0 +1,43 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/thread_scheduling_options.h"
+#include "mir/options/configuration.h"
+#include "mir/options/option.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <stdexcept>
+
+namespace mo = mir::options;
+
+auto mir::thread_scheduling_from(mo::Option const& options, char const* priority_opt, char const* cpus_opt)
+    -> ThreadScheduling
+{
+    ThreadScheduling scheduling;
+
+    scheduling.priority = options.get(priority_opt, 0);
+    if (scheduling.priority < 0 || scheduling.priority > 99)
+    {
+        BOOST_THROW_EXCEPTION(std::invalid_argument{
+            std::string{"--"} + priority_opt + " must be from 1 to 99 (or 0 for normal scheduling)"});
+    }
+
+    scheduling.policy = parse_scheduling_policy(options.get(mo::realtime_policy_opt, "fifo"));
+    scheduling.cpus = parse_cpu_list(options.get(cpus_opt, ""));
+
+    return scheduling;
+}
@@ -78,6 +78,16 @@ public:
         return !rectangular;
     }
 
+    std::vector<geometry::Rectangle> opaque_region() const override
+    {
+        return opaque;
+    }
+
+    void set_opaque_region(std::vector<geometry::Rectangle> const& region)
+    {
+        opaque = region;
+    }
+
     void set_buffer(std::shared_ptr<graphics::Buffer> b)
     {
         buf = b;
@@ -88,6 +98,16 @@ public:
         return buf;
     }
 
+    geometry::RectangleD src_bounds() const override
+    {
+        return src.value_or(geometry::RectangleD{{0, 0}, geometry::SizeD{buf->size()}});
+    }
+
+    void set_src_bounds(geometry::RectangleD const& bounds)
+    {
+        src = bounds;
+    }
+
     geometry::Rectangle screen_position() const override
     {
         return rect;
@@ -103,6 +123,8 @@ private:
     mir::geometry::Rectangle rect;
     float opacity;
     bool rectangular;
+    std::vector<geometry::Rectangle> opaque;
+    std::optional<geometry::RectangleD> src;
 };
 
 } // namespace doubles
@@ -61,6 +61,9 @@ struct MockBufferStream : public compositor::BufferStream
     MOCK_METHOD1(lock_compositor_buffer,
                  std::shared_ptr<graphics::Buffer>(void const*));
     MOCK_METHOD1(set_frame_posted_callback, void(std::function<void(geometry::Size const&)> const&));
+    MOCK_METHOD1(set_frame_presented_callback, void(std::function<void(
+        graphics::BufferID, geometry::Rectangle const&, graphics::Frame const&, bool)> const&));
+    MOCK_METHOD4(frame_presented, void(graphics::BufferID, geometry::Rectangle const&, graphics::Frame const&, bool));
 
     MOCK_METHOD0(get_stream_pixel_format, MirPixelFormat());
     MOCK_METHOD0(stream_size, geometry::Size());
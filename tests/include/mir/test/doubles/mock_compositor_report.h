@@ -44,6 +44,7 @@ public:
     MOCK_METHOD0(started, void());
     MOCK_METHOD0(stopped, void());
     MOCK_METHOD0(scheduled, void());
+    MOCK_METHOD3(captured_area, void(geometry::Rectangle const&, std::chrono::nanoseconds, bool));
 };
 
 } // namespace doubles
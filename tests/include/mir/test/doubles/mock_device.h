@@ -60,6 +60,7 @@ struct MockDevice : input::Device
     MOCK_METHOD1(apply_touchpad_configuration, void(MirTouchpadConfig const&));
     MOCK_METHOD1(apply_keyboard_configuration, void(MirKeyboardConfig const&));
     MOCK_METHOD1(apply_touchscreen_configuration, void(MirTouchscreenConfig const&));
+    MOCK_CONST_METHOD0(statistics, input::InputDeviceStatistics());
 };
 }
 }
@@ -31,6 +31,11 @@ struct MockRenderable : public graphics::Renderable
 {
     MockRenderable()
     {
+        ON_CALL(*this, src_bounds())
+            .WillByDefault(testing::Invoke([this]()
+                {
+                    return geometry::RectangleD{{0, 0}, geometry::SizeD{buffer()->size()}};
+                }));
         ON_CALL(*this, screen_position())
             .WillByDefault(testing::Return(geometry::Rectangle{{},{}}));
         ON_CALL(*this, clip_area())
@@ -43,16 +48,20 @@ struct MockRenderable : public graphics::Renderable
             .WillByDefault(testing::Return(glm::mat4{}));
         ON_CALL(*this, visible())
             .WillByDefault(testing::Return(true));
+        ON_CALL(*this, opaque_region())
+            .WillByDefault(testing::Return(std::vector<geometry::Rectangle>{}));
     }
 
     MOCK_CONST_METHOD0(id, ID());
     MOCK_CONST_METHOD0(buffer, std::shared_ptr<graphics::Buffer>());
+    MOCK_CONST_METHOD0(src_bounds, geometry::RectangleD());
     MOCK_CONST_METHOD0(screen_position, geometry::Rectangle());
     MOCK_CONST_METHOD0(clip_area, std::optional<geometry::Rectangle>());
     MOCK_CONST_METHOD0(alpha, float());
     MOCK_CONST_METHOD0(transformation, glm::mat4());
     MOCK_CONST_METHOD0(visible, bool());
     MOCK_CONST_METHOD0(shaped, bool());
+    MOCK_CONST_METHOD0(opaque_region, std::vector<geometry::Rectangle>());
 };
 }
 }
@@ -24,6 +24,10 @@
 
 namespace mir
 {
+namespace graphics
+{
+struct Frame;
+}
 namespace test
 {
 namespace doubles
@@ -43,6 +47,10 @@ public:
                 // valgrind for some tests
                 std::this_thread::yield();
             }
+
+            void frame_presented(graphics::Frame const&)
+            {
+            }
         };
 
         auto raw = new NullDisplayBufferCompositor{};
@@ -69,6 +69,9 @@ public:
     }
     MirPixelFormat pixel_format() const override { return mir_pixel_format_abgr_8888; }
     void set_frame_posted_callback(std::function<void(geometry::Size const&)> const&) override {}
+    void set_frame_presented_callback(
+        std::function<void(graphics::BufferID, geometry::Rectangle const&, graphics::Frame const&, bool)> const&) override {}
+    void frame_presented(graphics::BufferID, geometry::Rectangle const&, graphics::Frame const&, bool) override {}
     bool has_submitted_buffer() const override { return true; }
     void set_scale(float) override {}
 
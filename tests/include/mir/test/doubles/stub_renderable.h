@@ -68,6 +68,10 @@ public:
     {
         return stub_buffer;
     }
+    geometry::RectangleD src_bounds() const override
+    {
+        return {{0, 0}, geometry::SizeD{stub_buffer->size()}};
+    }
     geometry::Rectangle screen_position() const override
     {
         return rect;
@@ -88,6 +92,10 @@ public:
     {
         return false;
     }
+    std::vector<geometry::Rectangle> opaque_region() const override
+    {
+        return {};
+    }
 private:
     std::shared_ptr<graphics::Buffer> make_stub_buffer(geometry::Rectangle const& rect)
     {
@@ -53,6 +53,11 @@ public:
     {
     }
 
+    auto presentation_callback() const -> PresentationCallback override
+    {
+        return {};
+    }
+
 private:
     std::shared_ptr<graphics::Renderable> const renderable_;
 };
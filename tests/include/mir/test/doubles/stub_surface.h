@@ -38,6 +38,7 @@ struct StubSurface : scene::Surface
     input::InputReceptionMode reception_mode() const override { return input::InputReceptionMode::normal; }
     void set_reception_mode(input::InputReceptionMode) override {}
     void set_input_region(std::vector<geometry::Rectangle> const&) override {}
+    auto input_region() const -> std::vector<geometry::Rectangle> override { return {}; }
     void resize(geometry::Size const&) override {}
     geometry::Point top_left() const override { return {}; }
     geometry::Rectangle input_bounds() const override { return {}; }
@@ -48,6 +49,8 @@ struct StubSurface : scene::Surface
     void set_transformation(glm::mat4 const&) override {}
     bool visible() const override { return false; }
     graphics::RenderableList generate_renderables(compositor::CompositorID) const override { return {}; }
+    void buffer_presented(
+        graphics::Renderable::ID, graphics::BufferID, geometry::Rectangle const&, graphics::Frame const&, bool) override {}
     int buffers_ready_for_compositor(void const*) const override { return 0; }
     MirWindowType type() const override { return mir_window_type_normal; }
     auto state_tracker() const -> scene::SurfaceStateTracker override
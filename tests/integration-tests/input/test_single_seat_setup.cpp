@@ -17,6 +17,7 @@
 #include "src/server/input/default_input_device_hub.h"
 #include "src/server/input/basic_seat.h"
 #include "src/server/input/config_changer.h"
+#include "src/server/report/null_report_factory.h"
 #include "src/server/scene/broadcasting_session_event_sink.h"
 
 #include "mir/test/doubles/mock_input_device.h"
@@ -129,14 +130,16 @@ struct SingleSeatInputDeviceHubSetup : ::testing::Test
     mi::BasicSeat seat{mt::fake_shared(mock_dispatcher),      mt::fake_shared(mock_visualizer),
                        mt::fake_shared(mock_cursor_listener), mt::fake_shared(display_config),
                        mt::fake_shared(key_mapper),           mt::fake_shared(clock),
-                       mt::fake_shared(mock_seat_observer)};
+                       mt::fake_shared(mock_seat_observer),   mir::report::null_input_latency_report()};
     mi::DefaultInputDeviceHub hub{
         mt::fake_shared(seat),
         mt::fake_shared(multiplexer),
         mt::fake_shared(clock),
         cookie_authority,
         mt::fake_shared(key_mapper),
-        mt::fake_shared(mock_status_listener)};
+        mt::fake_shared(mock_status_listener),
+        mir::report::null_input_report(),
+        0};
     NiceMock<mtd::MockInputDeviceObserver> mock_observer;
     mi::ConfigChanger changer{
         mt::fake_shared(mock_input_manager),
@@ -103,7 +103,9 @@ mis::ButtonParameters mis::a_button_up_event()
 mis::MotionParameters::MotionParameters() :
     device_id(0),
     rel_x(0),
-    rel_y(0)
+    rel_y(0),
+    h_scroll(0),
+    v_scroll(0)
 {
 }
 
@@ -120,6 +122,13 @@ mis::MotionParameters& mis::MotionParameters::with_movement(int new_rel_x, int n
     return *this;
 }
 
+mis::MotionParameters& mis::MotionParameters::with_scroll(float new_h_scroll, float new_v_scroll)
+{
+    h_scroll = new_h_scroll;
+    v_scroll = new_v_scroll;
+    return *this;
+}
+
 mis::MotionParameters& mis::MotionParameters::with_event_time(std::chrono::nanoseconds event_time)
 {
     this->event_time = event_time;
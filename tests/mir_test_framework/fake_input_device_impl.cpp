@@ -37,6 +37,7 @@
 
 namespace mi = mir::input;
 namespace mie = mi::evdev;
+namespace mev = mir::events;
 namespace md = mir::dispatch;
 namespace geom = mir::geometry;
 namespace mtf = mir_test_framework;
@@ -157,7 +158,7 @@ void mtf::FakeInputDeviceImpl::InputDevice::synthesize_events(synthesis::KeyPara
 
     if (!sink)
         BOOST_THROW_EXCEPTION(std::runtime_error("Device is not started."));
-    sink->handle_input(std::move(key_event));
+    sink->handle_input(mev::share_event(std::move(key_event)));
 }
 
 void mtf::FakeInputDeviceImpl::InputDevice::synthesize_events(synthesis::ButtonParameters const& button)
@@ -176,7 +177,7 @@ void mtf::FakeInputDeviceImpl::InputDevice::synthesize_events(synthesis::ButtonP
 
     if (!sink)
         BOOST_THROW_EXCEPTION(std::runtime_error("Device is not started."));
-    sink->handle_input(std::move(button_event));
+    sink->handle_input(mev::share_event(std::move(button_event)));
 }
 
 MirPointerAction mtf::FakeInputDeviceImpl::InputDevice::update_buttons(synthesis::EventAction action, MirPointerButton button)
@@ -209,15 +210,16 @@ void mtf::FakeInputDeviceImpl::InputDevice::synthesize_events(synthesis::MotionP
         pointer.rel_x * acceleration,
         pointer.rel_y * acceleration};
 
+    bool const scrolls = pointer.h_scroll != 0 || pointer.v_scroll != 0;
     auto pointer_event = builder->pointer_event(
         event_time, mir_pointer_action_motion, buttons,
         std::nullopt, motion,
-        mir_pointer_axis_source_none,
-        {scroll.dx, {}, false},
-        {scroll.dy, {}, false});
+        scrolls ? mir_pointer_axis_source_wheel : mir_pointer_axis_source_none,
+        {scroll.dx + geom::DeltaXF{pointer.h_scroll}, {}, false},
+        {scroll.dy + geom::DeltaYF{pointer.v_scroll}, {}, false});
     pointer_event->to_input()->set_event_time(event_time);
 
-    sink->handle_input(std::move(pointer_event));
+    sink->handle_input(mev::share_event(std::move(pointer_event)));
 }
 
 void mtf::FakeInputDeviceImpl::InputDevice::synthesize_events(synthesis::TouchParameters const& touch)
@@ -246,7 +248,7 @@ void mtf::FakeInputDeviceImpl::InputDevice::synthesize_events(synthesis::TouchPa
             {{MirTouchId{1}, touch_action, mir_touch_tooltype_finger, {abs_x, abs_y}, 1.0f, 8.0f, 5.0f, 0.0f}});
         touch_event->to_input()->set_event_time(event_time);
 
-        sink->handle_input(std::move(touch_event));
+        sink->handle_input(mev::share_event(std::move(touch_event)));
     }
 }
 
@@ -22,6 +22,7 @@
 #include "mir/compositor/display_buffer_compositor.h"
 #include "mir/compositor/scene_element.h"
 #include "mir/graphics/buffer.h"
+#include "mir/graphics/frame.h"
 #include "mir/geometry/rectangle.h"
 
 namespace mtf = mir_test_framework;
@@ -77,6 +78,8 @@ mtf::HeadlessDisplayBufferCompositorFactory::create_compositor_for(mg::DisplayBu
                 {
                     (*it)->rendered();
                     renderables.push_back((*it)->renderable());
+                    if (auto callback = (*it)->presentation_callback())
+                        awaiting_presentation.push_back(std::move(callback));
                 }
             }
             std::reverse(renderables.begin(), renderables.end());
@@ -86,7 +89,8 @@ mtf::HeadlessDisplayBufferCompositorFactory::create_compositor_for(mg::DisplayBu
         void composite(mir::compositor::SceneElementSequence&& seq) override
         {
             auto renderlist = filter(seq, db.view_area());
-            if (db.overlay(renderlist))
+            zero_copy = db.overlay(renderlist);
+            if (zero_copy)
             {
                 if (tracker)
                     tracker->note_passthrough();
@@ -111,9 +115,19 @@ mtf::HeadlessDisplayBufferCompositorFactory::create_compositor_for(mg::DisplayBu
             if (render_target)
                 render_target->swap_buffers();
         }
+
+        void frame_presented(mg::Frame const& frame) override
+        {
+            for (auto const& callback : awaiting_presentation)
+                callback(db.view_area(), frame, zero_copy);
+            awaiting_presentation.clear();
+        }
+
         mg::DisplayBuffer& db;
         std::shared_ptr<PassthroughTracker> const tracker;
         mrg::RenderTarget* const render_target;
+        std::vector<mc::SceneElement::PresentationCallback> awaiting_presentation;
+        bool zero_copy{false};
     };
     return std::make_unique<HeadlessDBC>(db, tracker);
 }
@@ -0,0 +1,194 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_replay.h"
+
+#include "mir/input/input_device_info.h"
+#include "mir_test_framework/fake_input_device.h"
+#include "mir_test_framework/stub_server_platform_factory.h"
+#include "mir/test/event_factory.h"
+
+#include <linux/input.h>
+
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <thread>
+
+namespace mi = mir::input;
+namespace mis = mir::input::synthesis;
+namespace mt = mir::test;
+namespace mtf = mir_test_framework;
+
+namespace
+{
+struct ReplayedDevice
+{
+    mir::UniqueModulePtr<mtf::FakeInputDevice> device;
+    MirPointerButtons buttons{0};
+    // Motion is recorded in fractions of a pixel but the fake devices move whole pixels
+    float dx_remainder{0};
+    float dy_remainder{0};
+};
+
+// The fake devices are right-handed, so this is the inverse of mir::input::evdev::to_pointer_button()
+std::pair<MirPointerButton, int> const evdev_buttons[] = {
+    {mir_pointer_button_primary, BTN_LEFT},
+    {mir_pointer_button_secondary, BTN_RIGHT},
+    {mir_pointer_button_tertiary, BTN_MIDDLE},
+    {mir_pointer_button_back, BTN_BACK},
+    {mir_pointer_button_forward, BTN_FORWARD},
+    {mir_pointer_button_side, BTN_SIDE},
+    {mir_pointer_button_extra, BTN_EXTRA},
+    {mir_pointer_button_task, BTN_TASK}};
+
+auto now() -> std::chrono::nanoseconds
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+}
+
+auto emit_pointer(ReplayedDevice& replayed, mi::RecordedInput const& record) -> long
+{
+    long emitted{0};
+
+    for (auto const& [button, code] : evdev_buttons)
+    {
+        bool const was_down = replayed.buttons & button;
+        bool const is_down = record.buttons & button;
+        if (was_down != is_down)
+        {
+            replayed.device->emit_event(mis::ButtonParameters{}
+                .of_button(code)
+                .with_action(is_down ? mis::EventAction::Down : mis::EventAction::Up)
+                .with_event_time(now()));
+            ++emitted;
+        }
+    }
+    replayed.buttons = record.buttons;
+
+    if (record.pointer_action != mir_pointer_action_motion)
+        return emitted;
+
+    auto const dx = record.dx + replayed.dx_remainder;
+    auto const dy = record.dy + replayed.dy_remainder;
+    auto const rel_x = static_cast<int>(std::trunc(dx));
+    auto const rel_y = static_cast<int>(std::trunc(dy));
+    replayed.dx_remainder = dx - rel_x;
+    replayed.dy_remainder = dy - rel_y;
+
+    replayed.device->emit_event(mis::a_pointer_event()
+        .with_movement(rel_x, rel_y)
+        .with_scroll(record.h_scroll, record.v_scroll)
+        .with_event_time(now()));
+    return emitted + 1;
+}
+
+auto emit_touch(ReplayedDevice& replayed, mi::RecordedInput const& record) -> long
+{
+    for (auto const& contact : record.contacts)
+    {
+        auto action = mis::TouchParameters::Action::Move;
+        if (contact.action == mir_touch_action_down)
+            action = mis::TouchParameters::Action::Tap;
+        else if (contact.action == mir_touch_action_up)
+            action = mis::TouchParameters::Action::Release;
+
+        replayed.device->emit_event(mis::a_touch_event()
+            .at_position({static_cast<int>(contact.x), static_cast<int>(contact.y)})
+            .with_action(action)
+            .with_event_time(now()));
+    }
+    return record.contacts.size();
+}
+}
+
+struct mt::InputReplay::Devices
+{
+    std::map<MirInputDeviceId, ReplayedDevice> present;
+    // Events queued on a fake device refer to it, so removed devices are kept until the replay is destroyed
+    std::vector<ReplayedDevice> removed;
+};
+
+mt::InputReplay::InputReplay(std::vector<mi::RecordedInput> recording)
+    : recording{std::move(recording)},
+      devices{std::make_unique<Devices>()}
+{
+}
+
+mt::InputReplay::~InputReplay() = default;
+
+auto mt::InputReplay::run(Pace pace) -> long
+{
+    if (recording.empty())
+        return 0;
+
+    long emitted{0};
+
+    auto const recording_start = recording.front().time;
+    auto const replay_start = std::chrono::steady_clock::now();
+
+    for (auto const& record : recording)
+    {
+        if (pace == Pace::recorded)
+            std::this_thread::sleep_until(replay_start + (record.time - recording_start));
+
+        if (record.kind == mi::RecordedInput::Kind::device_added)
+        {
+            devices->present[record.device_id].device = mtf::add_fake_input_device(mi::InputDeviceInfo{
+                record.name,
+                record.unique_id,
+                mi::DeviceCapabilities{record.capabilities}});
+            continue;
+        }
+
+        auto const replayed = devices->present.find(record.device_id);
+        if (replayed == devices->present.end())
+        {
+            // Input from a device that was present before recording started
+            continue;
+        }
+
+        switch (record.kind)
+        {
+        case mi::RecordedInput::Kind::device_removed:
+            replayed->second.device->emit_device_removal();
+            devices->removed.push_back(std::move(replayed->second));
+            devices->present.erase(replayed);
+            break;
+
+        case mi::RecordedInput::Kind::key:
+            replayed->second.device->emit_event(mis::KeyParameters{}
+                .of_scancode(record.scan_code)
+                .with_action(record.key_action == mir_keyboard_action_up ? mis::EventAction::Up : mis::EventAction::Down)
+                .with_event_time(now()));
+            ++emitted;
+            break;
+
+        case mi::RecordedInput::Kind::pointer:
+            emitted += emit_pointer(replayed->second, record);
+            break;
+
+        case mi::RecordedInput::Kind::touch:
+            emitted += emit_touch(replayed->second, record);
+            break;
+
+        case mi::RecordedInput::Kind::device_added:
+            break;
+        }
+    }
+
+    return emitted;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_TEST_INPUT_REPLAY_H_
+#define MIR_TEST_INPUT_REPLAY_H_
+
+#include "mir/input/input_recording.h"
+
+#include <memory>
+#include <vector>
+
+namespace mir { namespace test {
+
+/**
+ * Replays an input recording (made with --input-record) through fake input devices of the in-process server.
+ *
+ * Each event is stamped with the time it is emitted, so latencies measured from the event time start here.
+ * The fake devices cannot express everything a recording may hold: absolute pointer positions are not replayed, and
+ * each touch contact is emitted as a touch event of its own.
+ */
+class InputReplay
+{
+public:
+    enum class Pace
+    {
+        recorded,   ///< Keep the gaps between events that the recording has
+        flat_out    ///< Emit everything as fast as possible
+    };
+
+    explicit InputReplay(std::vector<mir::input::RecordedInput> recording);
+    ~InputReplay();
+
+    /// Emits the whole recording, returning the number of input events emitted. The server handles them
+    /// asynchronously, so the replay must outlive that.
+    auto run(Pace pace) -> long;
+
+private:
+    std::vector<mir::input::RecordedInput> const recording;
+
+    struct Devices;
+    std::unique_ptr<Devices> const devices;
+};
+
+} } // namespace mir::test
+
+#endif // MIR_TEST_INPUT_REPLAY_H_
@@ -0,0 +1,157 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/geometry/region.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace geom = mir::geometry;
+
+namespace
+{
+struct RegionPerformance : ::testing::Test
+{
+    /// Scattered, overlapping window-sized rectangles, the same every run
+    auto windows(int count) -> std::vector<geom::Rectangle>
+    {
+        std::mt19937 generator{42};
+        std::uniform_int_distribution<int> position{0, 3000};
+        std::uniform_int_distribution<int> extent{50, 800};
+
+        std::vector<geom::Rectangle> result;
+        for (auto i = 0; i != count; ++i)
+        {
+            result.push_back({{position(generator), position(generator)}, {extent(generator), extent(generator)}});
+        }
+        return result;
+    }
+
+    /// Runs op repeatedly and records the mean time it took
+    template<typename Op>
+    void measure(std::string const& name, int iterations, Op op)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        for (auto i = 0; i != iterations; ++i)
+        {
+            op(i);
+        }
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+
+        auto const ns_per_op = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / iterations;
+        std::cout << name << ": " << ns_per_op << " ns/op" << std::endl;
+        RecordProperty(name, std::to_string(ns_per_op));
+    }
+
+    // Prevents the optimiser discarding work whose result is otherwise unused
+    long sink{0};
+};
+}
+
+TEST_F(RegionPerformance, build_from_rectangles)
+{
+    for (auto const count : {8, 64, 512})
+    {
+        auto const rects = windows(count);
+        measure("build_" + std::to_string(count), 20000 / count + 1, [&](int)
+            {
+                sink += geom::Region{rects}.size();
+            });
+    }
+    EXPECT_GT(sink, 0);
+}
+
+TEST_F(RegionPerformance, union_intersect_and_subtract)
+{
+    geom::Region const a{windows(64)};
+    auto b_rects = windows(128);
+    b_rects.erase(b_rects.begin(), b_rects.begin() + 64);
+    geom::Region const b{b_rects};
+
+    measure("union_64x64", 2000, [&](int)
+        {
+            auto result = a;
+            result.add(b);
+            sink += result.size();
+        });
+    measure("intersect_64x64", 2000, [&](int)
+        {
+            auto result = a;
+            result.intersect(b);
+            sink += result.size();
+        });
+    measure("subtract_64x64", 2000, [&](int)
+        {
+            auto result = a;
+            result.subtract(b);
+            sink += result.size();
+        });
+    EXPECT_GT(sink, 0);
+}
+
+TEST_F(RegionPerformance, contains_point)
+{
+    auto const rects = windows(512);
+    geom::Region const region{rects};
+
+    std::mt19937 generator{7};
+    std::uniform_int_distribution<int> coordinate{0, 4000};
+    std::vector<geom::Point> points;
+    for (auto i = 0; i != 4096; ++i)
+    {
+        points.push_back({coordinate(generator), coordinate(generator)});
+    }
+
+    measure("contains_point_region_512", 1000000, [&](int i)
+        {
+            sink += region.contains(points[i % points.size()]);
+        });
+    // What checking each rectangle in turn, as a plain list of rectangles requires, costs in comparison
+    measure("contains_point_linear_512", 1000000, [&](int i)
+        {
+            auto const& point = points[i % points.size()];
+            for (auto const& rect : rects)
+            {
+                if (rect.contains(point))
+                {
+                    ++sink;
+                    break;
+                }
+            }
+        });
+    EXPECT_GT(sink, 0);
+}
+
+TEST_F(RegionPerformance, occlusion_style_coverage)
+{
+    auto const rects = windows(64);
+
+    measure("coverage_of_64_windows", 200, [&](int)
+        {
+            geom::Region coverage;
+            for (auto const& rect : rects)
+            {
+                sink += coverage.contains(rect);
+                coverage.add(rect);
+            }
+        });
+    EXPECT_GT(sink, 0);
+}
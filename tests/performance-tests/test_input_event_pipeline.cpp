@@ -0,0 +1,389 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/input/composite_event_filter.h"
+#include "mir/input/event_filter.h"
+#include "mir/input/input_device_info.h"
+#include "mir/scene/surface.h"
+#include "mir/shell/focus_controller.h"
+#include "mir/server.h"
+#include "mir/fd.h"
+
+#include "mir_test_framework/headless_in_process_server.h"
+#include "mir_test_framework/fake_input_device.h"
+#include "mir_test_framework/stub_server_platform_factory.h"
+#include "mir/test/auto_unblock_thread.h"
+#include "mir/test/event_factory.h"
+#include "mir/test/signal.h"
+
+#include <gtest/gtest.h>
+
+#include <wayland-client.h>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+
+namespace mi = mir::input;
+namespace mis = mir::input::synthesis;
+namespace mt = mir::test;
+namespace mtf = mir_test_framework;
+namespace geom = mir::geometry;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// Allocations are only counted on the threads the events pass through (see PipelineThreads), so that the test
+// harness, the fake devices and the client do not contribute
+thread_local bool counting_allocations{false};
+std::atomic<long> pipeline_allocations{0};
+
+auto allocate(std::size_t size, std::size_t alignment = 0) noexcept -> void*
+{
+    if (counting_allocations)
+        pipeline_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (size == 0)
+        size = 1;
+
+    if (alignment > alignof(std::max_align_t))
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+
+    return std::malloc(size);
+}
+
+auto allocate_or_throw(std::size_t size, std::size_t alignment = 0) -> void*
+{
+    if (auto const block = allocate(size, alignment))
+        return block;
+    throw std::bad_alloc{};
+}
+}
+
+// Every form of the global allocation functions is replaced, so none of them bypasses the count
+void* operator new(std::size_t size) { return allocate_or_throw(size); }
+void* operator new[](std::size_t size) { return allocate_or_throw(size); }
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void* operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::size_t) noexcept { std::free(block); }
+void operator delete(void* block, std::nothrow_t const&) noexcept { std::free(block); }
+void operator delete[](void* block, std::nothrow_t const&) noexcept { std::free(block); }
+void operator delete(void* block, std::align_val_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept { std::free(block); }
+void operator delete(void* block, std::align_val_t, std::nothrow_t const&) noexcept { std::free(block); }
+void operator delete[](void* block, std::align_val_t, std::nothrow_t const&) noexcept { std::free(block); }
+
+namespace
+{
+/// Starts counting allocations on the input thread, which is where the event filters are run
+struct PipelineThreads : mi::EventFilter
+{
+    bool handle(MirEvent const&) override
+    {
+        counting_allocations = true;
+        return false;
+    }
+};
+
+/// A Wayland client with a surface under the pointer, counting the pointer motion it receives
+class PointerClient
+{
+public:
+    explicit PointerClient(mir::Fd const& socket)
+        : display{wl_display_connect_to_fd(dup(socket))},
+          stop_fd{eventfd(0, EFD_CLOEXEC)}
+    {
+        if (!display)
+            throw std::runtime_error{"Failed to connect to the Wayland server"};
+
+        registry = wl_display_get_registry(display);
+        wl_registry_add_listener(registry, &registry_listener, this);
+        wl_display_roundtrip(display);
+        if (!compositor || !shm || !shell || !seat)
+            throw std::runtime_error{"Missing Wayland globals"};
+
+        wl_seat_add_listener(seat, &seat_listener, this);
+        wl_display_roundtrip(display);
+        if (!pointer)
+            throw std::runtime_error{"Seat has no pointer"};
+
+        surface = wl_compositor_create_surface(compositor);
+        shell_surface = wl_shell_get_shell_surface(shell, surface);
+        wl_shell_surface_add_listener(shell_surface, &shell_surface_listener, this);
+        wl_shell_surface_set_toplevel(shell_surface);
+
+        auto const stride = width * 4;
+        auto const size = stride * height;
+        mir::Fd const pixels{memfd_create("pointer-client", MFD_CLOEXEC)};
+        if (pixels < 0 || ftruncate(pixels, size) < 0)
+            throw std::runtime_error{"Failed to create a buffer"};
+        auto const pool = wl_shm_create_pool(shm, pixels, size);
+        buffer = wl_shm_pool_create_buffer(pool, 0, width, height, stride, WL_SHM_FORMAT_ARGB8888);
+        wl_shm_pool_destroy(pool);
+
+        wl_surface_attach(surface, buffer, 0, 0);
+        wl_surface_commit(surface);
+        wl_display_roundtrip(display);
+
+        dispatch_thread = mt::AutoUnblockThread{
+            [this] { eventfd_write(stop_fd, 1); },
+            [this] { dispatch_until_stopped(); }};
+    }
+
+    ~PointerClient()
+    {
+        dispatch_thread.stop();
+        wl_buffer_destroy(buffer);
+        wl_shell_surface_destroy(shell_surface);
+        wl_surface_destroy(surface);
+        wl_pointer_destroy(pointer);
+        wl_seat_destroy(seat);
+        wl_shell_destroy(shell);
+        wl_shm_destroy(shm);
+        wl_compositor_destroy(compositor);
+        wl_registry_destroy(registry);
+        wl_display_disconnect(display);
+    }
+
+    void expect(long count)
+    {
+        received = 0;
+        expected = count;
+        all_received.reset();
+    }
+
+    static int constexpr width{64};
+    static int constexpr height{64};
+
+    mt::Signal entered;
+    std::atomic<long> received{0};
+    std::atomic<long> expected{-1};
+    mt::Signal all_received;
+
+private:
+    void dispatch_until_stopped()
+    {
+        pollfd fds[]{{wl_display_get_fd(display), POLLIN, 0}, {stop_fd, POLLIN, 0}};
+        for (;;)
+        {
+            while (wl_display_prepare_read(display) != 0)
+                wl_display_dispatch_pending(display);
+            wl_display_flush(display);
+
+            if (poll(fds, 2, -1) < 0 || fds[1].revents)
+            {
+                wl_display_cancel_read(display);
+                return;
+            }
+
+            if (fds[0].revents & POLLIN)
+            {
+                wl_display_read_events(display);
+                wl_display_dispatch_pending(display);
+            }
+            else
+            {
+                wl_display_cancel_read(display);
+            }
+        }
+    }
+
+    static void global(void* data, wl_registry* registry, uint32_t id, char const* interface, uint32_t)
+    {
+        auto const self = static_cast<PointerClient*>(data);
+        if (strcmp(interface, wl_compositor_interface.name) == 0)
+            self->compositor = static_cast<wl_compositor*>(wl_registry_bind(registry, id, &wl_compositor_interface, 1));
+        else if (strcmp(interface, wl_shm_interface.name) == 0)
+            self->shm = static_cast<wl_shm*>(wl_registry_bind(registry, id, &wl_shm_interface, 1));
+        else if (strcmp(interface, wl_shell_interface.name) == 0)
+            self->shell = static_cast<wl_shell*>(wl_registry_bind(registry, id, &wl_shell_interface, 1));
+        else if (strcmp(interface, wl_seat_interface.name) == 0)
+            self->seat = static_cast<wl_seat*>(wl_registry_bind(registry, id, &wl_seat_interface, 5));
+    }
+
+    static void global_remove(void*, wl_registry*, uint32_t) {}
+
+    static void capabilities(void* data, wl_seat* seat, uint32_t capabilities)
+    {
+        auto const self = static_cast<PointerClient*>(data);
+        if ((capabilities & WL_SEAT_CAPABILITY_POINTER) && !self->pointer)
+        {
+            self->pointer = wl_seat_get_pointer(seat);
+            wl_pointer_add_listener(self->pointer, &pointer_listener, self);
+        }
+    }
+
+    static void name(void*, wl_seat*, char const*) {}
+
+    static void ping(void*, wl_shell_surface* shell_surface, uint32_t serial)
+    {
+        wl_shell_surface_pong(shell_surface, serial);
+    }
+
+    static void configure(void*, wl_shell_surface*, uint32_t, int32_t, int32_t) {}
+    static void popup_done(void*, wl_shell_surface*) {}
+
+    static void enter(void* data, wl_pointer*, uint32_t, wl_surface*, wl_fixed_t, wl_fixed_t)
+    {
+        static_cast<PointerClient*>(data)->entered.raise();
+    }
+
+    static void motion(void* data, wl_pointer*, uint32_t, wl_fixed_t, wl_fixed_t)
+    {
+        auto const self = static_cast<PointerClient*>(data);
+        if (++self->received == self->expected)
+            self->all_received.raise();
+    }
+
+    static void leave(void*, wl_pointer*, uint32_t, wl_surface*) {}
+    static void button(void*, wl_pointer*, uint32_t, uint32_t, uint32_t, uint32_t) {}
+    static void axis(void*, wl_pointer*, uint32_t, uint32_t, wl_fixed_t) {}
+    static void frame(void*, wl_pointer*) {}
+    static void axis_source(void*, wl_pointer*, uint32_t) {}
+    static void axis_stop(void*, wl_pointer*, uint32_t, uint32_t) {}
+    static void axis_discrete(void*, wl_pointer*, uint32_t, int32_t) {}
+
+    static wl_registry_listener constexpr registry_listener{&global, &global_remove};
+    static wl_seat_listener constexpr seat_listener{&capabilities, &name};
+    static wl_shell_surface_listener constexpr shell_surface_listener{&ping, &configure, &popup_done};
+// If building against newer Wayland protocol definitions we may miss trailing fields
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+    static wl_pointer_listener constexpr pointer_listener{
+        &enter, &leave, &motion, &button, &axis, &frame, &axis_source, &axis_stop, &axis_discrete};
+#pragma GCC diagnostic pop
+
+    wl_display* const display;
+    mir::Fd const stop_fd;
+    wl_registry* registry{nullptr};
+    wl_compositor* compositor{nullptr};
+    wl_shm* shm{nullptr};
+    wl_shell* shell{nullptr};
+    wl_seat* seat{nullptr};
+    wl_pointer* pointer{nullptr};
+    wl_surface* surface{nullptr};
+    wl_shell_surface* shell_surface{nullptr};
+    wl_buffer* buffer{nullptr};
+    mt::AutoUnblockThread dispatch_thread;
+};
+
+struct InputEventPipelinePerformance : mtf::HeadlessInProcessServer
+{
+    void SetUp() override
+    {
+        start_server();
+        server.the_composite_event_filter()->prepend(pipeline_threads);
+        server.run_on_wayland_display([](auto) { counting_allocations = true; });
+
+        client = std::make_unique<PointerClient>(server.open_wayland_client_socket());
+
+        // The pointer starts at the origin, so put the client's surface there and move onto it
+        std::shared_ptr<mir::scene::Surface> surface;
+        for (auto const timeout = std::chrono::steady_clock::now() + 10s;
+             !(surface = server.the_focus_controller()->focused_surface()) && std::chrono::steady_clock::now() < timeout;)
+        {
+            std::this_thread::sleep_for(10ms);
+        }
+        ASSERT_TRUE(surface);
+        surface->move_to(geom::Point{0, 0});
+
+        fake_pointer->emit_event(mis::a_pointer_event().with_movement(1, 1));
+        ASSERT_TRUE(client->entered.wait_for(10s));
+    }
+
+    void TearDown() override
+    {
+        client.reset();
+        mtf::HeadlessInProcessServer::TearDown();
+    }
+
+    /// Emits count pointer motions, returning the time and allocations each took to reach the client
+    auto measure(std::string const& name, long count) -> double
+    {
+        client->expect(count);
+        auto const allocations_before = pipeline_allocations.load();
+        auto const start = std::chrono::steady_clock::now();
+
+        // Back and forth, so the pointer stays over the surface
+        for (auto i = 0; i != count; ++i)
+        {
+            auto const step = i % 2 ? 1 : -1;
+            fake_pointer->emit_event(mis::a_pointer_event().with_movement(step, step));
+        }
+        EXPECT_TRUE(client->all_received.wait_for(30s));
+
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+        auto const ns_per_event = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / count;
+        auto const allocations_per_event = double(pipeline_allocations.load() - allocations_before) / count;
+
+        std::cout << name << ": " << ns_per_event << " ns/event, "
+                  << allocations_per_event << " allocations/event" << std::endl;
+        RecordProperty(name + "_ns_per_event", std::to_string(ns_per_event));
+        RecordProperty(name + "_allocations_per_event", std::to_string(allocations_per_event));
+
+        return allocations_per_event;
+    }
+
+    std::shared_ptr<PipelineThreads> const pipeline_threads{std::make_shared<PipelineThreads>()};
+    std::unique_ptr<mtf::FakeInputDevice> fake_pointer{
+        mtf::add_fake_input_device(mi::InputDeviceInfo{"mouse", "mouse-uid", mi::DeviceCapability::pointer})};
+    std::unique_ptr<PointerClient> client;
+};
+}
+
+TEST_F(InputEventPipelinePerformance, pointer_motion)
+{
+    // The events themselves come from the event pool. What is left is the std::function that Executor::spawn()
+    // needs to carry each event to the Wayland thread, and the occasional growth of the queues along the way.
+    auto const max_steady_state_allocations_per_event = 2.0;
+
+    // The first burst fills the event pool, the second shows the steady state
+    measure("pointer_motion_warm_up", 1000);
+    EXPECT_LE(measure("pointer_motion", 10000), max_steady_state_allocations_per_event);
+}
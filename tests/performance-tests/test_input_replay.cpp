@@ -0,0 +1,226 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_replay.h"
+
+#include "mir/input/composite_event_filter.h"
+#include "mir/input/device_capability.h"
+#include "mir/input/event_filter.h"
+#include "mir/input/input_latency_report.h"
+#include "mir/input/input_recording.h"
+#include "mir/events/event_builders.h"
+#include "mir/events/input_event.h"
+#include "mir/events/event_private.h"
+#include "mir/server.h"
+
+#include "mir_test_framework/headless_in_process_server.h"
+#include "mir/test/signal.h"
+
+#include <gtest/gtest.h>
+
+#include <linux/input.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mi = mir::input;
+namespace mev = mir::events;
+namespace mt = mir::test;
+namespace mtf = mir_test_framework;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+auto now() -> std::chrono::nanoseconds
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+}
+
+/// Latencies from emission to each stage of the pipeline the events pass through
+struct StageLatencies : mi::InputLatencyReport, mi::EventFilter
+{
+    struct Stage
+    {
+        std::mutex mutex;
+        std::vector<std::chrono::nanoseconds> latencies;
+
+        void add(std::chrono::nanoseconds event_time)
+        {
+            auto const latency = now() - event_time;
+            std::lock_guard lock{mutex};
+            latencies.push_back(latency);
+        }
+    };
+
+    // Through the input thread to the seat
+    void received_event(std::chrono::nanoseconds event_time) override
+    {
+        seat.add(event_time);
+    }
+
+    // Through SurfaceInputDispatcher, which runs last in the dispatch chain
+    void dispatched_event(std::chrono::nanoseconds event_time) override
+    {
+        surface_input_dispatcher.add(event_time);
+        if (++dispatched == expected)
+            all_dispatched.raise();
+    }
+
+    // Through the Wayland senders to a client, if there is one
+    void sent_event(std::chrono::nanoseconds event_time) override
+    {
+        wayland_senders.add(event_time);
+    }
+
+    void committed_after_event(std::chrono::nanoseconds) override {}
+    void presented_after_event(std::chrono::nanoseconds, std::chrono::nanoseconds) override {}
+
+    // Through KeyRepeatDispatcher (and the rest of the dispatchers ahead of the event filters)
+    bool handle(MirEvent const& event) override
+    {
+        if (event.type() == mir_event_type_input)
+            key_repeat_dispatcher.add(event.to_input()->event_time());
+        return false;
+    }
+
+    Stage seat;
+    Stage key_repeat_dispatcher;
+    Stage surface_input_dispatcher;
+    Stage wayland_senders;
+
+    std::atomic<long> dispatched{0};
+    std::atomic<long> expected{-1};
+    mt::Signal all_dispatched;
+};
+
+/// A keyboard typing and a mouse moving at 1kHz, scrolling and clicking now and then
+auto synthetic_session(std::string const& path) -> std::vector<mi::RecordedInput>
+{
+    MirInputDeviceId const keyboard{1};
+    MirInputDeviceId const mouse{2};
+    {
+        mi::InputRecordingWriter writer{path};
+        writer.device_added(keyboard, "replayed-keyboard", "replayed-keyboard-uid",
+            mi::DeviceCapabilities{mi::DeviceCapability::keyboard | mi::DeviceCapability::alpha_numeric}.value());
+        writer.device_added(mouse, "replayed-mouse", "replayed-mouse-uid",
+            mi::DeviceCapabilities{mi::DeviceCapability::pointer}.value());
+
+        auto const start = now();
+        for (auto ms = 0; ms != 2000; ++ms)
+        {
+            auto const time = start + std::chrono::milliseconds{ms};
+            auto const button = (ms / 250) % 2 ? mir_pointer_button_primary : 0;
+            writer.record(*mev::make_pointer_event(
+                mouse, time, {}, mir_input_event_modifier_none, mir_pointer_action_motion, button,
+                0.0f, 0.0f, 0.0f, ms % 100 ? 0.0f : 1.0f, 1.5f, -0.5f));
+
+            if (ms % 50 == 0)
+            {
+                auto const action = (ms / 50) % 2 ? mir_keyboard_action_up : mir_keyboard_action_down;
+                writer.record(*mev::make_key_event(
+                    keyboard, time, {}, action, 0, KEY_A + (ms / 100) % 20, mir_input_event_modifier_none));
+            }
+        }
+    }
+
+    auto recording = mi::read_input_recording(path);
+    unlink(path.c_str());
+    return recording;
+}
+
+struct InputReplayPerformance : mtf::HeadlessInProcessServer
+{
+    void SetUp() override
+    {
+        server.override_the_input_latency_report([this] { return stages; });
+        start_server();
+        server.the_composite_event_filter()->prepend(stages);
+    }
+
+    /// The recording named by MIR_INPUT_RECORDING, or a synthetic one
+    auto recording() -> std::vector<mi::RecordedInput>
+    {
+        if (auto const path = getenv("MIR_INPUT_RECORDING"))
+            return mi::read_input_recording(path);
+
+        return synthetic_session("/tmp/mir-input-replay-" + std::to_string(getpid()));
+    }
+
+    void report(std::string const& name, StageLatencies::Stage& stage)
+    {
+        std::lock_guard lock{stage.mutex};
+        auto& latencies = stage.latencies;
+        if (latencies.empty())
+        {
+            std::cout << name << ": no events" << std::endl;
+            return;
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        auto const percentile = [&](int p)
+            {
+                auto const latency = latencies[(latencies.size() - 1) * p / 100];
+                return std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+            };
+
+        std::cout << name << ": " << latencies.size() << " events, latency p50 " << percentile(50)
+                  << "us, p99 " << percentile(99) << "us, max " << percentile(100) << "us" << std::endl;
+        RecordProperty(name + "_p50_us", std::to_string(percentile(50)));
+        RecordProperty(name + "_p99_us", std::to_string(percentile(99)));
+    }
+
+    void replay(std::string const& name, mt::InputReplay::Pace pace)
+    {
+        mt::InputReplay replay{recording()};
+
+        auto const start = std::chrono::steady_clock::now();
+        stages->expected = replay.run(pace);
+        if (stages->dispatched >= stages->expected)
+            stages->all_dispatched.raise();
+        EXPECT_TRUE(stages->all_dispatched.wait_for(30s));
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+
+        auto const events_per_second = stages->dispatched * 1.0e9 /
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        std::cout << name << ": " << stages->dispatched << " events, " << events_per_second << " events/s" << std::endl;
+        RecordProperty(name + "_events_per_second", std::to_string(events_per_second));
+
+        report(name + "_seat", stages->seat);
+        report(name + "_key_repeat_dispatcher", stages->key_repeat_dispatcher);
+        report(name + "_surface_input_dispatcher", stages->surface_input_dispatcher);
+        report(name + "_wayland_senders", stages->wayland_senders);
+    }
+
+    std::shared_ptr<StageLatencies> const stages{std::make_shared<StageLatencies>()};
+};
+}
+
+TEST_F(InputReplayPerformance, flat_out)
+{
+    replay("flat_out", mt::InputReplay::Pace::flat_out);
+}
+
+TEST_F(InputReplayPerformance, recorded_pace)
+{
+    replay("recorded_pace", mt::InputReplay::Pace::recorded);
+}
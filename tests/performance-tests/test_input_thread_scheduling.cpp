@@ -0,0 +1,168 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/input/input_dispatcher.h"
+#include "mir/input/input_device_info.h"
+#include "mir/options/configuration.h"
+#include "mir/events/event.h"
+#include "mir/events/input_event.h"
+#include "mir/server.h"
+
+#include "mir_test_framework/headless_in_process_server.h"
+#include "mir_test_framework/fake_input_device.h"
+#include "mir_test_framework/stub_server_platform_factory.h"
+#include "mir/test/event_factory.h"
+#include "mir/test/signal.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mi = mir::input;
+namespace mis = mir::input::synthesis;
+namespace mo = mir::options;
+namespace mt = mir::test;
+namespace mtf = mir_test_framework;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+/// Records how long each event took from being stamped by the input device to reaching the dispatcher
+struct LatencyRecordingInputDispatcher : mi::InputDispatcher
+{
+    bool dispatch(std::shared_ptr<MirEvent const> const& event) override
+    {
+        if (event->type() != mir_event_type_input)
+            return true;
+
+        auto const event_time = event->to_input()->event_time();
+        auto const now = std::chrono::steady_clock::now().time_since_epoch();
+
+        std::lock_guard lock{mutex};
+        latencies.push_back(now - event_time);
+        if (static_cast<long>(latencies.size()) == expected)
+            all_received.raise();
+        return true;
+    }
+
+    void start() override {}
+    void stop() override {}
+
+    std::mutex mutex;
+    std::vector<std::chrono::nanoseconds> latencies;
+    long expected{0};
+    mt::Signal all_received;
+};
+
+/// Keeps every CPU busy at normal priority while it exists
+class CpuLoad
+{
+public:
+    CpuLoad()
+    {
+        for (auto i = 0u; i != 2 * std::max(1u, std::thread::hardware_concurrency()); ++i)
+        {
+            threads.emplace_back([this]
+                {
+                    while (!stopping)
+                        sink.fetch_add(1, std::memory_order_relaxed);
+                });
+        }
+    }
+
+    ~CpuLoad()
+    {
+        stopping = true;
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+private:
+    std::atomic<bool> stopping{false};
+    std::atomic<long> sink{0};
+    std::vector<std::thread> threads;
+};
+
+/// The parameter is the real-time priority of the input thread, 0 being normal scheduling
+struct InputThreadSchedulingPerformance : mtf::HeadlessInProcessServer, ::testing::WithParamInterface<int>
+{
+    void SetUp() override
+    {
+        // As miral::RealtimeScheduling would
+        server.add_configuration_option(mo::input_thread_priority_opt, "", 0);
+        server.add_configuration_option(mo::realtime_policy_opt, "", "fifo");
+        server.add_configuration_option(mo::input_thread_cpus_opt, "", mir::OptionType::string);
+        add_to_environment("MIR_SERVER_INPUT_THREAD_PRIORITY", std::to_string(GetParam()).c_str());
+
+        server.override_the_input_dispatcher([this] { return dispatcher; });
+        start_server();
+    }
+
+    std::shared_ptr<LatencyRecordingInputDispatcher> const dispatcher{
+        std::make_shared<LatencyRecordingInputDispatcher>()};
+    std::unique_ptr<mtf::FakeInputDevice> fake_pointer{
+        mtf::add_fake_input_device(mi::InputDeviceInfo{"mouse", "mouse-uid", mi::DeviceCapability::pointer})};
+};
+
+auto as_ms(std::chrono::nanoseconds duration) -> double
+{
+    return std::chrono::duration<double, std::milli>{duration}.count();
+}
+}
+
+TEST_P(InputThreadSchedulingPerformance, dispatch_latency_under_cpu_load)
+{
+    long const count{2000};
+    dispatcher->expected = count;
+
+    {
+        CpuLoad const load;
+
+        // Paced like a 1000Hz mouse, so that what is measured is scheduling rather than queueing
+        for (auto i = 0; i != count; ++i)
+        {
+            fake_pointer->emit_event(mis::a_pointer_event().with_movement(1, 1));
+            std::this_thread::sleep_for(1ms);
+        }
+        ASSERT_TRUE(dispatcher->all_received.wait_for(60s));
+    }
+
+    std::lock_guard lock{dispatcher->mutex};
+    auto& latencies = dispatcher->latencies;
+    std::sort(latencies.begin(), latencies.end());
+    auto const p50 = latencies[latencies.size() / 2];
+    auto const p99 = latencies[latencies.size() * 99 / 100];
+
+    auto const name = "input_priority_" + std::to_string(GetParam());
+    std::cout << name << ": 50% under " << as_ms(p50) << " ms, 99% under " << as_ms(p99) << " ms, max "
+              << as_ms(latencies.back()) << " ms" << std::endl;
+    RecordProperty(name + "_p50_ns", std::to_string(p50.count()));
+    RecordProperty(name + "_p99_ns", std::to_string(p99.count()));
+}
+
+// Without CAP_SYS_NICE (or a sufficient RLIMIT_RTPRIO) the priority is not granted and both runs use normal scheduling
+INSTANTIATE_TEST_SUITE_P(
+    InputThreadScheduling,
+    InputThreadSchedulingPerformance,
+    ::testing::Values(0, 50));
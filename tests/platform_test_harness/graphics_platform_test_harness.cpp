@@ -441,6 +441,11 @@ void basic_software_buffer_drawing(
             return buffer_;
         }
 
+        auto src_bounds() const -> mir::geometry::RectangleD override
+        {
+            return {{0, 0}, mir::geometry::SizeD{buffer()->size()}};
+        }
+
         auto screen_position() const -> mir::geometry::Rectangle override
         {
             return mir::geometry::Rectangle{top_left, buffer()->size()};
@@ -461,6 +466,11 @@ void basic_software_buffer_drawing(
             return mg::contains_alpha(buffer_->pixel_format());
         }
 
+        std::vector<mir::geometry::Rectangle> opaque_region() const override
+        {
+            return {};
+        }
+
         auto clip_area() const -> std::optional<mir::geometry::Rectangle> override
         {
             return std::optional<mir::geometry::Rectangle>{};
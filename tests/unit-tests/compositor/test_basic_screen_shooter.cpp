@@ -25,6 +25,8 @@
 #include "mir/test/doubles/stub_buffer.h"
 #include "mir/test/doubles/stub_scene_element.h"
 #include "mir/test/doubles/stub_renderable.h"
+#include "mir/test/doubles/mock_compositor_report.h"
+#include "mir/scene/observer.h"
 
 #include <gtest/gtest.h>
 
@@ -47,6 +49,9 @@ class MockBufferRenderTarget: public mrg::BufferRenderTarget
 {
 public:
     MOCK_METHOD(void, set_buffer, (std::shared_ptr<mrs::WriteMappableBuffer> const& buffer), (override));
+    MOCK_METHOD(void, set_buffer_region,
+        (std::shared_ptr<mrs::WriteMappableBuffer> const& buffer, geom::Rectangle const& region), (override));
+    MOCK_METHOD(void, set_gpu_buffer, (std::shared_ptr<mg::Buffer> const& buffer), (override));
     MOCK_METHOD(geom::Size, size, (), (const, override));
     MOCK_METHOD(void, make_current, (), (override));
     MOCK_METHOD(void, release_current, (), (override));
@@ -62,6 +67,13 @@ struct BasicScreenShooter : Test
     }
 
     NiceMock<mtd::MockScene> scene;
+    std::shared_ptr<mir::scene::Observer> scene_observer;
+    bool const scene_observer_saved{[this]()
+        {
+            ON_CALL(scene, add_observer(_)).WillByDefault(SaveArg<0>(&scene_observer));
+            return true;
+        }()};
+    NiceMock<mtd::MockCompositorReport> report;
     mg::RenderableList renderables{[]()
         {
             mg::RenderableList renderables;
@@ -87,6 +99,7 @@ struct BasicScreenShooter : Test
     mc::BasicScreenShooter shooter{
         mt::fake_shared(scene),
         mt::fake_shared(clock),
+        mt::fake_shared(report),
         executor,
         std::unique_ptr<mrg::BufferRenderTarget>{&render_target},
         std::unique_ptr<mr::Renderer>{&renderer}};
@@ -193,3 +206,104 @@ TEST_F(BasicScreenShooter, throw_in_render_causes_graceful_failure)
     EXPECT_CALL(callback, Call(nullopt_time));
     executor.execute();
 }
+
+TEST_F(BasicScreenShooter, capture_update_renders_only_stale_area)
+{
+    mtd::StubBuffer unscaled_buffer{viewport_rect.size};
+    geom::Rectangle const stale_area{{25, 40}, {10, 100}};
+    shooter.capture_update(mt::fake_shared(unscaled_buffer), viewport_rect, stale_area, [&](auto time)
+        {
+            callback.Call(time);
+        });
+    InSequence seq;
+    EXPECT_CALL(render_target, set_buffer_region(
+        Eq(mt::fake_shared(unscaled_buffer)),
+        Eq(geom::Rectangle{{5, 10}, {10, 40}})));
+    EXPECT_CALL(renderer, set_viewport(Eq(geom::Rectangle{{25, 40}, {10, 40}})));
+    EXPECT_CALL(renderer, render(_));
+    EXPECT_CALL(callback, Call(std::make_optional(clock.now())));
+    executor.execute();
+}
+
+TEST_F(BasicScreenShooter, capture_update_without_stale_area_does_not_render)
+{
+    mtd::StubBuffer unscaled_buffer{viewport_rect.size};
+    shooter.capture_update(mt::fake_shared(unscaled_buffer), viewport_rect, {}, [&](auto time)
+        {
+            callback.Call(time);
+        });
+    EXPECT_CALL(renderer, render(_)).Times(0);
+    EXPECT_CALL(callback, Call(std::make_optional(clock.now())));
+    executor.execute();
+}
+
+TEST_F(BasicScreenShooter, capture_update_of_scaled_buffer_renders_everything)
+{
+    mtd::StubBuffer scaled_buffer{viewport_rect.size * 2};
+    shooter.capture_update(mt::fake_shared(scaled_buffer), viewport_rect, {{25, 40}, {10, 10}}, [&](auto time)
+        {
+            callback.Call(time);
+        });
+    InSequence seq;
+    EXPECT_CALL(render_target, set_buffer(Eq(mt::fake_shared(scaled_buffer))));
+    EXPECT_CALL(renderer, set_viewport(Eq(viewport_rect)));
+    EXPECT_CALL(renderer, render(_));
+    EXPECT_CALL(callback, Call(std::make_optional(clock.now())));
+    executor.execute();
+}
+
+TEST_F(BasicScreenShooter, capture_gpu_buffer_renders_straight_into_buffer)
+{
+    auto const gpu_buffer = std::make_shared<mtd::StubBuffer>(viewport_rect.size);
+    shooter.capture_gpu_buffer(gpu_buffer, viewport_rect, [&](auto time)
+        {
+            callback.Call(time);
+        });
+    InSequence seq;
+    EXPECT_CALL(render_target, make_current());
+    EXPECT_CALL(render_target, set_gpu_buffer(Eq(gpu_buffer)));
+    EXPECT_CALL(render_target, bind());
+    EXPECT_CALL(renderer, render(_));
+    EXPECT_CALL(render_target, release_current());
+    EXPECT_CALL(callback, Call(std::make_optional(clock.now())));
+    executor.execute();
+}
+
+TEST_F(BasicScreenShooter, captures_of_unchanged_scene_share_a_render)
+{
+    mtd::StubBuffer other_buffer;
+    shooter.capture(mt::fake_shared(buffer), viewport_rect, [&](auto time)
+        {
+            callback.Call(time);
+        });
+    shooter.capture(mt::fake_shared(other_buffer), viewport_rect, [&](auto time)
+        {
+            callback.Call(time);
+        });
+    EXPECT_CALL(renderer, render(_)).Times(1);
+    EXPECT_CALL(render_target, set_buffer(_)).Times(AnyNumber());
+    EXPECT_CALL(render_target, set_buffer(Eq(mt::fake_shared(other_buffer))));
+    EXPECT_CALL(render_target, swap_buffers()).Times(2);
+    EXPECT_CALL(report, captured_area(Eq(viewport_rect), _, true));
+    EXPECT_CALL(report, captured_area(Eq(viewport_rect), _, false));
+    EXPECT_CALL(callback, Call(std::make_optional(clock.now()))).Times(2);
+    executor.execute();
+}
+
+TEST_F(BasicScreenShooter, scene_change_causes_capture_to_render_again)
+{
+    ASSERT_THAT(scene_observer, NotNull());
+    shooter.capture(mt::fake_shared(buffer), viewport_rect, [&](auto time)
+        {
+            callback.Call(time);
+        });
+    EXPECT_CALL(renderer, render(_)).Times(2);
+    EXPECT_CALL(callback, Call(_)).Times(2);
+    executor.execute();
+    scene_observer->scene_changed();
+    shooter.capture(mt::fake_shared(buffer), viewport_rect, [&](auto time)
+        {
+            callback.Call(time);
+        });
+    executor.execute();
+}
@@ -19,6 +19,7 @@
 #include "mir/compositor/scene.h"
 #include "mir/renderer/renderer.h"
 #include "mir/geometry/rectangle.h"
+#include "mir/graphics/frame.h"
 #include "mir/test/doubles/mock_renderer.h"
 #include "mir/test/fake_shared.h"
 #include "mir/test/doubles/mock_display_buffer.h"
@@ -63,6 +64,11 @@ struct StubSceneElement : mc::SceneElement
     {
     }
 
+    auto presentation_callback() const -> PresentationCallback override
+    {
+        return {};
+    }
+
 private:
     std::shared_ptr<mg::Renderable> const renderable_;
 };
@@ -332,6 +338,7 @@ struct MockSceneElement : mc::SceneElement
     MOCK_CONST_METHOD0(renderable, std::shared_ptr<mir::graphics::Renderable>());
     MOCK_METHOD0(rendered, void());
     MOCK_METHOD0(occluded, void());
+    MOCK_CONST_METHOD0(presentation_callback, PresentationCallback());
 };
 }
 
@@ -378,3 +385,59 @@ TEST_F(DefaultDisplayBufferCompositor, marks_occluded_scene_elements)
     compositor.composite({element0_occluded, element1_rendered, element2_occluded});
 }
 
+TEST_F(DefaultDisplayBufferCompositor, notifies_rendered_scene_elements_once_presented)
+{
+    using namespace testing;
+
+    auto element0_occluded = std::make_shared<NiceMock<MockSceneElement>>(
+        std::make_shared<mtd::FakeRenderable>(geom::Rectangle{{10000,10000},{20,20}}));
+    auto element1_rendered = std::make_shared<NiceMock<MockSceneElement>>(
+        std::make_shared<mtd::FakeRenderable>(geom::Rectangle{{0,0},{100,100}}));
+
+    std::vector<std::tuple<geom::Rectangle, int64_t, bool>> presentations;
+    ON_CALL(*element0_occluded, presentation_callback())
+        .WillByDefault(Return([&](auto const&, auto const&, bool) { FAIL() << "occluded element was presented"; }));
+    ON_CALL(*element1_rendered, presentation_callback())
+        .WillByDefault(Return([&](auto const& area, auto const& frame, bool zero_copy)
+            { presentations.emplace_back(area, frame.msc, zero_copy); }));
+
+    mc::DefaultDisplayBufferCompositor compositor(
+        display_buffer,
+        mt::fake_shared(mock_renderer),
+        mr::null_compositor_report());
+
+    compositor.composite({element0_occluded, element1_rendered});
+    EXPECT_THAT(presentations, IsEmpty());
+
+    mg::Frame frame;
+    frame.msc = 42;
+    compositor.frame_presented(frame);
+    EXPECT_THAT(presentations, ElementsAre(std::make_tuple(screen, 42, false)));
+
+    // Each composited frame is only presented once
+    compositor.frame_presented(frame);
+    EXPECT_THAT(presentations, SizeIs(1));
+}
+
+TEST_F(DefaultDisplayBufferCompositor, presentation_of_bypassed_frame_is_zero_copy)
+{
+    using namespace testing;
+
+    auto element = std::make_shared<NiceMock<MockSceneElement>>(fullscreen);
+
+    std::optional<bool> zero_copy;
+    ON_CALL(*element, presentation_callback())
+        .WillByDefault(Return([&](auto const&, auto const&, bool flag) { zero_copy = flag; }));
+    EXPECT_CALL(display_buffer, overlay(_))
+        .WillOnce(Return(true));
+
+    mc::DefaultDisplayBufferCompositor compositor(
+        display_buffer,
+        mt::fake_shared(mock_renderer),
+        mr::null_compositor_report());
+
+    compositor.composite({element});
+    compositor.frame_presented(mg::Frame{});
+
+    EXPECT_THAT(zero_copy, Eq(std::optional<bool>{true}));
+}
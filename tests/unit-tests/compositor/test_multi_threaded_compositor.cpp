@@ -25,6 +25,7 @@
 #include "mir/raii.h"
 
 #include "mir/test/current_thread_name.h"
+#include "mir/test/signal.h"
 #include "mir/test/doubles/null_display.h"
 #include "mir/test/doubles/null_display_buffer.h"
 #include "mir/test/doubles/mock_display_buffer.h"
@@ -166,6 +167,10 @@ public:
         std::this_thread::yield();
     }
 
+    void frame_presented(mg::Frame const&)
+    {
+    }
+
 private:
     std::function<void()> const mark_render_buffer;
 };
@@ -282,6 +287,10 @@ public:
         std::this_thread::yield();
     }
 
+    void frame_presented(mg::Frame const&) override
+    {
+    }
+
 private:
     std::function<void()> const fake_surface_update;
 };
@@ -344,6 +353,75 @@ public:
 
 namespace
 {
+/// Posts like clone mode: the frame is only known once it is waited for
+class DeferredFlipDisplay : public mtd::NullDisplay
+{
+public:
+    void for_each_display_sync_group(std::function<void(mg::DisplaySyncGroup&)> const& f) override
+    {
+        f(group);
+    }
+
+    struct DeferredFlipSyncGroup : mg::DisplaySyncGroup
+    {
+        void for_each_display_buffer(std::function<void(mg::DisplayBuffer&)> const& f) override
+        {
+            f(buffer);
+        }
+        void post() override {}
+        std::chrono::milliseconds recommended_sleep() const override
+        {
+            return std::chrono::milliseconds::zero();
+        }
+        mg::Frame wait_for_last_frame() override
+        {
+            ++waits;
+            return flip;
+        }
+        mtd::NullDisplayBuffer buffer;
+        std::atomic<int> waits{0};
+    } group;
+
+    static inline mg::Frame const flip{42, mg::Frame::Timestamp{CLOCK_MONOTONIC, std::chrono::nanoseconds{123456789}}};
+};
+
+class PresentationRecordingDisplayBufferCompositorFactory : public mc::DisplayBufferCompositorFactory
+{
+public:
+    PresentationRecordingDisplayBufferCompositorFactory(bool awaits_presentation)
+        : awaits_presentation{awaits_presentation}
+    {
+    }
+
+    std::unique_ptr<mc::DisplayBufferCompositor> create_compositor_for(mg::DisplayBuffer&) override
+    {
+        return std::make_unique<Compositor>(*this);
+    }
+
+    bool const awaits_presentation;
+    mg::Frame presented;
+    mt::Signal frame_presented;
+
+private:
+    struct Compositor : mc::DisplayBufferCompositor
+    {
+        Compositor(PresentationRecordingDisplayBufferCompositorFactory& factory) : factory{factory} {}
+
+        void composite(mc::SceneElementSequence&&) override {}
+        void frame_presented(mg::Frame const& frame) override
+        {
+            if (!factory.frame_presented.raised())
+            {
+                factory.presented = frame;
+                factory.frame_presented.raise();
+            }
+        }
+        auto awaits_presentation() const -> bool override { return factory.awaits_presentation; }
+
+        PresentationRecordingDisplayBufferCompositorFactory& factory;
+    };
+};
+
 struct StubDisplayListener : mc::DisplayListener
 {
     virtual void add_display(geom::Rectangle const& /*area*/) override {}
@@ -945,3 +1023,37 @@ TEST(MultiThreadedCompositor, can_schedule_from_display_observer_when_removing_d
         display, stub_scene, db_compositor_factory, mock_display_listener, mock_report, default_delay, true};
     compositor.start();
 }
+
+TEST(MultiThreadedCompositor, waits_for_a_deferred_flip_when_presentation_is_awaited)
+{
+    using namespace testing;
+
+    auto display = std::make_shared<DeferredFlipDisplay>();
+    auto scene = std::make_shared<StubScene>();
+    auto factory = std::make_shared<PresentationRecordingDisplayBufferCompositorFactory>(true);
+    mc::MultiThreadedCompositor compositor{display, scene, factory, null_display_listener, null_report, default_delay, true};
+
+    compositor.start();
+    ASSERT_TRUE(factory->frame_presented.wait_for(10s));
+    compositor.stop();
+
+    EXPECT_THAT(display->group.waits.load(), Ge(1));
+    EXPECT_THAT(factory->presented.msc, Eq(DeferredFlipDisplay::flip.msc));
+}
+
+TEST(MultiThreadedCompositor, leaves_a_deferred_flip_when_presentation_is_not_awaited)
+{
+    using namespace testing;
+
+    auto display = std::make_shared<DeferredFlipDisplay>();
+    auto scene = std::make_shared<StubScene>();
+    auto factory = std::make_shared<PresentationRecordingDisplayBufferCompositorFactory>(false);
+    mc::MultiThreadedCompositor compositor{display, scene, factory, null_display_listener, null_report, default_delay, true};
+
+    compositor.start();
+    ASSERT_TRUE(factory->frame_presented.wait_for(10s));
+    compositor.stop();
+
+    EXPECT_THAT(display->group.waits.load(), Eq(0));
+    EXPECT_THAT(factory->presented.msc, Eq(0));
+}
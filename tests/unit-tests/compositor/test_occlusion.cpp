@@ -123,6 +123,45 @@ TEST_F(OcclusionFilterTest, shaped_window_occludes_nothing)
     EXPECT_THAT(renderables_from(elements), ElementsAre(bottom, top));
 }
 
+TEST_F(OcclusionFilterTest, opaque_region_of_shaped_window_occludes)
+{
+    auto top = std::make_shared<mtd::FakeRenderable>(Rectangle{{0, 0}, {30, 30}}, 1.0f, false);
+    top->set_opaque_region({{{10, 10}, {10, 10}}});
+    auto bottom = std::make_shared<mtd::FakeRenderable>(12, 12, 5, 5);
+    auto elements = scene_elements_from({bottom, top});
+
+    auto const& occlusions = filter_occlusions_from(elements, monitor_rect);
+
+    EXPECT_THAT(renderables_from(occlusions), ElementsAre(bottom));
+    EXPECT_THAT(renderables_from(elements), ElementsAre(top));
+}
+
+TEST_F(OcclusionFilterTest, opaque_region_of_translucent_window_occludes_nothing)
+{
+    auto top = std::make_shared<mtd::FakeRenderable>(Rectangle{{0, 0}, {30, 30}}, 0.5f, false);
+    top->set_opaque_region({{{0, 0}, {30, 30}}});
+    auto bottom = std::make_shared<mtd::FakeRenderable>(12, 12, 5, 5);
+    auto elements = scene_elements_from({bottom, top});
+
+    auto const& occlusions = filter_occlusions_from(elements, monitor_rect);
+
+    EXPECT_THAT(renderables_from(occlusions), IsEmpty());
+    EXPECT_THAT(renderables_from(elements), ElementsAre(bottom, top));
+}
+
+TEST_F(OcclusionFilterTest, window_outside_opaque_region_not_occluded)
+{
+    auto top = std::make_shared<mtd::FakeRenderable>(Rectangle{{0, 0}, {30, 30}}, 1.0f, false);
+    top->set_opaque_region({{{10, 10}, {10, 10}}});
+    auto bottom = std::make_shared<mtd::FakeRenderable>(5, 5, 10, 10);
+    auto elements = scene_elements_from({bottom, top});
+
+    auto const& occlusions = filter_occlusions_from(elements, monitor_rect);
+
+    EXPECT_THAT(renderables_from(occlusions), IsEmpty());
+    EXPECT_THAT(renderables_from(elements), ElementsAre(bottom, top));
+}
+
 TEST_F(OcclusionFilterTest, identical_window_occluded)
 {
     auto top = std::make_shared<mtd::FakeRenderable>(10, 10, 10, 10);
@@ -200,3 +239,16 @@ TEST_F(OcclusionFilterTest,
     EXPECT_THAT(renderables_from(occlusions), ElementsAre(partially_onscreen));
     EXPECT_THAT(renderables_from(elements), ElementsAre(covering));
 }
+
+TEST_F(OcclusionFilterTest, window_covered_by_several_windows_together_is_occluded)
+{
+    auto const left = std::make_shared<mtd::FakeRenderable>(0, 0, 50, 100);
+    auto const right = std::make_shared<mtd::FakeRenderable>(50, 0, 50, 100);
+    auto const bottom = std::make_shared<mtd::FakeRenderable>(20, 20, 60, 60);
+    auto elements = scene_elements_from({bottom, left, right});
+
+    auto const& occlusions = filter_occlusions_from(elements, monitor_rect);
+
+    EXPECT_THAT(renderables_from(occlusions), ElementsAre(bottom));
+    EXPECT_THAT(renderables_from(elements), ElementsAre(left, right));
+}
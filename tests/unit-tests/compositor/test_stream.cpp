@@ -17,6 +17,7 @@
 #include "mir/test/doubles/stub_buffer.h"
 #include "mir/test/fake_shared.h"
 #include "src/server/compositor/stream.h"
+#include "mir/graphics/frame.h"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -236,3 +237,22 @@ TEST_F(Stream, stream_remembers_scale_when_buffer_added)
     stream.submit_buffer(buffers[0]);
     ASSERT_THAT(stream.stream_size(), Eq(initial_size / 2));
 }
+
+TEST_F(Stream, frame_presented_is_forwarded_to_callback)
+{
+    geom::Rectangle const output_area{{0, 0}, {1920, 1080}};
+    mg::Frame frame;
+    frame.msc = 7;
+
+    std::optional<std::tuple<mg::BufferID, geom::Rectangle, int64_t, bool>> presented;
+    stream.set_frame_presented_callback(
+        [&](mg::BufferID id, geom::Rectangle const& area, mg::Frame const& frame, bool zero_copy)
+        {
+            presented = std::make_tuple(id, area, frame.msc, zero_copy);
+        });
+
+    stream.submit_buffer(buffers[0]);
+    stream.frame_presented(buffers[0]->id(), output_area, frame, true);
+
+    EXPECT_THAT(presented, Eq(std::make_optional(std::make_tuple(buffers[0]->id(), output_area, int64_t{7}, true))));
+}
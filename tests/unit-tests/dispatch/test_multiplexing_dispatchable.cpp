@@ -485,3 +485,89 @@ TEST(MultiplexingDispatchableTest, automatic_removals_are_threadsafe)
     
     dispatchee->trigger();
 }
+
+TEST(MultiplexingDispatchableTest, dispatches_all_ready_dispatchees_in_one_dispatch)
+{
+    int dispatched{0};
+    auto dispatchee_a = std::make_shared<mt::TestDispatchable>([&dispatched]() { ++dispatched; });
+    auto dispatchee_b = std::make_shared<mt::TestDispatchable>([&dispatched]() { ++dispatched; });
+    auto dispatchee_c = std::make_shared<mt::TestDispatchable>([&dispatched]() { ++dispatched; });
+    md::MultiplexingDispatchable dispatcher{dispatchee_a, dispatchee_b, dispatchee_c};
+
+    dispatchee_a->trigger();
+    dispatchee_b->trigger();
+    dispatchee_c->trigger();
+
+    ASSERT_TRUE(mt::fd_is_readable(dispatcher.watch_fd()));
+    dispatcher.dispatch(md::FdEvent::readable);
+
+    EXPECT_THAT(dispatched, testing::Eq(3));
+    EXPECT_FALSE(mt::fd_is_readable(dispatcher.watch_fd()));
+}
+
+TEST(MultiplexingDispatchableTest, dispatchee_removed_earlier_in_a_batch_is_not_dispatched)
+{
+    md::MultiplexingDispatchable dispatcher;
+    int dispatched{0};
+    std::shared_ptr<mt::TestDispatchable> dispatchee_a, dispatchee_b;
+
+    // Whichever is dispatched first removes the other
+    dispatchee_a = std::make_shared<mt::TestDispatchable>(
+        [&]() { ++dispatched; dispatcher.remove_watch(dispatchee_b); });
+    dispatchee_b = std::make_shared<mt::TestDispatchable>(
+        [&]() { ++dispatched; dispatcher.remove_watch(dispatchee_a); });
+    dispatcher.add_watch(dispatchee_a);
+    dispatcher.add_watch(dispatchee_b);
+
+    dispatchee_a->trigger();
+    dispatchee_b->trigger();
+
+    dispatcher.dispatch(md::FdEvent::readable);
+
+    EXPECT_THAT(dispatched, testing::Eq(1));
+}
+
+TEST(MultiplexingDispatchableTest, edge_triggered_dispatchee_is_dispatched_once_per_edge)
+{
+    int dispatched{0};
+    auto dispatchee = std::make_shared<mt::TestDispatchable>([&dispatched]() { ++dispatched; });
+    md::MultiplexingDispatchable dispatcher;
+    dispatcher.add_watch(dispatchee, md::DispatchReentrancy::sequential, md::DispatchTrigger::edge);
+
+    dispatchee->trigger();
+    dispatchee->trigger();
+
+    ASSERT_TRUE(mt::fd_is_readable(dispatcher.watch_fd()));
+    dispatcher.dispatch(md::FdEvent::readable);
+    EXPECT_THAT(dispatched, testing::Eq(1));
+
+    // The dispatchee left one trigger unconsumed, which is not reported again...
+    EXPECT_FALSE(mt::fd_is_readable(dispatcher.watch_fd()));
+
+    // ...until a new edge arrives
+    dispatchee->trigger();
+    ASSERT_TRUE(mt::fd_is_readable(dispatcher.watch_fd()));
+    dispatcher.dispatch(md::FdEvent::readable);
+    EXPECT_THAT(dispatched, testing::Eq(2));
+}
+
+TEST(MultiplexingDispatchableTest, counts_dispatches_of_each_dispatchee)
+{
+    auto dispatchee_a = std::make_shared<mt::TestDispatchable>([]() {});
+    auto dispatchee_b = std::make_shared<mt::TestDispatchable>([]() {});
+    md::MultiplexingDispatchable dispatcher{dispatchee_a, dispatchee_b};
+
+    for (int i = 0; i != 3; ++i)
+    {
+        dispatchee_a->trigger();
+        dispatcher.dispatch(md::FdEvent::readable);
+    }
+    dispatchee_b->trigger();
+    dispatcher.dispatch(md::FdEvent::readable);
+
+    EXPECT_THAT(dispatcher.dispatch_count(dispatchee_a->watch_fd()), testing::Eq(3u));
+    EXPECT_THAT(dispatcher.dispatch_count(dispatchee_b->watch_fd()), testing::Eq(1u));
+
+    dispatcher.remove_watch(dispatchee_a);
+    EXPECT_THAT(dispatcher.dispatch_count(dispatchee_a->watch_fd()), testing::Eq(0u));
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/fractional_scale_v1.h"
+#include "mir/test/doubles/stub_display_configuration.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mf = mir::frontend;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+using namespace testing;
+
+namespace
+{
+struct FractionalScaleTest : Test
+{
+    // Two side by side outputs, the right hand one scaled
+    mtd::StubDisplayConfig config{{{{0, 0}, {1920, 1080}}, {{1920, 0}, {2560, 1440}}}};
+
+    FractionalScaleTest()
+    {
+        config.outputs[1].scale = 1.5f;
+    }
+};
+}
+
+TEST_F(FractionalScaleTest, output_showing_most_of_the_surface_gives_the_scale)
+{
+    EXPECT_THAT(mf::scale_of_output_showing(geom::Rectangle{{1800, 0}, {400, 300}}, config), FloatEq(1.5f));
+    EXPECT_THAT(mf::scale_of_output_showing(geom::Rectangle{{1600, 0}, {400, 300}}, config), FloatEq(1.0f));
+}
+
+TEST_F(FractionalScaleTest, surface_on_no_output_gets_the_largest_scale)
+{
+    EXPECT_THAT(mf::scale_of_output_showing(geom::Rectangle{{0, 5000}, {400, 300}}, config), FloatEq(1.5f));
+    EXPECT_THAT(mf::scale_of_output_showing(std::nullopt, config), FloatEq(1.5f));
+}
+
+TEST_F(FractionalScaleTest, unused_outputs_are_ignored)
+{
+    config.outputs[1].used = false;
+
+    EXPECT_THAT(mf::scale_of_output_showing(geom::Rectangle{{1800, 0}, {400, 300}}, config), FloatEq(1.0f));
+    EXPECT_THAT(mf::scale_of_output_showing(std::nullopt, config), FloatEq(1.0f));
+}
+
+TEST(PreferredScale, is_rounded_to_120ths)
+{
+    mf::PreferredScale preferred;
+
+    EXPECT_THAT(preferred.update(1.0f), Optional(120u));
+    EXPECT_THAT(preferred.update(1.25f), Optional(150u));
+    EXPECT_THAT(preferred.update(4.0f / 3), Optional(160u));
+    EXPECT_THAT(preferred.update(1.004f), Optional(120u));
+}
+
+TEST_F(FractionalScaleTest, preferred_scale_is_resent_only_when_a_config_change_alters_it)
+{
+    mf::PreferredScale preferred;
+    geom::Rectangle const area{{1920, 0}, {400, 300}};
+
+    EXPECT_THAT(preferred.update(mf::scale_of_output_showing(area, config)), Optional(180u));
+    EXPECT_THAT(preferred.update(mf::scale_of_output_showing(area, config)), Eq(std::nullopt));
+
+    config.outputs[1].scale = 2.0f;
+    EXPECT_THAT(preferred.update(mf::scale_of_output_showing(area, config)), Optional(240u));
+
+    // Rearranging the outputs under the surface
+    config.outputs[0].top_left = {1920, 0};
+    config.outputs[1].top_left = {0, 0};
+    EXPECT_THAT(preferred.update(mf::scale_of_output_showing(area, config)), Optional(120u));
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/frame_callback_counts.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mf = mir::frontend;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct FrameCallbackCountsTest : Test
+{
+    mf::FrameCallbackCounts counts;
+    mir::time::Timestamp const start{1s};
+};
+}
+
+TEST_F(FrameCallbackCountsTest, counts_callbacks_sent_and_held_back)
+{
+    counts.sent(3);
+    counts.throttled();
+    counts.sent(1);
+    counts.throttled();
+
+    EXPECT_THAT(counts.counts().sent, Eq(4u));
+    EXPECT_THAT(counts.counts().throttled, Eq(2u));
+}
+
+TEST_F(FrameCallbackCountsTest, nothing_is_logged_until_callbacks_are_held_back)
+{
+    counts.sent(10);
+
+    EXPECT_FALSE(counts.due_for_logging(start));
+}
+
+TEST_F(FrameCallbackCountsTest, held_back_callbacks_are_logged_straight_away)
+{
+    counts.sent(2);
+    counts.throttled();
+
+    auto const logged = counts.due_for_logging(start);
+    ASSERT_TRUE(logged);
+    EXPECT_THAT(logged->sent, Eq(2u));
+    EXPECT_THAT(logged->throttled, Eq(1u));
+}
+
+TEST_F(FrameCallbackCountsTest, held_back_callbacks_are_logged_at_most_once_an_interval)
+{
+    counts.throttled();
+    ASSERT_TRUE(counts.due_for_logging(start));
+
+    counts.throttled();
+    EXPECT_FALSE(counts.due_for_logging(start + mf::FrameCallbackCounts::log_interval - 1ms));
+
+    auto const logged = counts.due_for_logging(start + mf::FrameCallbackCounts::log_interval);
+    ASSERT_TRUE(logged);
+    EXPECT_THAT(logged->throttled, Eq(2u));
+}
+
+TEST_F(FrameCallbackCountsTest, nothing_is_logged_if_no_more_callbacks_were_held_back)
+{
+    counts.throttled();
+    ASSERT_TRUE(counts.due_for_logging(start));
+
+    counts.sent(5);
+    EXPECT_FALSE(counts.due_for_logging(start + 2 * mf::FrameCallbackCounts::log_interval));
+}
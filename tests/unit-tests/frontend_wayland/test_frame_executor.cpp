@@ -0,0 +1,136 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/frame_executor.h"
+#include "mir/test/doubles/fake_alarm_factory.h"
+#include "mir/test/doubles/advanceable_clock.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mf = mir::frontend;
+namespace mtd = mir::test::doubles;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct FrameExecutorTest : Test
+{
+    // Created before the alarm factory (which has its own clock) so the alarms are never behind our clock
+    std::shared_ptr<mtd::AdvanceableClock> const clock{std::make_shared<mtd::AdvanceableClock>()};
+    mtd::FakeAlarmFactory alarm_factory;
+    mf::FrameExecutor executor{clock, alarm_factory};
+
+    void advance_by(mir::time::Duration step)
+    {
+        clock->advance_by(step);
+        alarm_factory.advance_by(step);
+    }
+};
+}
+
+TEST_F(FrameExecutorTest, spawned_work_runs_after_fallback_delay)
+{
+    int runs{0};
+    executor.spawn([&]{ ++runs; });
+
+    advance_by(mf::FrameExecutor::fallback_delay - 1ms);
+    EXPECT_THAT(runs, Eq(0));
+
+    advance_by(1ms);
+    EXPECT_THAT(runs, Eq(1));
+}
+
+TEST_F(FrameExecutorTest, work_spawned_at_a_deadline_runs_at_that_deadline)
+{
+    int runs{0};
+    executor.spawn_at(clock->now() + 4ms, [&]{ ++runs; });
+
+    advance_by(3ms);
+    EXPECT_THAT(runs, Eq(0));
+
+    advance_by(1ms);
+    EXPECT_THAT(runs, Eq(1));
+}
+
+TEST_F(FrameExecutorTest, earlier_deadline_is_not_delayed_by_later_work)
+{
+    std::vector<int> order;
+    executor.spawn([&]{ order.push_back(2); });
+    executor.spawn_at(clock->now() + 7ms, [&]{ order.push_back(1); });
+
+    advance_by(7ms);
+    EXPECT_THAT(order, ElementsAre(1));
+
+    advance_by(mf::FrameExecutor::fallback_delay);
+    EXPECT_THAT(order, ElementsAre(1, 2));
+}
+
+TEST_F(FrameExecutorTest, work_due_together_runs_in_one_wakeup)
+{
+    int runs{0};
+    auto const vblank = clock->now() + 5ms;
+    executor.spawn_at(vblank, [&]{ ++runs; });
+    executor.spawn_at(vblank, [&]{ ++runs; });
+
+    advance_by(5ms);
+    EXPECT_THAT(runs, Eq(2));
+    EXPECT_THAT(alarm_factory.wakeup_count(), Eq(1));
+}
+
+TEST_F(FrameExecutorTest, work_spawned_by_a_callback_is_not_delayed_by_later_work)
+{
+    std::vector<int> order;
+    executor.spawn([&]{ order.push_back(3); });
+    executor.spawn_at(clock->now() + 5ms, [&]
+        {
+            order.push_back(1);
+            executor.spawn_at(clock->now() + 2ms, [&]{ order.push_back(2); });
+        });
+
+    advance_by(5ms);
+    advance_by(2ms);
+    EXPECT_THAT(order, ElementsAre(1, 2));
+
+    advance_by(mf::FrameExecutor::fallback_delay);
+    EXPECT_THAT(order, ElementsAre(1, 2, 3));
+}
+
+TEST(HiddenSurfaceFramePolicy, positive_rate_releases_callbacks_once_per_period)
+{
+    mf::HiddenSurfaceFramePolicy const policy{4};
+    mir::time::Timestamp const last_sent{1s};
+
+    EXPECT_TRUE(policy.throttles());
+    EXPECT_THAT(policy.release_time(last_sent), Optional(last_sent + 250ms));
+}
+
+TEST(HiddenSurfaceFramePolicy, zero_rate_holds_callbacks_until_the_surface_is_seen)
+{
+    mf::HiddenSurfaceFramePolicy const policy{0};
+
+    EXPECT_TRUE(policy.throttles());
+    EXPECT_THAT(policy.release_time(mir::time::Timestamp{1s}), Eq(std::nullopt));
+}
+
+TEST(HiddenSurfaceFramePolicy, negative_rate_does_not_throttle)
+{
+    mf::HiddenSurfaceFramePolicy const policy{-1};
+
+    EXPECT_FALSE(policy.throttles());
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/pointer_motion_coalescer.h"
+#include "src/server/frontend_wayland/frame_executor.h"
+#include "mir/test/doubles/fake_alarm_factory.h"
+#include "mir/test/doubles/advanceable_clock.h"
+#include "mir/test/doubles/explicit_executor.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+namespace mf = mir::frontend;
+namespace mtd = mir::test::doubles;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct PointerMotionCoalescerTest : Test
+{
+    // Created before the alarm factory (which has its own clock) so the alarms are never behind our clock
+    std::shared_ptr<mtd::AdvanceableClock> const clock{std::make_shared<mtd::AdvanceableClock>()};
+    mtd::FakeAlarmFactory alarm_factory;
+    std::shared_ptr<mtd::ExplicitExecutor> const wayland_executor{std::make_shared<mtd::ExplicitExecutor>()};
+    std::shared_ptr<mf::FrameExecutor> const frame_executor{std::make_shared<mf::FrameExecutor>(clock, alarm_factory)};
+
+    /// What the client has been sent, in order
+    std::vector<std::string> sent;
+
+    std::unique_ptr<mf::PointerMotionCoalescer> coalescer{std::make_unique<mf::PointerMotionCoalescer>(
+        wayland_executor,
+        frame_executor,
+        [this](mf::PointerMotionCoalescer::Motion const& motion)
+        {
+            sent.push_back(
+                "motion " + std::to_string(static_cast<int>(motion.position.first)) +
+                "," + std::to_string(static_cast<int>(motion.position.second)));
+        },
+        [this]() { sent.push_back("frame"); })};
+
+    static auto motion_to(float x, float y) -> mf::PointerMotionCoalescer::Motion
+    {
+        return {0, {x, y}, std::chrono::nanoseconds{0}};
+    }
+
+    void advance_by(mir::time::Duration step)
+    {
+        clock->advance_by(step);
+        alarm_factory.advance_by(step);
+        wayland_executor->execute();
+    }
+};
+}
+
+TEST_F(PointerMotionCoalescerTest, held_motion_is_sent_with_a_frame_when_due)
+{
+    coalescer->hold(motion_to(1, 1), clock->now() + 5ms);
+
+    advance_by(4ms);
+    EXPECT_THAT(sent, IsEmpty());
+
+    advance_by(1ms);
+    EXPECT_THAT(sent, ElementsAre("motion 1,1", "frame"));
+}
+
+TEST_F(PointerMotionCoalescerTest, only_the_latest_motion_is_sent)
+{
+    coalescer->hold(motion_to(1, 1), clock->now() + 5ms);
+    coalescer->hold(motion_to(2, 2), clock->now() + 6ms);
+    coalescer->hold(motion_to(3, 3), clock->now() + 7ms);
+
+    advance_by(5ms);
+    EXPECT_THAT(sent, ElementsAre("motion 3,3", "frame"));
+}
+
+TEST_F(PointerMotionCoalescerTest, motion_without_a_due_time_is_sent_on_the_next_main_loop_iteration)
+{
+    coalescer->hold(motion_to(1, 1), std::nullopt);
+    coalescer->hold(motion_to(2, 2), std::nullopt);
+    EXPECT_THAT(sent, IsEmpty());
+
+    wayland_executor->execute();
+    EXPECT_THAT(sent, ElementsAre("motion 2,2", "frame"));
+}
+
+TEST_F(PointerMotionCoalescerTest, flushing_sends_held_motion_ahead_of_what_follows)
+{
+    coalescer->hold(motion_to(1, 1), clock->now() + 5ms);
+
+    // As a button press does
+    coalescer->flush();
+    sent.push_back("button");
+    sent.push_back("frame");
+
+    advance_by(5ms);
+    EXPECT_THAT(sent, ElementsAre("motion 1,1", "button", "frame"));
+}
+
+TEST_F(PointerMotionCoalescerTest, held_motion_is_sent_before_leaving)
+{
+    coalescer->hold(motion_to(1, 1), clock->now() + 5ms);
+
+    // As WlPointer::leave() does
+    coalescer->flush();
+    sent.push_back("leave");
+
+    advance_by(5ms);
+    EXPECT_THAT(sent, ElementsAre("motion 1,1", "leave"));
+}
+
+TEST_F(PointerMotionCoalescerTest, motion_held_after_a_flush_is_still_sent_when_due)
+{
+    coalescer->hold(motion_to(1, 1), clock->now() + 5ms);
+    coalescer->flush();
+    coalescer->hold(motion_to(2, 2), clock->now() + 5ms);
+
+    advance_by(5ms);
+    EXPECT_THAT(sent, ElementsAre("motion 1,1", "motion 2,2", "frame"));
+
+    coalescer->hold(motion_to(3, 3), clock->now() + 5ms);
+    advance_by(5ms);
+    EXPECT_THAT(sent, ElementsAre("motion 1,1", "motion 2,2", "frame", "motion 3,3", "frame"));
+}
+
+TEST_F(PointerMotionCoalescerTest, nothing_is_sent_once_the_coalescer_is_destroyed)
+{
+    coalescer->hold(motion_to(1, 1), clock->now() + 5ms);
+    coalescer.reset();
+
+    advance_by(5ms);
+    EXPECT_THAT(sent, IsEmpty());
+}
+
+TEST_F(PointerMotionCoalescerTest, nothing_is_sent_if_destroyed_while_the_flush_is_queued_on_the_main_loop)
+{
+    coalescer->hold(motion_to(1, 1), std::nullopt);
+    coalescer.reset();
+
+    wayland_executor->execute();
+    EXPECT_THAT(sent, IsEmpty());
+}
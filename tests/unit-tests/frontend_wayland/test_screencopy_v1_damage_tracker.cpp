@@ -59,7 +59,7 @@ public:
         return params;
     }
 
-    MOCK_METHOD(void, capture, (geom::Rectangle damage), (override));
+    MOCK_METHOD(void, capture, (geom::Region const& damage), (override));
 
     mf::WlrScreencopyV1DamageTracker::FrameParams params;
 };
@@ -539,7 +539,7 @@ TEST_F(DamageTrackerV1, when_multiple_damages_happen_before_capture_frame_is_cap
     geom::Rectangle const area{{}, {20, 30}};
     geom::Rectangle const damage_a{{0, 5}, {10, 6}};
     geom::Rectangle const damage_b{{5, 5}, {10, 8}};
-    geom::Rectangle const damage_combined{{0, 5}, {15, 8}};
+    geom::Region const damage_combined{damage_a, damage_b};
     capture_frame(area, area.size);
 
     damage_area(damage_a);
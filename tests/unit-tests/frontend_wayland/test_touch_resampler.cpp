@@ -0,0 +1,132 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/touch_resampler.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mf = mir::frontend;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct TouchResamplerTest : Test
+{
+    mf::TouchResampler resampler;
+    mir::time::Timestamp const start{1s};
+    int32_t const id{3};
+
+    void expect_position_at(mir::time::Timestamp time, float x, float y)
+    {
+        auto const position = resampler.position_at(id, time);
+        ASSERT_TRUE(position);
+        EXPECT_THAT(position->first, FloatEq(x));
+        EXPECT_THAT(position->second, FloatEq(y));
+    }
+};
+}
+
+TEST_F(TouchResamplerTest, unknown_touch_has_no_position)
+{
+    EXPECT_FALSE(resampler.position_at(id, start));
+    EXPECT_FALSE(resampler.latest(id));
+}
+
+TEST_F(TouchResamplerTest, interpolates_between_samples)
+{
+    resampler.add(id, start, {0, 0});
+    resampler.add(id, start + 8ms, {80, 40});
+
+    expect_position_at(start + 2ms, 20, 10);
+    expect_position_at(start + 8ms, 80, 40);
+}
+
+TEST_F(TouchResamplerTest, does_not_go_back_before_the_first_sample)
+{
+    resampler.add(id, start, {10, 20});
+    resampler.add(id, start + 8ms, {80, 40});
+
+    expect_position_at(start - 5ms, 10, 20);
+}
+
+TEST_F(TouchResamplerTest, extrapolates_by_at_most_half_an_interval)
+{
+    resampler.add(id, start, {0, 0});
+    resampler.add(id, start + 8ms, {80, 0});
+
+    expect_position_at(start + 10ms, 100, 0);
+    expect_position_at(start + 16ms, 120, 0);
+}
+
+TEST_F(TouchResamplerTest, extrapolates_by_at_most_max_prediction)
+{
+    resampler.add(id, start, {0, 0});
+    resampler.add(id, start + 20ms, {200, 0});
+
+    auto const limit = std::chrono::duration_cast<std::chrono::milliseconds>(mf::TouchResampler::max_prediction);
+    expect_position_at(start + 40ms, 200 + 10 * limit.count(), 0);
+}
+
+TEST_F(TouchResamplerTest, does_not_extrapolate_from_samples_too_close_together)
+{
+    resampler.add(id, start, {0, 0});
+    resampler.add(id, start + 1ms, {10, 0});
+
+    expect_position_at(start + 5ms, 10, 0);
+}
+
+TEST_F(TouchResamplerTest, does_not_extrapolate_from_samples_too_far_apart)
+{
+    resampler.add(id, start, {0, 0});
+    resampler.add(id, start + 50ms, {10, 0});
+
+    expect_position_at(start + 55ms, 10, 0);
+}
+
+TEST_F(TouchResamplerTest, only_reports_extrapolated_positions_as_predicted)
+{
+    resampler.add(id, start, {0, 0});
+    EXPECT_FALSE(resampler.predicts(id, start + 4ms));
+
+    resampler.add(id, start + 8ms, {80, 0});
+    EXPECT_FALSE(resampler.predicts(id, start + 4ms));
+    EXPECT_FALSE(resampler.predicts(id, start + 8ms));
+    EXPECT_TRUE(resampler.predicts(id, start + 10ms));
+
+    resampler.add(id, start + 58ms, {90, 0});
+    EXPECT_FALSE(resampler.predicts(id, start + 60ms));
+}
+
+TEST_F(TouchResamplerTest, late_sample_replaces_the_latest)
+{
+    resampler.add(id, start, {0, 0});
+    resampler.add(id, start + 8ms, {80, 0});
+    resampler.add(id, start + 4ms, {60, 0});
+
+    EXPECT_THAT(resampler.latest(id), Optional(start + 8ms));
+    expect_position_at(start + 8ms, 60, 0);
+}
+
+TEST_F(TouchResamplerTest, removed_touch_is_forgotten)
+{
+    resampler.add(id, start, {0, 0});
+    resampler.remove(id);
+
+    EXPECT_FALSE(resampler.position_at(id, start));
+}
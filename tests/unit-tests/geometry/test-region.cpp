@@ -0,0 +1,165 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/geometry/region.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace mir::geometry;
+using namespace testing;
+
+namespace
+{
+auto contents_of(Region const& region) -> std::vector<Rectangle>
+{
+    return {region.begin(), region.end()};
+}
+}
+
+TEST(Region, default_region_is_empty)
+{
+    Region const region;
+
+    EXPECT_TRUE(region.empty());
+    EXPECT_THAT(region.size(), Eq(0u));
+    EXPECT_THAT(region.bounding_rectangle(), Eq(Rectangle{}));
+}
+
+TEST(Region, empty_rectangles_are_dropped)
+{
+    Region const region{Rectangle{{5, 5}, {0, 10}}, Rectangle{{5, 5}, {10, 0}}, Rectangle{{5, 5}, {-3, -3}}};
+
+    EXPECT_TRUE(region.empty());
+}
+
+TEST(Region, single_rectangle_is_kept_as_is)
+{
+    Rectangle const rect{{-3, 7}, {20, 10}};
+
+    EXPECT_THAT(contents_of(Region{rect}), ElementsAre(rect));
+}
+
+TEST(Region, overlapping_rectangles_are_split_into_bands)
+{
+    Region const region{Rectangle{{0, 0}, {10, 10}}, Rectangle{{5, 5}, {10, 10}}};
+
+    EXPECT_THAT(contents_of(region), ElementsAre(
+        Rectangle{{0, 0}, {10, 5}},
+        Rectangle{{0, 5}, {15, 5}},
+        Rectangle{{5, 10}, {10, 5}}));
+}
+
+TEST(Region, touching_rectangles_are_merged)
+{
+    Region const side_by_side{Rectangle{{0, 0}, {10, 10}}, Rectangle{{10, 0}, {5, 10}}};
+    Region const stacked{Rectangle{{0, 0}, {10, 10}}, Rectangle{{0, 10}, {10, 5}}};
+
+    EXPECT_THAT(contents_of(side_by_side), ElementsAre(Rectangle{{0, 0}, {15, 10}}));
+    EXPECT_THAT(contents_of(stacked), ElementsAre(Rectangle{{0, 0}, {10, 15}}));
+}
+
+TEST(Region, equal_areas_compare_equal_however_they_were_built)
+{
+    Region const a{Rectangle{{0, 0}, {10, 5}}, Rectangle{{0, 5}, {5, 5}}, Rectangle{{5, 5}, {5, 5}}};
+    Region const b{Rectangle{{0, 0}, {5, 10}}, Rectangle{{5, 0}, {5, 10}}};
+
+    EXPECT_THAT(a, Eq(b));
+    EXPECT_THAT(a, Eq(Region{Rectangle{{0, 0}, {10, 10}}}));
+}
+
+TEST(Region, add_covers_both_areas)
+{
+    Region region{Rectangle{{0, 0}, {10, 10}}};
+    region.add(Rectangle{{20, 0}, {10, 10}});
+
+    EXPECT_THAT(contents_of(region), ElementsAre(Rectangle{{0, 0}, {10, 10}}, Rectangle{{20, 0}, {10, 10}}));
+}
+
+TEST(Region, subtract_can_punch_a_hole)
+{
+    Region region{Rectangle{{0, 0}, {30, 30}}};
+    region.subtract(Rectangle{{10, 10}, {10, 10}});
+
+    EXPECT_THAT(contents_of(region), ElementsAre(
+        Rectangle{{0, 0}, {30, 10}},
+        Rectangle{{0, 10}, {10, 10}},
+        Rectangle{{20, 10}, {10, 10}},
+        Rectangle{{0, 20}, {30, 10}}));
+    EXPECT_FALSE(region.contains(Point{15, 15}));
+    EXPECT_TRUE(region.contains(Point{5, 15}));
+}
+
+TEST(Region, subtracting_everything_leaves_nothing)
+{
+    Region region{Rectangle{{0, 0}, {30, 30}}, Rectangle{{50, 50}, {5, 5}}};
+    region.subtract(Rectangle{{-10, -10}, {100, 100}});
+
+    EXPECT_TRUE(region.empty());
+}
+
+TEST(Region, intersect_keeps_only_shared_area)
+{
+    Region region{Rectangle{{0, 0}, {10, 10}}, Rectangle{{20, 0}, {10, 10}}};
+    region.intersect(Rectangle{{5, 5}, {20, 10}});
+
+    EXPECT_THAT(contents_of(region), ElementsAre(Rectangle{{5, 5}, {5, 5}}, Rectangle{{20, 5}, {5, 5}}));
+}
+
+TEST(Region, intersect_with_disjoint_region_is_empty)
+{
+    Region region{Rectangle{{0, 0}, {10, 10}}};
+    region.intersect(Rectangle{{10, 0}, {10, 10}});
+
+    EXPECT_TRUE(region.empty());
+}
+
+TEST(Region, contains_point_respects_half_open_edges)
+{
+    Region const region{Rectangle{{0, 0}, {10, 10}}, Rectangle{{20, 20}, {10, 10}}};
+
+    EXPECT_TRUE(region.contains(Point{0, 0}));
+    EXPECT_TRUE(region.contains(Point{9, 9}));
+    EXPECT_FALSE(region.contains(Point{10, 5}));
+    EXPECT_FALSE(region.contains(Point{5, 10}));
+    EXPECT_FALSE(region.contains(Point{15, 15}));
+    EXPECT_TRUE(region.contains(Point{25, 25}));
+    EXPECT_FALSE(region.contains(Point{-1, 0}));
+}
+
+TEST(Region, contains_rectangle_covered_by_several_rectangles)
+{
+    Region const region{Rectangle{{0, 0}, {10, 20}}, Rectangle{{10, 5}, {10, 10}}};
+
+    EXPECT_TRUE(region.contains(Rectangle{{5, 5}, {10, 10}}));
+    EXPECT_FALSE(region.contains(Rectangle{{5, 4}, {10, 10}}));
+    EXPECT_TRUE(region.contains(Rectangle{}));
+}
+
+TEST(Region, bounding_rectangle_covers_all_bands)
+{
+    Region const region{Rectangle{{5, 0}, {5, 5}}, Rectangle{{0, 10}, {3, 3}}, Rectangle{{20, 2}, {1, 1}}};
+
+    EXPECT_THAT(region.bounding_rectangle(), Eq(Rectangle{{0, 0}, {21, 13}}));
+}
+
+TEST(Region, translate_moves_every_rectangle)
+{
+    Region region{Rectangle{{0, 0}, {10, 10}}, Rectangle{{20, 0}, {10, 10}}};
+    region.translate({5, -5});
+
+    EXPECT_THAT(region, Eq(Region{Rectangle{{5, -5}, {10, 10}}, Rectangle{{25, -5}, {10, 10}}}));
+}
@@ -145,3 +145,114 @@ TEST_F(Tessellation, tex_coords_0_or_1_when_transformed)
     mgl::Primitive const primitive = mgl::tessellate_renderable_into_rectangle(renderable, {x, y});
     expect_tex_coords_1_or_0(primitive);
 }
+
+TEST_F(Tessellation, without_opaque_region_is_single_translucent_rectangle)
+{
+    std::vector<mgl::Primitive> primitives;
+    mgl::tessellate_renderable_by_opacity(primitives, renderable, {}, {});
+
+    ASSERT_THAT(primitives.size(), Eq(1u));
+    EXPECT_THAT(bounding_box(primitives[0]), Eq(BoundingBox::from(rect)));
+    EXPECT_FALSE(primitives[0].opaque);
+    expect_tex_coords_1_or_0(primitives[0]);
+}
+
+TEST_F(Tessellation, fully_opaque_is_single_opaque_rectangle)
+{
+    std::vector<mgl::Primitive> primitives;
+    mgl::tessellate_renderable_by_opacity(primitives, renderable, {}, {rect});
+
+    ASSERT_THAT(primitives.size(), Eq(1u));
+    EXPECT_THAT(bounding_box(primitives[0]), Eq(BoundingBox::from(rect)));
+    EXPECT_TRUE(primitives[0].opaque);
+    expect_tex_coords_1_or_0(primitives[0]);
+}
+
+TEST_F(Tessellation, opaque_centre_is_split_from_translucent_border)
+{
+    geom::Rectangle const centre{rect.top_left + geom::Displacement{2, 5}, {6, 10}};
+
+    std::vector<mgl::Primitive> primitives;
+    mgl::tessellate_renderable_by_opacity(primitives, renderable, {}, {centre});
+
+    ASSERT_THAT(primitives.size(), Eq(5u));
+    std::vector<BoundingBox> opaque;
+    for (auto const& primitive : primitives)
+    {
+        if (primitive.opaque)
+            opaque.push_back(bounding_box(primitive));
+    }
+    EXPECT_THAT(opaque, ElementsAre(BoundingBox::from(centre)));
+}
+
+TEST_F(Tessellation, split_rectangles_sample_matching_part_of_texture)
+{
+    geom::Rectangle const left_half{rect.top_left, {rect.size.width.as_int() / 2, rect.size.height.as_int()}};
+
+    std::vector<mgl::Primitive> primitives;
+    mgl::tessellate_renderable_by_opacity(primitives, renderable, {}, {left_half});
+
+    ASSERT_THAT(primitives.size(), Eq(2u));
+    for (auto const& primitive : primitives)
+    {
+        for (int i = 0; i < primitive.nvertices; i++)
+        {
+            auto const& vertex = primitive.vertices[i];
+            EXPECT_THAT(vertex.texcoord[0],
+                FloatEq((vertex.position[0] - rect.left().as_int()) / rect.size.width.as_int()));
+            EXPECT_THAT(vertex.texcoord[1],
+                FloatEq((vertex.position[1] - rect.top().as_int()) / rect.size.height.as_int()));
+        }
+    }
+}
+
+TEST_F(Tessellation, opaque_region_outside_renderable_is_ignored)
+{
+    geom::Rectangle const elsewhere{rect.top_left + geom::Displacement{100, 100}, {10, 10}};
+
+    std::vector<mgl::Primitive> primitives;
+    mgl::tessellate_renderable_by_opacity(primitives, renderable, {}, {elsewhere});
+
+    ASSERT_THAT(primitives.size(), Eq(1u));
+    EXPECT_THAT(bounding_box(primitives[0]), Eq(BoundingBox::from(rect)));
+    EXPECT_FALSE(primitives[0].opaque);
+}
+
+TEST_F(Tessellation, tex_coords_cover_src_bounds)
+{
+    ON_CALL(renderable, buffer())
+        .WillByDefault(Return(std::make_shared<mtd::StubBuffer>(geom::Size{100, 200})));
+    ON_CALL(renderable, src_bounds())
+        .WillByDefault(Return(geom::RectangleD{{10, 20}, {50, 100}}));
+
+    mgl::Primitive const primitive = mgl::tessellate_renderable_into_rectangle(renderable, {});
+
+    EXPECT_THAT(bounding_box(primitive), Eq(BoundingBox::from(rect)));
+    for (int i = 0; i < primitive.nvertices; i++)
+    {
+        EXPECT_THAT(primitive.vertices[i].texcoord[0], AnyOf(FloatEq(0.1f), FloatEq(0.6f))) << "i=" << i;
+        EXPECT_THAT(primitive.vertices[i].texcoord[1], AnyOf(FloatEq(0.1f), FloatEq(0.6f))) << "i=" << i;
+    }
+}
+
+TEST_F(Tessellation, split_rectangles_stay_within_src_bounds)
+{
+    ON_CALL(renderable, buffer())
+        .WillByDefault(Return(std::make_shared<mtd::StubBuffer>(geom::Size{100, 200})));
+    ON_CALL(renderable, src_bounds())
+        .WillByDefault(Return(geom::RectangleD{{10, 20}, {50, 100}}));
+    geom::Rectangle const left_half{rect.top_left, {rect.size.width.as_int() / 2, rect.size.height.as_int()}};
+
+    std::vector<mgl::Primitive> primitives;
+    mgl::tessellate_renderable_by_opacity(primitives, renderable, {}, {left_half});
+
+    ASSERT_THAT(primitives.size(), Eq(2u));
+    for (auto const& primitive : primitives)
+    {
+        for (int i = 0; i < primitive.nvertices; i++)
+        {
+            EXPECT_THAT(primitive.vertices[i].texcoord[0], AllOf(Ge(0.1f - 1e-6f), Le(0.6f + 1e-6f)));
+            EXPECT_THAT(primitive.vertices[i].texcoord[1], AnyOf(FloatEq(0.1f), FloatEq(0.6f)));
+        }
+    }
+}
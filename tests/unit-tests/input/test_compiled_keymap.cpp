@@ -0,0 +1,78 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/input/compiled_keymap.h"
+#include "mir/input/parameter_keymap.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <string>
+
+namespace mi = mir::input;
+
+using namespace ::testing;
+
+TEST(CompiledKeymap, matching_keymaps_share_a_compiled_keymap)
+{
+    auto const a = mi::compiled_keymap_for(std::make_shared<mi::ParameterKeymap>());
+    auto const b = mi::compiled_keymap_for(std::make_shared<mi::ParameterKeymap>());
+
+    EXPECT_THAT(a, Eq(b));
+}
+
+TEST(CompiledKeymap, different_keymaps_are_compiled_separately)
+{
+    auto const us = mi::compiled_keymap_for(std::make_shared<mi::ParameterKeymap>());
+    auto const gb = mi::compiled_keymap_for(
+        std::make_shared<mi::ParameterKeymap>(mi::ParameterKeymap::default_model, "gb", "", ""));
+
+    EXPECT_THAT(us, Ne(gb));
+}
+
+TEST(CompiledKeymap, text_is_shared_in_a_sealed_file)
+{
+    auto const keymap = mi::compiled_keymap_for(std::make_shared<mi::ParameterKeymap>());
+
+    auto const fd = keymap->text_fd();
+    EXPECT_THAT(int{keymap->text_fd()}, Eq(int{fd}));
+
+    auto const seals = fcntl(fd, F_GET_SEALS);
+    ASSERT_THAT(seals, Ge(0));
+    EXPECT_THAT(seals & F_SEAL_WRITE, Ne(0));
+
+    auto const size = keymap->text_size();
+    auto const mapping = static_cast<char const*>(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+    ASSERT_THAT(static_cast<void const*>(mapping), Ne(MAP_FAILED));
+    EXPECT_THAT(mapping[size - 1], Eq('\0'));
+    EXPECT_THAT(std::string(mapping), StartsWith("xkb_keymap"));
+    munmap(const_cast<char*>(mapping), size);
+}
+
+TEST(CompiledKeymap, states_can_be_made_from_a_shared_keymap)
+{
+    auto const keymap = mi::compiled_keymap_for(std::make_shared<mi::ParameterKeymap>());
+
+    auto const a = keymap->make_state();
+    auto const b = keymap->make_state();
+
+    EXPECT_THAT(a.get(), NotNull());
+    EXPECT_THAT(b.get(), NotNull());
+}
@@ -16,6 +16,10 @@
 
 #include "src/server/input/default_input_device_hub.h"
 
+#include "src/server/input/input_statistics.h"
+#include "src/server/report/null_report_factory.h"
+#include "src/server/report/null/input_report.h"
+
 #include "mir/test/doubles/mock_input_device.h"
 #include "mir/test/doubles/mock_input_device_observer.h"
 #include "mir/test/doubles/mock_input_seat.h"
@@ -65,6 +69,17 @@ MATCHER_P(WithName, name,
 }
 }
 
+struct RecordingInputReport : mir::report::null::InputReport
+{
+    void device_statistics(char const*, mi::InputDeviceStatistics const& statistics) override
+    {
+        rates.push_back(statistics.events_per_second);
+    }
+    auto wants_device_statistics() const -> bool override { return true; }
+
+    std::vector<uint64_t> rates;
+};
+
 struct InputDeviceHubTest : ::testing::Test
 {
     std::shared_ptr<mir::cookie::Authority> cookie_authority = mir::cookie::Authority::create();
@@ -79,7 +94,9 @@ struct InputDeviceHubTest : ::testing::Test
         mt::fake_shared(clock),
         cookie_authority,
         mt::fake_shared(mock_key_mapper),
-        mt::fake_shared(mock_server_status_listener)};
+        mt::fake_shared(mock_server_status_listener),
+        mir::report::null_input_report(),
+        0};
     NiceMock<mtd::MockInputDeviceObserver> mock_observer;
     NiceMock<mtd::MockInputDevice> device{"device","dev-1", mi::DeviceCapability::unknown};
     NiceMock<mtd::MockInputDevice> another_device{"another_device","dev-2", mi::DeviceCapability::keyboard};
@@ -100,6 +117,20 @@ struct InputDeviceHubTest : ::testing::Test
                                  ));
     }
 
+    auto pointer_motion(mi::EventBuilder* builder) -> mir::EventUPtr
+    {
+        return builder->pointer_event(
+            std::nullopt, mir_pointer_action_motion, 0, std::nullopt, {1.0f, 1.0f},
+            mir_pointer_axis_source_none, {}, {});
+    }
+
+    /// So events are counted from the start of a measurement period
+    void start_of_next_period()
+    {
+        auto const since_period_start = clock.now().time_since_epoch() % mi::InputStatistics::period;
+        clock.advance_by(mi::InputStatistics::period - since_period_start);
+    }
+
     void expect_and_execute_multiplexer()
     {
         mt::fd_becomes_readable(multiplexer.watch_fd(), 2s);
@@ -353,3 +384,146 @@ TEST_F(InputDeviceHubTest, no_device_config_action_after_device_removal)
     hub.remove_device(mt::fake_shared(mouse));
     expect_and_execute_multiplexer();
 }
+
+TEST_F(InputDeviceHubTest, device_statistics_count_the_events_received)
+{
+    mi::InputSink* sink;
+    mi::EventBuilder* builder;
+    capture_input_sink(mouse, sink, builder);
+    auto const handle = hub.add_device(mt::fake_shared(mouse)).lock();
+
+    for (auto i = 0; i != 3; ++i)
+        sink->handle_input(pointer_motion(builder));
+
+    auto const statistics = handle->statistics();
+    EXPECT_THAT(statistics.events, Eq(3u));
+    EXPECT_THAT(statistics.dropped_events, Eq(0u));
+}
+
+TEST_F(InputDeviceHubTest, device_statistics_measure_the_event_rate_over_a_second)
+{
+    mi::InputSink* sink;
+    mi::EventBuilder* builder;
+    capture_input_sink(mouse, sink, builder);
+    auto const handle = hub.add_device(mt::fake_shared(mouse)).lock();
+
+    start_of_next_period();
+    for (auto i = 0; i != 250; ++i)
+    {
+        sink->handle_input(pointer_motion(builder));
+        clock.advance_by(4ms);
+    }
+    sink->handle_input(pointer_motion(builder));
+
+    EXPECT_THAT(handle->statistics().events_per_second, Eq(250u));
+}
+
+TEST_F(InputDeviceHubTest, device_statistics_measure_no_rate_after_a_quiet_period)
+{
+    mi::InputSink* sink;
+    mi::EventBuilder* builder;
+    capture_input_sink(mouse, sink, builder);
+    auto const handle = hub.add_device(mt::fake_shared(mouse)).lock();
+
+    start_of_next_period();
+    for (auto i = 0; i != 100; ++i)
+        sink->handle_input(pointer_motion(builder));
+    clock.advance_by(3s);
+    sink->handle_input(pointer_motion(builder));
+
+    EXPECT_THAT(handle->statistics().events_per_second, Eq(0u));
+}
+
+TEST_F(InputDeviceHubTest, device_statistics_are_reported_when_the_device_goes_quiet)
+{
+    RecordingInputReport report;
+    mi::DefaultInputDeviceHub reporting_hub{
+        mt::fake_shared(mock_seat),
+        mt::fake_shared(multiplexer),
+        mt::fake_shared(clock),
+        cookie_authority,
+        mt::fake_shared(mock_key_mapper),
+        mt::fake_shared(mock_server_status_listener),
+        mt::fake_shared(report),
+        0};
+
+    mi::InputSink* sink;
+    mi::EventBuilder* builder;
+    capture_input_sink(mouse, sink, builder);
+    reporting_hub.add_device(mt::fake_shared(mouse));
+
+    for (auto i = 0; i != 10; ++i)
+        sink->handle_input(pointer_motion(builder));
+
+    // The timer is set for the end of the period on the real clock, which is at most a period behind
+    clock.advance_by(1s);
+    ASSERT_TRUE(mt::fd_becomes_readable(multiplexer.watch_fd(), 2s));
+    multiplexer.dispatch(mir::dispatch::FdEvent::readable);
+    ASSERT_THAT(report.rates, ElementsAre(10u));
+
+    clock.advance_by(1s);
+    ASSERT_TRUE(mt::fd_becomes_readable(multiplexer.watch_fd(), 3s));
+    multiplexer.dispatch(mir::dispatch::FdEvent::readable);
+    EXPECT_THAT(report.rates, ElementsAre(10u, 0u));
+}
+
+TEST_F(InputDeviceHubTest, motion_over_the_rate_limit_is_not_dispatched)
+{
+    mi::DefaultInputDeviceHub limited_hub{
+        mt::fake_shared(mock_seat),
+        mt::fake_shared(multiplexer),
+        mt::fake_shared(clock),
+        cookie_authority,
+        mt::fake_shared(mock_key_mapper),
+        mt::fake_shared(mock_server_status_listener),
+        mir::report::null_input_report(),
+        250};
+
+    mi::InputSink* sink;
+    mi::EventBuilder* builder;
+    capture_input_sink(mouse, sink, builder);
+    auto const handle = limited_hub.add_device(mt::fake_shared(mouse)).lock();
+
+    EXPECT_CALL(mock_seat, dispatch_event(_)).Times(3);
+
+    for (auto i = 0; i != 9; ++i)
+    {
+        sink->handle_input(pointer_motion(builder));
+        clock.advance_by(1ms);
+    }
+
+    EXPECT_THAT(handle->statistics().dropped_events, Eq(6u));
+}
+
+TEST_F(InputDeviceHubTest, motion_over_the_rate_limit_is_dispatched_once_motion_stops)
+{
+    mi::DefaultInputDeviceHub limited_hub{
+        mt::fake_shared(mock_seat),
+        mt::fake_shared(multiplexer),
+        mt::fake_shared(clock),
+        cookie_authority,
+        mt::fake_shared(mock_key_mapper),
+        mt::fake_shared(mock_server_status_listener),
+        mir::report::null_input_report(),
+        250};
+
+    mi::InputSink* sink;
+    mi::EventBuilder* builder;
+    capture_input_sink(mouse, sink, builder);
+    limited_hub.add_device(mt::fake_shared(mouse));
+
+    EXPECT_CALL(mock_seat, dispatch_event(_)).Times(1);
+    sink->handle_input(pointer_motion(builder));
+    clock.advance_by(1ms);
+    sink->handle_input(pointer_motion(builder));
+    Mock::VerifyAndClearExpectations(&mock_seat);
+
+    std::shared_ptr<MirEvent> flushed;
+    EXPECT_CALL(mock_seat, dispatch_event(_)).WillOnce(SaveArg<0>(&flushed));
+    expect_and_execute_multiplexer();
+
+    ASSERT_THAT(flushed, NotNull());
+    auto const pointer = mir_input_event_get_pointer_event(mir_event_get_input_event(flushed.get()));
+    EXPECT_THAT(mir_pointer_event_axis_value(pointer, mir_pointer_axis_relative_x), FloatEq(1.0f));
+    EXPECT_THAT(mir_pointer_event_axis_value(pointer, mir_pointer_axis_relative_y), FloatEq(1.0f));
+}
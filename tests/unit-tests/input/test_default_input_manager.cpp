@@ -44,7 +44,8 @@ struct DefaultInputManagerTest : ::testing::Test
     md::ActionQueue platform_dispatchable;
     NiceMock<mtd::MockInputPlatform> platform;
     mir::Fd event_hub_fd{eventfd(0, EFD_CLOEXEC|EFD_NONBLOCK)};
-    mir::input::DefaultInputManager input_manager{mt::fake_shared(multiplexer), mt::fake_shared(platform)};
+    mir::input::DefaultInputManager input_manager{
+        mt::fake_shared(multiplexer), mt::fake_shared(platform), mir::ThreadScheduling{}};
     std::chrono::seconds const timeout{30};
 
     DefaultInputManagerTest()
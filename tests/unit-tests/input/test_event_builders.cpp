@@ -226,3 +226,37 @@ TEST_F(InputEventBuilder, when_creating_input_device_state_event_it_has_supplied
     EXPECT_THAT(mir_input_device_state_event_device_pressed_keys_count(ids_event, 1), Eq(0));
     EXPECT_THAT(mir_input_device_state_event_device_pointer_buttons(ids_event, 1), Eq(button_state));
 }
+
+TEST_F(InputEventBuilder, sharing_a_null_event_gives_an_empty_pointer)
+{
+    EXPECT_THAT(mev::share_event(mev::EventUPtr{nullptr, [](MirEvent*){}}), IsNull());
+}
+
+TEST_F(InputEventBuilder, shared_event_keeps_its_contents)
+{
+    auto const shared = mev::share_event(mev::make_pointer_event(
+        device_id, timestamp, cookie, modifiers,
+        mir_pointer_action_motion, 0, 3.0f, 4.0f, 0.0f, 0.0f, 1.0f, 1.0f));
+
+    ASSERT_THAT(shared, NotNull());
+    auto const pev = mir_input_event_get_pointer_event(mir_event_get_input_event(shared.get()));
+    EXPECT_THAT(mir_pointer_event_axis_value(pev, mir_pointer_axis_x), Eq(3.0f));
+    EXPECT_THAT(mir_pointer_event_axis_value(pev, mir_pointer_axis_y), Eq(4.0f));
+}
+
+TEST_F(InputEventBuilder, released_input_event_storage_is_reused)
+{
+    auto const make_motion = [this]
+        {
+            return mev::make_pointer_event(
+                device_id, timestamp, cookie, modifiers,
+                mir_pointer_action_motion, 0, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f);
+        };
+
+    auto first = make_motion();
+    auto const first_address = first.get();
+    first.reset();
+
+    auto const second = make_motion();
+    EXPECT_THAT(second.get(), Eq(first_address));
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/input/input_recording.h"
+#include "mir/events/event_builders.h"
+#include "mir/events/event_private.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mi = mir::input;
+namespace mev = mir::events;
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct InputRecording : Test
+{
+    InputRecording()
+    {
+        char name[] = "/tmp/mir-input-recording-XXXXXX";
+        auto const fd = mkstemp(name);
+        close(fd);
+        path = name;
+    }
+
+    ~InputRecording()
+    {
+        unlink(path.c_str());
+    }
+
+    std::string path;
+};
+}
+
+TEST_F(InputRecording, devices_round_trip)
+{
+    {
+        mi::InputRecordingWriter writer{path};
+        writer.device_added(3, "keyboard", "keyboard-uid", 4);
+        writer.device_removed(3);
+    }
+
+    auto const records = mi::read_input_recording(path);
+
+    ASSERT_THAT(records.size(), Eq(2u));
+    EXPECT_THAT(records[0].kind, Eq(mi::RecordedInput::Kind::device_added));
+    EXPECT_THAT(records[0].device_id, Eq(3));
+    EXPECT_THAT(records[0].name, Eq("keyboard"));
+    EXPECT_THAT(records[0].unique_id, Eq("keyboard-uid"));
+    EXPECT_THAT(records[0].capabilities, Eq(4u));
+    EXPECT_THAT(records[1].kind, Eq(mi::RecordedInput::Kind::device_removed));
+    EXPECT_THAT(records[1].device_id, Eq(3));
+}
+
+TEST_F(InputRecording, input_events_round_trip)
+{
+    {
+        mi::InputRecordingWriter writer{path};
+        writer.record(*mev::make_key_event(1, 10ms, {}, mir_keyboard_action_down, 0, 30, mir_input_event_modifier_none));
+        writer.record(*mev::make_pointer_event(
+            2, 20ms, {}, mir_input_event_modifier_none, mir_pointer_action_motion, mir_pointer_button_primary,
+            0.0f, 0.0f, 0.0f, -1.5f, 3.0f, -4.0f));
+        writer.record(*mev::make_touch_event(
+            4, 30ms, {}, mir_input_event_modifier_none,
+            {{7, mir_touch_action_down, mir_touch_tooltype_finger, {100.0f, 200.0f}, 0.5f, 8.0f, 5.0f, 0.0f}}));
+    }
+
+    auto const records = mi::read_input_recording(path);
+
+    ASSERT_THAT(records.size(), Eq(3u));
+
+    EXPECT_THAT(records[0].kind, Eq(mi::RecordedInput::Kind::key));
+    EXPECT_THAT(records[0].device_id, Eq(1));
+    EXPECT_THAT(records[0].time, Eq(10ms));
+    EXPECT_THAT(records[0].key_action, Eq(mir_keyboard_action_down));
+    EXPECT_THAT(records[0].scan_code, Eq(30));
+
+    EXPECT_THAT(records[1].kind, Eq(mi::RecordedInput::Kind::pointer));
+    EXPECT_THAT(records[1].time, Eq(20ms));
+    EXPECT_THAT(records[1].pointer_action, Eq(mir_pointer_action_motion));
+    EXPECT_THAT(records[1].buttons, Eq(mir_pointer_button_primary));
+    EXPECT_THAT(records[1].dx, FloatEq(3.0f));
+    EXPECT_THAT(records[1].dy, FloatEq(-4.0f));
+    EXPECT_THAT(records[1].v_scroll, FloatEq(-1.5f));
+
+    EXPECT_THAT(records[2].kind, Eq(mi::RecordedInput::Kind::touch));
+    ASSERT_THAT(records[2].contacts.size(), Eq(1u));
+    EXPECT_THAT(records[2].contacts[0].id, Eq(7));
+    EXPECT_THAT(records[2].contacts[0].action, Eq(mir_touch_action_down));
+    EXPECT_THAT(records[2].contacts[0].x, FloatEq(100.0f));
+    EXPECT_THAT(records[2].contacts[0].y, FloatEq(200.0f));
+    EXPECT_THAT(records[2].contacts[0].pressure, FloatEq(0.5f));
+}
+
+TEST_F(InputRecording, truncated_recording_is_rejected)
+{
+    {
+        mi::InputRecordingWriter writer{path};
+        writer.device_added(3, "keyboard", "keyboard-uid", 4);
+    }
+    truncate(path.c_str(), 20);
+
+    EXPECT_THROW(mi::read_input_recording(path), std::runtime_error);
+}
+
+TEST_F(InputRecording, recording_is_only_accessible_to_its_owner)
+{
+    unlink(path.c_str());
+    auto const old_umask = umask(0);
+    {
+        mi::InputRecordingWriter writer{path};
+    }
+    umask(old_umask);
+
+    struct stat info;
+    ASSERT_THAT(stat(path.c_str(), &info), Eq(0));
+    EXPECT_THAT(info.st_mode & 0777, Eq(0600u));
+}
+
+TEST_F(InputRecording, records_are_written_out_on_destruction)
+{
+    auto const record_count = 10000;
+    {
+        mi::InputRecordingWriter writer{path};
+        for (auto i = 0; i != record_count; ++i)
+        {
+            writer.record(
+                *mev::make_key_event(1, i * 1ms, {}, mir_keyboard_action_down, 0, 30, mir_input_event_modifier_none));
+        }
+    }
+
+    EXPECT_THAT(mi::read_input_recording(path).size(), Eq(size_t(record_count)));
+}
+
+TEST_F(InputRecording, records_are_written_out_without_waiting_for_more_input)
+{
+    mi::InputRecordingWriter writer{path};
+    writer.device_added(1, "keyboard", "keyboard-1", 0);
+
+    // The batch may be read part way through being written out
+    auto const deadline = std::chrono::steady_clock::now() + 5s;
+    std::vector<mi::RecordedInput> written;
+    while (written.empty() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(100ms);
+        try
+        {
+            written = mi::read_input_recording(path);
+        }
+        catch (std::runtime_error const&)
+        {
+        }
+    }
+
+    EXPECT_THAT(written.size(), Eq(1u));
+}
+
+TEST_F(InputRecording, other_files_are_rejected)
+{
+    std::ofstream{path} << "not a recording";
+
+    EXPECT_THROW(mi::read_input_recording(path), std::runtime_error);
+}
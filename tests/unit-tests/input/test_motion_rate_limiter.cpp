@@ -0,0 +1,163 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/input/motion_rate_limiter.h"
+#include "mir/events/event_builders.h"
+#include "mir/events/event_private.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mi = mir::input;
+namespace mev = mir::events;
+namespace geom = mir::geometry;
+
+using namespace ::testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct MotionRateLimiter : Test
+{
+    // At most one motion event every 4ms
+    mi::MotionRateLimiter limiter{250};
+
+    auto pointer(
+        std::chrono::nanoseconds time,
+        geom::DisplacementF motion,
+        MirPointerAction action = mir_pointer_action_motion,
+        MirPointerButtons buttons = 0) -> mir::EventUPtr
+    {
+        return mev::make_pointer_event(
+            1, time, {}, mir_input_event_modifier_none, action, buttons,
+            std::nullopt, motion, mir_pointer_axis_source_none, {}, {});
+    }
+
+    auto touch(std::chrono::nanoseconds time, MirTouchAction action) -> mir::EventUPtr
+    {
+        return mev::make_touch_event(
+            2, time, {}, mir_input_event_modifier_none,
+            {{0, action, mir_touch_tooltype_finger, {10.0f, 10.0f}, 1.0f, 1.0f, 1.0f, 0.0f}});
+    }
+
+    auto motion_of(MirEvent const& event) -> geom::DisplacementF
+    {
+        return event.to_input()->to_pointer()->motion();
+    }
+};
+}
+
+TEST_F(MotionRateLimiter, admits_motion_at_the_limit)
+{
+    EXPECT_TRUE(limiter.admit(*pointer(0ms, {1, 1})));
+    EXPECT_TRUE(limiter.admit(*pointer(4ms, {1, 1})));
+    EXPECT_TRUE(limiter.admit(*pointer(8ms, {1, 1})));
+}
+
+TEST_F(MotionRateLimiter, drops_motion_over_the_limit)
+{
+    EXPECT_TRUE(limiter.admit(*pointer(0ms, {1, 1})));
+    EXPECT_FALSE(limiter.admit(*pointer(1ms, {1, 1})));
+    EXPECT_FALSE(limiter.admit(*pointer(3ms, {1, 1})));
+}
+
+TEST_F(MotionRateLimiter, dropped_motion_is_added_to_the_next_event_admitted)
+{
+    limiter.admit(*pointer(0ms, {1, 1}));
+    limiter.admit(*pointer(1ms, {2, 0}));
+    limiter.admit(*pointer(2ms, {0, 3}));
+
+    auto const next = pointer(4ms, {1, 1});
+    ASSERT_TRUE(limiter.admit(*next));
+    EXPECT_THAT(motion_of(*next), Eq(geom::DisplacementF{3, 4}));
+}
+
+TEST_F(MotionRateLimiter, admits_button_changes_with_the_dropped_motion)
+{
+    limiter.admit(*pointer(0ms, {1, 1}));
+    limiter.admit(*pointer(1ms, {2, 2}));
+
+    auto const press = pointer(2ms, {0, 0}, mir_pointer_action_button_down, mir_pointer_button_primary);
+    ASSERT_TRUE(limiter.admit(*press));
+    EXPECT_THAT(motion_of(*press), Eq(geom::DisplacementF{2, 2}));
+
+    // Dragging with the button held is motion like any other
+    EXPECT_FALSE(limiter.admit(*pointer(3ms, {1, 1}, mir_pointer_action_motion, mir_pointer_button_primary)));
+}
+
+TEST_F(MotionRateLimiter, admits_scrolling)
+{
+    limiter.admit(*pointer(0ms, {1, 1}));
+
+    auto const scroll = mev::make_pointer_event(
+        1, 1ms, {}, mir_input_event_modifier_none, mir_pointer_action_motion, 0,
+        std::nullopt, {}, mir_pointer_axis_source_wheel, {}, {geom::DeltaYF{1}, geom::DeltaY{1}, false});
+
+    EXPECT_TRUE(limiter.admit(*scroll));
+}
+
+TEST_F(MotionRateLimiter, drops_touch_motion_over_the_limit_but_not_touches_going_up)
+{
+    EXPECT_TRUE(limiter.admit(*touch(0ms, mir_touch_action_down)));
+    EXPECT_FALSE(limiter.admit(*touch(1ms, mir_touch_action_change)));
+    EXPECT_TRUE(limiter.admit(*touch(2ms, mir_touch_action_up)));
+}
+
+TEST_F(MotionRateLimiter, dropped_motion_is_flushed_when_motion_stops)
+{
+    limiter.admit(*pointer(0ms, {1, 1}));
+    limiter.admit(*pointer(1ms, {2, 0}));
+    limiter.admit(*pointer(2ms, {0, 3}));
+
+    EXPECT_THAT(limiter.flush_due(), Optional(Eq(4ms)));
+
+    auto const flushed = limiter.flush();
+    ASSERT_THAT(flushed, NotNull());
+    EXPECT_THAT(flushed->to_input()->event_time(), Eq(2ms));
+    EXPECT_THAT(motion_of(*flushed), Eq(geom::DisplacementF{2, 3}));
+
+    EXPECT_THAT(limiter.flush(), IsNull());
+    EXPECT_THAT(limiter.flush_due(), Eq(std::nullopt));
+}
+
+TEST_F(MotionRateLimiter, nothing_is_flushed_once_the_dropped_motion_is_admitted)
+{
+    limiter.admit(*pointer(0ms, {1, 1}));
+    limiter.admit(*pointer(1ms, {2, 0}));
+    limiter.admit(*pointer(4ms, {1, 1}));
+
+    EXPECT_THAT(limiter.flush_due(), Eq(std::nullopt));
+    EXPECT_THAT(limiter.flush(), IsNull());
+}
+
+TEST_F(MotionRateLimiter, dropped_touch_motion_is_flushed_when_the_contact_stops)
+{
+    limiter.admit(*touch(0ms, mir_touch_action_down));
+    limiter.admit(*touch(1ms, mir_touch_action_change));
+    limiter.admit(*touch(2ms, mir_touch_action_change));
+
+    EXPECT_THAT(limiter.flush_due(), Optional(Eq(4ms)));
+
+    auto const flushed = limiter.flush();
+    ASSERT_THAT(flushed, NotNull());
+    EXPECT_THAT(flushed->to_input()->event_time(), Eq(2ms));
+    EXPECT_THAT(limiter.flush(), IsNull());
+}
+
+TEST_F(MotionRateLimiter, rejects_a_limit_that_is_not_positive)
+{
+    EXPECT_THROW(mi::MotionRateLimiter{0}, std::invalid_argument);
+}
@@ -18,6 +18,7 @@
 #include "src/server/input/default_event_builder.h"
 
 #include "mir/input/xkb_mapper.h"
+#include "mir/input/parameter_keymap.h"
 #include "mir/test/doubles/mock_input_dispatcher.h"
 #include "mir/test/doubles/mock_cursor_listener.h"
 #include "mir/test/doubles/mock_touch_visualizer.h"
@@ -312,3 +313,96 @@ TEST_F(SeatInputDeviceTracker, reset_pointer_confinement_allows_movement_past)
     tracker.reset_confinement_regions();
     tracker.dispatch(motion_event(some_device_builder, max_w_h * 2, max_w_h * 2));
 }
+
+TEST_F(SeatInputDeviceTracker, device_state_reflects_dispatched_events)
+{
+    tracker.add_device(some_device);
+    tracker.add_device(another_device);
+    tracker.dispatch(motion_event(some_device_builder, 20.0f, 40.0f));
+    tracker.dispatch(button_event(some_device_builder, mir_pointer_action_button_down, mir_pointer_button_primary));
+    tracker.dispatch(another_device_builder.key_event(arbitrary_timestamp, mir_keyboard_action_down, 0, KEY_A));
+
+    auto const state_event = tracker.create_device_state();
+    auto const state = mir_event_get_input_device_state_event(state_event.get());
+
+    EXPECT_THAT(mir_input_device_state_event_pointer_axis(state, mir_pointer_axis_x), FloatEq(20.0f));
+    EXPECT_THAT(mir_input_device_state_event_pointer_axis(state, mir_pointer_axis_y), FloatEq(40.0f));
+    EXPECT_THAT(mir_input_device_state_event_pointer_buttons(state), Eq(mir_pointer_button_primary));
+    EXPECT_THAT(tracker.button_state(), Eq(mir_pointer_button_primary));
+
+    ASSERT_THAT(mir_input_device_state_event_device_count(state), Eq(2u));
+    for (auto i = 0u; i != 2; ++i)
+    {
+        if (mir_input_device_state_event_device_id(state, i) != another_device)
+            continue;
+        ASSERT_THAT(mir_input_device_state_event_device_pressed_keys_count(state, i), Eq(1u));
+        EXPECT_THAT(mir_input_device_state_event_device_pressed_keys_for_index(state, i, 0), Eq(uint32_t{KEY_A}));
+    }
+}
+
+TEST_F(SeatInputDeviceTracker, device_state_reflects_cursor_position_set)
+{
+    tracker.set_cursor_position(12.0f, 34.0f);
+
+    auto const state_event = tracker.create_device_state();
+    auto const state = mir_event_get_input_device_state_event(state_event.get());
+
+    EXPECT_THAT(mir_input_device_state_event_pointer_axis(state, mir_pointer_axis_x), FloatEq(12.0f));
+    EXPECT_THAT(mir_input_device_state_event_pointer_axis(state, mir_pointer_axis_y), FloatEq(34.0f));
+}
+
+TEST_F(SeatInputDeviceTracker, xkb_modifiers_reflect_dispatched_keys)
+{
+    mapper.set_keymap_for_all_devices(std::make_shared<mi::ParameterKeymap>());
+    tracker.add_device(some_device);
+    tracker.dispatch(some_device_builder.key_event(arbitrary_timestamp, mir_keyboard_action_down, 0, KEY_LEFTSHIFT));
+
+    EXPECT_THAT(tracker.xkb_modifiers().depressed, Ne(0u));
+
+    tracker.dispatch(some_device_builder.key_event(arbitrary_timestamp, mir_keyboard_action_up, 0, KEY_LEFTSHIFT));
+
+    EXPECT_THAT(tracker.xkb_modifiers().depressed, Eq(0u));
+}
+
+TEST_F(SeatInputDeviceTracker, modifiers_reflect_keymap_changes_made_outside_the_seat)
+{
+    mapper.set_keymap_for_all_devices(std::make_shared<mi::ParameterKeymap>());
+    tracker.add_device(some_device);
+    tracker.dispatch(some_device_builder.key_event(arbitrary_timestamp, mir_keyboard_action_down, 0, KEY_LEFTSHIFT));
+
+    ASSERT_THAT(tracker.xkb_modifiers().depressed, Ne(0u));
+
+    mapper.clear_keymap_for_device(some_device);
+
+    EXPECT_THAT(tracker.xkb_modifiers().depressed, Eq(0u));
+    auto const state_event = tracker.create_device_state();
+    auto const state = mir_event_get_input_device_state_event(state_event.get());
+    EXPECT_THAT(mir_input_device_state_event_modifiers(state) & mir_input_event_modifier_shift, Eq(0u));
+}
+
+TEST_F(SeatInputDeviceTracker, pointer_state_set_updates_button_state)
+{
+    tracker.add_device(some_device);
+    tracker.add_device(another_device);
+    tracker.dispatch(button_event(some_device_builder, mir_pointer_action_button_down, mir_pointer_button_primary));
+
+    tracker.set_pointer_state(another_device, mir_pointer_button_secondary);
+
+    EXPECT_THAT(tracker.button_state(), Eq(mir_pointer_button_primary | mir_pointer_button_secondary));
+
+    tracker.set_pointer_state(another_device, 0);
+
+    EXPECT_THAT(tracker.button_state(), Eq(mir_pointer_button_primary));
+}
+
+TEST_F(SeatInputDeviceTracker, output_change_confines_subsequent_motion)
+{
+    EXPECT_CALL(mock_cursor_listener, cursor_moved_to(20.0f, 40.0f));
+    EXPECT_CALL(mock_cursor_listener, cursor_moved_to(49.0f, 49.0f));
+
+    tracker.add_device(some_device);
+    tracker.dispatch(motion_event(some_device_builder, 20.0f, 40.0f));
+
+    tracker.update_outputs({geom::Rectangle{{0, 0}, {50, 50}}});
+    tracker.dispatch(motion_event(some_device_builder, 100.0f, 100.0f));
+}
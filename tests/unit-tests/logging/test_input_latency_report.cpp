@@ -0,0 +1,115 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/report/logging/input_latency_report.h"
+#include "mir/logging/logger.h"
+#include "mir/test/doubles/advanceable_clock.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+namespace mtd = mir::test::doubles;
+namespace mrl = mir::report::logging;
+namespace ml = mir::logging;
+
+using namespace std::chrono_literals;
+using namespace testing;
+
+namespace
+{
+class Recorder : public ml::Logger
+{
+public:
+    void log(ml::Severity, std::string const& message, std::string const&) override
+    {
+        messages.push_back(message);
+    }
+
+    std::vector<std::string> messages;
+};
+
+struct LoggingInputLatencyReport : Test
+{
+    std::shared_ptr<mtd::AdvanceableClock> const clock = std::make_shared<mtd::AdvanceableClock>();
+    std::shared_ptr<Recorder> const recorder = std::make_shared<Recorder>();
+    mrl::InputLatencyReport report{recorder, clock};
+
+    auto now() const -> std::chrono::nanoseconds
+    {
+        return clock->now().time_since_epoch();
+    }
+};
+}
+
+TEST_F(LoggingInputLatencyReport, logs_nothing_within_the_first_second)
+{
+    report.received_event(now() - 1ms);
+    report.sent_event(now() - 2ms);
+
+    EXPECT_THAT(recorder->messages, IsEmpty());
+}
+
+TEST_F(LoggingInputLatencyReport, summarises_each_stage_that_was_reached)
+{
+    for (auto i = 0; i != 100; ++i)
+    {
+        report.received_event(now() - 100us);
+        report.dispatched_event(now() - 300us);
+    }
+    clock->advance_by(1s);
+    report.received_event(now() - 100us);
+
+    ASSERT_THAT(recorder->messages, SizeIs(2));
+    EXPECT_THAT(recorder->messages[0], HasSubstr("Latency to seat: 101 events, mean 0.100 ms"));
+    EXPECT_THAT(recorder->messages[1], HasSubstr("Latency to dispatch: 100 events, mean 0.300 ms"));
+}
+
+TEST_F(LoggingInputLatencyReport, percentiles_come_from_the_histogram)
+{
+    for (auto i = 0; i != 99; ++i)
+    {
+        report.sent_event(now() - 1500us);
+    }
+    clock->advance_by(1s);
+    report.sent_event(now() - 20ms);
+
+    ASSERT_THAT(recorder->messages, SizeIs(1));
+    EXPECT_THAT(recorder->messages[0], HasSubstr("50% under 2.048 ms"));
+    EXPECT_THAT(recorder->messages[0], HasSubstr("max 20.000 ms"));
+}
+
+TEST_F(LoggingInputLatencyReport, presentation_latency_is_measured_to_the_presentation_time)
+{
+    clock->advance_by(1s);
+    report.presented_after_event(now() - 5s, now() - 5s + 25ms);
+
+    ASSERT_THAT(recorder->messages, SizeIs(1));
+    EXPECT_THAT(recorder->messages[0], HasSubstr("Latency to screen: 1 events, mean 25.000 ms"));
+}
+
+TEST_F(LoggingInputLatencyReport, counts_are_reset_after_logging)
+{
+    clock->advance_by(1s);
+    report.committed_after_event(now() - 8ms);
+    clock->advance_by(1s);
+    report.committed_after_event(now() - 8ms);
+
+    ASSERT_THAT(recorder->messages, SizeIs(2));
+    EXPECT_THAT(recorder->messages[1], HasSubstr("Latency to commit: 1 events"));
+}
@@ -81,6 +81,17 @@ TEST_F(BypassMatchTest, shaped_fullscreen_window_not_bypassed)
     EXPECT_EQ(list.rend(), std::find_if(list.rbegin(), list.rend(), matcher));
 }
 
+TEST_F(BypassMatchTest, cropped_fullscreen_window_not_bypassed)
+{
+    auto window = std::make_shared<mtd::FakeRenderable>(0, 0, 1920, 1200);
+    window->set_buffer(std::make_shared<mtd::StubBuffer>(geom::Size{3840, 2400}));
+    window->set_src_bounds({{0, 0}, {1920, 1200}});
+    mgg::BypassMatch matcher(primary_monitor);
+    mg::RenderableList list{window};
+
+    EXPECT_EQ(list.rend(), std::find_if(list.rbegin(), list.rend(), matcher));
+}
+
 TEST_F(BypassMatchTest, offset_fullscreen_window_not_bypassed)
 {
     mgg::BypassMatch matcher(primary_monitor);
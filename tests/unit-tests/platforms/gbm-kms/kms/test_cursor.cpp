@@ -465,6 +465,56 @@ TEST_F(MesaCursorTest, pads_missing_data_when_buffer_size_differs)
     cursor_tmp.show(SinglePixelCursorImage());
 }
 
+TEST_F(MesaCursorTest, showing_the_same_image_again_does_not_rewrite_bo)
+{
+    using namespace testing;
+
+    EXPECT_CALL(mock_gbm, gbm_bo_write(_, _, _)).Times(AtLeast(1));
+    cursor.show(stub_image);
+    Mock::VerifyAndClearExpectations(&mock_gbm);
+
+    EXPECT_CALL(mock_gbm, gbm_bo_write(_, _, _)).Times(0);
+    cursor.show(StubCursorImage());
+}
+
+TEST_F(MesaCursorTest, switching_back_to_the_previous_image_does_not_rewrite_bo)
+{
+    using namespace testing;
+
+    cursor.show(SinglePixelCursorImage());
+    cursor.show(stub_image);
+    Mock::VerifyAndClearExpectations(&mock_gbm);
+    output_container.verify_and_clear_expectations();
+
+    EXPECT_CALL(mock_gbm, gbm_bo_write(_, _, _)).Times(0);
+    EXPECT_CALL(*output_container.outputs[0], set_cursor(_));
+    cursor.show(SinglePixelCursorImage());
+}
+
+TEST_F(MesaCursorTest, switching_to_a_third_image_rewrites_bo)
+{
+    using namespace testing;
+
+    size_t const stride = 64 * 4;
+    ON_CALL(mock_gbm, gbm_bo_get_stride(_))
+        .WillByDefault(Return(stride));
+
+    struct HalfSizeCursorImage : public StubCursorImage
+    {
+        geom::Size size() const
+        {
+            return geom::Size{geom::Width{32}, geom::Height{32}};
+        }
+    };
+
+    cursor.show(stub_image);
+    cursor.show(HalfSizeCursorImage());
+    Mock::VerifyAndClearExpectations(&mock_gbm);
+
+    EXPECT_CALL(mock_gbm, gbm_bo_write(_, ContainsASingleWhitePixel(64*64), 64*stride)).Times(AtLeast(1));
+    cursor.show(SinglePixelCursorImage());
+}
+
 TEST_F(MesaCursorTest, does_not_throw_when_images_are_too_large)
 {
     using namespace testing;
@@ -464,6 +464,78 @@ TEST_F(MesaDisplayBufferTest, clone_mode_waits_for_page_flip_on_second_flip)
     db.post();
 }
 
+TEST_F(MesaDisplayBufferTest, single_mode_reports_the_frame_it_flipped_on)
+{
+    Frame const flip{42, Frame::Timestamp{CLOCK_MONOTONIC, std::chrono::nanoseconds{123456789}}};
+    ON_CALL(*mock_kms_output, last_frame())
+        .WillByDefault(Return(flip));
+
+    graphics::gbm::DisplayBuffer db(
+        graphics::gbm::BypassOption::allowed,
+        null_display_report(),
+        {mock_kms_output},
+        make_output_surface(),
+        display_area,
+        identity);
+
+    db.swap_buffers();
+    db.post();
+
+    EXPECT_THAT(db.last_frame().msc, Eq(flip.msc));
+    EXPECT_THAT(db.last_frame().ust, Eq(flip.ust));
+}
+
+TEST_F(MesaDisplayBufferTest, clone_mode_does_not_report_the_previous_flip_as_this_frame)
+{
+    Frame const flip{42, Frame::Timestamp{CLOCK_MONOTONIC, std::chrono::nanoseconds{123456789}}};
+    ON_CALL(*mock_kms_output, last_frame())
+        .WillByDefault(Return(flip));
+
+    graphics::gbm::DisplayBuffer db(
+        graphics::gbm::BypassOption::allowed,
+        null_display_report(),
+        {mock_kms_output, mock_kms_output},
+        make_output_surface(),
+        display_area,
+        identity);
+
+    db.swap_buffers();
+    db.post();
+    db.swap_buffers();
+    db.post();
+
+    // The second post() waited for the first flip, but not for its own
+    EXPECT_THAT(db.last_frame().msc, Eq(0));
+    EXPECT_THAT(db.last_frame().ust, Gt(flip.ust));
+}
+
+TEST_F(MesaDisplayBufferTest, clone_mode_waits_for_the_frame_when_asked)
+{
+    Frame const flip{42, Frame::Timestamp{CLOCK_MONOTONIC, std::chrono::nanoseconds{123456789}}};
+    ON_CALL(*mock_kms_output, last_frame())
+        .WillByDefault(Return(flip));
+
+    graphics::gbm::DisplayBuffer db(
+        graphics::gbm::BypassOption::allowed,
+        null_display_report(),
+        {mock_kms_output, mock_kms_output},
+        make_output_surface(),
+        display_area,
+        identity);
+
+    db.swap_buffers();
+    db.post();
+
+    EXPECT_CALL(*mock_kms_output, wait_for_page_flip())
+        .Times(2);
+
+    auto const frame = db.wait_for_last_frame();
+
+    EXPECT_THAT(frame.msc, Eq(flip.msc));
+    EXPECT_THAT(frame.ust, Eq(flip.ust));
+    EXPECT_THAT(db.last_frame().msc, Eq(flip.msc));
+}
+
 TEST_F(MesaDisplayBufferTest, skips_bypass_because_of_incompatible_list)
 {
     graphics::RenderableList list{
@@ -148,3 +148,29 @@ TEST_F(BasicBufferRenderTarget, throws_on_invalid_buffer)
         render_target.swap_buffers();
     }, std::logic_error);
 }
+
+TEST_F(BasicBufferRenderTarget, reads_only_pixels_of_buffer_region)
+{
+    mrg::BasicBufferRenderTarget render_target{mt::fake_shared(ctx)};
+    EXPECT_CALL(mock_gl, glViewport(0, 0, 10, 8));
+    render_target.set_buffer_region(mt::fake_shared(reasonable_buffer), {{4, 6}, {10, 8}});
+    EXPECT_THAT(render_target.size(), Eq(geom::Size{10, 8}));
+    EXPECT_CALL(mock_gl, glReadPixels(0, 0, 10, 8, _, _, _));
+    render_target.swap_buffers();
+}
+
+TEST_F(BasicBufferRenderTarget, throws_on_region_outside_buffer)
+{
+    mrg::BasicBufferRenderTarget render_target{mt::fake_shared(ctx)};
+    EXPECT_THROW({
+        render_target.set_buffer_region(mt::fake_shared(reasonable_buffer), {{4, 6}, reasonable_size});
+    }, std::logic_error);
+}
+
+TEST_F(BasicBufferRenderTarget, throws_on_gpu_buffer_that_is_not_a_dmabuf)
+{
+    mrg::BasicBufferRenderTarget render_target{mt::fake_shared(ctx)};
+    EXPECT_THROW({
+        render_target.set_gpu_buffer(mt::fake_shared(reasonable_buffer));
+    }, std::logic_error);
+}
@@ -22,6 +22,7 @@
 #include <mir/test/doubles/mock_gl_buffer.h>
 #include <mir/test/doubles/mock_renderable.h>
 #include <mir/compositor/buffer_stream.h>
+#include <mir/graphics/solid_colour_buffer.h>
 #include <mir/test/doubles/mock_gl.h>
 #include <mir/test/doubles/mock_egl.h>
 #include <src/renderers/gl/renderer.h>
@@ -226,6 +227,27 @@ TEST_F(GLRenderer, avoids_src_alpha_for_rgbx_blending)  // LP: #1423462
     renderer.render(renderable_list);
 }
 
+TEST_F(GLRenderer, fills_solid_colour_buffers_without_a_texture)
+{
+    auto const solid_colour =
+        std::make_shared<mg::SolidColourBuffer>(mg::SolidColourBuffer::Colour{0.25f, 0.5f, 0.75f, 1.0f});
+    EXPECT_CALL(*renderable, buffer()).WillRepeatedly(Return(solid_colour));
+    EXPECT_CALL(*mock_buffer, bind()).Times(0);
+    EXPECT_CALL(mock_gl, glUniform4fv(_, 1, _))
+        .WillOnce(testing::Invoke(
+            [](GLint, GLsizei, GLfloat const* colour)
+            {
+                EXPECT_THAT(colour[0], testing::FloatEq(0.25f));
+                EXPECT_THAT(colour[1], testing::FloatEq(0.5f));
+                EXPECT_THAT(colour[2], testing::FloatEq(0.75f));
+                EXPECT_THAT(colour[3], testing::FloatEq(1.0f));
+            }));
+    EXPECT_CALL(mock_gl, glDrawArrays(_, _, _)).Times(AtLeast(1));
+
+    mrg::Renderer renderer(display_buffer);
+    renderer.render(renderable_list);
+}
+
 TEST_F(GLRenderer, clears_to_opaque_black)
 {
     InSequence seq;
@@ -22,6 +22,8 @@
 #include "mir/frontend/event_sink.h"
 #include "mir/geometry/rectangle.h"
 #include "mir/geometry/displacement.h"
+#include "mir/graphics/frame.h"
+#include "mir/graphics/solid_colour_buffer.h"
 #include "mir/scene/null_surface_observer.h"
 #include "mir/events/event_builders.h"
 
@@ -66,6 +68,7 @@ class MockSurfaceObserver : public ms::NullSurfaceObserver
 public:
     MOCK_METHOD3(attrib_changed, void(ms::Surface const*, MirWindowAttrib, int));
     MOCK_METHOD2(window_resized_to, void(ms::Surface const*, geom::Size const&));
+    MOCK_METHOD2(moved_to, void(ms::Surface const*, geom::Point const&));
     MOCK_METHOD2(content_resized_to, void(ms::Surface const*, geom::Size const&));
     MOCK_METHOD3(frame_posted, void(ms::Surface const*, int, geom::Rectangle const&));
     MOCK_METHOD2(hidden_set_to, void(ms::Surface const*, bool));
@@ -1005,6 +1008,23 @@ TEST_F(BasicSurfaceTest, notifies_about_cursor_image_removal)
     surface.set_cursor_image({});
 }
 
+TEST_F(BasicSurfaceTest, single_pixel_buffer_can_be_the_cursor)
+{
+    using namespace testing;
+
+    // Premultiplied half-transparent red
+    auto const buffer = std::make_shared<mir::graphics::SolidColourBuffer>(
+        mir::graphics::SolidColourBuffer::Colour{0.5f, 0.0f, 0.0f, 0.5f});
+
+    surface.set_cursor_from_buffer(buffer, {1, 1});
+
+    auto const image = surface.cursor_image();
+    ASSERT_THAT(image, NotNull());
+    EXPECT_THAT(image->size(), Eq(geom::Size{1, 1}));
+    EXPECT_THAT(image->hotspot(), Eq(geom::Displacement{1, 1}));
+    EXPECT_THAT(*static_cast<uint32_t const*>(image->as_argb_8888()), Eq(0x80800000u));
+}
+
 TEST_F(BasicSurfaceTest, when_frame_is_posted_an_observer_is_notified_of_frame_with_correct_size)
 {
     using namespace testing;
@@ -1083,6 +1103,43 @@ TEST_F(BasicSurfaceTest, when_stream_info_has_offset_an_observer_is_notified_of_
     buffer_stream->frame_posted_callback(rect.size);
 }
 
+TEST_F(BasicSurfaceTest, renderable_reports_stream_opaque_region_in_screen_coordinates)
+{
+    using namespace testing;
+    geom::Displacement const stream_info_offset{7, 10};
+    geom::Size const stream_info_size{20, 30};
+
+    auto buffer_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    ms::StreamInfo stream_info{buffer_stream, stream_info_offset, stream_info_size};
+    stream_info.opaque_region = {{{2, 3}, {5, 5}}, {{15, 25}, {10, 10}}, {{50, 50}, {5, 5}}};
+    surface.set_streams({stream_info});
+
+    auto const renderables = surface.generate_renderables(this);
+    ASSERT_THAT(renderables.size(), Eq(1u));
+
+    auto const stream_top_left = rect.top_left + stream_info_offset;
+    EXPECT_THAT(renderables[0]->opaque_region(), ElementsAre(
+        geom::Rectangle{stream_top_left + geom::Displacement{2, 3}, {5, 5}},
+        geom::Rectangle{stream_top_left + geom::Displacement{15, 25}, {5, 5}}));
+}
+
+TEST_F(BasicSurfaceTest, renderable_reports_stream_src_bounds_and_size)
+{
+    using namespace testing;
+    geom::Size const stream_info_size{1920, 1080};
+    geom::RectangleD const src_bounds{{0.5, 60}, {1280, 720}};
+
+    auto buffer_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    ms::StreamInfo stream_info{buffer_stream, {}, stream_info_size};
+    stream_info.src_bounds = src_bounds;
+    surface.set_streams({stream_info});
+
+    auto const renderables = surface.generate_renderables(this);
+    ASSERT_THAT(renderables.size(), Eq(1u));
+    EXPECT_THAT(renderables[0]->src_bounds(), Eq(src_bounds));
+    EXPECT_THAT(renderables[0]->screen_position().size, Eq(stream_info_size));
+}
+
 TEST_F(BasicSurfaceTest, when_surface_has_margins_an_observer_is_notified_of_frame_with_correct_offset)
 {
     using namespace testing;
@@ -1332,6 +1389,40 @@ TEST_F(BasicSurfaceTest, registers_frame_callbacks_on_set_streams)
     surface.set_streams(streams);
 }
 
+TEST_F(BasicSurfaceTest, setting_unchanged_streams_does_nothing)
+{
+    using namespace testing;
+
+    auto buffer_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    std::list<ms::StreamInfo> streams = {
+        { mock_buffer_stream, {0,0}, {} },
+        { buffer_stream, {3,4}, {} }
+    };
+    surface.set_streams(streams);
+    surface.register_interest(mock_surface_observer, executor);
+
+    EXPECT_CALL(*mock_buffer_stream, set_frame_posted_callback(_)).Times(0);
+    EXPECT_CALL(*buffer_stream, set_frame_posted_callback(_)).Times(0);
+    EXPECT_CALL(*mock_surface_observer, moved_to(_, _)).Times(0);
+
+    surface.set_streams(streams);
+}
+
+TEST_F(BasicSurfaceTest, only_moved_streams_get_new_frame_callbacks_on_set_streams)
+{
+    using namespace testing;
+
+    auto buffer_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    surface.set_streams({{ mock_buffer_stream, {0,0}, {} }, { buffer_stream, {3,4}, {} }});
+    surface.register_interest(mock_surface_observer, executor);
+
+    EXPECT_CALL(*mock_buffer_stream, set_frame_posted_callback(_)).Times(0);
+    EXPECT_CALL(*buffer_stream, set_frame_posted_callback(_));
+    EXPECT_CALL(*mock_surface_observer, moved_to(_, _));
+
+    surface.set_streams({{ mock_buffer_stream, {0,0}, {} }, { buffer_stream, {5,6}, {} }});
+}
+
 TEST_F(BasicSurfaceTest, showing_brings_all_streams_up_to_date)
 {
     using namespace testing;
@@ -1620,3 +1711,33 @@ TEST_F(BasicSurfaceTest, buffer_can_be_submitted_to_set_stream_after_surface_des
     surface.reset();
     callback({10, 10});
 }
+
+TEST_F(BasicSurfaceTest, buffer_presented_is_forwarded_to_the_rendered_stream_only)
+{
+    using namespace testing;
+
+    auto const other_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    surface.set_streams({ms::StreamInfo{mock_buffer_stream, {}, {}}, ms::StreamInfo{other_stream, {}, {}}});
+
+    mg::BufferID const buffer{42};
+    geom::Rectangle const output_area{{0, 0}, {640, 480}};
+
+    EXPECT_CALL(*mock_buffer_stream, frame_presented(_, _, _, _)).Times(0);
+    EXPECT_CALL(*other_stream, frame_presented(buffer, output_area, _, true));
+
+    surface.buffer_presented(other_stream.get(), buffer, output_area, mg::Frame{}, true);
+}
+
+TEST_F(BasicSurfaceTest, buffer_presented_for_a_removed_stream_is_ignored)
+{
+    using namespace testing;
+
+    auto const removed_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    surface.set_streams({ms::StreamInfo{removed_stream, {}, {}}});
+    surface.set_streams({ms::StreamInfo{mock_buffer_stream, {}, {}}});
+
+    EXPECT_CALL(*removed_stream, frame_presented(_, _, _, _)).Times(0);
+    EXPECT_CALL(*mock_buffer_stream, frame_presented(_, _, _, _)).Times(0);
+
+    surface.buffer_presented(removed_stream.get(), mg::BufferID{1}, {}, mg::Frame{}, false);
+}
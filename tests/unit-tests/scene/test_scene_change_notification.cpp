@@ -146,3 +146,25 @@ TEST_F(SceneChangeNotificationTest, ending_observation_unregisters_observers)
     // Verify that its not simply the destruction removing the observer...
     ::testing::Mock::VerifyAndClearExpectations(&observer);
 }
+
+TEST_F(SceneChangeNotificationTest, frames_of_occluded_surfaces_do_not_trigger_compositing)
+{
+    using namespace ::testing;
+    std::weak_ptr<ms::SurfaceObserver> surface_observer;
+    EXPECT_CALL(*surface, register_interest(_)).Times(1)
+        .WillOnce(SaveArg<0>(&surface_observer));
+
+    ms::SceneChangeNotification observer(scene_change_callback, buffer_change_callback);
+    observer.surface_added(surface);
+
+    surface_observer.lock()->attrib_changed(surface.get(), mir_window_attrib_visibility, mir_window_visibility_occluded);
+
+    EXPECT_CALL(buffer_callback, invoke(_, _)).Times(0);
+    surface_observer.lock()->frame_posted(surface.get(), 1, {});
+    Mock::VerifyAndClearExpectations(&buffer_callback);
+
+    surface_observer.lock()->attrib_changed(surface.get(), mir_window_attrib_visibility, mir_window_visibility_exposed);
+
+    EXPECT_CALL(buffer_callback, invoke(1, _)).Times(1);
+    surface_observer.lock()->frame_posted(surface.get(), 1, {});
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/scene/surface_input_index.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace ms = mir::scene;
+namespace geom = mir::geometry;
+
+using namespace testing;
+
+namespace
+{
+struct SurfaceInputIndex : Test
+{
+    ms::SurfaceInputIndex index;
+
+    // The index never dereferences the surfaces
+    int dummies[3];
+    ms::Surface const* const surface1{reinterpret_cast<ms::Surface const*>(&dummies[0])};
+    ms::Surface const* const surface2{reinterpret_cast<ms::Surface const*>(&dummies[1])};
+    ms::Surface const* const surface3{reinterpret_cast<ms::Surface const*>(&dummies[2])};
+};
+}
+
+TEST_F(SurfaceInputIndex, finds_surfaces_containing_point)
+{
+    index.insert(surface1, {{0, 0}, {1000, 1000}});
+    index.insert(surface2, {{100, 100}, {50, 50}});
+    index.insert(surface3, {{600, 600}, {50, 50}});
+
+    EXPECT_THAT(index.surfaces_at({120, 120}), UnorderedElementsAre(surface1, surface2));
+    EXPECT_THAT(index.surfaces_at({620, 620}), UnorderedElementsAre(surface1, surface3));
+    EXPECT_THAT(index.surfaces_at({160, 160}), ElementsAre(surface1));
+    EXPECT_THAT(index.surfaces_at({1000, 1000}), IsEmpty());
+}
+
+TEST_F(SurfaceInputIndex, handles_negative_coordinates)
+{
+    index.insert(surface1, {{-300, -300}, {100, 100}});
+
+    EXPECT_THAT(index.surfaces_at({-250, -250}), ElementsAre(surface1));
+    EXPECT_THAT(index.surfaces_at({-50, -50}), IsEmpty());
+    EXPECT_THAT(index.surfaces_at({50, 50}), IsEmpty());
+}
+
+TEST_F(SurfaceInputIndex, moved_surface_is_only_found_at_new_bounds)
+{
+    index.insert(surface1, {{0, 0}, {100, 100}});
+    index.insert(surface1, {{2000, 2000}, {100, 100}});
+
+    EXPECT_THAT(index.surfaces_at({50, 50}), IsEmpty());
+    EXPECT_THAT(index.surfaces_at({2050, 2050}), ElementsAre(surface1));
+}
+
+TEST_F(SurfaceInputIndex, erased_surface_is_not_found)
+{
+    index.insert(surface1, {{0, 0}, {100, 100}});
+    index.erase(surface1);
+
+    EXPECT_FALSE(index.contains(surface1));
+    EXPECT_THAT(index.surfaces_at({50, 50}), IsEmpty());
+}
+
+TEST_F(SurfaceInputIndex, surface_with_empty_bounds_is_contained_but_never_found)
+{
+    index.insert(surface1, {});
+
+    EXPECT_TRUE(index.contains(surface1));
+    EXPECT_THAT(index.surfaces_at({0, 0}), IsEmpty());
+}
+
+TEST_F(SurfaceInputIndex, finds_surfaces_too_big_for_the_grid)
+{
+    auto const huge = ms::SurfaceInputIndex::cell_size * ms::SurfaceInputIndex::max_cells_per_surface;
+    index.insert(surface1, {{-huge, -huge}, {2 * huge, 2 * huge}});
+
+    EXPECT_THAT(index.surfaces_at({huge - 1, huge - 1}), ElementsAre(surface1));
+    EXPECT_THAT(index.surfaces_at({huge, huge}), IsEmpty());
+
+    index.erase(surface1);
+    EXPECT_THAT(index.surfaces_at({0, 0}), IsEmpty());
+}
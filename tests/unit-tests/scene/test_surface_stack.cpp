@@ -989,6 +989,7 @@ TEST_F(SurfaceStack, returns_top_surface_under_cursor)
     stub_surface1->resize({900, 900});
     stub_surface2->resize({500, 200});
     stub_surface3->resize({200, 500});
+    executor.execute();
 
     EXPECT_THAT(stack.surface_at(cursor_over_all),  Eq(stub_surface3));
     EXPECT_THAT(stack.surface_at(cursor_over_12),   Eq(stub_surface2));
@@ -1012,6 +1013,7 @@ TEST_F(SurfaceStack, returns_top_visible_surface_under_cursor)
     stub_surface2->resize({500, 200});
     stub_surface3->resize({200, 500});
     invisible_stub_surface->resize({999, 999});
+    executor.execute();
 
     EXPECT_THAT(stack.surface_at(cursor_over_all),  Eq(stub_surface3));
     EXPECT_THAT(stack.surface_at(cursor_over_12),   Eq(stub_surface2));
@@ -1019,6 +1021,41 @@ TEST_F(SurfaceStack, returns_top_visible_surface_under_cursor)
     EXPECT_THAT(stack.surface_at(cursor_over_none).get(), IsNull());
 }
 
+TEST_F(SurfaceStack, finds_surface_under_cursor_after_it_moves)
+{
+    stack.add_surface(stub_surface1, mi::InputReceptionMode::normal);
+    stub_surface1->resize({100, 100});
+    executor.execute();
+
+    stub_surface1->move_to({1000, 1000});
+    executor.execute();
+
+    EXPECT_THAT(stack.surface_at({50, 50}).get(), IsNull());
+    EXPECT_THAT(stack.surface_at({1050, 1050}), Eq(stub_surface1));
+}
+
+TEST_F(SurfaceStack, finds_surface_under_cursor_in_input_region_outside_its_content)
+{
+    stack.add_surface(stub_surface1, mi::InputReceptionMode::normal);
+    stub_surface1->resize({100, 100});
+    stub_surface1->set_input_region({{{-600, -600}, {50, 50}}});
+    executor.execute();
+
+    EXPECT_THAT(stack.surface_at({50, 50}).get(), IsNull());
+    EXPECT_THAT(stack.surface_at({-575, -575}), Eq(stub_surface1));
+}
+
+TEST_F(SurfaceStack, does_not_find_removed_surface_under_cursor)
+{
+    stack.add_surface(stub_surface1, mi::InputReceptionMode::normal);
+    stub_surface1->resize({100, 100});
+    executor.execute();
+
+    stack.remove_surface(stub_surface1);
+
+    EXPECT_THAT(stack.surface_at({50, 50}).get(), IsNull());
+}
+
 TEST_F(SurfaceStack, raise_surfaces_to_top)
 {
     stack.add_surface(stub_surface1, mi::InputReceptionMode::normal);
@@ -0,0 +1,87 @@
+/*
+ * Copyright © Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/thread_scheduling.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace testing;
+
+namespace
+{
+auto current_affinity() -> cpu_set_t
+{
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    pthread_getaffinity_np(pthread_self(), sizeof cpus, &cpus);
+    return cpus;
+}
+
+auto first_cpu_of(cpu_set_t const& cpus) -> int
+{
+    for (auto cpu = 0; cpu != CPU_SETSIZE; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &cpus))
+            return cpu;
+    }
+    return -1;
+}
+}
+
+TEST(ThreadScheduling, parses_policies)
+{
+    EXPECT_THAT(mir::parse_scheduling_policy("fifo"), Eq(mir::ThreadScheduling::Policy::fifo));
+    EXPECT_THAT(mir::parse_scheduling_policy("rr"), Eq(mir::ThreadScheduling::Policy::round_robin));
+    EXPECT_THROW(mir::parse_scheduling_policy("idle"), std::invalid_argument);
+}
+
+TEST(ThreadScheduling, parses_cpu_lists)
+{
+    EXPECT_THAT(mir::parse_cpu_list(""), IsEmpty());
+    EXPECT_THAT(mir::parse_cpu_list("3"), ElementsAre(3));
+    EXPECT_THAT(mir::parse_cpu_list("0-2,5"), ElementsAre(0, 1, 2, 5));
+}
+
+TEST(ThreadScheduling, rejects_malformed_cpu_lists)
+{
+    EXPECT_THROW(mir::parse_cpu_list("1,"), std::invalid_argument);
+    EXPECT_THROW(mir::parse_cpu_list("a"), std::invalid_argument);
+    EXPECT_THROW(mir::parse_cpu_list("3-1"), std::invalid_argument);
+    EXPECT_THROW(mir::parse_cpu_list("-1"), std::invalid_argument);
+    EXPECT_THROW(mir::parse_cpu_list("2x"), std::invalid_argument);
+}
+
+TEST(ThreadScheduling, scoped_scheduling_restores_affinity)
+{
+    auto const before = current_affinity();
+    auto const cpu = first_cpu_of(before);
+    ASSERT_THAT(cpu, Ge(0));
+
+    {
+        mir::ScopedThreadScheduling const scheduling{mir::ThreadScheduling{0, {}, {cpu}}, "test"};
+
+        auto const during = current_affinity();
+        EXPECT_THAT(CPU_COUNT(&during), Eq(1));
+        EXPECT_TRUE(CPU_ISSET(cpu, &during));
+    }
+
+    auto const after = current_affinity();
+    EXPECT_TRUE(CPU_EQUAL(&before, &after));
+}